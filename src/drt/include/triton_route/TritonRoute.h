@@ -95,6 +95,8 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  std::string paCacheDir;
+  bool incremental = false;
 };
 
 class TritonRoute
@@ -125,6 +127,8 @@ class TritonRoute
               bool followGuide);
 
   int getNumDRVs() const;
+  // unique instances the last pin_access loaded from -pa_cache_dir
+  int getNumPinAccessCacheHits() const;
 
   void setDebugDR(bool on = true);
   void setDebugDumpDR(bool on, const std::string& dumpDir);
@@ -180,6 +184,8 @@ class TritonRoute
                  const std::list<std::unique_ptr<fr::frMarker>>& markers,
                  odb::Rect bbox = odb::Rect(0, 0, 0, 0));
   void checkDRC(const char* drc_file, int x0, int y0, int x1, int y1);
+  // Errors out on an open in the routed design
+  void checkConnectivity();
   bool initGuide();
   void prep();
   void processBTermsAboveTopLayer(bool has_routing = false);
@@ -193,6 +199,7 @@ class TritonRoute
   std::unique_ptr<fr::FlexDR> dr_;  // kept for single stepping
   stt::SteinerTreeBuilder* stt_builder_;
   int num_drvs_;
+  int num_pa_cache_hits_;
   gui::Gui* gui_;
   dst::Distributed* dist_;
   bool distributed_;
@@ -206,6 +213,7 @@ class TritonRoute
   boost::asio::thread_pool dist_pool_;
 
   void initDesign();
+  bool routeIncremental();
   void gr();
   void ta();
   void dr();
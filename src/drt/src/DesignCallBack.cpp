@@ -38,13 +38,56 @@ static inline int defdist(odb::dbBlock* block, int x)
          / (double) block->getDbUnitsPerMicron();
 }
 
+void DesignCallBack::markInstDirty(odb::dbInst* db_inst)
+{
+  dirtyInsts_.insert(db_inst->getName());
+  for (auto db_iterm : db_inst->getITerms()) {
+    if (db_iterm->getNet() != nullptr)
+      dirtyNets_.insert(db_iterm->getNet()->getName());
+  }
+}
+
+// The whole net is revisited when its terminals change: the routes to a
+// removed terminal are dangling and a new one has to be reached from them.
+void DesignCallBack::addNetRegion(const frNet* net)
+{
+  Rect region;
+  region.mergeInit();
+  for (auto& shape : net->getShapes())
+    region.merge(shape->getBBox());
+  for (auto& via : net->getVias())
+    region.merge(via->getBBox());
+  for (auto& pwire : net->getPatchWires())
+    region.merge(pwire->getBBox());
+  for (auto& guide : net->getGuides())
+    region.merge(guide->getBBox());
+  for (auto instTerm : net->getInstTerms())
+    region.merge(instTerm->getInst()->getBBox());
+  for (auto bterm : net->getBTerms())
+    region.merge(bterm->getBBox());
+  if (!region.isInverted())
+    addDirtyRegion(region);
+}
+
+void DesignCallBack::clearDirtyObjects()
+{
+  dirtyInsts_.clear();
+  reimportInsts_.clear();
+  dirtyNets_.clear();
+  connectedNets_.clear();
+  dirtyRegions_.clear();
+}
+
 void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 {
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
+    markInstDirty(db_inst);
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
     if (inst == nullptr)
       return;
+    // the routing between the old and the new location is revisited too
+    Rect region = inst->getBBox();
     if (design->getRegionQuery() != nullptr)
       design->getRegionQuery()->removeBlockObj(inst);
     int x, y;
@@ -56,6 +99,8 @@ void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
     inst->setOrient(db_inst->getOrient());
     if (design->getRegionQuery() != nullptr)
       design->getRegionQuery()->addBlockObj(inst);
+    region.merge(inst->getBBox());
+    addDirtyRegion(region);
   }
 }
 
@@ -63,11 +108,91 @@ void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
 {
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
+    markInstDirty(db_inst);
+    dirtyInsts_.erase(db_inst->getName());
+    reimportInsts_.erase(db_inst->getName());
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
     if (inst == nullptr)
       return;
+    addDirtyRegion(inst->getBBox());
     if (design->getRegionQuery() != nullptr)
       design->getRegionQuery()->removeBlockObj(inst);
     design->getTopBlock()->removeInst(inst);
   }
 }
+
+void DesignCallBack::inDbInstCreate(odb::dbInst* db_inst)
+{
+  auto design = router_->getDesign();
+  if (design != nullptr && design->getTopBlock() != nullptr) {
+    markInstDirty(db_inst);
+    reimportInsts_.insert(db_inst->getName());
+  }
+}
+
+void DesignCallBack::inDbInstSwapMasterAfter(odb::dbInst* db_inst)
+{
+  auto design = router_->getDesign();
+  if (design != nullptr && design->getTopBlock() != nullptr) {
+    markInstDirty(db_inst);
+    reimportInsts_.insert(db_inst->getName());
+    // the new footprint is added once the instance is reimported
+    auto inst = design->getTopBlock()->getInst(db_inst->getName());
+    if (inst != nullptr)
+      addDirtyRegion(inst->getBBox());
+  }
+}
+
+void DesignCallBack::inDbITermPostConnect(odb::dbITerm* db_iterm)
+{
+  auto design = router_->getDesign();
+  if (design == nullptr || design->getTopBlock() == nullptr)
+    return;
+  auto db_inst = db_iterm->getInst();
+  markInstDirty(db_inst);
+  connectedNets_[db_iterm->getNet()->getName()].insert(db_inst->getName());
+  auto net = design->getTopBlock()->findNet(db_iterm->getNet()->getName());
+  if (net != nullptr)
+    addNetRegion(net);
+  // reimported instances pick up their connections from odb
+  if (reimportInsts_.find(db_inst->getName()) != reimportInsts_.end())
+    return;
+  auto inst = design->getTopBlock()->getInst(db_inst->getName());
+  if (inst == nullptr || net == nullptr)
+    return;
+  auto term = inst->getMaster()->getTerm(db_iterm->getMTerm()->getName());
+  if (term == nullptr)
+    return;
+  auto instTerm = inst->getInstTerms()[term->getIndexInOwner()].get();
+  instTerm->addToNet(net);
+  net->addInstTerm(instTerm);
+  addDirtyRegion(inst->getBBox());
+}
+
+void DesignCallBack::inDbITermPreDisconnect(odb::dbITerm* db_iterm)
+{
+  auto design = router_->getDesign();
+  if (design == nullptr || design->getTopBlock() == nullptr)
+    return;
+  auto db_inst = db_iterm->getInst();
+  markInstDirty(db_inst);
+  if (db_iterm->getNet() != nullptr) {
+    auto net = design->getTopBlock()->findNet(db_iterm->getNet()->getName());
+    if (net != nullptr)
+      addNetRegion(net);
+  }
+  if (reimportInsts_.find(db_inst->getName()) != reimportInsts_.end())
+    return;
+  auto inst = design->getTopBlock()->getInst(db_inst->getName());
+  if (inst == nullptr)
+    return;
+  auto term = inst->getMaster()->getTerm(db_iterm->getMTerm()->getName());
+  if (term == nullptr)
+    return;
+  auto instTerm = inst->getInstTerms()[term->getIndexInOwner()].get();
+  if (instTerm->getNet() != nullptr) {
+    instTerm->getNet()->removeInstTerm(instTerm);
+    instTerm->addToNet(nullptr);
+  }
+  addDirtyRegion(inst->getBBox());
+}
@@ -26,20 +26,67 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
 namespace triton_route {
 class TritonRoute;
 }
 namespace fr {
+class frNet;
+// Keeps frDesign in sync with odb edits made after routing and records what
+// they touched so that detailed_route -incremental only revisits those
+// objects.
 class DesignCallBack : public odb::dbBlockCallBackObj
 {
  public:
   DesignCallBack(triton_route::TritonRoute* router) : router_(router) {}
   void inDbPostMoveInst(odb::dbInst* inst) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+
+  bool hasDirtyObjects() const
+  {
+    return !dirtyInsts_.empty() || !dirtyNets_.empty()
+           || !dirtyRegions_.empty();
+  }
+  // instances needing pin access again
+  const std::set<std::string>& getDirtyInsts() const { return dirtyInsts_; }
+  // instances whose frInst is stale and must be reimported
+  const std::set<std::string>& getReimportInsts() const
+  {
+    return reimportInsts_;
+  }
+  const std::set<std::string>& getDirtyNets() const { return dirtyNets_; }
+  // nets that gained a terminal, with the instances of the new terminals
+  const std::map<std::string, std::set<std::string>>& getConnectedNets()
+      const
+  {
+    return connectedNets_;
+  }
+  const std::vector<odb::Rect>& getDirtyRegions() const
+  {
+    return dirtyRegions_;
+  }
+  void addDirtyRegion(const odb::Rect& box) { dirtyRegions_.push_back(box); }
+  void clearDirtyObjects();
 
  private:
+  void markInstDirty(odb::dbInst* inst);
+  void addNetRegion(const frNet* net);
+
   triton_route::TritonRoute* router_;
+  std::set<std::string> dirtyInsts_;
+  std::set<std::string> reimportInsts_;
+  std::set<std::string> dirtyNets_;
+  std::map<std::string, std::set<std::string>> connectedNets_;
+  std::vector<odb::Rect> dirtyRegions_;
 };
 }  // namespace fr
@@ -77,6 +77,7 @@ TritonRoute::TritonRoute()
       logger_(nullptr),
       stt_builder_(nullptr),
       num_drvs_(-1),
+      num_pa_cache_hits_(-1),
       gui_(gui::Gui::get()),
       dist_(nullptr),
       distributed_(false),
@@ -202,6 +203,14 @@ int TritonRoute::getNumDRVs() const
   return num_drvs_;
 }
 
+int TritonRoute::getNumPinAccessCacheHits() const
+{
+  if (num_pa_cache_hits_ < 0) {
+    logger_->error(DRT, 159, "Pin access has not been run yet.");
+  }
+  return num_pa_cache_hits_;
+}
+
 std::string TritonRoute::runDRWorker(const std::string& workerStr,
                                      FlexDRViaData* viaData)
 {
@@ -301,6 +310,7 @@ void TritonRoute::resetDb(const char* file_name)
 void TritonRoute::clearDesign()
 {
   design_ = std::make_unique<frDesign>(logger_);
+  db_callback_->clearDirtyObjects();
 }
 
 static void deserializeUpdate(frDesign* design,
@@ -564,6 +574,175 @@ void TritonRoute::initDesign()
     db_callback_->addOwner(db_->getChip()->getBlock());
 }
 
+// Reroutes only what the odb edits since the last run touched, as recorded
+// by the DesignCallBack.  Returns false if the full flow has to run instead.
+bool TritonRoute::routeIncremental()
+{
+  frBlock* block = getDesign()->getTopBlock();
+  if (distributed_) {
+    logger_->warn(utl::DRT,
+                  121,
+                  "Incremental routing is not supported in distributed mode, "
+                  "running the full flow.");
+    return false;
+  }
+  const bool routed = block != nullptr
+                      && std::any_of(block->getNets().begin(),
+                                     block->getNets().end(),
+                                     [](const auto& net) {
+                                       return !net->getShapes().empty()
+                                              || !net->getVias().empty();
+                                     });
+  if (!routed) {
+    logger_->info(utl::DRT,
+                  88,
+                  "No routed design to update incrementally, running the "
+                  "full flow.");
+    return false;
+  }
+  if (!db_callback_->hasDirtyObjects()) {
+    num_drvs_ = block->getNumMarkers();
+    return true;
+  }
+
+  // Only existing nets and masters are handled incrementally.
+  odb::dbBlock* dbBlock = db_->getChip()->getBlock();
+  std::vector<odb::dbInst*> reimportInsts;
+  for (const auto& name : db_callback_->getReimportInsts()) {
+    odb::dbInst* inst = dbBlock->findInst(name.c_str());
+    if (inst != nullptr) {
+      reimportInsts.push_back(inst);
+    }
+  }
+  for (const auto& name : db_callback_->getDirtyNets()) {
+    if (dbBlock->findNet(name.c_str()) != nullptr
+        && block->findNet(name) == nullptr) {
+      logger_->info(utl::DRT,
+                    64,
+                    "Net {} is new since the last run, running the full flow.",
+                    name);
+      clearDesign();
+      return false;
+    }
+  }
+  // The rip-up workers only reconnect a pin to routes that cross their own
+  // box.  A worker spans several GCells, so a new terminal within a GCell
+  // of the existing routes of its net is connected incrementally, while one
+  // farther away would stay open.
+  const frCoord reach = std::max(block->getGCellSizeHorizontal(),
+                                 block->getGCellSizeVertical());
+  for (const auto& [name, instNames] : db_callback_->getConnectedNets()) {
+    frNet* net = block->findNet(name);
+    if (net == nullptr
+        || (net->getShapes().empty() && net->getVias().empty())) {
+      continue;
+    }
+    for (const auto& instName : instNames) {
+      odb::dbInst* inst = dbBlock->findInst(instName.c_str());
+      if (inst == nullptr) {
+        continue;
+      }
+      Rect box;
+      inst->getBBox()->getBox().bloat(reach, box);
+      const bool nearRoute
+          = std::any_of(net->getShapes().begin(),
+                        net->getShapes().end(),
+                        [&box](const auto& shape) {
+                          return box.intersects(shape->getBBox());
+                        })
+            || std::any_of(net->getVias().begin(),
+                           net->getVias().end(),
+                           [&box](const auto& via) {
+                             return box.intersects(via->getBBox());
+                           });
+      if (!nearRoute) {
+        logger_->info(utl::DRT,
+                      148,
+                      "Net {} has a new terminal on {} away from its routes, "
+                      "running the full flow.",
+                      name,
+                      instName);
+        clearDesign();
+        return false;
+      }
+    }
+  }
+  for (odb::dbInst* inst : reimportInsts) {
+    if (getDesign()->getMaster(inst->getMaster()->getName()) == nullptr) {
+      logger_->info(utl::DRT,
+                    137,
+                    "Master {} is new since the last run, running the full "
+                    "flow.",
+                    inst->getMaster()->getName());
+      clearDesign();
+      return false;
+    }
+  }
+
+  logger_->info(utl::DRT,
+                152,
+                "Incremental routing of {} dirty instances, {} dirty nets "
+                "and {} dirty regions.",
+                db_callback_->getDirtyInsts().size(),
+                db_callback_->getDirtyNets().size(),
+                db_callback_->getDirtyRegions().size());
+
+  // Markers in the dirty regions are stale and may refer to the instances
+  // deleted below.  The workers recompute them.
+  auto regionQuery = getDesign()->getRegionQuery();
+  std::set<frMarker*> staleMarkers;
+  std::vector<frMarker*> result;
+  for (const odb::Rect& region : db_callback_->getDirtyRegions()) {
+    result.clear();
+    regionQuery->queryMarker(region, result);
+    staleMarkers.insert(result.begin(), result.end());
+  }
+  for (frMarker* marker : staleMarkers) {
+    regionQuery->removeMarker(marker);
+    block->removeMarker(marker);
+  }
+
+  io::Parser parser(db_, getDesign(), logger_);
+  for (frInst* inst : parser.reimportInsts(reimportInsts)) {
+    db_callback_->addDirtyRegion(inst->getBBox());
+  }
+  block->removeDeletedInsts();
+
+  std::vector<odb::dbInst*> targetInsts;
+  for (const auto& name : db_callback_->getDirtyInsts()) {
+    odb::dbInst* inst = dbBlock->findInst(name.c_str());
+    if (inst != nullptr) {
+      targetInsts.push_back(inst);
+    }
+  }
+  if (!targetInsts.empty()) {
+    FlexPA pa(getDesign(), logger_, dist_);
+    pa.setTargetInstances(targetInsts);
+    pa.setIncremental(true);
+    pa.setDebug(debug_.get(), db_);
+    pa.setDB(db_);
+    pa.main();
+  }
+
+  // recheck the connectivity of the touched nets after rerouting
+  for (const auto& name : db_callback_->getDirtyNets()) {
+    frNet* net = block->findNet(name);
+    if (net != nullptr) {
+      net->setModified(true);
+    }
+  }
+
+  FlexDR dr(this, getDesign(), logger_, db_);
+  dr.setDebug(debug_.get());
+  dr.incrementalMain(db_callback_->getDirtyRegions());
+  db_callback_->clearDirtyObjects();
+
+  io::Writer writer(getDesign(), logger_);
+  writer.updateDb(db_);
+  num_drvs_ = block->getNumMarkers();
+  return true;
+}
+
 void TritonRoute::prep()
 {
   FlexRP rp(getDesign(), getDesign()->getTech(), logger_);
@@ -829,6 +1008,10 @@ int TritonRoute::main()
     writeGlobals(globals_path);
   }
   MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
+  if (INCREMENTAL_DR && routeIncremental()) {
+    return 0;
+  }
+  db_callback_->clearDirtyObjects();
   if (distributed_) {
     if (DO_PA)
       asio::post(pa_pool, [this]() {
@@ -849,6 +1032,7 @@ int TritonRoute::main()
     FlexPA pa(getDesign(), logger_, dist_);
     pa.setDistributed(dist_ip_, dist_port_, shared_volume_, cloud_sz_);
     pa.setDebug(debug_.get(), db_);
+    pa.setDB(db_);
     pa_pool.join();
     pa.main();
     if (distributed_ || debug_->debugDR || debug_->debugDumpDR) {
@@ -909,11 +1093,13 @@ void TritonRoute::pinAccess(std::vector<odb::dbInst*> target_insts)
   FlexPA pa(getDesign(), logger_, dist_);
   pa.setTargetInstances(target_insts);
   pa.setDebug(debug_.get(), db_);
+  pa.setDB(db_);
   if (distributed_) {
     pa.setDistributed(dist_ip_, dist_port_, shared_volume_, cloud_sz_);
     dist_pool_.join();
   }
   pa.main();
+  num_pa_cache_hits_ = pa.getNumCacheHits();
   io::Writer writer(getDesign(), logger_);
   writer.updateDb(db_, true);
 }
@@ -1007,6 +1193,20 @@ void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
   reportDRC(filename, markers, requiredDrcBox);
 }
 
+void TritonRoute::checkConnectivity()
+{
+  if (design_ == nullptr || design_->getTopBlock() == nullptr) {
+    logger_->error(DRT, 158, "No routed design to check.");
+  }
+  // the checker only visits modified nets
+  for (auto& net : design_->getTopBlock()->getNets()) {
+    net->setModified(true);
+  }
+  FlexDRConnectivityChecker checker(
+      getDesign(), logger_, db_, nullptr, /* save_updates */ false);
+  checker.check(0);
+}
+
 void TritonRoute::processBTermsAboveTopLayer(bool has_routing)
 {
   odb::dbTech* tech = db_->getTech();
@@ -1218,6 +1418,8 @@ void TritonRoute::setParams(const ParamStruct& params)
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
+  PA_CACHE_DIR = params.paCacheDir;
+  INCREMENTAL_DR = params.incremental;
 }
 
 void TritonRoute::addWorkerResults(
@@ -51,6 +51,12 @@ int detailed_route_num_drvs()
   return router->getNumDRVs();
 }
 
+int pin_access_num_cache_hits()
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  return router->getNumPinAccessCacheHits();
+}
+
 void detailed_route_distributed(const char* remote_ip,
                                 unsigned short remote_port,
                                 const char* sharedVolume,
@@ -95,7 +101,9 @@ void detailed_route_cmd(const char* outputMazeFile,
                         int minAccessPoints,
                         bool saveGuideUpdates,
                         const char* repairPDNLayerName,
-                        int drcReportIterStep)
+                        int drcReportIterStep,
+                        const char* paCacheDir,
+                        bool incremental)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   std::optional<int> drcReportIterStepOpt;
@@ -122,7 +130,9 @@ void detailed_route_cmd(const char* outputMazeFile,
                     singleStepDR,
                     minAccessPoints,
                     saveGuideUpdates,
-                    repairPDNLayerName});
+                    repairPDNLayerName,
+                    paCacheDir,
+                    incremental});
   router->main();
   router->setDistributed(false);
 }
@@ -131,7 +141,8 @@ void pin_access_cmd(const char* dbProcessNode,
                     const char* bottomRoutingLayer,
                     const char* topRoutingLayer,
                     int verbose,
-                    int minAccessPoints)
+                    int minAccessPoints,
+                    const char* paCacheDir)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   triton_route::ParamStruct params;
@@ -140,6 +151,7 @@ void pin_access_cmd(const char* dbProcessNode,
   params.topRoutingLayer = topRoutingLayer;
   params.verbose = verbose;
   params.minAccessPoints = minAccessPoints;
+  params.paCacheDir = paCacheDir;
   router->setParams(params);
   router->pinAccess();
   router->setDistributed(false);
@@ -239,4 +251,10 @@ void check_drc_cmd(const char* drc_file, int x1, int y1, int x2, int y2)
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   router->checkDRC(drc_file, x1, y1, x2, y2);
 }
+
+void check_connectivity_cmd()
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  router->checkConnectivity();
+}
 %} // inline
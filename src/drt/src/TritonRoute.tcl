@@ -59,6 +59,8 @@ sta::define_cmd_args "detailed_route" {
     [-min_access_points count]
     [-save_guide_updates]
     [-repair_pdn_vias layer]
+    [-pa_cache_dir dir]
+    [-incremental]
 }
 
 proc detailed_route { args } {
@@ -67,8 +69,10 @@ proc detailed_route { args } {
       -db_process_node -droute_end_iter -via_in_pin_bottom_layer \
       -via_in_pin_top_layer -or_seed -or_k -bottom_routing_layer \
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
-      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
-    flags {-disable_via_gen -distributed -clean_patches -no_pin_access -single_step_dr -save_guide_updates}
+      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step \
+      -pa_cache_dir} \
+    flags {-disable_via_gen -distributed -clean_patches -no_pin_access -single_step_dr -save_guide_updates \
+      -incremental}
   sta::check_argc_eq0 "detailed_route" $args
 
   set enable_via_gen [expr ![info exists flags(-disable_via_gen)]]
@@ -78,6 +82,7 @@ proc detailed_route { args } {
   # development.  It is not listed in the help string intentionally.
   set single_step_dr  [expr [info exists flags(-single_step_dr)]]
   set save_guide_updates  [expr [info exists flags(-save_guide_updates)]]
+  set incremental [expr [info exists flags(-incremental)]]
 
   if { [info exists keys(-repair_pdn_vias)] } {
     set repair_pdn_vias $keys(-repair_pdn_vias)
@@ -190,12 +195,18 @@ proc detailed_route { args } {
   } else {
     set min_access_points -1
   }
+  if { [info exists keys(-pa_cache_dir)] } {
+    set pa_cache_dir $keys(-pa_cache_dir)
+  } else {
+    set pa_cache_dir ""
+  }
   drt::detailed_route_cmd $output_maze $output_drc $output_cmap \
     $output_guide_coverage $db_process_node $enable_via_gen $droute_end_iter \
     $via_in_pin_bottom_layer $via_in_pin_top_layer \
     $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
     $clean_patches $no_pin_access $single_step_dr $min_access_points \
-    $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+    $save_guide_updates $repair_pdn_vias $drc_report_iter_step $pa_cache_dir \
+    $incremental
 }
 
 proc detailed_route_num_drvs { args } {
@@ -279,6 +290,12 @@ proc detailed_route_debug { args } {
       $worker_x $worker_y $iter $pa_markers $pa_edge $pa_commit $dump_dir $ta $write_net_tracks
 }
 
+# -pa_cache_dir dir keeps the access points of each unique instance in dir
+# and reuses them in later runs (also with detailed_route -pa_cache_dir).
+# An entry is keyed by the tech and its vias, the master, the orientation
+# and the track offsets only.  The neighborhood of the instance, e.g. PDN
+# stripes, obstructions or other shapes near its pins, is not part of the
+# key, so clear dir when those change.
 sta::define_cmd_args "pin_access" {
     [-db_process_node name]
     [-bottom_routing_layer layer]
@@ -290,11 +307,13 @@ sta::define_cmd_args "pin_access" {
     [-remote_port rport]
     [-shared_volume vol]
     [-cloud_size sz]
+    [-pa_cache_dir dir]
 }
 proc pin_access { args } {
   sta::parse_key_args "pin_access" args \
       keys {-db_process_node -bottom_routing_layer -top_routing_layer -verbose \
-            -min_access_points -remote_host -remote_port -shared_volume -cloud_size } \
+            -min_access_points -remote_host -remote_port -shared_volume -cloud_size \
+            -pa_cache_dir } \
       flags {-distributed}
   sta::check_argc_eq0 "detailed_route_debug" $args
   if [info exists keys(-db_process_node)] {
@@ -324,6 +343,11 @@ proc pin_access { args } {
   } else {
     set min_access_points -1
   }
+  if { [info exists keys(-pa_cache_dir)] } {
+    set pa_cache_dir $keys(-pa_cache_dir)
+  } else {
+    set pa_cache_dir ""
+  }
   if { [info exists flags(-distributed)] } {
     if { [info exists keys(-remote_host)] } {
       set rhost $keys(-remote_host)
@@ -347,7 +371,7 @@ proc pin_access { args } {
     }
     drt::detailed_route_distributed $rhost $rport $vol $cloudsz
   }
-  drt::pin_access_cmd $db_process_node $bottom_routing_layer $top_routing_layer $verbose $min_access_points
+  drt::pin_access_cmd $db_process_node $bottom_routing_layer $top_routing_layer $verbose $min_access_points $pa_cache_dir
 }
 
 sta::define_cmd_args "detailed_route_run_worker" {
@@ -36,9 +36,12 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
+#include <queue>
 #include <sstream>
 
 #include "db/infra/frTime.h"
@@ -49,6 +52,7 @@
 #include "dst/BalancerJobDescription.h"
 #include "dst/Distributed.h"
 #include "frProfileTask.h"
+#include "frRTree.h"
 #include "gc/FlexGC.h"
 #include "io/io.h"
 #include "ord/OpenRoad.hh"
@@ -174,6 +178,12 @@ int FlexDRWorker::main(frDesign* design)
                     routeBox_.xMax() * micronPerDBU,
                     routeBox_.yMax() * micronPerDBU);
   }
+  // commits of other workers only wait for the design to be read; routing
+  // works on the worker's own copy
+  std::shared_lock<FlexDRDesignLock> designLock;
+  if (designLock_) {
+    designLock = std::shared_lock<FlexDRDesignLock>(*designLock_);
+  }
   initMarkers(design);
   if (getDRIter() && getInitNumMarkers() == 0 && !needRecheck_) {
     skipRouting_ = true;
@@ -208,6 +218,9 @@ int FlexDRWorker::main(frDesign* design)
   if (!skipRouting_) {
     init(design);
   }
+  if (designLock) {
+    designLock.unlock();
+  }
   high_resolution_clock::time_point t1 = high_resolution_clock::now();
   if (!skipRouting_) {
     route_queue();
@@ -448,6 +461,149 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+void FlexDR::scheduleWorkers(
+    vector<vector<vector<unique_ptr<FlexDRWorker>>>>& workers,
+    const std::function<void(int numMarkers)>& workerDone)
+{
+  // flatten the batches; the position in this order is the commit order
+  vector<unique_ptr<FlexDRWorker>> order;
+  vector<int> batchOf;
+  int batchIdx = 0;
+  for (auto& workerBatch : workers) {
+    for (auto& workersInBatch : workerBatch) {
+      for (auto& worker : workersInBatch) {
+        order.push_back(std::move(worker));
+        batchOf.push_back(batchIdx);
+      }
+      batchIdx++;
+    }
+  }
+  workers.clear();
+  const int numWorkers = order.size();
+  if (numWorkers == 0) {
+    return;
+  }
+
+  // A worker reads the design within its ext box and commits within its
+  // drc box, so two workers conflict when the union of both boxes overlap.
+  auto conflictBox = [&order](int idx) {
+    Rect box = order[idx]->getExtBox();
+    box.merge(order[idx]->getDrcBox());
+    return box;
+  };
+  vector<pair<Rect, int>> boxes;
+  boxes.reserve(numWorkers);
+  for (int i = 0; i < numWorkers; i++) {
+    boxes.emplace_back(conflictBox(i), i);
+  }
+  RTree<int> boxTree(boxes);
+
+  // A worker may start once the last conflicting worker of an earlier batch
+  // is committed.  Conflicting workers of the same batch read the design
+  // before either commits, so a commit also waits for the main() of the
+  // conflicting workers that follow it in its batch.
+  vector<int> waitFor(numWorkers, -1);
+  vector<int> endBlockers(numWorkers, 0);
+  vector<vector<int>> unblocks(numWorkers);
+  for (int i = 0; i < numWorkers; i++) {
+    vector<pair<Rect, int>> result;
+    boxTree.query(bgi::intersects(boxes[i].first), back_inserter(result));
+    for (auto& [box, j] : result) {
+      if (j >= i) {
+        continue;
+      }
+      if (batchOf[j] < batchOf[i]) {
+        waitFor[i] = max(waitFor[i], j);
+      } else {
+        endBlockers[j]++;
+        unblocks[i].push_back(j);
+      }
+    }
+  }
+  // released[k] holds the workers that become ready after k commits
+  vector<vector<int>> released(numWorkers);
+  for (int i = 0; i < numWorkers; i++) {
+    released[waitFor[i] + 1].push_back(i);
+  }
+
+  FlexDRDesignLock designLock;
+  for (auto& worker : order) {
+    worker->setDesignLock(&designLock);
+  }
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  priority_queue<int, vector<int>, greater<int>> ready;
+  vector<char> mainDone(numWorkers, false);
+  int numCommitted = 0;
+  // the design must not be read outside the design lock, so the marker
+  // count is taken by the committing thread
+  int numMarkers = getDesign()->getTopBlock()->getNumMarkers();
+  bool committing = false;
+  bool aborted = false;
+  for (int i : released[0]) {
+    ready.push(i);
+  }
+
+  ThreadException exception;
+#pragma omp parallel
+  {
+    try {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!aborted && numCommitted < numWorkers) {
+        const int next = numCommitted;
+        if (!committing && mainDone[next] && endBlockers[next] == 0) {
+          // commits are serialized and exclusive of any design read
+          committing = true;
+          lock.unlock();
+          int committedMarkers;
+          {
+            std::unique_lock<FlexDRDesignLock> designWrite(designLock);
+            if (order[next]->end(getDesign())) {
+              numWorkUnits_ += 1;
+            }
+            if (order[next]->isCongested()) {
+              increaseClipsize_ = true;
+            }
+            committedMarkers = getDesign()->getTopBlock()->getNumMarkers();
+          }
+          order[next].reset();
+          lock.lock();
+          numMarkers = committedMarkers;
+          committing = false;
+          numCommitted++;
+          if (numCommitted < numWorkers) {
+            for (int i : released[numCommitted]) {
+              ready.push(i);
+            }
+          }
+          cond.notify_all();
+        } else if (!ready.empty()) {
+          const int idx = ready.top();
+          ready.pop();
+          lock.unlock();
+          order[idx]->main(getDesign());
+          lock.lock();
+          mainDone[idx] = true;
+          for (int j : unblocks[idx]) {
+            endBlockers[j]--;
+          }
+          workerDone(numMarkers);
+          cond.notify_all();
+        } else {
+          cond.wait(lock);
+        }
+      }
+    } catch (...) {
+      exception.capture();
+      std::lock_guard<std::mutex> lock(mutex);
+      aborted = true;
+      cond.notify_all();
+    }
+  }
+  exception.rethrow();
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = iter_++;
@@ -494,8 +650,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   auto& xgp = gCellPatterns.at(0);
   auto& ygp = gCellPatterns.at(1);
   int cnt = 0;
-  int tot = (((int) xgp.getCount() - 1 - offset) / size + 1)
-            * (((int) ygp.getCount() - 1 - offset) / size + 1);
+  int tot = 0;
   int prev_perc = 0;
   bool isExceed = false;
 
@@ -510,7 +665,6 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   int xIdx = 0, yIdx = 0;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
-      auto worker = make_unique<FlexDRWorker>(&via_data_, design_, logger_);
       Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
       const int max_i = min((int) xgp.getCount() - 1, i + size - 1);
       const int max_j = min((int) ygp.getCount(), j + size - 1);
@@ -520,6 +674,12 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
                     routeBox1.yMin(),
                     routeBox2.xMax(),
                     routeBox2.yMax());
+      if (!isDirty(routeBox)) {
+        yIdx++;
+        continue;
+      }
+      auto worker = make_unique<FlexDRWorker>(&via_data_, design_, logger_);
+      tot++;
       Rect extBox;
       Rect drcBox;
       routeBox.bloat(MTSAFEDIST, extBox);
@@ -568,16 +728,38 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   int version = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
-  // parallel execution
-  for (auto& workerBatch : workers) {
-    ProfileTask profile("DR:checkerboard");
-    for (auto& workersInBatch : workerBatch) {
-      {
-        const std::string batch_name = std::string("DR:batch<")
-                                       + std::to_string(workersInBatch.size())
-                                       + ">";
-        ProfileTask profile(batch_name.c_str());
-        if (dist_on_) {
+  FlexGridGraph::resetArenaStats();
+  auto reportProgress = [&](int numMarkers) {
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
+        }
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
+                          prev_perc,
+                          numMarkers);
+          logger_->report("    {}.", t);
+        }
+      }
+    }
+  };
+  if (!dist_on_) {
+    // parallel execution
+    ProfileTask profile("DR:schedule");
+    scheduleWorkers(workers, reportProgress);
+  } else {
+    // distributed execution
+    for (auto& workerBatch : workers) {
+      ProfileTask profile("DR:checkerboard");
+      for (auto& workersInBatch : workerBatch) {
+        {
+          const std::string batch_name
+              = std::string("DR:batch<")
+                + std::to_string(workersInBatch.size()) + ">";
+          ProfileTask profile(batch_name.c_str());
           router_->dist_pool_.join();
           if (version++ == 0 && !design_->hasUpdates()) {
             std::string serializedViaData;
@@ -585,44 +767,21 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
             router_->sendGlobalsUpdates(globals_path_, serializedViaData);
           } else
             router_->sendDesignUpdates(globals_path_);
-        }
-        {
-          ProfileTask task("DIST: PROCESS_BATCH");
-          // multi thread
-          ThreadException exception;
+          {
+            ProfileTask task("DIST: PROCESS_BATCH");
+            // multi thread
+            ThreadException exception;
 #pragma omp parallel for schedule(dynamic)
-          for (int i = 0; i < (int) workersInBatch.size(); i++) {
-            try {
-              if (dist_on_)
+            for (int i = 0; i < (int) workersInBatch.size(); i++) {
+              try {
                 workersInBatch[i]->distributedMain(getDesign());
-              else
-                workersInBatch[i]->main(getDesign());
 #pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
-                          prev_perc,
-                          getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
+                reportProgress(getDesign()->getTopBlock()->getNumMarkers());
+              } catch (...) {
+                exception.capture();
               }
-            } catch (...) {
-              exception.capture();
             }
-          }
-          exception.rethrow();
-          if (dist_on_) {
+            exception.rethrow();
             int j = 0;
             std::vector<std::vector<std::pair<int, FlexDRWorker*>>>
                 distWorkerBatches(router_->getCloudSize());
@@ -646,25 +805,26 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
               ProfileTask task("DIST: DESERIALIZING_BATCH");
 #pragma omp parallel for schedule(dynamic)
               for (int i = 0; i < workers.size(); i++) {
-                deserializeWorker(workersInBatch.at(workers.at(i).first).get(),
-                                  design_,
-                                  workers.at(i).second);
+                deserializeWorker(
+                    workersInBatch.at(workers.at(i).first).get(),
+                    design_,
+                    workers.at(i).second);
               }
             }
             logger_->report("    Deserialized Batches:{}.", t);
           }
         }
-      }
-      {
-        ProfileTask profile("DR:end_batch");
-        // single thread
-        for (int i = 0; i < (int) workersInBatch.size(); i++) {
-          if (workersInBatch[i]->end(getDesign()))
-            numWorkUnits_ += 1;
-          if (workersInBatch[i]->isCongested())
-            increaseClipsize_ = true;
+        {
+          ProfileTask profile("DR:end_batch");
+          // single thread
+          for (int i = 0; i < (int) workersInBatch.size(); i++) {
+            if (workersInBatch[i]->end(getDesign()))
+              numWorkUnits_ += 1;
+            if (workersInBatch[i]->isCongested())
+              increaseClipsize_ = true;
+          }
+          workersInBatch.clear();
         }
-        workersInBatch.clear();
       }
     }
   }
@@ -700,6 +860,15 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
              1,
              "Number of work units = {}.",
              numWorkUnits_);
+  const auto arenaStats = FlexGridGraph::getArenaStats();
+  debugPrint(logger_,
+             utl::DRT,
+             "workers",
+             1,
+             "Grid graph buffers: {} reused, {} allocated ({:.2f} MB).",
+             arenaStats.reused,
+             arenaStats.allocated,
+             arenaStats.allocatedBytes / (1024.0 * 1024.0));
   if (VERBOSE > 0) {
     logger_->info(DRT,
                   199,
@@ -762,6 +931,12 @@ void FlexDR::end(bool done)
   if (done && VERBOSE > 0) {
     logger_->info(DRT, 198, "Complete detail routing.");
   }
+  if (done) {
+    // give back the grid graph buffers kept by the routing threads
+    omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel
+    FlexGridGraph::freeArena();
+  }
 
   using ULL = unsigned long long;
   const auto size = getTech()->getLayers().size();
@@ -1106,6 +1281,42 @@ void FlexDR::reportGuideCoverage()
   file.close();
 }
 
+bool FlexDR::isDirty(const Rect& box) const
+{
+  if (dirtyRegions_.empty()) {
+    return true;
+  }
+  return std::any_of(
+      dirtyRegions_.begin(), dirtyRegions_.end(), [&box](const Rect& region) {
+        return region.intersects(box);
+      });
+}
+
+int FlexDR::getNumDirtyMarkers() const
+{
+  std::set<frMarker*> markers;
+  std::vector<frMarker*> result;
+  for (const Rect& region : dirtyRegions_) {
+    result.clear();
+    getRegionQuery()->queryMarker(region, result);
+    markers.insert(result.begin(), result.end());
+  }
+  return markers.size();
+}
+
+void FlexDR::adjustClipSize(SearchRepairArgs& args)
+{
+  int clipSize = args.size;
+  if (args.ripupMode != 1) {
+    if (increaseClipsize_) {
+      clipSizeInc_ += 2;
+    } else
+      clipSizeInc_ = max((float) 0, clipSizeInc_ - 0.2f);
+    clipSize += min(MAX_CLIPSIZE_INCREASE, (int) round(clipSizeInc_));
+  }
+  args.size = clipSize;
+}
+
 int FlexDR::main()
 {
   ProfileTask profile("DR:main");
@@ -1113,16 +1324,7 @@ int FlexDR::main()
   frTime t;
 
   for (auto& args : strategy()) {
-    int clipSize = args.size;
-    if (args.ripupMode != 1) {
-      if (increaseClipsize_) {
-        clipSizeInc_ += 2;
-      } else
-        clipSizeInc_ = max((float) 0, clipSizeInc_ - 0.2f);
-      clipSize += min(MAX_CLIPSIZE_INCREASE, (int) round(clipSizeInc_));
-    }
-    args.size = clipSize;
-
+    adjustClipSize(args);
     searchRepair(args);
     if (getDesign()->getTopBlock()->getNumMarkers() == 0) {
       break;
@@ -1152,6 +1354,42 @@ int FlexDR::main()
   return 0;
 }
 
+int FlexDR::incrementalMain(const std::vector<Rect>& dirtyRegions)
+{
+  ProfileTask profile("DR:incrementalMain");
+  frTime t;
+  if (VERBOSE > 0) {
+    logger_->info(DRT, 120, "Start incremental detail routing.");
+  }
+  getRegionQuery()->initDRObj();
+  init_halfViaEncArea();
+  dirtyRegions_ = dirtyRegions;
+
+  // The first iteration routes from the global routing guides.  The design
+  // is already routed here so start with the rip-up-and-reroute iterations,
+  // which take the boundary pins from the existing routes.
+  iter_ = 1;
+  auto strategies = strategy();
+  for (auto it = strategies.begin() + 1; it != strategies.end(); ++it) {
+    auto& args = *it;
+    adjustClipSize(args);
+    searchRepair(args);
+    if (getNumDirtyMarkers() == 0) {
+      break;
+    }
+    if (iter_ > END_ITERATION) {
+      break;
+    }
+  }
+  dirtyRegions_.clear();
+
+  end(/* done */ true);
+  if (VERBOSE > 0) {
+    t.print(logger_);
+  }
+  return 0;
+}
+
 void FlexDR::sendWorkers(
     const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
     std::vector<std::unique_ptr<FlexDRWorker>>& batch)
@@ -33,7 +33,10 @@
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 #include "db/drObj/drMarker.h"
 #include "db/drObj/drNet.h"
@@ -81,6 +84,33 @@ struct FlexDRViaData
   friend class boost::serialization::access;
 };
 
+// Guards the design while search-repair workers run concurrently: workers
+// hold it shared while main() reads the design, and commits hold it
+// exclusively.  glibc's std::shared_mutex prefers readers, so a steady
+// stream of workers starting main() could starve a waiting commit.  A
+// writer closes the gate before it waits for the current readers to leave,
+// which keeps new readers out until the commit is done.
+class FlexDRDesignLock
+{
+ public:
+  void lock()
+  {
+    std::lock_guard<std::mutex> gate(gate_);
+    mutex_.lock();
+  }
+  void unlock() { mutex_.unlock(); }
+  void lock_shared()
+  {
+    { std::lock_guard<std::mutex> gate(gate_); }
+    mutex_.lock_shared();
+  }
+  void unlock_shared() { mutex_.unlock_shared(); }
+
+ private:
+  std::mutex gate_;
+  std::shared_mutex mutex_;
+};
+
 class FlexDR
 {
  public:
@@ -110,6 +140,9 @@ class FlexDR
   // others
   void init();
   int main();
+  // Reroutes an already routed design only in the gcells overlapping the
+  // given regions, until no violation is left inside them.
+  int incrementalMain(const std::vector<Rect>& dirtyRegions);
   void searchRepair(const SearchRepairArgs& args);
   void end(bool done = false);
 
@@ -164,11 +197,26 @@ class FlexDR
   bool increaseClipsize_;
   float clipSizeInc_;
   int iter_;
+  // when non-empty, searchRepair skips workers not touching these regions
+  std::vector<Rect> dirtyRegions_;
 
   // others
   void initFromTA();
   void initGCell2BoundaryPin();
   void getBatchInfo(int& batchStepX, int& batchStepY);
+  void adjustClipSize(SearchRepairArgs& args);
+  bool isDirty(const Rect& box) const;
+  int getNumDirtyMarkers() const;
+  // Runs the batches of workers without a barrier between them.  A worker
+  // starts once every worker of an earlier batch whose box overlaps its own
+  // has been committed.  Commits follow the batch order so results match a
+  // batch-by-batch run.  workerDone is called with the number of markers
+  // after the latest commit, which is read while the commit holds the
+  // design lock.
+  void scheduleWorkers(
+      std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>>&
+          workers,
+      const std::function<void(int numMarkers)>& workerDone);
 
   void init_halfViaEncArea();
 
@@ -277,7 +325,8 @@ class FlexDRWorker
         dist_port_(0),
         dist_on_(false),
         isCongested_(false),
-        save_updates_(false)
+        save_updates_(false),
+        designLock_(nullptr)
   {
   }
   FlexDRWorker()
@@ -306,7 +355,8 @@ class FlexDRWorker
         dist_port_(0),
         dist_on_(false),
         isCongested_(false),
-        save_updates_(false)
+        save_updates_(false),
+        designLock_(nullptr)
   {
   }
   // setters
@@ -318,6 +368,8 @@ class FlexDRWorker
   void setExtBox(const Rect& boxIn) { extBox_ = boxIn; }
   void setDrcBox(const Rect& boxIn) { drcBox_ = boxIn; }
   void setGCellBox(const Rect& boxIn) { gcellBox_ = boxIn; }
+  // held shared while main() reads the design
+  void setDesignLock(FlexDRDesignLock* in) { designLock_ = in; }
   void setDRIter(int in) { drIter_ = in; }
   void setDRIter(int in,
                  std::map<frNet*,
@@ -544,6 +596,7 @@ class FlexDRWorker
   bool dist_on_;
   bool isCongested_;
   bool save_updates_;
+  FlexDRDesignLock* designLock_;  // owned by FlexDR
 
   // init
   void init(const frDesign* design);
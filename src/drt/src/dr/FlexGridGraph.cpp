@@ -28,6 +28,7 @@
 
 #include "dr/FlexGridGraph.h"
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -37,6 +38,99 @@
 using namespace std;
 using namespace fr;
 
+thread_local FlexGridGraph::Arena FlexGridGraph::arena_;
+static std::atomic<uint64_t> numArenaReused(0);
+static std::atomic<uint64_t> numArenaAllocated(0);
+static std::atomic<uint64_t> numArenaAllocatedBytes(0);
+
+FlexGridGraph::ArenaStats FlexGridGraph::getArenaStats()
+{
+  ArenaStats stats;
+  stats.reused = numArenaReused;
+  stats.allocated = numArenaAllocated;
+  stats.allocatedBytes = numArenaAllocatedBytes;
+  return stats;
+}
+
+void FlexGridGraph::resetArenaStats()
+{
+  numArenaReused = 0;
+  numArenaAllocated = 0;
+  numArenaAllocatedBytes = 0;
+}
+
+void FlexGridGraph::freeArena()
+{
+  arena_ = Arena();
+}
+
+size_t FlexGridGraph::getBufferBytes() const
+{
+  const size_t numBits = prevDirs_.capacity() + srcs_.capacity()
+                         + dsts_.capacity() + guides_.capacity();
+  return nodes_.capacity() * sizeof(Node) + numBits / 8;
+}
+
+// Takes over the buffers of the previous worker on this thread if they are
+// larger than the ones this graph already has.
+void FlexGridGraph::acquireBuffers()
+{
+  if (arena_.nodes.capacity() > nodes_.capacity()) {
+    nodes_.swap(arena_.nodes);
+  }
+  if (arena_.prevDirs.capacity() > prevDirs_.capacity()) {
+    prevDirs_.swap(arena_.prevDirs);
+  }
+  if (arena_.srcs.capacity() > srcs_.capacity()) {
+    srcs_.swap(arena_.srcs);
+  }
+  if (arena_.dsts.capacity() > dsts_.capacity()) {
+    dsts_.swap(arena_.dsts);
+  }
+  if (arena_.guides.capacity() > guides_.capacity()) {
+    guides_.swap(arena_.guides);
+  }
+  if (arena_.wavefront.capacity() > wavefront_.capacity()) {
+    wavefront_.swapStorage(arena_.wavefront);
+  }
+}
+
+// Keeps the larger of each buffer and the arena's for the next worker on
+// this thread and frees the other one.
+void FlexGridGraph::releaseBuffers()
+{
+  nodes_.clear();
+  prevDirs_.clear();
+  srcs_.clear();
+  dsts_.clear();
+  guides_.clear();
+  wavefront_.cleanup();
+  if (nodes_.capacity() > arena_.nodes.capacity()) {
+    nodes_.swap(arena_.nodes);
+  }
+  if (prevDirs_.capacity() > arena_.prevDirs.capacity()) {
+    prevDirs_.swap(arena_.prevDirs);
+  }
+  if (srcs_.capacity() > arena_.srcs.capacity()) {
+    srcs_.swap(arena_.srcs);
+  }
+  if (dsts_.capacity() > arena_.dsts.capacity()) {
+    dsts_.swap(arena_.dsts);
+  }
+  if (guides_.capacity() > arena_.guides.capacity()) {
+    guides_.swap(arena_.guides);
+  }
+  if (wavefront_.capacity() > arena_.wavefront.capacity()) {
+    wavefront_.swapStorage(arena_.wavefront);
+  }
+  nodes_.shrink_to_fit();
+  prevDirs_.shrink_to_fit();
+  srcs_.shrink_to_fit();
+  dsts_.shrink_to_fit();
+  guides_.shrink_to_fit();
+  wavefront_.fit();
+}
+
 void FlexGridGraph::initGrids(
     const map<frCoord, map<frLayerNum, frTrackPattern*>>& xMap,
     const map<frCoord, map<frLayerNum, frTrackPattern*>>& yMap,
@@ -71,6 +165,8 @@ void FlexGridGraph::initGrids(
   getDim(xDim, yDim, zDim);
   const int capacity = xDim * yDim * zDim;
 
+  acquireBuffers();
+  const size_t prevBytes = getBufferBytes();
   nodes_.clear();
   nodes_.resize(capacity, Node());
   // new
@@ -87,6 +183,13 @@ void FlexGridGraph::initGrids(
   } else {
     guides_.resize(capacity, 1);
   }
+  const size_t bytes = getBufferBytes();
+  if (bytes > prevBytes) {
+    numArenaAllocated++;
+    numArenaAllocatedBytes += bytes;
+  } else {
+    numArenaReused++;
+  }
 }
 
 bool FlexGridGraph::outOfDieVia(frMIdx x,
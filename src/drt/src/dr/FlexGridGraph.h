@@ -847,16 +847,23 @@ class FlexGridGraph
   }
   int nTracksX() { return xCoords_.size(); }
   int nTracksY() { return yCoords_.size(); }
+
+  // Counts how often initGrids could reuse the buffers of an earlier worker
+  // on the same thread and how much it had to allocate otherwise.
+  struct ArenaStats
+  {
+    uint64_t reused = 0;
+    uint64_t allocated = 0;
+    uint64_t allocatedBytes = 0;
+  };
+  static ArenaStats getArenaStats();
+  static void resetArenaStats();
+  // Frees the buffers kept for the calling thread.
+  static void freeArena();
+
   void cleanup()
   {
-    nodes_.clear();
-    nodes_.shrink_to_fit();
-    srcs_.clear();
-    srcs_.shrink_to_fit();
-    dsts_.clear();
-    dsts_.shrink_to_fit();
-    guides_.clear();
-    guides_.shrink_to_fit();
+    releaseBuffers();
     xCoords_.clear();
     xCoords_.shrink_to_fit();
     yCoords_.clear();
@@ -867,8 +874,6 @@ class FlexGridGraph
     yCoords_.shrink_to_fit();
     yCoords_.clear();
     yCoords_.shrink_to_fit();
-    wavefront_.cleanup();
-    wavefront_.fit();
   }
 
   void printNode(frMIdx x, frMIdx y, frMIdx z)
@@ -952,6 +957,18 @@ class FlexGridGraph
 #ifndef DEBUG_DRT_UNDERFLOW
   static_assert(sizeof(Node) == 8);
 #endif
+  // Buffers handed from one worker to the next on the same thread so their
+  // capacity is reused instead of reallocated for every worker.
+  struct Arena
+  {
+    frVector<Node> nodes;
+    std::vector<bool> prevDirs;
+    std::vector<bool> srcs;
+    std::vector<bool> dsts;
+    std::vector<bool> guides;
+    std::vector<FlexWavefrontGrid> wavefront;
+  };
+  static thread_local Arena arena_;
   frVector<Node> nodes_;
   std::vector<bool> prevDirs_;
   std::vector<bool> srcs_;
@@ -1205,6 +1222,9 @@ class FlexGridGraph
   bool outOfDieVia(frMIdx x, frMIdx y, frMIdx z, const Rect& dieBox);
   bool hasOutOfDieViol(frMIdx x, frMIdx y, frMIdx z);
   bool isWorkerBorder(frMIdx v, bool isVert);
+  void acquireBuffers();
+  void releaseBuffers();
+  size_t getBufferBytes() const;
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version)
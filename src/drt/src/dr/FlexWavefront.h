@@ -31,6 +31,7 @@
 #include <bitset>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "dr/FlexMazeTypes.h"
 #include "frBaseTypes.h"
@@ -148,6 +149,12 @@ class myPriorityQueue : public std::priority_queue<FlexWavefrontGrid>
     this->c.clear();
     this->c.shrink_to_fit();
   }
+  size_t capacity() const { return this->c.capacity(); }
+  // only valid while both are empty
+  void swapStorage(std::vector<FlexWavefrontGrid>& storage)
+  {
+    this->c.swap(storage);
+  }
 };
 
 class FlexWavefront
@@ -160,6 +167,11 @@ class FlexWavefront
   unsigned int size() const { return wavefrontPQ_.size(); }
   void cleanup() { wavefrontPQ_.cleanup(); }
   void fit() { wavefrontPQ_.fit(); }
+  size_t capacity() const { return wavefrontPQ_.capacity(); }
+  void swapStorage(std::vector<FlexWavefrontGrid>& storage)
+  {
+    wavefrontPQ_.swapStorage(storage);
+  }
 
  private:
   myPriorityQueue wavefrontPQ_;
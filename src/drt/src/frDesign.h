@@ -65,6 +65,14 @@ class frDesign
   {
     return masters_;
   }
+  frMaster* getMaster(const std::string& name) const
+  {
+    auto it = name2master_.find(name);
+    if (it == name2master_.end()) {
+      return nullptr;
+    }
+    return it->second;
+  }
   const std::vector<std::string>& getUserSelectedVias() const
   {
     return user_selected_vias_;
@@ -28,6 +28,7 @@
 
 #include "frRegionQuery.h"
 
+#include <boost/iterator/function_output_iterator.hpp>
 #include <boost/polygon/polygon.hpp>
 #include <iostream>
 
@@ -35,9 +36,11 @@
 #include "frRTree.h"
 #include "global.h"
 #include "utl/algorithms.h"
+#include "utl/exception.h"
 
 using namespace fr;
 using utl::enumerate;
+using utl::ThreadException;
 namespace gtl = boost::polygon;
 
 struct frRegionQuery::Impl
@@ -88,8 +91,38 @@ struct frRegionQuery::Impl
   void addGRObj(grVia* in, ObjectsByLayer<grBlockObject>& allShapes);
   void addGRObj(grShape* in);
   void addGRObj(grVia* in);
+
+  // Packs the objects of each layer into that layer's tree.  The layers
+  // are independent so they are bulk loaded in parallel.
+  template <typename T>
+  static void buildTrees(RTreesByLayer<T*>& trees, ObjectsByLayer<T>& objs)
+  {
+    const int numLayers = objs.size();
+    ThreadException exception;
+#pragma omp parallel for schedule(dynamic) num_threads(MAX_THREADS)
+    for (int i = 0; i < numLayers; i++) {
+      try {
+        trees[i] = RTree<T*>(objs[i]);
+        Objects<T>().swap(objs[i]);
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+  }
 };
 
+// Appends only the objects of the query results to result, skipping the
+// temporary vector of (box, object) pairs.
+template <typename T>
+static auto objectInserter(std::vector<T*>& result)
+{
+  return boost::make_function_output_iterator(
+      [&result](const rq_box_value_t<T*>& value) {
+        result.push_back(value.second);
+      });
+}
+
 frRegionQuery::frRegionQuery(frDesign* design, Logger* logger)
     : impl_(make_unique<Impl>())
 {
@@ -588,22 +621,15 @@ void frRegionQuery::queryGuide(const Rect& box,
                                const frLayerNum layerNum,
                                vector<frGuide*>& result) const
 {
-  Objects<frGuide> temp;
-  queryGuide(box, layerNum, temp);
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
+  impl_->guides_.at(layerNum).query(bgi::intersects(box),
+                                    objectInserter(result));
 }
 
 void frRegionQuery::queryGuide(const Rect& box, vector<frGuide*>& result) const
 {
-  Objects<frGuide> temp;
   for (auto& m : impl_->guides_) {
-    m.query(bgi::intersects(box), back_inserter(temp));
+    m.query(bgi::intersects(box), objectInserter(result));
   }
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
 }
 
 void frRegionQuery::queryOrigGuide(const Rect& box,
@@ -617,11 +643,7 @@ void frRegionQuery::queryOrigGuide(const Rect& box,
 void frRegionQuery::queryGRPin(const Rect& box,
                                vector<frBlockObject*>& result) const
 {
-  Objects<frBlockObject> temp;
-  impl_->grPins_.query(bgi::intersects(box), back_inserter(temp));
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
+  impl_->grPins_.query(bgi::intersects(box), objectInserter(result));
 }
 
 void frRegionQuery::queryDRObj(const box_t& boostb,
@@ -644,58 +666,40 @@ void frRegionQuery::queryDRObj(const Rect& box,
                                const frLayerNum layerNum,
                                vector<frBlockObject*>& result) const
 {
-  Objects<frBlockObject> temp;
-  impl_->drObjs_.at(layerNum).query(bgi::intersects(box), back_inserter(temp));
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
+  impl_->drObjs_.at(layerNum).query(bgi::intersects(box),
+                                    objectInserter(result));
 }
 
 void frRegionQuery::queryDRObj(const Rect& box,
                                vector<frBlockObject*>& result) const
 {
-  Objects<frBlockObject> temp;
   for (auto& m : impl_->drObjs_) {
-    m.query(bgi::intersects(box), back_inserter(temp));
+    m.query(bgi::intersects(box), objectInserter(result));
   }
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
 }
 
 void frRegionQuery::queryGRObj(const Rect& box,
                                vector<grBlockObject*>& result) const
 {
-  Objects<grBlockObject> temp;
   for (auto& m : impl_->grObjs_) {
-    m.query(bgi::intersects(box), back_inserter(temp));
+    m.query(bgi::intersects(box), objectInserter(result));
   }
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
 }
 
 void frRegionQuery::queryMarker(const Rect& box,
                                 const frLayerNum layerNum,
                                 vector<frMarker*>& result) const
 {
-  Objects<frMarker> temp;
-  impl_->markers_.at(layerNum).query(bgi::intersects(box), back_inserter(temp));
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
+  impl_->markers_.at(layerNum).query(bgi::intersects(box),
+                                     objectInserter(result));
 }
 
 void frRegionQuery::queryMarker(const Rect& box,
                                 vector<frMarker*>& result) const
 {
-  Objects<frMarker> temp;
   for (auto& m : impl_->markers_) {
-    m.query(bgi::intersects(box), back_inserter(temp));
+    m.query(bgi::intersects(box), objectInserter(result));
   }
-  transform(temp.begin(), temp.end(), back_inserter(result), [](auto& kv) {
-    return kv.second;
-  });
 }
 
 void frRegionQuery::init()
@@ -779,10 +783,8 @@ void frRegionQuery::Impl::init()
     }
   }
 
+  buildTrees(shapes_, allShapes);
   for (auto i = 0; i < numLayers; i++) {
-    shapes_.at(i) = boost::move(RTree<frBlockObject*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
       logger_->info(DRT,
                     24,
@@ -824,10 +826,8 @@ void frRegionQuery::Impl::initOrigGuide(
       }
     }
   }
+  buildTrees(origGuides_, allShapes);
   for (auto i = 0; i < numLayers; i++) {
-    origGuides_.at(i) = boost::move(RTree<frNet*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
       logger_->info(DRT,
                     28,
@@ -867,10 +867,8 @@ void frRegionQuery::Impl::initGuide()
       }
     }
   }
+  buildTrees(guides_, allGuides);
   for (auto i = 0; i < numLayers; i++) {
-    guides_.at(i) = boost::move(RTree<frGuide*>(allGuides.at(i)));
-    allGuides.at(i).clear();
-    allGuides.at(i).shrink_to_fit();
     if (VERBOSE > 0) {
       logger_->info(DRT,
                     35,
@@ -917,11 +915,7 @@ void frRegionQuery::Impl::initRPin()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
-    rpins_.at(i) = boost::move(RTree<frRPin*>(allRPins.at(i)));
-    allRPins.at(i).clear();
-    allRPins.at(i).shrink_to_fit();
-  }
+  buildTrees(rpins_, allRPins);
 }
 
 void frRegionQuery::initDRObj()
@@ -947,11 +941,7 @@ void frRegionQuery::Impl::initDRObj()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
-    drObjs_.at(i) = boost::move(RTree<frBlockObject*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
-  }
+  buildTrees(drObjs_, allShapes);
 }
 
 void frRegionQuery::Impl::initGRObj()
@@ -972,11 +962,7 @@ void frRegionQuery::Impl::initGRObj()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
-    grObjs_.at(i) = boost::move(RTree<grBlockObject*>(allShapes.at(i)));
-    allShapes.at(i).clear();
-    allShapes.at(i).shrink_to_fit();
-  }
+  buildTrees(grObjs_, allShapes);
 }
 
 void frRegionQuery::initGRObj()
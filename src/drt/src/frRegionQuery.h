@@ -71,6 +71,17 @@ class frRegionQuery
   void addBlockObj(frBlockObject* obj);
 
   // Queries
+  // Queries only read the trees, without locking.  While FlexDR search and
+  // repair runs, worker commits change only the DR object and marker trees.
+  // - query(), queryGuide(), queryOrigGuide(), queryRPin() and queryGRPin()
+  //   read trees that stay fixed during detailed routing.  Any number of
+  //   threads may call them at any time, e.g. FlexDRWorker::hasAccessPoint
+  //   during route_queue().
+  // - queryDRObj() and queryMarker() read trees that commits change.  They
+  //   must hold the FlexDRDesignLock shared, as FlexDRWorker::main() does
+  //   around init().
+  // Anything that changes the fixed trees (the add/removeBlockObj callbacks
+  // or the init*() calls) must not run while workers are routing.
   void query(const box_t& boostb,
              const frLayerNum layerNum,
              Objects<frBlockObject>& result) const;
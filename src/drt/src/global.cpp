@@ -70,6 +70,7 @@ bool ENABLE_VIA_GEN = true;
 bool CLEAN_PATCHES = false;
 bool DO_PA = true;
 bool SINGLE_STEP_DR = false;
+bool INCREMENTAL_DR = false;
 bool SAVE_GUIDE_UPDATES = false;
 
 std::string VIAINPIN_BOTTOMLAYER_NAME;
@@ -114,6 +115,7 @@ int MISALIGNMENTCOST = 8;
 int CONGCOST = 8;
 int HISTCOST = 32;
 std::string REPAIR_PDN_LAYER_NAME;
+std::string PA_CACHE_DIR;
 frLayerNum GC_IGNORE_PDN_LAYER = -1;
 namespace fr {
 
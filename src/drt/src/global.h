@@ -64,6 +64,7 @@ extern bool ENABLE_VIA_GEN;
 extern bool CLEAN_PATCHES;
 extern bool DO_PA;
 extern bool SINGLE_STEP_DR;
+extern bool INCREMENTAL_DR;
 extern bool SAVE_GUIDE_UPDATES;
 // extern int TEST;
 extern std::string VIAINPIN_BOTTOMLAYER_NAME;
@@ -111,6 +112,8 @@ extern int HISTCOST;
 extern int CONGCOST;
 
 extern std::string REPAIR_PDN_LAYER_NAME;
+// directory of the persistent pin access cache, disabled when empty
+extern std::string PA_CACHE_DIR;
 extern fr::frLayerNum GC_IGNORE_PDN_LAYER;
 
 #define DIRBITSIZE 3
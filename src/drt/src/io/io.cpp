@@ -125,47 +125,120 @@ void io::Parser::setTracks(odb::dbBlock* block)
   }
 }
 
+unique_ptr<frInst> io::Parser::createInst(odb::dbInst* inst)
+{
+  auto it = design_->name2master_.find(inst->getMaster()->getName());
+  if (it == design_->name2master_.end())
+    logger_->error(
+        DRT, 95, "Library cell {} not found.", inst->getMaster()->getName());
+  frMaster* master = it->second;
+  auto uInst = make_unique<frInst>(inst->getName(), master);
+  auto tmpInst = uInst.get();
+  tmpInst->setId(numInsts_);
+  numInsts_++;
+
+  int x, y;
+  inst->getLocation(x, y);
+  tmpInst->setOrigin(Point(x, y));
+  tmpInst->setOrient(inst->getOrient());
+  int numInstTerms = 0;
+  tmpInst->setPinAccessIdx(inst->getPinAccessIdx());
+  for (auto& uTerm : tmpInst->getMaster()->getTerms()) {
+    auto term = uTerm.get();
+    unique_ptr<frInstTerm> instTerm = make_unique<frInstTerm>(tmpInst, term);
+    instTerm->setId(numTerms_++);
+    instTerm->setIndexInOwner(numInstTerms++);
+    int pinCnt = term->getPins().size();
+    instTerm->setAPSize(pinCnt);
+    tmpInst->addInstTerm(std::move(instTerm));
+  }
+  for (auto& uBlk : tmpInst->getMaster()->getBlockages()) {
+    auto blk = uBlk.get();
+    unique_ptr<frInstBlockage> instBlk
+        = make_unique<frInstBlockage>(tmpInst, blk);
+    instBlk->setId(numBlockages_);
+    numBlockages_++;
+    tmpInst->addInstBlockage(std::move(instBlk));
+  }
+  return uInst;
+}
+
+frInstTerm* io::Parser::getInstTerm(frInst* inst, odb::dbITerm* term)
+{
+  auto frterm = inst->getMaster()->getTerm(term->getMTerm()->getName());
+  if (frterm == nullptr)
+    logger_->error(DRT,
+                   106,
+                   "Component pin {}/{} not found.",
+                   term->getInst()->getName(),
+                   term->getMTerm()->getName());
+  return inst->getInstTerms()[frterm->getIndexInOwner()].get();
+}
+
 void io::Parser::setInsts(odb::dbBlock* block)
 {
   for (auto inst : block->getInsts()) {
-    if (design_->name2master_.find(inst->getMaster()->getName())
-        == design_->name2master_.end())
-      logger_->error(
-          DRT, 95, "Library cell {} not found.", inst->getMaster()->getName());
     if (tmpBlock_->name2inst_.find(inst->getName())
         != tmpBlock_->name2inst_.end())
       logger_->error(DRT, 96, "Same cell name: {}.", inst->getName());
-    frMaster* master = design_->name2master_.at(inst->getMaster()->getName());
-    auto uInst = make_unique<frInst>(inst->getName(), master);
+    tmpBlock_->addInst(createInst(inst));
+  }
+}
+
+// Replaces the frInst of each given instance by a fresh copy of the odb one,
+// e.g. after an ECO swapped its master.  The new instances are connected to
+// the existing nets and added to the region query; the old ones are only
+// marked for deletion.
+vector<frInst*> io::Parser::reimportInsts(const vector<odb::dbInst*>& insts)
+{
+  auto block = design_->getTopBlock();
+  auto regionQuery = design_->getRegionQuery();
+  // continue numbering after the objects already in the design
+  numInsts_ = block->getInsts().size();
+  numTerms_ = 0;
+  numBlockages_ = 0;
+  for (auto& term : block->getTerms()) {
+    numTerms_ = max(numTerms_, term->getId() + 1);
+  }
+  for (auto& blk : block->getBlockages()) {
+    numBlockages_ = max(numBlockages_, blk->getId() + 1);
+  }
+  for (auto& inst : block->getInsts()) {
+    for (auto& instTerm : inst->getInstTerms()) {
+      numTerms_ = max(numTerms_, instTerm->getId() + 1);
+    }
+    for (auto& instBlk : inst->getInstBlockages()) {
+      numBlockages_ = max(numBlockages_, instBlk->getId() + 1);
+    }
+  }
+
+  vector<frInst*> result;
+  for (auto inst : insts) {
+    frInst* oldInst = block->getInst(inst->getName());
+    if (oldInst != nullptr) {
+      if (regionQuery != nullptr)
+        regionQuery->removeBlockObj(oldInst);
+      block->removeInst(oldInst);
+    }
+    auto uInst = createInst(inst);
     auto tmpInst = uInst.get();
-    tmpInst->setId(numInsts_);
-    numInsts_++;
-
-    int x, y;
-    inst->getLocation(x, y);
-    tmpInst->setOrigin(Point(x, y));
-    tmpInst->setOrient(inst->getOrient());
-    int numInstTerms = 0;
-    tmpInst->setPinAccessIdx(inst->getPinAccessIdx());
-    for (auto& uTerm : tmpInst->getMaster()->getTerms()) {
-      auto term = uTerm.get();
-      unique_ptr<frInstTerm> instTerm = make_unique<frInstTerm>(tmpInst, term);
-      instTerm->setId(numTerms_++);
-      instTerm->setIndexInOwner(numInstTerms++);
-      int pinCnt = term->getPins().size();
-      instTerm->setAPSize(pinCnt);
-      tmpInst->addInstTerm(std::move(instTerm));
-    }
-    for (auto& uBlk : tmpInst->getMaster()->getBlockages()) {
-      auto blk = uBlk.get();
-      unique_ptr<frInstBlockage> instBlk
-          = make_unique<frInstBlockage>(tmpInst, blk);
-      instBlk->setId(numBlockages_);
-      numBlockages_++;
-      tmpInst->addInstBlockage(std::move(instBlk));
-    }
-    tmpBlock_->addInst(std::move(uInst));
+    block->addInst(std::move(uInst));
+    for (auto term : inst->getITerms()) {
+      if (term->getNet() == nullptr)
+        continue;
+      frNet* net = block->findNet(term->getNet()->getName());
+      if (net == nullptr)
+        logger_->error(
+            DRT, 151, "Net {} not found.", term->getNet()->getName());
+      auto instTerm = getInstTerm(tmpInst, term);
+      instTerm->addToNet(net);
+      net->addInstTerm(instTerm);
+    }
+    if (regionQuery != nullptr)
+      regionQuery->addBlockObj(tmpInst);
+    result.push_back(tmpInst);
   }
+  return result;
 }
 
 void io::Parser::setObstructions(odb::dbBlock* block)
@@ -562,16 +635,7 @@ void io::Parser::setNets(odb::dbBlock* block)
             DRT, 105, "Component {} not found.", term->getInst()->getName());
       auto inst = tmpBlock_->name2inst_[term->getInst()->getName()];
       // gettin inst term
-      auto frterm = inst->getMaster()->getTerm(term->getMTerm()->getName());
-      if (frterm == nullptr)
-        logger_->error(DRT,
-                       106,
-                       "Component pin {}/{} not found.",
-                       term->getInst()->getName(),
-                       term->getMTerm()->getName());
-      int idx = frterm->getIndexInOwner();
-      auto& instTerms = inst->getInstTerms();
-      auto instTerm = instTerms[idx].get();
+      auto instTerm = getInstTerm(inst, term);
       assert(instTerm->getTerm()->getName() == term->getMTerm()->getName());
 
       instTerm->addToNet(netIn);
@@ -71,6 +71,7 @@ class Parser
   void postProcessGuide();
   void initDefaultVias();
   void initRPin();
+  std::vector<frInst*> reimportInsts(const std::vector<odb::dbInst*>& insts);
   auto& getTrackOffsetMap() { return trackOffsetMap_; }
   std::vector<frTrackPattern*>& getPrefTrackPatterns()
   {
@@ -84,6 +85,8 @@ class Parser
   void setDieArea(odb::dbBlock*);
   void setTracks(odb::dbBlock*);
   void setInsts(odb::dbBlock*);
+  std::unique_ptr<frInst> createInst(odb::dbInst*);
+  frInstTerm* getInstTerm(frInst* inst, odb::dbITerm* term);
   void setObstructions(odb::dbBlock*);
   void setBTerms(odb::dbBlock*);
   odb::Rect getViaBoxForTermAboveMaxLayer(odb::dbBTerm* term,
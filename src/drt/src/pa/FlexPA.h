@@ -69,7 +69,12 @@ class FlexPA
   ~FlexPA();
 
   void setDebug(frDebugSettings* settings, odb::dbDatabase* db);
+  // needed to hash the tech for the pin access cache
+  void setDB(odb::dbDatabase* db) { db_ = db; }
   void setTargetInstances(const frCollection<odb::dbInst*>& insts);
+  // keep the pin access of the other instances and append new entries for
+  // the targets only
+  void setIncremental(bool in) { incremental_ = in; }
   void setDistributed(const std::string& rhost,
                       ushort rport,
                       const std::string& shared_vol,
@@ -77,10 +82,15 @@ class FlexPA
 
   int main();
 
+  // unique instances loaded from the pin access cache by the last main()
+  int getNumCacheHits() const { return numCacheHits_; }
+
  private:
   frDesign* design_;
   Logger* logger_;
   dst::Distributed* dist_;
+  odb::dbDatabase* db_ = nullptr;
+  bool incremental_ = false;
 
   std::unique_ptr<FlexPAGraphics> graphics_;
   std::string debugPinName_;
@@ -99,6 +109,12 @@ class FlexPA
 
   UniqueInsts unique_insts_;
 
+  // pin access cache, indexed like the unique instances; an empty key
+  // marks a unique instance that is not cached
+  std::vector<std::string> cacheKeys_;
+  std::vector<bool> cacheHits_;
+  int numCacheHits_ = 0;
+
   // helper structures
   std::vector<std::map<frCoord, frAccessPointEnum>> trackCoords_;
   std::map<frLayerNum, std::map<int, std::map<ViaRawPriorityTuple, frViaDef*>>>
@@ -123,6 +139,17 @@ class FlexPA
   void init();
   void initTrackCoords();
   void initViaRawPriority();
+  // cache
+  void initCache();
+  std::string getCacheKey(frInst* inst, uint64_t techHash) const;
+  std::string getCachePath(const std::string& key) const;
+  bool loadCache(int uniqueIdx);
+  void saveCache(int uniqueIdx);
+  void writeCache();
+  bool isCached(int uniqueIdx) const
+  {
+    return !cacheHits_.empty() && cacheHits_[uniqueIdx];
+  }
   // prep
   void prep();
   void prepPoint();
@@ -0,0 +1,427 @@
+/* Authors: Lutong Wang and Bangqi Xu */
+/*
+ * Copyright (c) 2019, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "FlexPA.h"
+#include "distributed/frArchive.h"
+#include "odb/db.h"
+#include "odb/lefout.h"
+
+using namespace std;
+using namespace fr;
+
+// Access points and patterns of a unique instance only depend on its master,
+// orientation, track offsets and the technology, the same things
+// UniqueInsts uses to group instances.  They are stored in PA_CACHE_DIR
+// keyed by a hash of those so later runs can skip prepPoint/prepPattern for
+// the classes they have seen before.
+
+namespace {
+
+// bump when the layout of a cache entry or the pin access algorithm changes
+constexpr int paCacheVersion = 1;
+
+// 64-bit FNV-1a; unlike std::hash it is stable across runs and builds
+class CacheHasher
+{
+ public:
+  void add(const std::string& str)
+  {
+    for (const unsigned char c : str) {
+      addByte(c);
+    }
+    addByte(0);
+  }
+  void add(int64_t value)
+  {
+    for (int i = 0; i < 8; i++) {
+      addByte((value >> (8 * i)) & 0xff);
+    }
+  }
+  void add(const Rect& box)
+  {
+    add(box.xMin());
+    add(box.yMin());
+    add(box.xMax());
+    add(box.yMax());
+  }
+  void add(const frPinFig* fig)
+  {
+    add(fig->typeId());
+    if (fig->typeId() == frcRect) {
+      auto rect = static_cast<const frRect*>(fig);
+      add(rect->getLayerNum());
+      add(rect->getBBox());
+    } else if (fig->typeId() == frcPolygon) {
+      auto polygon = static_cast<const frPolygon*>(fig);
+      add(polygon->getLayerNum());
+      for (const Point& pt : polygon->getPoints()) {
+        add(pt.x());
+        add(pt.y());
+      }
+    }
+  }
+  uint64_t get() const { return hash_; }
+
+ private:
+  void addByte(unsigned char c)
+  {
+    hash_ ^= c;
+    hash_ *= 1099511628211ULL;
+  }
+
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+}  // namespace
+
+void FlexPA::initCache()
+{
+  cacheKeys_.clear();
+  cacheHits_.clear();
+  numCacheHits_ = 0;
+  if (PA_CACHE_DIR.empty() || db_ == nullptr) {
+    return;
+  }
+  if (mkdir(PA_CACHE_DIR.c_str(), 0777) != 0 && errno != EEXIST) {
+    logger_->warn(DRT,
+                  72,
+                  "Cannot create pin access cache directory {}.",
+                  PA_CACHE_DIR);
+    return;
+  }
+
+  // The tech is hashed from its LEF so any rule change invalidates the
+  // cache.  Access points refer to via defs by index, so the via list,
+  // which also holds the DEF vias, is part of the key as well.
+  CacheHasher techHasher;
+  std::ostringstream techLef;
+  odb::lefout writer(logger_, techLef);
+  writer.writeTech(db_->getTech());
+  techHasher.add(techLef.str());
+  for (const auto& viaDef : getTech()->getVias()) {
+    techHasher.add(viaDef->getName());
+  }
+  techHasher.add(paCacheVersion);
+  techHasher.add(ENABLE_VIA_GEN);
+  techHasher.add(USENONPREFTRACKS);
+  techHasher.add(BOTTOM_ROUTING_LAYER);
+  techHasher.add(TOP_ROUTING_LAYER);
+  techHasher.add(VIAINPIN_BOTTOMLAYERNUM);
+  techHasher.add(VIAINPIN_TOPLAYERNUM);
+  techHasher.add(VIA_ACCESS_LAYERNUM);
+  techHasher.add(MINNUMACCESSPOINT_STDCELLPIN);
+  techHasher.add(MINNUMACCESSPOINT_MACROCELLPIN);
+  techHasher.add(ACCESS_PATTERN_END_ITERATION_NUM);
+  techHasher.add(DBPROCESSNODE);
+  const uint64_t techHash = techHasher.get();
+
+  const auto& unique = unique_insts_.getUnique();
+  cacheKeys_.resize(unique.size());
+  cacheHits_.resize(unique.size(), false);
+  uniqueInstPatterns_.resize(unique.size());
+  for (int i = 0; i < (int) unique.size(); i++) {
+    cacheKeys_[i] = getCacheKey(unique[i], techHash);
+    if (!cacheKeys_[i].empty()) {
+      cacheHits_[i] = loadCache(i);
+    }
+  }
+}
+
+// The key only covers what the unique instances are computed from: the tech,
+// the master, the orientation and the track offsets.  The neighborhood of
+// the instance (PDN stripes and obstructions loaded by initPA0, other
+// nearby shapes) is not part of it, so a cache directory must be cleared
+// when that changes (see the -pa_cache_dir help in TritonRoute.tcl).
+std::string FlexPA::getCacheKey(frInst* inst, uint64_t techHash) const
+{
+  // NDR instances are analyzed on their own and depend on their nets
+  if (unique_insts_.getClass(inst) == nullptr) {
+    return "";
+  }
+  const frMaster* master = inst->getMaster();
+  CacheHasher masterHasher;
+  masterHasher.add(master->getName());
+  for (const auto& boundary : master->getBoundaries()) {
+    for (const Point& pt : boundary.getPoints()) {
+      masterHasher.add(pt.x());
+      masterHasher.add(pt.y());
+    }
+  }
+  frLayerNum minLayerNum = std::numeric_limits<frLayerNum>::max();
+  frLayerNum maxLayerNum = std::numeric_limits<frLayerNum>::min();
+  for (const auto& term : master->getTerms()) {
+    masterHasher.add(term->getName());
+    masterHasher.add(term->getType().getValue());
+    masterHasher.add(term->getDirection().getValue());
+    for (const auto& pin : term->getPins()) {
+      masterHasher.add(pin->getFigs().size());
+      for (const auto& fig : pin->getFigs()) {
+        masterHasher.add(fig.get());
+        if (!term->getType().isSupply()) {
+          const frLayerNum lNum
+              = static_cast<frShape*>(fig.get())->getLayerNum();
+          minLayerNum = std::min(minLayerNum, lNum);
+          maxLayerNum = std::max(maxLayerNum, lNum);
+        }
+      }
+    }
+  }
+  for (const auto& blockage : master->getBlockages()) {
+    masterHasher.add(blockage->getDesignRuleWidth());
+    for (const auto& fig : blockage->getPin()->getFigs()) {
+      masterHasher.add(fig.get());
+    }
+  }
+  maxLayerNum += 2;
+
+  std::string key = fmt::format("{:016x} {} {:016x} {}",
+                                techHash,
+                                master->getName(),
+                                masterHasher.get(),
+                                inst->getOrient().getString());
+
+  // offsets of the preferred tracks relative to the origin, as in
+  // UniqueInsts::computeUnique
+  const Point origin = inst->getOrigin();
+  const Rect bbox = inst->getBoundaryBBox();
+  for (const auto& tp : design_->getTopBlock()->getTrackPatterns()) {
+    const frLayerNum lNum = tp->getLayerNum();
+    const bool isVLayer
+        = getTech()->getLayer(lNum)->getDir() == dbTechLayerDir::VERTICAL;
+    const bool isVTrack = tp->isHorizontal();  // yes = vertical track
+    if (isVLayer != isVTrack || lNum < minLayerNum || lNum > maxLayerNum) {
+      continue;
+    }
+    const frCoord spacing = tp->getTrackSpacing();
+    const frCoord low = tp->getStartCoord();
+    const frCoord high = low + spacing * ((int) tp->getNumTracks() - 1);
+    const frCoord bboxLow = isVTrack ? bbox.xMin() : bbox.yMin();
+    const frCoord bboxHigh = isVTrack ? bbox.xMax() : bbox.yMax();
+    if (low > bboxHigh || high < bboxLow) {
+      key += fmt::format(" {}:-", lNum);
+    } else if (low <= bboxLow && high >= bboxHigh) {
+      const frCoord originCoord = isVTrack ? origin.x() : origin.y();
+      const frCoord phase = ((low - originCoord) % spacing + spacing) % spacing;
+      key += fmt::format(" {}:{}/{}", lNum, phase, spacing);
+    } else {
+      // tracks ending inside the instance
+      return "";
+    }
+  }
+  return key;
+}
+
+std::string FlexPA::getCachePath(const std::string& key) const
+{
+  CacheHasher hasher;
+  hasher.add(key);
+  return fmt::format("{}/{:016x}.pa", PA_CACHE_DIR, hasher.get());
+}
+
+// An entry holds the key, the pin access of every pin of the unique
+// instance in instTerm order and the patterns.  Patterns refer to access
+// points by (pin, access point) index.
+bool FlexPA::loadCache(int uniqueIdx)
+{
+  std::ifstream file(getCachePath(cacheKeys_[uniqueIdx]), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  frInst* inst = unique_insts_.getUnique(uniqueIdx);
+  vector<frMPin*> pins;
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      pins.push_back(pin.get());
+    }
+  }
+
+  std::string key;
+  vector<unique_ptr<frPinAccess>> pinAccess;
+  vector<vector<int>> patterns;
+  try {
+    frIArchive ar(file);
+    ar.setDesign(design_);
+    registerTypes(ar);
+    ar >> key;
+    if (key != cacheKeys_[uniqueIdx]) {
+      return false;
+    }
+    ar >> pinAccess;
+    ar >> patterns;
+  } catch (const std::exception&) {
+    // truncated or from another build
+    return false;
+  }
+  if (pinAccess.size() != pins.size()) {
+    return false;
+  }
+  // each pattern holds (pin, ap) pairs for the pattern then the left and
+  // right boundary access points; -1 is a null access point
+  auto validAp = [&](int pinIdx, int apIdx) {
+    if (pinIdx == -1) {
+      return true;
+    }
+    return pinIdx >= 0 && pinIdx < (int) pins.size() && apIdx >= 0
+           && apIdx < pinAccess[pinIdx]->getNumAccessPoints();
+  };
+  for (const auto& pattern : patterns) {
+    if (pattern.size() % 2 != 0 || pattern.size() < 4) {
+      return false;
+    }
+    for (int i = 0; i < (int) pattern.size(); i += 2) {
+      if (!validAp(pattern[i], pattern[i + 1])) {
+        return false;
+      }
+    }
+  }
+
+  const int paIdx = unique_insts_.getPAIndex(inst);
+  for (int i = 0; i < (int) pins.size(); i++) {
+    pins[i]->setPinAccess(paIdx, std::move(pinAccess[i]));
+  }
+  auto getAp = [&](int pinIdx, int apIdx) -> frAccessPoint* {
+    if (pinIdx == -1) {
+      return nullptr;
+    }
+    return pins[pinIdx]->getPinAccess(paIdx)->getAccessPoint(apIdx);
+  };
+  auto& instPatterns = uniqueInstPatterns_[uniqueIdx];
+  instPatterns.clear();
+  for (const auto& pattern : patterns) {
+    auto accessPattern = make_unique<FlexPinAccessPattern>();
+    const int numAps = pattern.size() / 2 - 2;
+    for (int i = 0; i < numAps; i++) {
+      accessPattern->addAccessPoint(getAp(pattern[2 * i], pattern[2 * i + 1]));
+    }
+    accessPattern->setBoundaryAP(
+        true, getAp(pattern[2 * numAps], pattern[2 * numAps + 1]));
+    accessPattern->setBoundaryAP(
+        false, getAp(pattern[2 * numAps + 2], pattern[2 * numAps + 3]));
+    accessPattern->updateCost();
+    instPatterns.push_back(std::move(accessPattern));
+  }
+  return true;
+}
+
+void FlexPA::saveCache(int uniqueIdx)
+{
+  frInst* inst = unique_insts_.getUnique(uniqueIdx);
+  const int paIdx = unique_insts_.getPAIndex(inst);
+  map<frPin*, int> pinIdxs;
+  vector<unique_ptr<frPinAccess>> pinAccess;
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      pinIdxs[pin.get()] = pinAccess.size();
+      pinAccess.push_back(
+          make_unique<frPinAccess>(*pin->getPinAccess(paIdx)));
+    }
+  }
+  auto addAp = [&pinIdxs](vector<int>& pattern, frAccessPoint* ap) {
+    if (ap == nullptr) {
+      pattern.push_back(-1);
+      pattern.push_back(-1);
+    } else {
+      pattern.push_back(pinIdxs.at(ap->getPinAccess()->getPin()));
+      pattern.push_back(ap->getId());
+    }
+  };
+  vector<vector<int>> patterns;
+  for (const auto& accessPattern : uniqueInstPatterns_[uniqueIdx]) {
+    vector<int> pattern;
+    for (frAccessPoint* ap : accessPattern->getPattern()) {
+      addAp(pattern, ap);
+    }
+    addAp(pattern, accessPattern->getBoundaryAP(true));
+    addAp(pattern, accessPattern->getBoundaryAP(false));
+    patterns.push_back(std::move(pattern));
+  }
+
+  // write to a private file first so concurrent runs never read a partial
+  // entry
+  const std::string path = getCachePath(cacheKeys_[uniqueIdx]);
+  const std::string tmpPath = fmt::format("{}.{}", path, getpid());
+  {
+    std::ofstream file(tmpPath, std::ios::binary);
+    frOArchive ar(file);
+    registerTypes(ar);
+    ar << cacheKeys_[uniqueIdx];
+    ar << pinAccess;
+    ar << patterns;
+    if (!file) {
+      logger_->warn(
+          DRT, 75, "Cannot write pin access cache entry {}.", tmpPath);
+      std::remove(tmpPath.c_str());
+      return;
+    }
+  }
+  std::rename(tmpPath.c_str(), path.c_str());
+}
+
+void FlexPA::writeCache()
+{
+  if (cacheKeys_.empty()) {
+    return;
+  }
+  int numHits = 0;
+  int numMisses = 0;
+  for (int i = 0; i < (int) cacheKeys_.size(); i++) {
+    if (cacheKeys_[i].empty()) {
+      continue;
+    }
+    if (cacheHits_[i]) {
+      numHits++;
+    } else {
+      numMisses++;
+      // keep recomputing std cells without a valid pattern so DRT-0087
+      // is still reported
+      const dbMasterType masterType
+          = unique_insts_.getUnique(i)->getMaster()->getMasterType();
+      if (!uniqueInstPatterns_[i].empty() || !masterType.isCore()) {
+        saveCache(i);
+      }
+    }
+  }
+  numCacheHits_ = numHits;
+  if (VERBOSE > 0) {
+    logger_->info(DRT,
+                  71,
+                  "Pin access cache: {} hits, {} misses, {} uncached unique "
+                  "instances.",
+                  numHits,
+                  numMisses,
+                  cacheKeys_.size() - numHits - numMisses);
+  }
+}
@@ -1429,6 +1429,9 @@ void FlexPA::prepPoint()
   for (int i = 0; i < (int) unique.size(); i++) {
     try {
       auto& inst = unique[i];
+      if (isCached(i)) {
+        continue;
+      }
       // only do for core and block cells
       dbMasterType masterType = inst->getMaster()->getMasterType();
       if (masterType != dbMasterType::CORE
@@ -1641,6 +1644,9 @@ void FlexPA::prepPattern()
        currUniqueInstIdx++) {
     try {
       auto& inst = unique[currUniqueInstIdx];
+      if (isCached(currUniqueInstIdx)) {
+        continue;
+      }
       // only do for core and block cells
       // TODO the above comment says "block cells" but that's not what the code
       // does?
@@ -1692,6 +1698,7 @@ void FlexPA::prepPattern()
   if (VERBOSE > 0) {
     logger_->info(DRT, 81, "  Complete {} unique inst patterns.", cnt);
   }
+  writeCache();
   if (isDistributed()) {
     dst::JobMessage msg(dst::JobMessage::PIN_ACCESS,
                         dst::JobMessage::BROADCAST),
@@ -1753,7 +1760,12 @@ void FlexPA::prepPattern()
 void FlexPA::revertAccessPoints()
 {
   const auto& unique = unique_insts_.getUnique();
-  for (auto& inst : unique) {
+  for (int i = 0; i < (int) unique.size(); i++) {
+    // cached access points are stored reverted
+    if (isCached(i)) {
+      continue;
+    }
+    auto& inst = unique[i];
     const dbTransform xform = inst->getTransform();
     const Point offset(xform.getOffset());
     dbTransform revertXform;
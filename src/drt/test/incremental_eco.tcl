@@ -0,0 +1,61 @@
+# Incremental detailed routing after moving a routed instance must only
+# revisit the moved instance and leave no violations and no opens
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+detailed_route -verbose 0
+
+# the wire length of each net, except the nets of inst
+proc wire_lengths { block inst } {
+  set touched {}
+  foreach iterm [$inst getITerms] {
+    set net [$iterm getNet]
+    if { $net != "NULL" } {
+      lappend touched [$net getName]
+    }
+  }
+  set lengths {}
+  foreach net [$block getNets] {
+    set wire [$net getWire]
+    if { $wire != "NULL" && [lsearch $touched [$net getName]] == -1 } {
+      dict set lengths [$net getName] [$wire getLength]
+    }
+  }
+  return $lengths
+}
+
+# ECO: move inst4678 (driver of net1237) two sites to the left
+set block [ord::get_db_block]
+set inst [$block findInst inst4678]
+set before [wire_lengths $block $inst]
+$inst setLocation 90000 82080
+
+detailed_route -incremental -verbose 0
+
+# errors out on an open net
+drt::check_connectivity_cmd
+if { [detailed_route_num_drvs] != 0 } {
+  puts "FAIL: [detailed_route_num_drvs] violations after the ECO"
+  exit 1
+}
+set after [wire_lengths $block $inst]
+if { [dict size $before] == 0 } {
+  puts "FAIL: No routed nets"
+  exit 1
+}
+set changed 0
+dict for {name length} $before {
+  if { ![dict exists $after $name] || [dict get $after $name] != $length } {
+    incr changed
+  }
+}
+# only the neighborhood of the moved instance is rerouted
+if { $changed * 2 > [dict size $before] } {
+  puts "FAIL: $changed of [dict size $before] untouched nets were rerouted"
+  exit 1
+}
+
+puts "pass"
+exit 0
@@ -0,0 +1,64 @@
+# pin_access -pa_cache_dir run twice must load the unique instances from
+# the cache the second time and give the same access points as pin_access
+# without the cache
+source "helpers.tcl"
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+
+# the access points in odb, one sorted line each
+proc access_points {} {
+  set aps {}
+  foreach ap [[ord::get_db_block] getAccessPoints] {
+    set mpin [$ap getMPin]
+    if { $mpin != "NULL" } {
+      set mterm [$mpin getMTerm]
+      set pin "[[$mterm getMaster] getName]/[$mterm getName]"
+    } else {
+      set pin "PIN/[[[$ap getBPin] getBTerm] getName]"
+    }
+    set pt [$ap getPoint]
+    lappend aps "$pin [[$ap getLayer] getName] [$pt getX] [$pt getY]\
+                 [$ap hasAccess]"
+  }
+  return [lsort $aps]
+}
+
+# The first run adds the vias it generates to the block.  Those are part
+# of the cache key, so the runs compared below all start after it.
+pin_access -verbose 0
+pin_access -verbose 0
+set uncached [access_points]
+
+set cache_dir [make_result_file pa_cache]
+file delete -force $cache_dir
+pin_access -verbose 1 -pa_cache_dir $cache_dir
+set first_hits [drt::pin_access_num_cache_hits]
+set first [access_points]
+pin_access -verbose 1 -pa_cache_dir $cache_dir
+set second_hits [drt::pin_access_num_cache_hits]
+set second [access_points]
+
+if { [llength $uncached] == 0 } {
+  puts "FAIL: No access points"
+  exit 1
+}
+if { $first_hits != 0 } {
+  puts "FAIL: $first_hits cache hits with an empty cache"
+  exit 1
+}
+if { $second_hits == 0 } {
+  puts "FAIL: No cache hits on the second run"
+  exit 1
+}
+if { $first != $uncached } {
+  puts "FAIL: Access points of the first cached run differ from the uncached run"
+  exit 1
+}
+if { $second != $uncached } {
+  puts "FAIL: Access points loaded from the cache differ from the uncached run"
+  exit 1
+}
+
+puts "pass"
+exit 0
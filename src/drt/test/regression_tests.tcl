@@ -11,4 +11,8 @@ record_tests {
 }
 record_pass_fail_tests {
   gc_test
+  incremental_eco
+  pa_cache
+  rq_test
+  scheduler_threads
 }
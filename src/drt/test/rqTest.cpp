@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE rq
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+// Shared library version
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#else
+// Header only version
+#include <boost/test/included/unit_test.hpp>
+#endif
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "dr/FlexDR.h"
+#include "fixture.h"
+#include "frDesign.h"
+#include "frRegionQuery.h"
+
+using namespace fr;
+
+// Fixture for the concurrent access rules of frRegionQuery.  Build with
+// -DTSAN=ON so that a race on the trees fails the test instead of passing
+// by luck.
+struct RQFixture : public Fixture
+{
+  RQFixture()
+  {
+    frNet* n1 = makeNet("n1");
+    makePathseg(n1, 2, {0, 0}, {1000, 0});
+    auto block = makeMacro("OBS");
+    makeMacroObs(block, 450, -50, 750, 200, 2);
+    makeInst("i1", block, 0, 0);
+    initRegionQuery();
+  }
+
+  static constexpr int num_readers = 4;
+  static constexpr int num_commits = 2000;
+};
+
+BOOST_FIXTURE_TEST_SUITE(rq, RQFixture);
+
+// Workers query the fixed shapes without a lock and the DR objects and
+// markers under the shared design lock while commits change the DR objects
+// and markers under the exclusive design lock, as in FlexDR::searchRepair.
+BOOST_AUTO_TEST_CASE(concurrent_read_during_commit)
+{
+  frRegionQuery* rq = design->getRegionQuery();
+  const Rect box(0, -100, 1000, 300);
+
+  frPathSeg ps;
+  ps.setPoints({0, 100}, {1000, 100});
+  ps.setLayerNum(2);
+  frSegStyle style;
+  style.setWidth(100);
+  ps.setStyle(style);
+
+  frMarker marker;
+  marker.setBBox(Rect(450, 50, 750, 150));
+  marker.setLayerNum(2);
+
+  FlexDRDesignLock design_lock;
+  std::atomic<bool> done(false);
+  std::vector<int> bad_fixed(num_readers, 0);
+  std::vector<int> bad_dr(num_readers, 0);
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < num_readers; t++) {
+    readers.emplace_back([&, t] {
+      while (!done) {
+        // the obstruction is fixed, so no lock is needed
+        frRegionQuery::Objects<frBlockObject> fixed;
+        rq->query(box, 2, fixed);
+        if (fixed.size() != 1) {
+          bad_fixed[t]++;
+        }
+        std::shared_lock<FlexDRDesignLock> lock(design_lock);
+        std::vector<frBlockObject*> dr_objs;
+        rq->queryDRObj(box, 2, dr_objs);
+        std::vector<frMarker*> markers;
+        rq->queryMarker(box, 2, markers);
+        // a commit adds or removes the path segment and the marker together
+        if (dr_objs.size() != markers.size() + 1) {
+          bad_dr[t]++;
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < num_commits; i++) {
+    std::unique_lock<FlexDRDesignLock> lock(design_lock);
+    if (i % 2 == 0) {
+      rq->addDRObj(&ps);
+      rq->addMarker(&marker);
+    } else {
+      rq->removeDRObj(&ps);
+      rq->removeMarker(&marker);
+    }
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  for (int t = 0; t < num_readers; t++) {
+    BOOST_TEST(bad_fixed[t] == 0);
+    BOOST_TEST(bad_dr[t] == 0);
+  }
+  std::vector<frBlockObject*> dr_objs;
+  rq->queryDRObj(box, 2, dr_objs);
+  BOOST_TEST(dr_objs.size() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,3 @@
+source "helpers.tcl"
+
+run_unit_test_and_exit [list "build" "src" "drt" "rqTest"]
@@ -0,0 +1,24 @@
+# The worker scheduler of search and repair must give the same routing
+# with several threads as the single-threaded ispd18_sample run
+source "helpers.tcl"
+
+set_thread_count 2
+
+read_lef testcase/ispd18_sample/ispd18_sample.input.lef
+read_def testcase/ispd18_sample/ispd18_sample.input.def
+read_guides testcase/ispd18_sample/ispd18_sample.input.guide
+detailed_route -verbose 0
+
+set def_file [make_result_file scheduler_threads.def]
+write_def $def_file
+if { [diff_files ispd18_sample.defok $def_file] } {
+  puts "FAIL: Routing with 2 threads differs from ispd18_sample.defok"
+  exit 1
+}
+if { [detailed_route_num_drvs] != 0 } {
+  puts "FAIL: [detailed_route_num_drvs] violations"
+  exit 1
+}
+
+puts "pass"
+exit 0
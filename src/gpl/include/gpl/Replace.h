@@ -34,6 +34,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace odb {
@@ -62,6 +63,7 @@ class PlacerBaseCommon;
 class PlacerBase;
 class NesterovBaseCommon;
 class NesterovBase;
+class NesterovBaseVars;
 class RouteBase;
 class TimingBase;
 
@@ -92,9 +94,15 @@ class Replace
   void setInitialPlaceMaxSolverIter(int iter);
   void setInitialPlaceMaxFanout(int fanout);
   void setInitialPlaceNetWeightScale(float scale);
+  // IC(0) instead of Jacobi preconditioning in the CG solver
+  void setInitialPlaceIncompleteCholesky(bool mode);
 
   void setNesterovPlaceMaxIter(int iter);
 
+  // number of clustered coarse levels placed before the flat placement
+  // (not in incremental placement or when resuming a checkpoint)
+  void setMultilevelLevels(int levels);
+
   void setBinGridCnt(int binGridCntX, int binGridCntY);
 
   void setTargetDensity(float density);
@@ -115,7 +123,11 @@ class Replace
   void setPadRight(int padding);
 
   void setForceCPU(bool force_cpu);
+  void setNumThreads(int threads);
+  void setLegacyFFT(bool legacy_fft);
   void setTimingDrivenMode(bool mode);
+  // re-estimate only the nets of moved cells after the first reweight
+  void setTimingDrivenIncremental(bool mode);
 
   void setSkipIoMode(bool mode);
 
@@ -132,6 +144,15 @@ class Replace
 
   void setRoutabilityRcCoefficients(float k1, float k2, float k3, float k4);
 
+  // estimate congestion with RUDY between full global routes
+  void setRoutabilityUseRudy(bool mode);
+
+  // save the Nesterov state to file at each added overflow milestone
+  void setCheckpointFile(const std::string& file);
+  void addCheckpointOverflow(float overflow);
+  // resume Nesterov from the overflow milestone saved in file
+  void setResumeCheckpoint(const std::string& file, float overflow);
+
   void addTimingNetWeightOverflow(int overflow);
   void setTimingNetWeightMax(float max);
 
@@ -142,7 +163,11 @@ class Replace
                 odb::dbInst* inst = nullptr);
 
  private:
+  void initPlacerBase();
   bool initNesterovPlace();
+  NesterovBaseVars nesterovBaseVars() const;
+  // places the clustered coarse levels; only the place instances move
+  void doMultilevelPlace();
 
   odb::dbDatabase* db_;
   rsz::Resizer* rs_;
@@ -164,11 +189,15 @@ class Replace
   int initialPlaceMaxSolverIter_;
   int initialPlaceMaxFanout_;
   float initialPlaceNetWeightScale_;
+  bool initialPlaceIncompleteCholesky_;
   bool forceCPU_;
+  int numThreads_;
+  bool legacyFFT_;
 
   int total_placeable_insts_;
 
   int nesterovPlaceMaxIter_;
+  int multilevelLevels_;
   int binGridCntX_;
   int binGridCntY_;
   float overflow_;
@@ -194,12 +223,19 @@ class Replace
   float timingNetWeightMax_;
 
   bool timingDrivenMode_;
+  bool timingDrivenIncremental_;
   bool routabilityDrivenMode_;
+  bool routabilityUseRudy_;
   bool uniformTargetDensityMode_;
   bool skipIoMode_;
 
   std::vector<int> timingNetWeightOverflows_;
 
+  std::string checkpointFile_;
+  std::vector<float> checkpointOverflows_;
+  std::string resumeCheckpoint_;
+  float resumeOverflow_;
+
   // temp variable; OpenDB should have these values.
   int padLeft_;
   int padRight_;
@@ -0,0 +1,531 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018-2020, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dct.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gpl {
+
+// columns gathered per block in Dct2D::columnPass
+static constexpr int kColumnBlock = 8;
+
+////////////////////////////////////////////////////////
+// DftPlan
+
+DftPlan::DftPlan(int n) : n_(n)
+{
+  // radix 4 first, then 2, 3, 5 and any remaining prime factor
+  int rest = n;
+  while (rest % 4 == 0) {
+    radices_.push_back(4);
+    rest /= 4;
+  }
+  for (int p = 2; rest > 1; p++) {
+    while (rest % p == 0) {
+      radices_.push_back(p);
+      rest /= p;
+    }
+    if (p * p > rest && rest > 1) {
+      radices_.push_back(rest);
+      rest = 1;
+    }
+  }
+
+  int len = 1;
+  for (const int p : radices_) {
+    const int next = len * p;
+    for (int j = 0; j < len; j++) {
+      for (int q = 0; q < p; q++) {
+        const double angle = 2.0 * M_PI * q * j / next;
+        twRe_.push_back(std::cos(angle));
+        twIm_.push_back(std::sin(angle));
+      }
+    }
+    len = next;
+  }
+}
+
+// Stockham autosort: after the stage that builds length-L transforms,
+// the DFT of the stride-r subsequence starting at k has its entry j at
+// index j * r + k (r = n / L). Each stage reads one buffer and writes
+// the other, so no bit reversal is needed and the innermost loop runs
+// over k with unit stride on both sides.
+bool DftPlan::transform(float* re,
+                        float* im,
+                        float* re2,
+                        float* im2,
+                        int sign) const
+{
+  float* xr = re;
+  float* xi = im;
+  float* yr = re2;
+  float* yi = im2;
+  const float s = sign < 0 ? -1.0f : 1.0f;
+
+  std::vector<float> genRe;
+  std::vector<float> genIm;
+
+  int len = 1;
+  size_t twOffset = 0;
+  for (const int p : radices_) {
+    const int r = n_ / (len * p);
+    const float* twr = &twRe_[twOffset];
+    const float* twi = &twIm_[twOffset];
+
+    if (p != 2 && p != 4) {
+      // butterfly inputs followed by w_p^t
+      genRe.resize(2 * p);
+      genIm.resize(2 * p);
+      for (int t = 0; t < p; t++) {
+        const double angle = 2.0 * M_PI * t / p;
+        genRe[p + t] = std::cos(angle);
+        genIm[p + t] = s * std::sin(angle);
+      }
+    }
+
+    for (int j = 0; j < len; j++) {
+      const float* inR = xr + j * p * r;
+      const float* inI = xi + j * p * r;
+
+      if (p == 2) {
+        const float w1r = twr[j * 2 + 1];
+        const float w1i = s * twi[j * 2 + 1];
+        float* y0r = yr + j * r;
+        float* y0i = yi + j * r;
+        float* y1r = yr + (j + len) * r;
+        float* y1i = yi + (j + len) * r;
+#pragma omp simd
+        for (int k = 0; k < r; k++) {
+          const float x0r = inR[k];
+          const float x0i = inI[k];
+          const float x1r = inR[r + k] * w1r - inI[r + k] * w1i;
+          const float x1i = inR[r + k] * w1i + inI[r + k] * w1r;
+          y0r[k] = x0r + x1r;
+          y0i[k] = x0i + x1i;
+          y1r[k] = x0r - x1r;
+          y1i[k] = x0i - x1i;
+        }
+      } else if (p == 4) {
+        const float w1r = twr[j * 4 + 1];
+        const float w1i = s * twi[j * 4 + 1];
+        const float w2r = twr[j * 4 + 2];
+        const float w2i = s * twi[j * 4 + 2];
+        const float w3r = twr[j * 4 + 3];
+        const float w3i = s * twi[j * 4 + 3];
+        float* y0r = yr + j * r;
+        float* y0i = yi + j * r;
+        float* y1r = yr + (j + len) * r;
+        float* y1i = yi + (j + len) * r;
+        float* y2r = yr + (j + 2 * len) * r;
+        float* y2i = yi + (j + 2 * len) * r;
+        float* y3r = yr + (j + 3 * len) * r;
+        float* y3i = yi + (j + 3 * len) * r;
+#pragma omp simd
+        for (int k = 0; k < r; k++) {
+          const float a0r = inR[k];
+          const float a0i = inI[k];
+          const float a1r = inR[r + k] * w1r - inI[r + k] * w1i;
+          const float a1i = inR[r + k] * w1i + inI[r + k] * w1r;
+          const float a2r = inR[2 * r + k] * w2r - inI[2 * r + k] * w2i;
+          const float a2i = inR[2 * r + k] * w2i + inI[2 * r + k] * w2r;
+          const float a3r = inR[3 * r + k] * w3r - inI[3 * r + k] * w3i;
+          const float a3i = inR[3 * r + k] * w3i + inI[3 * r + k] * w3r;
+
+          const float b0r = a0r + a2r;
+          const float b0i = a0i + a2i;
+          const float b1r = a0r - a2r;
+          const float b1i = a0i - a2i;
+          const float b2r = a1r + a3r;
+          const float b2i = a1i + a3i;
+          // (s * i) * (a1 - a3)
+          const float b3r = -s * (a1i - a3i);
+          const float b3i = s * (a1r - a3r);
+
+          y0r[k] = b0r + b2r;
+          y0i[k] = b0i + b2i;
+          y2r[k] = b0r - b2r;
+          y2i[k] = b0i - b2i;
+          y1r[k] = b1r + b3r;
+          y1i[k] = b1i + b3i;
+          y3r[k] = b1r - b3r;
+          y3i[k] = b1i - b3i;
+        }
+      } else {
+        // direct butterfly for the other prime radices
+        float* ar = genRe.data();
+        float* ai = genIm.data();
+        const float* wr = genRe.data() + p;
+        const float* wi = genIm.data() + p;
+        for (int k = 0; k < r; k++) {
+          for (int q = 0; q < p; q++) {
+            const float tr = twr[j * p + q];
+            const float ti = s * twi[j * p + q];
+            const float xq = inR[q * r + k];
+            const float yq = inI[q * r + k];
+            ar[q] = xq * tr - yq * ti;
+            ai[q] = xq * ti + yq * tr;
+          }
+          for (int out = 0; out < p; out++) {
+            float sumR = 0;
+            float sumI = 0;
+            int t = 0;
+            for (int q = 0; q < p; q++) {
+              sumR += ar[q] * wr[t] - ai[q] * wi[t];
+              sumI += ar[q] * wi[t] + ai[q] * wr[t];
+              t += out;
+              if (t >= p) {
+                t -= p;
+              }
+            }
+            yr[(j + out * len) * r + k] = sumR;
+            yi[(j + out * len) * r + k] = sumI;
+          }
+        }
+      }
+    }
+
+    std::swap(xr, yr);
+    std::swap(xi, yi);
+    twOffset += static_cast<size_t>(len) * p;
+    len *= p;
+  }
+
+  return xr != re;
+}
+
+////////////////////////////////////////////////////////
+// DctPlan
+//
+// Makhoul's reordering turns a length-n DCT into one real length-n
+// DFT: v[m] = a[2m], v[n - 1 - m] = a[2m + 1]. For even n the real DFT
+// is computed as a length n/2 complex DFT of z[m] = v[2m] + i v[2m + 1].
+
+DctPlan::DctPlan(int n)
+    : n_(n), packed_(n % 2 == 0), dft_(n % 2 == 0 ? n / 2 : n)
+{
+  shiftCos_.resize(n);
+  shiftSin_.resize(n);
+  for (int k = 0; k < n; k++) {
+    const double angle = M_PI * k / (2.0 * n);
+    shiftCos_[k] = std::cos(angle);
+    shiftSin_[k] = std::sin(angle);
+  }
+  if (packed_) {
+    splitCos_.resize(n / 2);
+    splitSin_.resize(n / 2);
+    for (int k = 0; k < n / 2; k++) {
+      const double angle = 2.0 * M_PI * k / n;
+      splitCos_[k] = std::cos(angle);
+      splitSin_[k] = std::sin(angle);
+    }
+  }
+}
+
+// V[k] = sum_m v[m] e^{-2 pi i k m / n} for k = 0..n/2 (the rest is the
+// conjugate mirror) into re/im, which must hold n/2 + 1 entries.
+void DctPlan::realForward(float* v, float* re, float* im, float* scratch) const
+{
+  const int n = n_;
+  if (!packed_) {
+    float* zr = scratch;
+    float* zi = scratch + n;
+    float* tr = scratch + 2 * n;
+    float* ti = scratch + 3 * n;
+    std::copy(v, v + n, zr);
+    std::fill(zi, zi + n, 0.0f);
+    if (dft_.transform(zr, zi, tr, ti, -1)) {
+      std::swap(zr, tr);
+      std::swap(zi, ti);
+    }
+    std::copy(zr, zr + n / 2 + 1, re);
+    std::copy(zi, zi + n / 2 + 1, im);
+    return;
+  }
+
+  const int h = n / 2;
+  float* zr = scratch;
+  float* zi = scratch + h;
+  float* tr = scratch + 2 * h;
+  float* ti = scratch + 3 * h;
+  for (int m = 0; m < h; m++) {
+    zr[m] = v[2 * m];
+    zi[m] = v[2 * m + 1];
+  }
+  if (dft_.transform(zr, zi, tr, ti, -1)) {
+    std::swap(zr, tr);
+    std::swap(zi, ti);
+  }
+
+  // E = (Z[k] + conj Z[h-k]) / 2, O = (Z[k] - conj Z[h-k]) / 2i,
+  // V[k] = E + e^{-2 pi i k / n} O
+  for (int k = 0; k < h; k++) {
+    const int mk = k == 0 ? 0 : h - k;
+    const float er = 0.5f * (zr[k] + zr[mk]);
+    const float ei = 0.5f * (zi[k] - zi[mk]);
+    const float orr = 0.5f * (zi[k] + zi[mk]);
+    const float oi = -0.5f * (zr[k] - zr[mk]);
+    const float c = splitCos_[k];
+    const float sn = splitSin_[k];
+    re[k] = er + orr * c + oi * sn;
+    im[k] = ei + oi * c - orr * sn;
+  }
+  re[h] = zr[0] - zi[0];
+  im[h] = 0.0f;
+}
+
+// v[m] = sum_k H[k] e^{2 pi i k m / n} for a Hermitian H given as
+// k = 0..n/2 in re/im. re/im are clobbered.
+void DctPlan::realInverseReal(float* re,
+                              float* im,
+                              float* v,
+                              float* scratch) const
+{
+  const int n = n_;
+  if (!packed_) {
+    float* zr = scratch;
+    float* zi = scratch + n;
+    float* tr = scratch + 2 * n;
+    float* ti = scratch + 3 * n;
+    for (int k = 0; k <= n / 2; k++) {
+      zr[k] = re[k];
+      zi[k] = im[k];
+    }
+    for (int k = n / 2 + 1; k < n; k++) {
+      zr[k] = re[n - k];
+      zi[k] = -im[n - k];
+    }
+    const float* out = dft_.transform(zr, zi, tr, ti, 1) ? tr : zr;
+    std::copy(out, out + n, v);
+    return;
+  }
+
+  // Z[k] = (H[k] + H[k+h]) + i e^{2 pi i k / n} (H[k] - H[k+h]),
+  // z = IDFT_h(Z), v[2m] = Re z[m], v[2m + 1] = Im z[m]
+  const int h = n / 2;
+  float* zr = scratch;
+  float* zi = scratch + h;
+  float* tr = scratch + 2 * h;
+  float* ti = scratch + 3 * h;
+  for (int k = 0; k < h; k++) {
+    // H[k + h] = conj H[h - k]
+    const float hr = re[h - k];
+    const float hi = -im[h - k];
+    const float sr = re[k] + hr;
+    const float si = im[k] + hi;
+    const float dr = re[k] - hr;
+    const float di = im[k] - hi;
+    const float c = splitCos_[k];
+    const float sn = splitSin_[k];
+    const float pr = dr * c - di * sn;
+    const float pi = dr * sn + di * c;
+    zr[k] = sr - pi;
+    zi[k] = si + pr;
+  }
+  if (dft_.transform(zr, zi, tr, ti, 1)) {
+    std::swap(zr, tr);
+    std::swap(zi, ti);
+  }
+  for (int m = 0; m < h; m++) {
+    v[2 * m] = zr[m];
+    v[2 * m + 1] = zi[m];
+  }
+}
+
+void DctPlan::dct2(float* a, float* scratch) const
+{
+  const int n = n_;
+  const int h = n / 2;
+  float* v = scratch;
+  float* re = scratch + n;
+  float* im = re + h + 1;
+  float* work = im + h + 1;
+
+  for (int m = 0; 2 * m < n; m++) {
+    v[m] = a[2 * m];
+  }
+  for (int m = 0; 2 * m + 1 < n; m++) {
+    v[n - 1 - m] = a[2 * m + 1];
+  }
+  realForward(v, re, im, work);
+
+  // C[k] = Re(e^{-i pi k / 2n} V[k]), V[n - k] = conj V[k]
+  for (int k = 0; k <= h; k++) {
+    a[k] = re[k] * shiftCos_[k] + im[k] * shiftSin_[k];
+  }
+  for (int k = h + 1; k < n; k++) {
+    a[k] = re[n - k] * shiftCos_[k] - im[n - k] * shiftSin_[k];
+  }
+}
+
+void DctPlan::dct3(float* a, float* scratch) const
+{
+  // v = IDFT(H), H[k] = Re part of a[k] e^{i pi k / 2n} made Hermitian:
+  // H[0] = a[0], H[k] = e^{i pi k / 2n} (a[k] - i a[n - k]) / 2
+  const int n = n_;
+  const int h = n / 2;
+  float* v = scratch;
+  float* re = scratch + n;
+  float* im = re + h + 1;
+  float* work = im + h + 1;
+
+  re[0] = a[0];
+  im[0] = 0.0f;
+  for (int k = 1; k <= h; k++) {
+    const float ar = 0.5f * a[k];
+    const float ai = -0.5f * a[n - k];
+    re[k] = ar * shiftCos_[k] - ai * shiftSin_[k];
+    im[k] = ar * shiftSin_[k] + ai * shiftCos_[k];
+  }
+  realInverseReal(re, im, v, work);
+
+  for (int m = 0; 2 * m < n; m++) {
+    a[2 * m] = v[m];
+  }
+  for (int m = 0; 2 * m + 1 < n; m++) {
+    a[2 * m + 1] = v[n - 1 - m];
+  }
+}
+
+void DctPlan::dst3(float* a, float* scratch) const
+{
+  // S[k] = (-1)^k * dct3(b)[k] with b[0] = A[n] = a[0], b[m] = a[n - m]
+  const int n = n_;
+  std::reverse(a + 1, a + n);
+  dct3(a, scratch);
+  for (int k = 1; k < n; k += 2) {
+    a[k] = -a[k];
+  }
+}
+
+////////////////////////////////////////////////////////
+// Dct2D
+
+Dct2D::Dct2D(int n1, int n2, int numThreads)
+    : n1_(n1),
+      n2_(n2),
+      numThreads_(std::max(1, numThreads)),
+      rowPlan_(n2),
+      columnPlan_(n1)
+{
+  // a 1D transform, plus the gathered block for the column pass
+  scratchSize_ = std::max(DctPlan::scratchSize(n2),
+                          DctPlan::scratchSize(n1)
+                              + kColumnBlock * static_cast<size_t>(n1));
+  scratch_.resize(scratchSize_ * numThreads_);
+}
+
+float* Dct2D::threadScratch()
+{
+  return scratch_.data() + omp_get_thread_num() * scratchSize_;
+}
+
+void Dct2D::apply(const DctPlan& plan, Kind kind, float* a, float* scratch)
+{
+  switch (kind) {
+    case Kind::DCT2:
+      plan.dct2(a, scratch);
+      break;
+    case Kind::DCT3:
+      plan.dct3(a, scratch);
+      break;
+    case Kind::DST3:
+      plan.dst3(a, scratch);
+      break;
+  }
+}
+
+void Dct2D::rowPass(float* a, Kind kind)
+{
+#pragma omp parallel for num_threads(numThreads_) schedule(static)
+  for (int i = 0; i < n1_; i++) {
+    apply(rowPlan_, kind, a + static_cast<size_t>(i) * n2_, threadScratch());
+  }
+}
+
+void Dct2D::columnPass(float* a, Kind kind)
+{
+  const int numBlocks = (n2_ + kColumnBlock - 1) / kColumnBlock;
+#pragma omp parallel for num_threads(numThreads_) schedule(static)
+  for (int blk = 0; blk < numBlocks; blk++) {
+    float* scratch = threadScratch();
+    float* block = scratch + DctPlan::scratchSize(n1_);
+    const int j0 = blk * kColumnBlock;
+    const int width = std::min(kColumnBlock, n2_ - j0);
+
+    for (int i = 0; i < n1_; i++) {
+      const float* row = a + static_cast<size_t>(i) * n2_ + j0;
+      for (int b = 0; b < width; b++) {
+        block[b * n1_ + i] = row[b];
+      }
+    }
+    for (int b = 0; b < width; b++) {
+      apply(columnPlan_, kind, block + b * n1_, scratch);
+    }
+    for (int i = 0; i < n1_; i++) {
+      float* row = a + static_cast<size_t>(i) * n2_ + j0;
+      for (int b = 0; b < width; b++) {
+        row[b] = block[b * n1_ + i];
+      }
+    }
+  }
+}
+
+void Dct2D::dct2(float* a)
+{
+  rowPass(a, Kind::DCT2);
+  columnPass(a, Kind::DCT2);
+}
+
+void Dct2D::dct3(float* a)
+{
+  rowPass(a, Kind::DCT3);
+  columnPass(a, Kind::DCT3);
+}
+
+void Dct2D::dst3dct3(float* a)
+{
+  rowPass(a, Kind::DCT3);
+  columnPass(a, Kind::DST3);
+}
+
+void Dct2D::dct3dst3(float* a)
+{
+  rowPass(a, Kind::DST3);
+  columnPass(a, Kind::DCT3);
+}
+
+}  // namespace gpl
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018-2020, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace gpl {
+
+// Mixed-radix complex DFT of one length, kept as split real/imag arrays
+// so the butterflies vectorize. Any length works; lengths made of
+// 2, 3, 4 and 5 are the fast path, other prime factors fall back to a
+// direct O(p^2) butterfly.
+class DftPlan
+{
+ public:
+  explicit DftPlan(int n);
+
+  int n() const { return n_; }
+
+  // Unnormalized transform of (re, im) using (re2, im2) as scratch.
+  // sign -1 is the forward e^{-2 pi i jk / n} transform, +1 the inverse.
+  // Returns true when the result ended up in (re2, im2).
+  bool transform(float* re, float* im, float* re2, float* im2, int sign) const;
+
+ private:
+  int n_;
+  std::vector<int> radices_;
+  // per stage, w_{L p}^{q j} for j < L, q < p (forward sign)
+  std::vector<float> twRe_;
+  std::vector<float> twIm_;
+};
+
+// Real DCT/DST of one length with the fftsg (Ooura) scaling:
+//   dct2: C[k] = sum_j a[j] cos(pi (j + 1/2) k / n)        (ddct, isgn -1)
+//   dct3: C[k] = sum_j a[j] cos(pi j (k + 1/2) / n)        (ddct, isgn  1)
+//   dst3: S[k] = sum_j A[j] sin(pi j (k + 1/2) / n), j = 1..n,
+//         with A[n] stored in a[0]                         (ddst, isgn  1)
+class DctPlan
+{
+ public:
+  explicit DctPlan(int n);
+
+  int n() const { return n_; }
+
+  // number of floats the scratch argument must hold
+  static std::size_t scratchSize(int n) { return 6 * std::size_t(n) + 2; }
+
+  void dct2(float* a, float* scratch) const;
+  void dct3(float* a, float* scratch) const;
+  void dst3(float* a, float* scratch) const;
+
+ private:
+  // v is the Makhoul-ordered real sequence of length n
+  void realForward(float* v, float* re, float* im, float* scratch) const;
+  void realInverseReal(float* re, float* im, float* v, float* scratch) const;
+
+  int n_;
+  // even n: the real length-n DFT is packed into a length n/2 one
+  bool packed_;
+  DftPlan dft_;
+  // cos / sin(pi k / 2n)
+  std::vector<float> shiftCos_;
+  std::vector<float> shiftSin_;
+  // cos / sin(2 pi k / n), k < n / 2, for the packed split
+  std::vector<float> splitCos_;
+  std::vector<float> splitSin_;
+};
+
+// 2D transforms of an n1 x n2 row-major map (a[i * n2 + j]) with the
+// same results as the fftsg 2D routines. Row passes run directly on
+// contiguous rows; column passes gather blocks of columns into
+// per-thread scratch first. Both passes are split across threads and
+// every row/column is owned by one thread, so results do not depend on
+// the thread count.
+class Dct2D
+{
+ public:
+  Dct2D(int n1, int n2, int numThreads);
+
+  void dct2(float* a);     // ddct2d(n1, n2, -1, ...)
+  void dct3(float* a);     // ddct2d(n1, n2, 1, ...)
+  void dst3dct3(float* a);  // ddsct2d(n1, n2, 1, ...)
+  void dct3dst3(float* a);  // ddcst2d(n1, n2, 1, ...)
+
+ private:
+  enum class Kind
+  {
+    DCT2,
+    DCT3,
+    DST3
+  };
+
+  void rowPass(float* a, Kind kind);
+  void columnPass(float* a, Kind kind);
+  static void apply(const DctPlan& plan, Kind kind, float* a, float* scratch);
+  float* threadScratch();
+
+  int n1_;
+  int n2_;
+  int numThreads_;
+  DctPlan rowPlan_;     // length n2
+  DctPlan columnPlan_;  // length n1
+  std::size_t scratchSize_;
+  std::vector<float> scratch_;
+};
+
+}  // namespace gpl
@@ -33,6 +33,9 @@
 
 #include "fft.h"
 
+#include "dct.h"
+
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
@@ -43,39 +46,38 @@
 namespace gpl {
 
 FFT::FFT()
-    : binDensity_(nullptr),
-      electroPhi_(nullptr),
-      electroForceX_(nullptr),
-      electroForceY_(nullptr),
-      binCntX_(0),
+    : binCntX_(0),
       binCntY_(0),
       binSizeX_(0),
-      binSizeY_(0)
+      binSizeY_(0),
+      numThreads_(1),
+      useLegacy_(true)
 {
 }
 
-FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
+FFT::FFT(int binCntX,
+         int binCntY,
+         int binSizeX,
+         int binSizeY,
+         int numThreads,
+         bool useLegacy)
     : binCntX_(binCntX),
       binCntY_(binCntY),
       binSizeX_(binSizeX),
-      binSizeY_(binSizeY)
+      binSizeY_(binSizeY),
+      numThreads_(numThreads),
+      useLegacy_(useLegacy)
 {
   init();
 }
 
 FFT::~FFT()
 {
-  using std::vector;
-  for (int i = 0; i < binCntX_; i++) {
-    delete[] binDensity_[i];
-    delete[] electroPhi_[i];
-    delete[] electroForceX_[i];
-    delete[] electroForceY_[i];
-  }
-  delete[] binDensity_;
-  delete[] electroPhi_;
-  delete[] electroForceX_;
-  delete[] electroForceY_;
+  binDensity_.clear();
+  binDensityRows_.clear();
+  electroPhiRows_.clear();
+  electroForceXRows_.clear();
+  electroForceYRows_.clear();
 
   csTable_.clear();
   wx_.clear();
@@ -88,21 +90,14 @@ FFT::~FFT()
 
 void FFT::init()
 {
-  binDensity_ = new float*[binCntX_];
-  electroPhi_ = new float*[binCntX_];
-  electroForceX_ = new float*[binCntX_];
-  electroForceY_ = new float*[binCntX_];
+  binDensity_.assign(binCntX_ * static_cast<size_t>(binCntY_), 0.0f);
+  binDensityRows_.resize(binCntX_, nullptr);
+  electroPhiRows_.resize(binCntX_, nullptr);
+  electroForceXRows_.resize(binCntX_, nullptr);
+  electroForceYRows_.resize(binCntX_, nullptr);
 
   for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i] = new float[binCntY_];
-    electroPhi_[i] = new float[binCntY_];
-    electroForceX_[i] = new float[binCntY_];
-    electroForceY_[i] = new float[binCntY_];
-
-    for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] = electroPhi_[i][j] = electroForceX_[i][j]
-          = electroForceY_[i][j] = 0.0f;
-    }
+    binDensityRows_[i] = &binDensity_[i * static_cast<size_t>(binCntY_)];
   }
 
   csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
@@ -114,6 +109,10 @@ void FFT::init()
 
   workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
 
+  if (!useLegacy_) {
+    dct_ = std::make_unique<Dct2D>(binCntX_, binCntY_, numThreads_);
+  }
+
   for (int i = 0; i < binCntX_; i++) {
     wx_[i]
         = REPLACE_FFT_PI * static_cast<float>(i) / static_cast<float>(binCntX_);
@@ -128,47 +127,53 @@ void FFT::init()
   }
 }
 
-void FFT::updateDensity(int x, int y, float density)
-{
-  binDensity_[x][y] = density;
-}
-
-std::pair<float, float> FFT::getElectroForce(int x, int y) const
-{
-  return std::make_pair(electroForceX_[x][y], electroForceY_[x][y]);
-}
-
-float FFT::getElectroPhi(int x, int y) const
-{
-  return electroPhi_[x][y];
-}
-
 using namespace std;
 
-void FFT::doFFT()
+void FFT::doFFT(const float* density,
+                float* electroPhi,
+                float* electroForceX,
+                float* electroForceY)
 {
-  ddct2d(binCntX_,
-         binCntY_,
-         -1,
-         binDensity_,
-         NULL,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
+  std::copy(density, density + binDensity_.size(), binDensity_.begin());
+  for (int i = 0; i < binCntX_; i++) {
+    const size_t offset = i * static_cast<size_t>(binCntY_);
+    electroPhiRows_[i] = electroPhi + offset;
+    electroForceXRows_[i] = electroForceX + offset;
+    electroForceYRows_[i] = electroForceY + offset;
+  }
+
+  float** densityMap = binDensityRows_.data();
+  float** phiMap = electroPhiRows_.data();
+  float** forceXMap = electroForceXRows_.data();
+  float** forceYMap = electroForceYRows_.data();
+
+  if (useLegacy_) {
+    ddct2d(binCntX_,
+           binCntY_,
+           -1,
+           densityMap,
+           NULL,
+           (int*) &workArea_[0],
+           (float*) &csTable_[0]);
+  } else {
+    dct_->dct2(binDensity_.data());
+  }
 
   for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i][0] *= 0.5;
+    densityMap[i][0] *= 0.5;
   }
 
   for (int i = 0; i < binCntY_; i++) {
-    binDensity_[0][i] *= 0.5;
+    densityMap[0][i] *= 0.5;
   }
 
   for (int i = 0; i < binCntX_; i++) {
     for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] *= 4.0 / binCntX_ / binCntY_;
+      densityMap[i][j] *= 4.0 / binCntX_ / binCntY_;
     }
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     float wx = wx_[i];
     float wx2 = wxSquare_[i];
@@ -177,7 +182,7 @@ void FFT::doFFT()
       float wy = wy_[j];
       float wy2 = wySquare_[j];
 
-      float density = binDensity_[i][j];
+      float density = densityMap[i][j];
       float phi = 0;
       float electroX = 0, electroY = 0;
 
@@ -199,33 +204,39 @@ void FFT::doFFT()
         electroX = phi * wx;
         electroY = phi * wy;
       }
-      electroPhi_[i][j] = phi;
-      electroForceX_[i][j] = electroX;
-      electroForceY_[i][j] = electroY;
+      phiMap[i][j] = phi;
+      forceXMap[i][j] = electroX;
+      forceYMap[i][j] = electroY;
     }
   }
   // Inverse DCT
-  ddct2d(binCntX_,
-         binCntY_,
-         1,
-         electroPhi_,
-         NULL,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
-  ddsct2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceX_,
-          NULL,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
-  ddcst2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceY_,
-          NULL,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
+  if (useLegacy_) {
+    ddct2d(binCntX_,
+           binCntY_,
+           1,
+           phiMap,
+           NULL,
+           (int*) &workArea_[0],
+           (float*) &csTable_[0]);
+    ddsct2d(binCntX_,
+            binCntY_,
+            1,
+            forceXMap,
+            NULL,
+            (int*) &workArea_[0],
+            (float*) &csTable_[0]);
+    ddcst2d(binCntX_,
+            binCntY_,
+            1,
+            forceYMap,
+            NULL,
+            (int*) &workArea_[0],
+            (float*) &csTable_[0]);
+  } else {
+    dct_->dct3(electroPhi);
+    dct_->dst3dct3(electroForceX);
+    dct_->dct3dst3(electroForceY);
+  }
 }
 
 }  // namespace gpl
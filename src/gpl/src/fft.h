@@ -33,34 +33,46 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 namespace gpl {
 
+class Dct2D;
+
 class FFT
 {
  public:
   FFT();
-  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY);
+  // useLegacy selects the original fftsg (Ooura) routines, which need
+  // power-of-two bin counts and run single-threaded; otherwise the
+  // Dct2D engine is used with numThreads threads.
+  FFT(int binCntX,
+      int binCntY,
+      int binSizeX,
+      int binSizeY,
+      int numThreads = 1,
+      bool useLegacy = true);
   ~FFT();
 
-  // input func
-  void updateDensity(int x, int y, float density);
-
-  // do FFT
-  void doFFT();
-
-  // returning func
-  std::pair<float, float> getElectroForce(int x, int y) const;
-  float getElectroPhi(int x, int y) const;
+  // All maps are contiguous and x-major: map[x * binCntY + y].
+  // density is copied into the transform buffer in one block;
+  // potential and field are written straight into the caller's arrays.
+  void doFFT(const float* density,
+             float* electroPhi,
+             float* electroForceX,
+             float* electroForceY);
 
  private:
-  // 2D array; width: binCntX_, height: binCntY_;
-  // No hope to use Vector at this moment...
-  float** binDensity_;
-  float** electroPhi_;
-  float** electroForceX_;
-  float** electroForceY_;
+  // transform buffer; binCntX_ * binCntY_ floats, x-major
+  std::vector<float> binDensity_;
+
+  // row pointers handed to the 2D Ooura routines.
+  // binDensityRows_ is fixed, the others are rebound on each doFFT.
+  std::vector<float*> binDensityRows_;
+  std::vector<float*> electroPhiRows_;
+  std::vector<float*> electroForceXRows_;
+  std::vector<float*> electroForceYRows_;
 
   // cos/sin table (prev: w_2d)
   // length:  max(binCntX, binCntY) * 3 / 2
@@ -82,6 +94,9 @@ class FFT
   int binCntY_;
   int binSizeX_;
   int binSizeY_;
+  int numThreads_;
+  bool useLegacy_;
+  std::unique_ptr<Dct2D> dct_;
 
   void init();
 };
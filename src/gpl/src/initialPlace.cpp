@@ -33,6 +33,7 @@
 
 #include "initialPlace.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "placerBase.h"
@@ -57,6 +58,8 @@ void InitialPlaceVars::reset()
   netWeightScale = 800.0;
   debug = false;
   forceCPU = false;
+  numThreads = 1;
+  useIncompleteCholesky = false;
 }
 
 InitialPlace::InitialPlace() : pbc_(nullptr), log_(nullptr)
@@ -82,7 +85,7 @@ void InitialPlace::reset()
   ipVars_.reset();
 }
 
-void InitialPlace::doBicgstabPlace()
+void InitialPlace::doInitialPlace()
 {
   ResidualError error;
   bool run_cpu = true;
@@ -131,6 +134,8 @@ void InitialPlace::doBicgstabPlace()
                              placeInstForceMatrixY_,
                              fixedInstForceVecY_,
                              instLocVecY_,
+                             ipVars_.numThreads,
+                             ipVars_.useIncompleteCholesky,
                              log_);
     }
     float error_max = max(error.x, error.y);
@@ -259,9 +264,6 @@ void InitialPlace::createSparseMatrix()
   instLocVecY_.resize(placeCnt);
   fixedInstForceVecY_.resize(placeCnt);
 
-  placeInstForceMatrixX_.resize(placeCnt, placeCnt);
-  placeInstForceMatrixY_.resize(placeCnt, placeCnt);
-
   //
   // listX and listY is a temporary vector that have tuples, (idx1, idx2, val)
   //
@@ -430,8 +432,50 @@ void InitialPlace::createSparseMatrix()
     }
   }
 
-  placeInstForceMatrixX_.setFromTriplets(listX.begin(), listX.end());
-  placeInstForceMatrixY_.setFromTriplets(listY.begin(), listY.end());
+  fillSparseMatrix(listX, placeInstForceMatrixX_, patternX_);
+  fillSparseMatrix(listY, placeInstForceMatrixY_, patternY_);
+}
+
+void InitialPlace::fillSparseMatrix(const vector<T>& list,
+                                    SMatrix& matrix,
+                                    TripletPattern& pattern)
+{
+  const int placeCnt = pbc_->placeInsts().size();
+
+  bool samePattern = matrix.rows() == placeCnt
+                     && pattern.rows.size() == list.size();
+  for (size_t i = 0; samePattern && i < list.size(); i++) {
+    samePattern = pattern.rows[i] == list[i].row()
+                  && pattern.cols[i] == list[i].col();
+  }
+
+  // duplicates are summed in triplet order, as setFromTriplets does
+  if (samePattern) {
+    float* values = matrix.valuePtr();
+    std::fill(values, values + matrix.nonZeros(), 0.0f);
+    for (size_t i = 0; i < list.size(); i++) {
+      values[pattern.slots[i]] += list[i].value();
+    }
+    return;
+  }
+
+  matrix.resize(placeCnt, placeCnt);
+  matrix.setFromTriplets(list.begin(), list.end());
+
+  pattern.rows.resize(list.size());
+  pattern.cols.resize(list.size());
+  pattern.slots.resize(list.size());
+  const int* outer = matrix.outerIndexPtr();
+  const int* inner = matrix.innerIndexPtr();
+  for (size_t i = 0; i < list.size(); i++) {
+    const int row = list[i].row();
+    const int col = list[i].col();
+    pattern.rows[i] = row;
+    pattern.cols[i] = col;
+    pattern.slots[i]
+        = std::lower_bound(inner + outer[row], inner + outer[row + 1], col)
+          - inner;
+  }
 }
 
 void InitialPlace::updateCoordi()
@@ -35,6 +35,7 @@
 
 #include <Eigen/SparseCore>
 #include <memory>
+#include <vector>
 
 #include "nesterovPlace.h"
 #include "odb/db.h"
@@ -59,6 +60,8 @@ class InitialPlaceVars
   float netWeightScale;
   bool debug;
   bool forceCPU;
+  int numThreads;
+  bool useIncompleteCholesky;
 
   InitialPlaceVars();
   void reset();
@@ -66,6 +69,15 @@ class InitialPlaceVars
 
 typedef Eigen::SparseMatrix<float, Eigen::RowMajor> SMatrix;
 
+// Layout of a matrix built from triplets: the (row, col) of every triplet
+// and the slot of its value in the compressed matrix.
+struct TripletPattern
+{
+  std::vector<int> rows;
+  std::vector<int> cols;
+  std::vector<int> slots;
+};
+
 class InitialPlace
 {
  public:
@@ -75,7 +87,7 @@ class InitialPlace
                std::vector<std::shared_ptr<PlacerBase>>& pbVec,
                utl::Logger* logger);
   ~InitialPlace();
-  void doBicgstabPlace();
+  void doInitialPlace();
 
  private:
   InitialPlaceVars ipVars_;
@@ -107,16 +119,23 @@ class InitialPlace
   //        SparseMatrix that contains connectivity forces on Y // B2B model is
   //        used
   //
-  // Used the interative BiCGSTAB solver to solve matrix eqs.
+  // Used the preconditioned CG solver to solve matrix eqs.
 
   Eigen::VectorXf instLocVecX_, fixedInstForceVecX_;
   Eigen::VectorXf instLocVecY_, fixedInstForceVecY_;
   SMatrix placeInstForceMatrixX_, placeInstForceMatrixY_;
 
+  // B2B matrices often keep their sparsity pattern between iterations;
+  // their compressed storage is then refilled in place.
+  TripletPattern patternX_, patternY_;
+
   void placeInstsCenter();
   void setPlaceInstExtId();
   void updatePinInfo();
   void createSparseMatrix();
+  void fillSparseMatrix(const std::vector<Eigen::Triplet<float>>& list,
+                        SMatrix& matrix,
+                        TripletPattern& pattern);
   void updateCoordi();
   void reset();
 };
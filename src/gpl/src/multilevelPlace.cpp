@@ -0,0 +1,323 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018-2020, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "multilevelPlace.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "nesterovPlace.h"
+#include "placerBase.h"
+#include "utl/Logger.h"
+
+namespace gpl {
+
+using utl::GPL;
+
+MultilevelPlaceVars::MultilevelPlaceVars()
+{
+  reset();
+}
+
+void MultilevelPlaceVars::reset()
+{
+  maxLevels = 0;
+  minClusters = 1000;
+  minReductionRatio = 0.1;
+  maxClusterAreaRatio = 4.0;
+  maxFanout = 50;
+  coarseTargetOverflow = 0.3;
+}
+
+MultilevelPlace::MultilevelPlace(
+    const MultilevelPlaceVars& mlVars,
+    const NesterovBaseVars& nbVars,
+    const NesterovPlaceVars& npVars,
+    std::shared_ptr<PlacerBaseCommon> pbc,
+    std::vector<std::shared_ptr<PlacerBase>>& pbVec,
+    utl::Logger* log)
+    : mlVars_(mlVars),
+      nbVars_(nbVars),
+      npVars_(npVars),
+      pbc_(std::move(pbc)),
+      pbVec_(pbVec),
+      log_(log)
+{
+  // coarse levels only have to spread the clusters roughly;
+  // timing and routability are left to the flat placement.
+  npVars_.targetOverflow
+      = std::max(npVars_.targetOverflow, mlVars_.coarseTargetOverflow);
+  npVars_.timingDrivenMode = false;
+  npVars_.routabilityDrivenMode = false;
+  npVars_.debug = false;
+  // the levels only move the place instances; odb gets the flat result
+  npVars_.updateDb = false;
+}
+
+void MultilevelPlace::doMultilevelPlace()
+{
+  std::vector<int> regions;
+  std::vector<std::vector<Cluster>> levels;
+
+  std::vector<Cluster> clusters = initClusters(regions);
+  for (int level = 1; level <= mlVars_.maxLevels; level++) {
+    std::vector<Cluster> coarse = coarsen(clusters, regions);
+    const int numCoarse = coarse.size();
+    if (numCoarse < mlVars_.minClusters
+        || numCoarse > clusters.size() * (1.0 - mlVars_.minReductionRatio)) {
+      log_->info(GPL,
+                 310,
+                 "Multilevel: coarsening stopped at level {} with {} clusters.",
+                 level,
+                 numCoarse);
+      break;
+    }
+    log_->info(GPL,
+               309,
+               "Multilevel: level {} has {} clusters.",
+               level,
+               numCoarse);
+    clusters = coarse;
+    levels.push_back(std::move(coarse));
+  }
+
+  if (levels.empty()) {
+    log_->info(GPL, 311, "Multilevel: no coarse level, skipping.");
+    return;
+  }
+
+  // Nesterov locks the converged instances; only the
+  // instances locked by the caller may stay locked.
+  std::vector<Instance*> unlockedInsts;
+  for (auto& pb : pbVec_) {
+    for (Instance* inst : pb->placeInsts()) {
+      if (!inst->isLocked()) {
+        unlockedInsts.push_back(inst);
+      }
+    }
+  }
+
+  for (int level = levels.size(); level >= 1; level--) {
+    placeLevel(level, levels[level - 1]);
+    for (Instance* inst : unlockedInsts) {
+      inst->unlock();
+    }
+  }
+}
+
+std::vector<MultilevelPlace::Cluster> MultilevelPlace::initClusters(
+    std::vector<int>& regions) const
+{
+  std::unordered_map<Instance*, int> instRegion;
+  for (size_t i = 0; i < pbVec_.size(); i++) {
+    for (Instance* inst : pbVec_[i]->placeInsts()) {
+      instRegion[inst] = i;
+    }
+  }
+
+  // macros and locked instances are never clustered
+  std::vector<Cluster> clusters;
+  clusters.reserve(pbc_->placeInsts().size());
+  regions.clear();
+  regions.reserve(pbc_->placeInsts().size());
+  for (Instance* inst : pbc_->placeInsts()) {
+    clusters.push_back({inst});
+    auto it = instRegion.find(inst);
+    const bool fixed = it == instRegion.end() || inst->isMacro()
+                       || inst->isLocked();
+    regions.push_back(fixed ? -1 : it->second);
+  }
+  return clusters;
+}
+
+std::vector<MultilevelPlace::Cluster> MultilevelPlace::coarsen(
+    const std::vector<Cluster>& clusters,
+    std::vector<int>& regions) const
+{
+  const int numClusters = clusters.size();
+
+  std::unordered_map<Instance*, int> instToCluster;
+  std::vector<int64_t> areas(numClusters, 0);
+  int64_t totalArea = 0;
+  int numMergeable = 0;
+  for (int c = 0; c < numClusters; c++) {
+    for (Instance* inst : clusters[c]) {
+      instToCluster[inst] = c;
+      areas[c] += inst->area();
+    }
+    if (regions[c] >= 0) {
+      totalArea += areas[c];
+      numMergeable++;
+    }
+  }
+
+  if (numMergeable == 0) {
+    return clusters;
+  }
+
+  const double maxArea
+      = mlVars_.maxClusterAreaRatio * totalArea / numMergeable;
+
+  // Heavy-edge matching: the small clusters pick first and merge with the
+  // unmatched neighbor of the best connectivity per area.
+  std::vector<int> order(numClusters);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return areas[a] < areas[b];
+  });
+
+  std::vector<int> match(numClusters, -1);
+  std::vector<float> scores(numClusters, 0);
+  std::vector<int> touched;
+  int numCoarse = 0;
+
+  for (int u : order) {
+    if (match[u] != -1) {
+      continue;
+    }
+    match[u] = numCoarse++;
+    if (regions[u] < 0) {
+      continue;
+    }
+
+    touched.clear();
+    for (Instance* inst : clusters[u]) {
+      for (Pin* pin : inst->pins()) {
+        Net* net = pin->net();
+        if (!net) {
+          continue;
+        }
+        const int degree = net->pins().size();
+        if (degree < 2 || degree > mlVars_.maxFanout) {
+          continue;
+        }
+        const float weight = 1.0f / (degree - 1);
+        for (Pin* otherPin : net->pins()) {
+          Instance* otherInst = otherPin->instance();
+          if (!otherInst) {
+            continue;
+          }
+          auto it = instToCluster.find(otherInst);
+          if (it == instToCluster.end()) {
+            continue;
+          }
+          const int v = it->second;
+          if (v == u || match[v] != -1 || regions[v] != regions[u]) {
+            continue;
+          }
+          if (scores[v] == 0) {
+            touched.push_back(v);
+          }
+          scores[v] += weight;
+        }
+      }
+    }
+
+    int best = -1;
+    double bestScore = 0;
+    for (int v : touched) {
+      const double area = areas[u] + areas[v];
+      if (area <= maxArea) {
+        const double score = scores[v] / std::max(area, 1.0);
+        if (score > bestScore) {
+          bestScore = score;
+          best = v;
+        }
+      }
+      scores[v] = 0;
+    }
+
+    if (best != -1) {
+      match[best] = match[u];
+    }
+  }
+
+  std::vector<Cluster> coarse(numCoarse);
+  std::vector<int> coarseRegions(numCoarse, -1);
+  for (int c = 0; c < numClusters; c++) {
+    Cluster& cluster = coarse[match[c]];
+    cluster.insert(cluster.end(), clusters[c].begin(), clusters[c].end());
+    coarseRegions[match[c]] = regions[c];
+  }
+  regions = std::move(coarseRegions);
+  return coarse;
+}
+
+void MultilevelPlace::placeLevel(int level,
+                                 const std::vector<Cluster>& clusters)
+{
+  std::shared_ptr<NesterovBaseCommon> nbc
+      = std::make_shared<NesterovBaseCommon>(nbVars_, pbc_, log_, clusters);
+
+  // member offsets from the cluster centers, kept through the placement
+  std::vector<int> offsetX;
+  std::vector<int> offsetY;
+  offsetX.reserve(pbc_->placeInsts().size());
+  offsetY.reserve(pbc_->placeInsts().size());
+  for (const Cluster& cluster : clusters) {
+    const GCell* gCell = nbc->pbToNb(cluster.front());
+    for (Instance* inst : cluster) {
+      offsetX.push_back(inst->cx() - gCell->dCx());
+      offsetY.push_back(inst->cy() - gCell->dCy());
+    }
+  }
+
+  std::vector<std::shared_ptr<NesterovBase>> nbVec;
+  for (const auto& pb : pbVec_) {
+    nbVec.push_back(std::make_shared<NesterovBase>(nbVars_, pb, nbc, log_));
+  }
+
+  NesterovPlace np(npVars_, pbc_, nbc, pbVec_, nbVec, nullptr, nullptr, log_);
+  np.doNesterovPlace();
+
+  // uncluster: move the members along with their cluster
+  int k = 0;
+  for (const Cluster& cluster : clusters) {
+    const GCell* gCell = nbc->pbToNb(cluster.front());
+    for (Instance* inst : cluster) {
+      inst->setCenterLocation(gCell->dCx() + offsetX[k],
+                              gCell->dCy() + offsetY[k]);
+      k++;
+    }
+  }
+
+  log_->info(GPL,
+             312,
+             "Multilevel: level {} placed, HPWL: {}",
+             level,
+             nbc->getHpwl());
+}
+
+}  // namespace gpl
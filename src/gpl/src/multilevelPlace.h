@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018-2020, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "nesterovBase.h"
+
+namespace utl {
+class Logger;
+}
+
+namespace gpl {
+
+class PlacerBaseCommon;
+class PlacerBase;
+class Instance;
+
+class MultilevelPlaceVars
+{
+ public:
+  // number of coarse levels; 0 disables the multilevel flow
+  int maxLevels;
+  // stop coarsening once a level holds fewer clusters than this
+  int minClusters;
+  // stop coarsening once a level removes less than this ratio of clusters
+  float minReductionRatio;
+  // a cluster may grow to this multiple of the level's average cluster area
+  float maxClusterAreaRatio;
+  // nets with more pins are ignored when scoring neighbors
+  int maxFanout;
+  // coarse levels stop at this density overflow
+  float coarseTargetOverflow;
+
+  MultilevelPlaceVars();
+  void reset();
+};
+
+// V-cycle global placement.
+//
+// The netlist is clustered by heavy-edge matching into a hierarchy of levels.
+// Starting from the coarsest level, every level is placed by Nesterov with
+// each cluster as one GCell. The clusters are then expanded, moving their
+// members by the cluster's displacement, to seed the next finer level.
+// The flat Nesterov placement afterwards refines the finest level.
+class MultilevelPlace
+{
+ public:
+  MultilevelPlace(const MultilevelPlaceVars& mlVars,
+                  const NesterovBaseVars& nbVars,
+                  const NesterovPlaceVars& npVars,
+                  std::shared_ptr<PlacerBaseCommon> pbc,
+                  std::vector<std::shared_ptr<PlacerBase>>& pbVec,
+                  utl::Logger* log);
+
+  // Leaves the place instances at the refined coarse locations.
+  // The odb instances are not moved.
+  void doMultilevelPlace();
+
+ private:
+  using Cluster = std::vector<Instance*>;
+
+  MultilevelPlaceVars mlVars_;
+  NesterovBaseVars nbVars_;
+  NesterovPlaceVars npVars_;
+  std::shared_ptr<PlacerBaseCommon> pbc_;
+  std::vector<std::shared_ptr<PlacerBase>> pbVec_;
+  utl::Logger* log_;
+
+  // clusters of the finest level are the place instances themselves
+  std::vector<Cluster> initClusters(std::vector<int>& regions) const;
+
+  // Merges pairs of connected clusters of the same region.
+  // regions is updated for the coarser level.
+  std::vector<Cluster> coarsen(const std::vector<Cluster>& clusters,
+                               std::vector<int>& regions) const;
+
+  void placeLevel(int level, const std::vector<Cluster>& clusters);
+};
+
+}  // namespace gpl
@@ -34,6 +34,7 @@
 #include "nesterovBase.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <random>
 #include <utility>
@@ -152,6 +153,29 @@ void GCell::setFiller()
 void GCell::setClusteredInstance(const std::vector<Instance*>& insts)
 {
   insts_ = insts;
+  if (insts_.empty()) {
+    return;
+  }
+
+  // A cluster is modeled as a square of its members' total area,
+  // centered at their area-weighted centroid.
+  double sumArea = 0;
+  double sumCx = 0;
+  double sumCy = 0;
+  for (Instance* inst : insts_) {
+    const double area = std::max<int64_t>(inst->area(), 1);
+    sumArea += area;
+    sumCx += area * inst->cx();
+    sumCy += area * inst->cy();
+  }
+
+  const int cx = static_cast<int>(sumCx / sumArea);
+  const int cy = static_cast<int>(sumCy / sumArea);
+  const int side = static_cast<int>(std::ceil(std::sqrt(sumArea)));
+  dLx_ = lx_ = cx - side / 2;
+  dLy_ = ly_ = cy - side / 2;
+  dUx_ = ux_ = lx_ + side;
+  dUy_ = uy_ = ly_ + side;
 }
 
 void GCell::setLocation(int lx, int ly)
@@ -274,6 +298,10 @@ bool GCell::isMacroInstance() const
 
 bool GCell::isStdInstance() const
 {
+  // clusters are only formed from standard cells
+  if (insts_.size() > 1) {
+    return true;
+  }
   if (!isInstance()) {
     return false;
   }
@@ -290,14 +318,6 @@ GNet::GNet()
       uy_(0),
       timingWeight_(1),
       customWeight_(1),
-      waExpMinSumX_(0),
-      waXExpMinSumX_(0),
-      waExpMaxSumX_(0),
-      waXExpMaxSumX_(0),
-      waExpMinSumY_(0),
-      waYExpMinSumY_(0),
-      waExpMaxSumY_(0),
-      waYExpMaxSumY_(0),
       isDontCare_(0)
 {
 }
@@ -351,6 +371,14 @@ void GNet::updateBox()
   }
 }
 
+void GNet::setBox(int lx, int ly, int ux, int uy)
+{
+  lx_ = lx;
+  ly_ = ly;
+  ux_ = ux;
+  uy_ = uy;
+}
+
 int64_t GNet::hpwl() const
 {
   if (ux_ < lx_) {  // dangling net
@@ -363,21 +391,6 @@ int64_t GNet::hpwl() const
   return (ux - lx) + (uy - ly);
 }
 
-void GNet::clearWaVars()
-{
-  waExpMinSumX_ = 0;
-  waXExpMinSumX_ = 0;
-
-  waExpMaxSumX_ = 0;
-  waXExpMaxSumX_ = 0;
-
-  waExpMinSumY_ = 0;
-  waYExpMinSumY_ = 0;
-
-  waExpMaxSumY_ = 0;
-  waYExpMaxSumY_ = 0;
-}
-
 void GNet::setDontCare()
 {
   isDontCare_ = 1;
@@ -397,15 +410,7 @@ GPin::GPin()
       offsetCx_(0),
       offsetCy_(0),
       cx_(0),
-      cy_(0),
-      maxExpSumX_(0),
-      maxExpSumY_(0),
-      minExpSumX_(0),
-      minExpSumY_(0),
-      hasMaxExpSumX_(0),
-      hasMaxExpSumY_(0),
-      hasMinExpSumX_(0),
-      hasMinExpSumY_(0)
+      cy_(0)
 {
 }
 
@@ -445,45 +450,16 @@ void GPin::setGNet(GNet* gNet)
   gNet_ = gNet;
 }
 
-void GPin::setCenterLocation(int cx, int cy)
-{
-  cx_ = cx;
-  cy_ = cy;
-}
-
-void GPin::clearWaVars()
-{
-  hasMaxExpSumX_ = 0;
-  hasMaxExpSumY_ = 0;
-  hasMinExpSumX_ = 0;
-  hasMinExpSumY_ = 0;
-
-  maxExpSumX_ = maxExpSumY_ = 0;
-  minExpSumX_ = minExpSumY_ = 0;
-}
-
-void GPin::setMaxExpSumX(float maxExpSumX)
-{
-  hasMaxExpSumX_ = 1;
-  maxExpSumX_ = maxExpSumX;
-}
-
-void GPin::setMaxExpSumY(float maxExpSumY)
+void GPin::setOffset(int offsetCx, int offsetCy)
 {
-  hasMaxExpSumY_ = 1;
-  maxExpSumY_ = maxExpSumY;
+  offsetCx_ = offsetCx;
+  offsetCy_ = offsetCy;
 }
 
-void GPin::setMinExpSumX(float minExpSumX)
-{
-  hasMinExpSumX_ = 1;
-  minExpSumX_ = minExpSumX;
-}
-
-void GPin::setMinExpSumY(float minExpSumY)
+void GPin::setCenterLocation(int cx, int cy)
 {
-  hasMinExpSumY_ = 1;
-  minExpSumY_ = minExpSumY;
+  cx_ = cx;
+  cy_ = cy;
 }
 
 void GPin::updateLocation(const GCell* gCell)
@@ -513,15 +489,20 @@ Bin::Bin()
       instPlacedAreaUnscaled_(0),
       nonPlaceAreaUnscaled_(0),
       fillerArea_(0),
-      density_(0),
       targetDensity_(0),
-      electroPhi_(0),
-      electroForceX_(0),
-      electroForceY_(0)
+      grid_(nullptr),
+      mapIdx_(0)
 {
 }
 
-Bin::Bin(int x, int y, int lx, int ly, int ux, int uy, float targetDensity)
+Bin::Bin(int x,
+         int y,
+         int lx,
+         int ly,
+         int ux,
+         int uy,
+         float targetDensity,
+         BinGrid* grid)
     : Bin()
 {
   x_ = x;
@@ -531,6 +512,8 @@ Bin::Bin(int x, int y, int lx, int ly, int ux, int uy, float targetDensity)
   ux_ = ux;
   uy_ = uy;
   targetDensity_ = targetDensity;
+  grid_ = grid;
+  mapIdx_ = x * grid->binCntY() + y;
 }
 
 Bin::~Bin()
@@ -539,8 +522,9 @@ Bin::~Bin()
   lx_ = ly_ = ux_ = uy_ = 0;
   nonPlaceArea_ = instPlacedArea_ = fillerArea_ = nonPlaceAreaUnscaled_
       = instPlacedAreaUnscaled_ = 0;
-  electroPhi_ = electroForceX_ = electroForceY_ = 0;
-  density_ = targetDensity_ = 0;
+  targetDensity_ = 0;
+  grid_ = nullptr;
+  mapIdx_ = 0;
 }
 
 const int64_t Bin::binArea() const
@@ -550,7 +534,7 @@ const int64_t Bin::binArea() const
 
 float Bin::density() const
 {
-  return density_;
+  return grid_->densityMap()[mapIdx_];
 }
 
 float Bin::targetDensity() const
@@ -560,22 +544,22 @@ float Bin::targetDensity() const
 
 float Bin::electroForceX() const
 {
-  return electroForceX_;
+  return grid_->electroForceXMap()[mapIdx_];
 }
 
 float Bin::electroForceY() const
 {
-  return electroForceY_;
+  return grid_->electroForceYMap()[mapIdx_];
 }
 
 float Bin::electroPhi() const
 {
-  return electroPhi_;
+  return grid_->electroPhiMap()[mapIdx_];
 }
 
 void Bin::setDensity(float density)
 {
-  density_ = density;
+  grid_->densityMap()[mapIdx_] = density;
 }
 
 void Bin::setTargetDensity(float density)
@@ -585,13 +569,13 @@ void Bin::setTargetDensity(float density)
 
 void Bin::setElectroForce(float electroForceX, float electroForceY)
 {
-  electroForceX_ = electroForceX;
-  electroForceY_ = electroForceY;
+  grid_->electroForceXMap()[mapIdx_] = electroForceX;
+  grid_->electroForceYMap()[mapIdx_] = electroForceY;
 }
 
 void Bin::setElectroPhi(float phi)
 {
-  electroPhi_ = phi;
+  grid_->electroPhiMap()[mapIdx_] = phi;
 }
 
 ////////////////////////////////////////////////
@@ -610,6 +594,7 @@ BinGrid::BinGrid()
       targetDensity_(0),
       overflowArea_(0),
       overflowAreaUnscaled_(0),
+      numThreads_(1),
       isSetBinCnt_(0)
 {
 }
@@ -622,6 +607,11 @@ BinGrid::BinGrid(Die* die) : BinGrid()
 BinGrid::~BinGrid()
 {
   bins_.clear();
+  density_.clear();
+  electroPhi_.clear();
+  electroForceX_.clear();
+  electroForceY_.clear();
+  cellRows_.clear();
   binCntX_ = binCntY_ = 0;
   binSizeX_ = binSizeY_ = 0;
   isSetBinCnt_ = 0;
@@ -792,8 +782,14 @@ void BinGrid::initBins()
 
   log_->info(GPL, 29, "BinSize: {} {}", binSizeX_, binSizeY_);
 
-  // initialize bins_ vector
-  bins_.reserve(binCntX_ * (size_t) binCntY_);
+  // initialize the maps backing the bins, then the bins_ vector
+  const size_t numBins = binCntX_ * (size_t) binCntY_;
+  density_.assign(numBins, 0.0f);
+  electroPhi_.assign(numBins, 0.0f);
+  electroForceX_.assign(numBins, 0.0f);
+  electroForceY_.assign(numBins, 0.0f);
+
+  bins_.reserve(numBins);
   for (int idxY = 0; idxY < binCntY_; ++idxY) {
     for (int idxX = 0; idxX < binCntX_; ++idxX) {
       const int x = lx_ + idxX * binSizeX_;
@@ -802,7 +798,7 @@ void BinGrid::initBins()
       const int sizeY = std::min(uy_ - y, binSizeY_);
 
       bins_.emplace_back(
-          idxX, idxY, x, y, x + sizeX, y + sizeY, targetDensity_);
+          idxX, idxY, x, y, x + sizeX, y + sizeY, targetDensity_, this);
     }
   }
 
@@ -853,64 +849,96 @@ void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
     bin.setFillerArea(0);
   }
 
-  for (auto& cell : cells) {
-    std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
-    std::pair<int, int> pairY = getDensityMinMaxIdxY(cell);
+  const int numCells = static_cast<int>(cells.size());
+  cellRows_.resize(numCells);
+#pragma omp parallel for num_threads(numThreads_)
+  for (int c = 0; c < numCells; c++) {
+    cellRows_[c] = getDensityMinMaxIdxY(cells[c]);
+  }
+
+  // Row-striped scatter: each stripe owns a band of bin rows and adds
+  // only the overlaps that fall inside it, visiting cells in order.
+  // Every bin is written by exactly one stripe, and the areas are
+  // accumulated as int64, so the result matches the serial loop.
+  const int numStripes = std::max(1, std::min(numThreads_, binCntY_));
+#pragma omp parallel for num_threads(numThreads_) schedule(static, 1)
+  for (int stripe = 0; stripe < numStripes; stripe++) {
+    const int rowLo = static_cast<int>(int64_t(binCntY_) * stripe / numStripes);
+    const int rowHi
+        = static_cast<int>(int64_t(binCntY_) * (stripe + 1) / numStripes);
+
+    for (int c = 0; c < numCells; c++) {
+      const int jLo = std::max(cellRows_[c].first, rowLo);
+      const int jHi = std::min(cellRows_[c].second, rowHi);
+      if (jLo >= jHi) {
+        continue;
+      }
 
-    // The following function is critical runtime hotspot
-    // for global placer.
-    //
-    if (cell->isInstance()) {
-      // macro should have
-      // scale-down with target-density
-      if (cell->isMacroInstance()) {
-        for (int i = pairX.first; i < pairX.second; i++) {
-          for (int j = pairY.first; j < pairY.second; j++) {
-            Bin& bin = bins_[j * binCntX_ + i];
+      const GCell* cell = cells[c];
+      std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
 
-            const float scaledAvea = getOverlapDensityArea(bin, cell)
-                                     * cell->densityScale()
-                                     * bin.targetDensity();
-            bin.addInstPlacedArea(scaledAvea);
-            bin.addInstPlacedAreaUnscaled(scaledAvea);
+      // The following function is critical runtime hotspot
+      // for global placer.
+      //
+      if (cell->isClusteredInstance()) {
+        // macro should have
+        // scale-down with target-density
+        if (cell->isMacroInstance()) {
+          for (int i = pairX.first; i < pairX.second; i++) {
+            for (int j = jLo; j < jHi; j++) {
+              Bin& bin = bins_[j * binCntX_ + i];
+
+              const float scaledAvea = getOverlapDensityArea(bin, cell)
+                                       * cell->densityScale()
+                                       * bin.targetDensity();
+              bin.addInstPlacedArea(scaledAvea);
+              bin.addInstPlacedAreaUnscaled(scaledAvea);
+            }
           }
         }
-      }
-      // normal cells
-      else if (cell->isStdInstance()) {
+        // normal cells
+        else if (cell->isStdInstance()) {
+          for (int i = pairX.first; i < pairX.second; i++) {
+            for (int j = jLo; j < jHi; j++) {
+              Bin& bin = bins_[j * binCntX_ + i];
+              const float scaledArea
+                  = getOverlapDensityArea(bin, cell) * cell->densityScale();
+              bin.addInstPlacedArea(scaledArea);
+              bin.addInstPlacedAreaUnscaled(scaledArea);
+            }
+          }
+        }
+      } else if (cell->isFiller()) {
         for (int i = pairX.first; i < pairX.second; i++) {
-          for (int j = pairY.first; j < pairY.second; j++) {
+          for (int j = jLo; j < jHi; j++) {
             Bin& bin = bins_[j * binCntX_ + i];
-            const float scaledArea
-                = getOverlapDensityArea(bin, cell) * cell->densityScale();
-            bin.addInstPlacedArea(scaledArea);
-            bin.addInstPlacedAreaUnscaled(scaledArea);
+            bin.addFillerArea(getOverlapDensityArea(bin, cell)
+                              * cell->densityScale());
           }
         }
       }
-    } else if (cell->isFiller()) {
-      for (int i = pairX.first; i < pairX.second; i++) {
-        for (int j = pairY.first; j < pairY.second; j++) {
-          Bin& bin = bins_[j * binCntX_ + i];
-          bin.addFillerArea(getOverlapDensityArea(bin, cell)
-                            * cell->densityScale());
-        }
-      }
     }
   }
 
-  overflowArea_ = 0;
-  overflowAreaUnscaled_ = 0;
-  // update density and overflowArea
-  // for nesterov use and FFT library
-  for (Bin& bin : bins_) {
-    int64_t binArea = bin.binArea();
+  // update density for nesterov use and FFT library
+  const int numBins = static_cast<int>(bins_.size());
+#pragma omp parallel for num_threads(numThreads_)
+  for (int b = 0; b < numBins; b++) {
+    Bin& bin = bins_[b];
     const float scaledBinArea
-        = static_cast<float>(binArea * bin.targetDensity());
+        = static_cast<float>(bin.binArea() * bin.targetDensity());
     bin.setDensity((static_cast<float>(bin.instPlacedArea())
                     + static_cast<float>(bin.fillerArea())
                     + static_cast<float>(bin.nonPlaceArea()))
                    / scaledBinArea);
+  }
+
+  // overflowArea is summed serially to keep the accumulation order
+  overflowArea_ = 0;
+  overflowAreaUnscaled_ = 0;
+  for (const Bin& bin : bins_) {
+    const float scaledBinArea
+        = static_cast<float>(bin.binArea() * bin.targetDensity());
 
     overflowArea_ += std::max(0.0f,
                               static_cast<float>(bin.instPlacedArea())
@@ -980,6 +1008,8 @@ void NesterovBaseVars::reset()
   minWireLengthForceBar = -300;
   isSetBinCnt = 0;
   useUniformTargetDensity = 0;
+  useLegacyFFT = 1;
+  numThreads = 1;
 }
 
 ////////////////////////////////////////////////
@@ -1010,6 +1040,9 @@ void NesterovPlaceVars::reset()
   debug_update_iterations = 10;
   debug_draw_bins = true;
   debug_inst = nullptr;
+  updateDb = true;
+  checkpointFile.clear();
+  checkpointOverflows.clear();
 }
 
 ////////////////////////////////////////////////
@@ -1028,7 +1061,20 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
   nbVars_ = nbVars;
   pbc_ = std::move(pbc);
   log_ = log;
-  init();
+  init({});
+}
+
+NesterovBaseCommon::NesterovBaseCommon(
+    NesterovBaseVars nbVars,
+    std::shared_ptr<PlacerBaseCommon> pbc,
+    utl::Logger* log,
+    const std::vector<std::vector<Instance*>>& clusters)
+    : NesterovBaseCommon()
+{
+  nbVars_ = nbVars;
+  pbc_ = std::move(pbc);
+  log_ = log;
+  init(clusters);
 }
 
 NesterovBaseCommon::~NesterovBaseCommon()
@@ -1062,15 +1108,34 @@ void NesterovBaseCommon::reset()
 
   gNets_.shrink_to_fit();
   gPins_.shrink_to_fit();
+
+  waNetPinStart_.clear();
+  waPinSlot_.clear();
+  waSlotNet_.clear();
+  waSlotX_.clear();
+  waSlotY_.clear();
 }
 
-void NesterovBaseCommon::init()
+void NesterovBaseCommon::init(
+    const std::vector<std::vector<Instance*>>& clusters)
 {
   // gCellStor init
-  gCellStor_.reserve(pbc_->placeInsts().size());
+  if (clusters.empty()) {
+    gCellStor_.reserve(pbc_->placeInsts().size());
+
+    for (auto& inst : pbc_->placeInsts()) {
+      gCellStor_.push_back(GCell(inst));
+    }
+  } else {
+    gCellStor_.reserve(clusters.size());
 
-  for (auto& inst : pbc_->placeInsts()) {
-    gCellStor_.push_back(GCell(inst));
+    for (auto& cluster : clusters) {
+      if (cluster.size() == 1) {
+        gCellStor_.push_back(GCell(cluster[0]));
+      } else {
+        gCellStor_.push_back(GCell(cluster));
+      }
+    }
   }
 
   // TODO:
@@ -1094,11 +1159,13 @@ void NesterovBaseCommon::init()
   // gCell ptr init
   gCells_.reserve(gCellStor_.size());
   for (auto& gCell : gCellStor_) {
-    if (!gCell.isInstance()) {
+    if (!gCell.isClusteredInstance()) {
       continue;
     }
     gCells_.push_back(&gCell);
-    gCellMap_[gCell.instance()] = &gCell;
+    for (Instance* inst : gCell.insts()) {
+      gCellMap_[inst] = &gCell;
+    }
   }
 
   // gPin ptr init
@@ -1121,15 +1188,23 @@ void NesterovBaseCommon::init()
       continue;
     }
 
-    for (auto& pin : gCell.instance()->pins()) {
-      gCell.addGPin(pbToNb(pin));
+    for (Instance* inst : gCell.insts()) {
+      for (auto& pin : inst->pins()) {
+        gCell.addGPin(pbToNb(pin));
+      }
     }
   }
 
   // gPinStor_' GNet and GCell fill
   for (auto& gPin : gPinStor_) {
-    gPin.setGCell(pbToNb(gPin.pin()->instance()));
+    GCell* gCell = pbToNb(gPin.pin()->instance());
+    gPin.setGCell(gCell);
     gPin.setGNet(pbToNb(gPin.pin()->net()));
+
+    // pins of a cluster sit on its center
+    if (gCell && gCell->insts().size() > 1) {
+      gPin.setOffset(0, 0);
+    }
   }
 
   // gNetStor_'s GPin fill
@@ -1138,6 +1213,8 @@ void NesterovBaseCommon::init()
       gNet.addGPin(pbToNb(pin));
     }
   }
+
+  initWaArrays();
 }
 
 GCell* NesterovBaseCommon::pbToNb(Instance* inst) const
@@ -1182,101 +1259,133 @@ GNet* NesterovBaseCommon::dbToNb(odb::dbNet* net) const
   return pbToNb(pbNet);
 }
 
+// Build the flat WA arrays (see nesterovBase.h)
+void NesterovBaseCommon::initWaArrays()
+{
+  const int numNets = static_cast<int>(gNets_.size());
+  waNetPinStart_.clear();
+  waNetPinStart_.reserve(numNets + 1);
+  waNetPinStart_.push_back(0);
+  waPinSlot_.assign(gPinStor_.size(), -1);
+  waSlotNet_.clear();
+  waSlotX_.clear();
+  waSlotY_.clear();
+  for (int netIdx = 0; netIdx < numNets; netIdx++) {
+    for (const GPin* gPin : gNets_[netIdx]->gPins()) {
+      waPinSlot_[pinIndex(gPin)] = static_cast<int>(waSlotNet_.size());
+      waSlotNet_.push_back(netIdx);
+      waSlotX_.push_back(gPin->cx());
+      waSlotY_.push_back(gPin->cy());
+    }
+    waNetPinStart_.push_back(static_cast<int>(waSlotNet_.size()));
+  }
+
+  const size_t numSlots = waSlotNet_.size();
+  waMinExpX_.assign(numSlots, 0);
+  waMaxExpX_.assign(numSlots, 0);
+  waMinExpY_.assign(numSlots, 0);
+  waMaxExpY_.assign(numSlots, 0);
+
+  waExpMinSumX_.assign(numNets, 0);
+  waXExpMinSumX_.assign(numNets, 0);
+  waExpMaxSumX_.assign(numNets, 0);
+  waXExpMaxSumX_.assign(numNets, 0);
+  waExpMinSumY_.assign(numNets, 0);
+  waYExpMinSumY_.assign(numNets, 0);
+  waExpMaxSumY_.assign(numNets, 0);
+  waYExpMaxSumY_.assign(numNets, 0);
+}
+
+void NesterovBaseCommon::updatePinLocation(const GCell* gCell)
+{
+  for (const GPin* gPin : gCell->gPins()) {
+    const int slot = waPinSlot_[pinIndex(gPin)];
+    if (slot != -1) {
+      waSlotX_[slot] = gPin->cx();
+      waSlotY_[slot] = gPin->cy();
+    }
+  }
+}
+
 //
 // WA force cals - wlCoeffX / wlCoeffY
 //
 // * Note that wlCoeffX and wlCoeffY is 1/gamma
 // in ePlace paper.
+//
+// The nets are independent of each other, so they are processed in
+// parallel.  Within a net, the exponentials are computed with SIMD on the
+// contiguous pin arrays, and the sums are accumulated in the pin order,
+// so the result does not depend on the number of threads.
 void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
 {
-  // clear all WA variables.
-  for (auto& gNet : gNets_) {
-    gNet->clearWaVars();
-  }
-  for (auto& gPin : gPins_) {
-    gPin->clearWaVars();
-  }
-
-  for (auto& gNet : gNets_) {
-    gNet->updateBox();
-
-    for (auto& gPin : gNet->gPins()) {
-      // The WA terms are shift invariant:
-      //
-      //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
-      //   -----------------    = -----------------
-      //   Sum(exp(x_i))          Sum(exp(x_i - C))
-      //
-      // So we shift to keep the exponential from overflowing
-      float expMinX = (gNet->lx() - gPin->cx()) * wlCoeffX;
-      float expMaxX = (gPin->cx() - gNet->ux()) * wlCoeffX;
-      float expMinY = (gNet->ly() - gPin->cy()) * wlCoeffY;
-      float expMaxY = (gPin->cy() - gNet->uy()) * wlCoeffY;
-
-      // min x
-      if (expMinX > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumX(fastExp(expMinX));
-        gNet->addWaExpMinSumX(gPin->minExpSumX());
-        gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumX());
-        }
-      }
-
-      // max x
-      if (expMaxX > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumX(fastExp(expMaxX));
-        gNet->addWaExpMaxSumX(gPin->maxExpSumX());
-        gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumX());
-        }
-      }
+  const float minForceBar = nbVars_.minWireLengthForceBar;
+  const int numNets = static_cast<int>(gNets_.size());
+
+#pragma omp parallel for num_threads(nbVars_.numThreads) schedule(dynamic, 256)
+  for (int netIdx = 0; netIdx < numNets; netIdx++) {
+    const int begin = waNetPinStart_[netIdx];
+    const int end = waNetPinStart_[netIdx + 1];
+    const int* pinX = waSlotX_.data();
+    const int* pinY = waSlotY_.data();
+
+    int lx = INT_MAX, ly = INT_MAX;
+    int ux = INT_MIN, uy = INT_MIN;
+#pragma omp simd reduction(min : lx, ly) reduction(max : ux, uy)
+    for (int slot = begin; slot < end; slot++) {
+      lx = std::min(pinX[slot], lx);
+      ly = std::min(pinY[slot], ly);
+      ux = std::max(pinX[slot], ux);
+      uy = std::max(pinY[slot], uy);
+    }
+    gNets_[netIdx]->setBox(lx, ly, ux, uy);
 
-      // min y
-      if (expMinY > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumY(fastExp(expMinY));
-        gNet->addWaExpMinSumY(gPin->minExpSumY());
-        gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumY());
-        }
-      }
+    // The WA terms are shift invariant:
+    //
+    //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
+    //   -----------------    = -----------------
+    //   Sum(exp(x_i))          Sum(exp(x_i - C))
+    //
+    // So we shift to keep the exponential from overflowing.
+    // The pins whose exponent is below minForceBar are not considered.
+    float* minExpX = waMinExpX_.data();
+    float* maxExpX = waMaxExpX_.data();
+    float* minExpY = waMinExpY_.data();
+    float* maxExpY = waMaxExpY_.data();
+#pragma omp simd
+    for (int slot = begin; slot < end; slot++) {
+      const float expMinX = (lx - pinX[slot]) * wlCoeffX;
+      const float expMaxX = (pinX[slot] - ux) * wlCoeffX;
+      const float expMinY = (ly - pinY[slot]) * wlCoeffY;
+      const float expMaxY = (pinY[slot] - uy) * wlCoeffY;
+      minExpX[slot] = expMinX > minForceBar ? fastExp(expMinX) : 0.0f;
+      maxExpX[slot] = expMaxX > minForceBar ? fastExp(expMaxX) : 0.0f;
+      minExpY[slot] = expMinY > minForceBar ? fastExp(expMinY) : 0.0f;
+      maxExpY[slot] = expMaxY > minForceBar ? fastExp(expMaxY) : 0.0f;
+    }
 
-      // max y
-      if (expMaxY > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumY(fastExp(expMaxY));
-        gNet->addWaExpMaxSumY(gPin->maxExpSumY());
-        gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumY());
-        }
-      }
+    float expMinSumX = 0, xExpMinSumX = 0;
+    float expMaxSumX = 0, xExpMaxSumX = 0;
+    float expMinSumY = 0, yExpMinSumY = 0;
+    float expMaxSumY = 0, yExpMaxSumY = 0;
+    for (int slot = begin; slot < end; slot++) {
+      expMinSumX += minExpX[slot];
+      xExpMinSumX += pinX[slot] * minExpX[slot];
+      expMaxSumX += maxExpX[slot];
+      xExpMaxSumX += pinX[slot] * maxExpX[slot];
+      expMinSumY += minExpY[slot];
+      yExpMinSumY += pinY[slot] * minExpY[slot];
+      expMaxSumY += maxExpY[slot];
+      yExpMaxSumY += pinY[slot] * maxExpY[slot];
     }
+    waExpMinSumX_[netIdx] = expMinSumX;
+    waXExpMinSumX_[netIdx] = xExpMinSumX;
+    waExpMaxSumX_[netIdx] = expMaxSumX;
+    waXExpMaxSumX_[netIdx] = xExpMaxSumX;
+    waExpMinSumY_[netIdx] = expMinSumY;
+    waYExpMinSumY_[netIdx] = yExpMinSumY;
+    waExpMaxSumY_[netIdx] = expMaxSumY;
+    waYExpMaxSumY_[netIdx] = yExpMaxSumY;
   }
 }
 
@@ -1287,107 +1396,99 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientWA(const GCell* gCell,
 {
   FloatPoint gradientPair;
 
-  for (auto& gPin : gCell->gPins()) {
-    auto tmpPair = getWireLengthGradientPinWA(gPin, wlCoeffX, wlCoeffY);
-
-    debugPrint(log_,
-               GPL,
-               "getGradientWA",
-               1,
-               "wlPair: {:g} {:g}",
-               tmpPair.x,
-               tmpPair.y);
+  for (const GPin* gPin : gCell->gPins()) {
+    const int slot = waPinSlot_[pinIndex(gPin)];
+    if (slot == -1) {
+      continue;
+    }
+    auto tmpPair = getWireLengthGradientSlotWA(slot, wlCoeffX, wlCoeffY);
 
     // apply timing/custom net weight
-    tmpPair.x *= gPin->gNet()->totalWeight();
-    tmpPair.y *= gPin->gNet()->totalWeight();
+    const float netWeight = gNets_[waSlotNet_[slot]]->totalWeight();
+    tmpPair.x *= netWeight;
+    tmpPair.y *= netWeight;
 
     gradientPair.x += tmpPair.x;
     gradientPair.y += tmpPair.y;
   }
 
-  if (gCell->isInstance()) {
-    debugPrint(log_,
-               GPL,
-               "getGradientWA",
-               1,
-               "gradient: {:g} {:g}",
-               gradientPair.x,
-               gradientPair.y);
-  }
-
   // return sum
   return gradientPair;
 }
 
-// get x,y WA Gradient values from GPin
+FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
+                                                          float wlCoeffX,
+                                                          float wlCoeffY) const
+{
+  const int slot = waPinSlot_[pinIndex(gPin)];
+  if (slot == -1) {
+    return FloatPoint();
+  }
+  return getWireLengthGradientSlotWA(slot, wlCoeffX, wlCoeffY);
+}
+
+// get x,y WA Gradient values of the pin in slot
 // Please check the JingWei's Ph.D. thesis full paper,
 // Equation (4.13)
 //
 // You can't understand the following function
 // unless you read the (4.13) formula
-FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
-                                                          float wlCoeffX,
-                                                          float wlCoeffY) const
+FloatPoint NesterovBaseCommon::getWireLengthGradientSlotWA(int slot,
+                                                           float wlCoeffX,
+                                                           float wlCoeffY) const
 {
   float gradientMinX = 0, gradientMinY = 0;
   float gradientMaxX = 0, gradientMaxY = 0;
 
+  const int netIdx = waSlotNet_[slot];
+  const int cx = waSlotX_[slot];
+  const int cy = waSlotY_[slot];
+
   // min x
-  if (gPin->hasMinExpSumX()) {
+  const float minExpX = waMinExpX_[slot];
+  if (minExpX != 0) {
     // from Net.
-    float waExpMinSumX = gPin->gNet()->waExpMinSumX();
-    float waXExpMinSumX = gPin->gNet()->waXExpMinSumX();
+    float waExpMinSumX = waExpMinSumX_[netIdx];
+    float waXExpMinSumX = waXExpMinSumX_[netIdx];
 
-    gradientMinX
-        = (waExpMinSumX * (gPin->minExpSumX() * (1.0 - wlCoeffX * gPin->cx()))
-           + wlCoeffX * gPin->minExpSumX() * waXExpMinSumX)
-          / (waExpMinSumX * waExpMinSumX);
+    gradientMinX = (waExpMinSumX * (minExpX * (1.0 - wlCoeffX * cx))
+                    + wlCoeffX * minExpX * waXExpMinSumX)
+                   / (waExpMinSumX * waExpMinSumX);
   }
 
   // max x
-  if (gPin->hasMaxExpSumX()) {
-    float waExpMaxSumX = gPin->gNet()->waExpMaxSumX();
-    float waXExpMaxSumX = gPin->gNet()->waXExpMaxSumX();
+  const float maxExpX = waMaxExpX_[slot];
+  if (maxExpX != 0) {
+    float waExpMaxSumX = waExpMaxSumX_[netIdx];
+    float waXExpMaxSumX = waXExpMaxSumX_[netIdx];
 
-    gradientMaxX
-        = (waExpMaxSumX * (gPin->maxExpSumX() * (1.0 + wlCoeffX * gPin->cx()))
-           - wlCoeffX * gPin->maxExpSumX() * waXExpMaxSumX)
-          / (waExpMaxSumX * waExpMaxSumX);
+    gradientMaxX = (waExpMaxSumX * (maxExpX * (1.0 + wlCoeffX * cx))
+                    - wlCoeffX * maxExpX * waXExpMaxSumX)
+                   / (waExpMaxSumX * waExpMaxSumX);
   }
 
   // min y
-  if (gPin->hasMinExpSumY()) {
-    float waExpMinSumY = gPin->gNet()->waExpMinSumY();
-    float waYExpMinSumY = gPin->gNet()->waYExpMinSumY();
+  const float minExpY = waMinExpY_[slot];
+  if (minExpY != 0) {
+    float waExpMinSumY = waExpMinSumY_[netIdx];
+    float waYExpMinSumY = waYExpMinSumY_[netIdx];
 
-    gradientMinY
-        = (waExpMinSumY * (gPin->minExpSumY() * (1.0 - wlCoeffY * gPin->cy()))
-           + wlCoeffY * gPin->minExpSumY() * waYExpMinSumY)
-          / (waExpMinSumY * waExpMinSumY);
+    gradientMinY = (waExpMinSumY * (minExpY * (1.0 - wlCoeffY * cy))
+                    + wlCoeffY * minExpY * waYExpMinSumY)
+                   / (waExpMinSumY * waExpMinSumY);
   }
 
   // max y
-  if (gPin->hasMaxExpSumY()) {
-    float waExpMaxSumY = gPin->gNet()->waExpMaxSumY();
-    float waYExpMaxSumY = gPin->gNet()->waYExpMaxSumY();
+  const float maxExpY = waMaxExpY_[slot];
+  if (maxExpY != 0) {
+    float waExpMaxSumY = waExpMaxSumY_[netIdx];
+    float waYExpMaxSumY = waYExpMaxSumY_[netIdx];
 
-    gradientMaxY
-        = (waExpMaxSumY * (gPin->maxExpSumY() * (1.0 + wlCoeffY * gPin->cy()))
-           - wlCoeffY * gPin->maxExpSumY() * waYExpMaxSumY)
-          / (waExpMaxSumY * waExpMaxSumY);
+    gradientMaxY = (waExpMaxSumY * (maxExpY * (1.0 + wlCoeffY * cy))
+                    - wlCoeffY * maxExpY * waYExpMaxSumY)
+                   / (waExpMaxSumY * waExpMaxSumY);
   }
 
-  debugPrint(log_,
-             GPL,
-             "getGradientWAPin",
-             1,
-             "gradient:  X[{:g} {:g}]  Y[{:g} {:g}]",
-             gradientMinX,
-             gradientMaxX,
-             gradientMinY,
-             gradientMaxY);
-
   return FloatPoint(gradientMinX - gradientMaxX, gradientMinY - gradientMaxY);
 }
 
@@ -1546,6 +1647,14 @@ void NesterovBase::init()
 
     inst->setLocation(inst->lx() + x_offset, inst->ly() + y_offset);
 
+    // a cluster keeps its members and is added once, through its first one
+    if (gCell->insts().size() > 1) {
+      if (gCell->instance() == inst) {
+        gCells_.push_back(gCell);
+      }
+      continue;
+    }
+
     gCell->clearInstances();
     gCell->setInstance(inst);
     gCells_.push_back(gCell);
@@ -1557,7 +1666,7 @@ void NesterovBase::init()
   }
 
   for (auto& gCell : gCells_) {
-    if (gCell->isInstance()) {
+    if (gCell->isClusteredInstance()) {
       gCellInsts_.push_back(gCell);
     } else if (gCell->isFiller()) {
       gCellFillers_.push_back(gCell);
@@ -1578,13 +1687,31 @@ void NesterovBase::init()
   bg_.setLogger(log_);
   bg_.setCorePoints(&(pb_->die()));
   bg_.setTargetDensity(targetDensity_);
+  bg_.setNumThreads(nbVars_.numThreads);
 
   // update binGrid info
   bg_.initBins();
 
+  // the fftsg routines only handle power-of-two lengths
+  bool useLegacyFFT = nbVars_.useLegacyFFT;
+  if (useLegacyFFT
+      && ((bg_.binCntX() & (bg_.binCntX() - 1)) != 0
+          || (bg_.binCntY() & (bg_.binCntY() - 1)) != 0)) {
+    log_->warn(GPL,
+               306,
+               "Bin counts {} {} are not powers of two, using the DCT FFT.",
+               bg_.binCntX(),
+               bg_.binCntY());
+    useLegacyFFT = false;
+  }
+
   // initialize fft structrue based on bins
-  std::unique_ptr<FFT> fft(
-      new FFT(bg_.binCntX(), bg_.binCntY(), bg_.binSizeX(), bg_.binSizeY()));
+  std::unique_ptr<FFT> fft(new FFT(bg_.binCntX(),
+                                   bg_.binCntY(),
+                                   bg_.binSizeX(),
+                                   bg_.binSizeY(),
+                                   nbVars_.numThreads,
+                                   useLegacyFFT));
 
   fft_ = std::move(fft);
 
@@ -1716,6 +1843,7 @@ void NesterovBase::updateGCellLocation(const std::vector<FloatPoint>& coordis)
   for (auto& coordi : coordis) {
     int idx = &coordi - &coordis[0];
     gCells_[idx]->setLocation(coordi.x, coordi.y);
+    nbc_->updatePinLocation(gCells_[idx]);
   }
 }
 
@@ -1726,15 +1854,19 @@ void NesterovBase::updateGCellCenterLocation(
   for (auto& coordi : coordis) {
     int idx = &coordi - &coordis[0];
     gCells_[idx]->setCenterLocation(coordi.x, coordi.y);
+    nbc_->updatePinLocation(gCells_[idx]);
   }
 }
 
 void NesterovBase::updateGCellDensityCenterLocation(
     const std::vector<FloatPoint>& coordis)
 {
-  for (auto& coordi : coordis) {
-    int idx = &coordi - &coordis[0];
-    gCells_[idx]->setDensityCenterLocation(coordi.x, coordi.y);
+  // each gCell only updates its own pins (and their WA pin slots)
+  const int numGCells = static_cast<int>(coordis.size());
+#pragma omp parallel for num_threads(nbVars_.numThreads)
+  for (int idx = 0; idx < numGCells; idx++) {
+    gCells_[idx]->setDensityCenterLocation(coordis[idx].x, coordis[idx].y);
+    nbc_->updatePinLocation(gCells_[idx]);
   }
   bg_.updateBinsGCellDensityArea(gCells_);
 }
@@ -1957,6 +2089,7 @@ void NesterovBase::updateDensityCoordiLayoutInside(GCell* gCell)
     targetLy = bg_.uy() - gCell->dDy();
   }
   gCell->setDensityLocation(targetLx, targetLy);
+  nbc_->updatePinLocation(gCell);
 }
 
 float NesterovBase::getDensityCoordiLayoutInsideX(const GCell* gCell,
@@ -2024,24 +2157,17 @@ FloatPoint NesterovBase::getDensityGradient(const GCell* gCell) const
 // Density force cals
 void NesterovBase::updateDensityForceBin()
 {
-  // copy density to utilize FFT
-  for (Bin& bin : bg_.bins()) {
-    fft_->updateDensity(bin.x(), bin.y(), bin.density());
-  }
-
-  // do FFT
-  fft_->doFFT();
+  // do FFT; the bins' density, electroPhi and electroForce are backed
+  // by the grid maps, so the FFT reads and writes them in place
+  fft_->doFFT(bg_.densityMap(),
+              bg_.electroPhiMap(),
+              bg_.electroForceXMap(),
+              bg_.electroForceYMap());
 
-  // update electroPhi and electroForce
   // update sumPhi_ for nesterov loop
   sumPhi_ = 0;
-  for (Bin& bin : bg_.bins()) {
-    auto eForcePair = fft_->getElectroForce(bin.x(), bin.y());
-    bin.setElectroForce(eForcePair.first, eForcePair.second);
-
-    float electroPhi = fft_->getElectroPhi(bin.x(), bin.y());
-    bin.setElectroPhi(electroPhi);
-
+  for (const Bin& bin : bg_.bins()) {
+    const float electroPhi = bin.electroPhi();
     sumPhi_ += electroPhi
                * static_cast<float>(bin.nonPlaceArea() + bin.instPlacedArea()
                                     + bin.fillerArea());
@@ -2176,11 +2302,19 @@ void NesterovBase::updateGradients(std::vector<FloatPoint>& sumGrads,
   debugPrint(
       log_, GPL, "updateGrad", 1, "DensityPenalty: {:g}", densityPenalty_);
 
-  for (size_t i = 0; i < gCells_.size(); i++) {
-    GCell* gCell = gCells_.at(i);
+  // The gradients of the gCells are independent of each other,
+  // while the sums below are accumulated in order for stability.
+  const int numGCells = static_cast<int>(gCells_.size());
+#pragma omp parallel for num_threads(nbVars_.numThreads) schedule(dynamic, 1024)
+  for (int i = 0; i < numGCells; i++) {
+    GCell* gCell = gCells_[i];
     wireLengthGrads[i]
         = nbc_->getWireLengthGradientWA(gCell, wlCoeffX, wlCoeffY);
     densityGrads[i] = getDensityGradient(gCell);
+  }
+
+  for (size_t i = 0; i < gCells_.size(); i++) {
+    GCell* gCell = gCells_.at(i);
 
     // Different compiler has different results on the following formula.
     // e.g. wireLengthGradSum_ += fabs(~~.x) + fabs(~~.y);
@@ -2508,6 +2642,59 @@ void NesterovBase::snapshot()
   isSnapshotSaved = true;
 }
 
+NesterovBaseState NesterovBase::saveState() const
+{
+  NesterovBaseState state;
+  state.curCoordi = curCoordi_;
+  state.curSLPCoordi = curSLPCoordi_;
+  state.curSLPSumGrads = curSLPSumGrads_;
+  state.densityPenalty = densityPenalty_;
+  state.stepLength = stepLength_;
+  state.sumOverflow = sumOverflow_;
+  state.sumOverflowUnscaled = sumOverflowUnscaled_;
+  state.prevHpwl = prevHpwl_;
+  state.isMaxPhiCoefChanged = isMaxPhiCoefChanged_;
+  state.isConverged = isConverged_;
+  return state;
+}
+
+bool NesterovBase::matchesState(const NesterovBaseState& state) const
+{
+  return state.curCoordi.size() == gCells_.size()
+         && state.curSLPCoordi.size() == gCells_.size()
+         && state.curSLPSumGrads.size() == gCells_.size();
+}
+
+bool NesterovBase::restoreState(const NesterovBaseState& state)
+{
+  if (!matchesState(state)) {
+    return false;
+  }
+
+  curCoordi_ = state.curCoordi;
+  curSLPCoordi_ = state.curSLPCoordi;
+  curSLPSumGrads_ = state.curSLPSumGrads;
+  densityPenalty_ = state.densityPenalty;
+  stepLength_ = state.stepLength;
+  sumOverflow_ = state.sumOverflow;
+  sumOverflowUnscaled_ = state.sumOverflowUnscaled;
+  prevHpwl_ = state.prevHpwl;
+  isMaxPhiCoefChanged_ = state.isMaxPhiCoefChanged;
+  isConverged_ = state.isConverged;
+
+  updateGCellDensityCenterLocation(curCoordi_);
+  updateDensityForceBin();
+
+  if (isConverged_) {
+    for (auto& gCell : gCells_) {
+      if (gCell->isInstance()) {
+        gCell->instance()->lock();
+      }
+    }
+  }
+  return true;
+}
+
 bool NesterovBase::checkConvergence()
 {
   if (isConverged_) {
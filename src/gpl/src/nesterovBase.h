@@ -64,6 +64,7 @@ class Net;
 
 class GPin;
 class FFT;
+class BinGrid;
 
 class GCell
 {
@@ -254,37 +255,12 @@ class GNet
 
   void addGPin(GPin* gPin);
   void updateBox();
+  void setBox(int lx, int ly, int ux, int uy);
   int64_t hpwl() const;
 
   void setDontCare();
   bool isDontCare() const;
 
-  // clear WA(Weighted Average) variables.
-  void clearWaVars();
-
-  void addWaExpMinSumX(float waExpMinSumX);
-  void addWaXExpMinSumX(float waExpXMinSumX);
-
-  void addWaExpMinSumY(float waExpMinSumY);
-  void addWaYExpMinSumY(float waExpXMinSumY);
-
-  void addWaExpMaxSumX(float waExpMaxSumX);
-  void addWaXExpMaxSumX(float waExpXMaxSumX);
-
-  void addWaExpMaxSumY(float waExpMaxSumY);
-  void addWaYExpMaxSumY(float waExpXMaxSumY);
-
-  float waExpMinSumX() const;
-  float waXExpMinSumX() const;
-
-  float waExpMinSumY() const;
-  float waYExpMinSumY() const;
-
-  float waExpMaxSumX() const;
-  float waXExpMaxSumX() const;
-
-  float waExpMaxSumY() const;
-  float waYExpMaxSumY() const;
 
  private:
   std::vector<GPin*> gPins_;
@@ -297,43 +273,6 @@ class GNet
   float timingWeight_;
   float customWeight_;
 
-  //
-  // weighted average WL model stor for better indexing
-  // Please check the equation (4) in the ePlace-MS paper.
-  //
-  // WA: weighted Average
-  // saving four variable will be helpful for
-  // calculating the WA gradients/wirelengths.
-  //
-  // gamma: modeling accuracy.
-  //
-  // X forces.
-  //
-  // waExpMinSumX_: store sigma {exp(x_i/gamma)}
-  // waXExpMinSumX_: store signa {x_i*exp(e_i/gamma)}
-  // waExpMaxSumX_ : store sigma {exp(-x_i/gamma)}
-  // waXExpMaxSumX_: store sigma {x_i*exp(-x_i/gamma)}
-  //
-  float waExpMinSumX_;
-  float waXExpMinSumX_;
-
-  float waExpMaxSumX_;
-  float waXExpMaxSumX_;
-
-  //
-  // Y forces.
-  //
-  // waExpMinSumY_: store sigma {exp(y_i/gamma)}
-  // waYExpMinSumY_: store signa {y_i*exp(e_i/gamma)}
-  // waExpMaxSumY_ : store sigma {exp(-y_i/gamma)}
-  // waYExpMaxSumY_: store sigma {y_i*exp(-y_i/gamma)}
-  //
-  float waExpMinSumY_;
-  float waYExpMinSumY_;
-
-  float waExpMaxSumY_;
-  float waYExpMaxSumY_;
-
   unsigned char isDontCare_ : 1;
 };
 
@@ -357,87 +296,6 @@ inline int GNet::uy() const
   return uy_;
 }
 
-// eight add functions
-inline void GNet::addWaExpMinSumX(float waExpMinSumX)
-{
-  waExpMinSumX_ += waExpMinSumX;
-}
-
-inline void GNet::addWaXExpMinSumX(float waXExpMinSumX)
-{
-  waXExpMinSumX_ += waXExpMinSumX;
-}
-
-inline void GNet::addWaExpMinSumY(float waExpMinSumY)
-{
-  waExpMinSumY_ += waExpMinSumY;
-}
-
-inline void GNet::addWaYExpMinSumY(float waYExpMinSumY)
-{
-  waYExpMinSumY_ += waYExpMinSumY;
-}
-
-inline void GNet::addWaExpMaxSumX(float waExpMaxSumX)
-{
-  waExpMaxSumX_ += waExpMaxSumX;
-}
-
-inline void GNet::addWaXExpMaxSumX(float waXExpMaxSumX)
-{
-  waXExpMaxSumX_ += waXExpMaxSumX;
-}
-
-inline void GNet::addWaExpMaxSumY(float waExpMaxSumY)
-{
-  waExpMaxSumY_ += waExpMaxSumY;
-}
-
-inline void GNet::addWaYExpMaxSumY(float waYExpMaxSumY)
-{
-  waYExpMaxSumY_ += waYExpMaxSumY;
-}
-
-inline float GNet::waExpMinSumX() const
-{
-  return waExpMinSumX_;
-}
-
-inline float GNet::waXExpMinSumX() const
-{
-  return waXExpMinSumX_;
-}
-
-inline float GNet::waExpMinSumY() const
-{
-  return waExpMinSumY_;
-}
-
-inline float GNet::waYExpMinSumY() const
-{
-  return waYExpMinSumY_;
-}
-
-inline float GNet::waExpMaxSumX() const
-{
-  return waExpMaxSumX_;
-}
-
-inline float GNet::waXExpMaxSumX() const
-{
-  return waXExpMaxSumX_;
-}
-
-inline float GNet::waExpMaxSumY() const
-{
-  return waExpMaxSumY_;
-}
-
-inline float GNet::waYExpMaxSumY() const
-{
-  return waYExpMaxSumY_;
-}
-
 class GPin
 {
  public:
@@ -458,23 +316,8 @@ class GPin
   int cx() const { return cx_; }
   int cy() const { return cy_; }
 
-  // clear WA(Weighted Average) variables.
-  void clearWaVars();
-
-  void setMaxExpSumX(float maxExpSumX);
-  void setMaxExpSumY(float maxExpSumY);
-  void setMinExpSumX(float minExpSumX);
-  void setMinExpSumY(float minExpSumY);
-
-  float maxExpSumX() const { return maxExpSumX_; }
-  float maxExpSumY() const { return maxExpSumY_; }
-  float minExpSumX() const { return minExpSumX_; }
-  float minExpSumY() const { return minExpSumY_; }
-
-  bool hasMaxExpSumX() const { return (hasMaxExpSumX_ == 1); }
-  bool hasMaxExpSumY() const { return (hasMaxExpSumY_ == 1); }
-  bool hasMinExpSumX() const { return (hasMinExpSumX_ == 1); }
-  bool hasMinExpSumY() const { return (hasMinExpSumY_ == 1); }
+  // offset of the pin from its GCell's center
+  void setOffset(int offsetCx, int offsetCy);
 
   void setCenterLocation(int cx, int cy);
   void updateLocation(const GCell* gCell);
@@ -489,36 +332,20 @@ class GPin
   int offsetCy_;
   int cx_;
   int cy_;
-
-  // weighted average WL vals stor for better indexing
-  // Please check the equation (4) in the ePlace-MS paper.
-  //
-  // maxExpSum_: holds exp(x_i/gamma)
-  // minExpSum_: holds exp(-x_i/gamma)
-  // the x_i is equal to cx_ variable.
-  //
-  float maxExpSumX_;
-  float maxExpSumY_;
-
-  float minExpSumX_;
-  float minExpSumY_;
-
-  // flag variables
-  //
-  // check whether
-  // this pin is considered in a WA models.
-  unsigned char hasMaxExpSumX_ : 1;
-  unsigned char hasMaxExpSumY_ : 1;
-
-  unsigned char hasMinExpSumX_ : 1;
-  unsigned char hasMinExpSumY_ : 1;
 };
 
 class Bin
 {
  public:
   Bin();
-  Bin(int x, int y, int lx, int ly, int ux, int uy, float targetDensity);
+  Bin(int x,
+      int y,
+      int lx,
+      int ly,
+      int ux,
+      int uy,
+      float targetDensity,
+      BinGrid* grid);
 
   ~Bin();
 
@@ -588,11 +415,12 @@ class Bin
   int64_t nonPlaceAreaUnscaled_;
   int64_t fillerArea_;
 
-  float density_;
   float targetDensity_;  // will enable bin-wise density screening
-  float electroPhi_;
-  float electroForceX_;
-  float electroForceY_;
+
+  // density, electroPhi and electroForce live in the owning grid's
+  // contiguous x-major maps, which the FFT reads and writes directly.
+  BinGrid* grid_;
+  int mapIdx_;
 };
 
 inline int Bin::cx() const
@@ -676,11 +504,16 @@ class BinGrid
   BinGrid(Die* die);
   ~BinGrid();
 
+  // bins_ hold a pointer back to their grid
+  BinGrid(const BinGrid&) = delete;
+  BinGrid& operator=(const BinGrid&) = delete;
+
   void setPlacerBase(const std::shared_ptr<PlacerBase> pb);
   void setLogger(utl::Logger* log);
   void setCorePoints(const Die* die);
   void setBinCnt(int binCntX, int binCntY);
   void setTargetDensity(float density);
+  void setNumThreads(int numThreads) { numThreads_ = numThreads; }
   void updateBinsGCellDensityArea(const std::vector<GCell*>& cells);
 
   void initBins();
@@ -713,10 +546,27 @@ class BinGrid
   std::vector<Bin>& bins();
   const std::vector<Bin>& binsConst() const { return bins_; };
 
+  // x-major maps (index x * binCntY + y) backing the Bin fields;
+  // laid out the way FFT::doFFT consumes them.
+  const float* densityMap() const { return density_.data(); }
+  float* densityMap() { return density_.data(); }
+  const float* electroPhiMap() const { return electroPhi_.data(); }
+  float* electroPhiMap() { return electroPhi_.data(); }
+  const float* electroForceXMap() const { return electroForceX_.data(); }
+  float* electroForceXMap() { return electroForceX_.data(); }
+  const float* electroForceYMap() const { return electroForceY_.data(); }
+  float* electroForceYMap() { return electroForceY_.data(); }
+
   void updateBinsNonPlaceArea();
 
  private:
   std::vector<Bin> bins_;
+  std::vector<float> density_;
+  std::vector<float> electroPhi_;
+  std::vector<float> electroForceX_;
+  std::vector<float> electroForceY_;
+  // per-gcell [first, last) bin row, scratch of updateBinsGCellDensityArea
+  std::vector<std::pair<int, int>> cellRows_;
   std::shared_ptr<PlacerBase> pb_;
   utl::Logger* log_;
   int lx_;
@@ -730,6 +580,7 @@ class BinGrid
   float targetDensity_;
   int64_t overflowArea_;
   int64_t overflowAreaUnscaled_;
+  int numThreads_;
 
   unsigned char isSetBinCnt_ : 1;
 };
@@ -746,9 +597,11 @@ class NesterovBaseVars
   int binCntX;
   int binCntY;
   float minWireLengthForceBar;
+  int numThreads;  // number of threads for the parallel kernels
   // temp variables
   unsigned char isSetBinCnt : 1;
   unsigned char useUniformTargetDensity : 1;
+  unsigned char useLegacyFFT : 1;  // fftsg Poisson solver (default) or Dct2D
 
   NesterovBaseVars();
   void reset();
@@ -780,6 +633,13 @@ class NesterovPlaceVars
   int debug_update_iterations;
   bool debug_draw_bins;
   odb::dbInst* debug_inst;
+  // write the final locations to odb; off for the multilevel coarse levels
+  bool updateDb;
+
+  // the Nesterov state is saved to checkpointFile
+  // each time the overflow reaches one of checkpointOverflows
+  std::string checkpointFile;
+  std::vector<float> checkpointOverflows;
 
   NesterovPlaceVars();
   void reset();
@@ -794,6 +654,12 @@ class NesterovBaseCommon
   NesterovBaseCommon(NesterovBaseVars nbVars,
                      std::shared_ptr<PlacerBaseCommon> pb,
                      utl::Logger* log);
+  // Each cluster of place instances becomes a single GCell.
+  // Every place instance must belong to exactly one cluster.
+  NesterovBaseCommon(NesterovBaseVars nbVars,
+                     std::shared_ptr<PlacerBaseCommon> pb,
+                     utl::Logger* log,
+                     const std::vector<std::vector<Instance*>>& clusters);
   ~NesterovBaseCommon();
 
   const std::vector<GCell*>& gCells() const { return gCells_; }
@@ -836,11 +702,31 @@ class NesterovBaseCommon
   // for preconditioner
   FloatPoint getWireLengthPreconditioner(const GCell* gCell) const;
 
+  // Copy the pin locations of gCell into the flat WA pin arrays.
+  // It must be called whenever the pins of gCell are moved.
+  void updatePinLocation(const GCell* gCell);
+
   int64_t getHpwl();
 
   void updateDbGCells();
 
+  int getNumThreads() const { return nbVars_.numThreads; }
+
  private:
+  // index of gPin in gPinStor_
+  int pinIndex(const GPin* gPin) const
+  {
+    return static_cast<int>(gPin - gPinStor_.data());
+  }
+
+  // the pin gradient of the WA model from the flat WA arrays
+  FloatPoint getWireLengthGradientSlotWA(int slot,
+                                         float wlCoeffX,
+                                         float wlCoeffY) const;
+
+  // build the flat WA arrays from gNets_ and gPins_
+  void initWaArrays();
+
   NesterovBaseVars nbVars_;
   std::shared_ptr<PlacerBaseCommon> pbc_;
   utl::Logger* log_;
@@ -857,7 +743,49 @@ class NesterovBaseCommon
   std::unordered_map<Pin*, GPin*> gPinMap_;
   std::unordered_map<Net*, GNet*> gNetMap_;
 
-  void init();
+  //
+  // Flat (structure of arrays) storage of the weighted average WL model.
+  // Please check the equation (4) in the ePlace-MS paper.
+  //
+  // The pins are stored net by net in "slots": the pins of gNets_[i] are
+  // the slots [waNetPinStart_[i], waNetPinStart_[i + 1]) in the order of
+  // GNet::gPins(), so the WA kernels walk contiguous arrays.
+  //
+  // waPinSlot_: the slot of each gPin (see pinIndex()), -1 if no net
+  // waSlotNet_: the net index of each slot
+  // waSlotX_/Y_: mirror of GPin::cx()/cy(), see updatePinLocation()
+  //
+  // waMinExpX_: holds exp((lx - x_i)/gamma) (0 if it is not considered)
+  // waMaxExpX_: holds exp((x_i - ux)/gamma) (0 if it is not considered)
+  //
+  // waExpMinSumX_: store sigma {waMinExpX_}  (per net)
+  // waXExpMinSumX_: store sigma {x_i * waMinExpX_}
+  // waExpMaxSumX_ : store sigma {waMaxExpX_}
+  // waXExpMaxSumX_: store sigma {x_i * waMaxExpX_}
+  //
+  // and the same for Y.
+  //
+  std::vector<int> waNetPinStart_;
+  std::vector<int> waPinSlot_;
+  std::vector<int> waSlotNet_;
+  std::vector<int> waSlotX_;
+  std::vector<int> waSlotY_;
+
+  std::vector<float> waMinExpX_;
+  std::vector<float> waMaxExpX_;
+  std::vector<float> waMinExpY_;
+  std::vector<float> waMaxExpY_;
+
+  std::vector<float> waExpMinSumX_;
+  std::vector<float> waXExpMinSumX_;
+  std::vector<float> waExpMaxSumX_;
+  std::vector<float> waXExpMaxSumX_;
+  std::vector<float> waExpMinSumY_;
+  std::vector<float> waYExpMinSumY_;
+  std::vector<float> waExpMaxSumY_;
+  std::vector<float> waYExpMaxSumY_;
+
+  void init(const std::vector<std::vector<Instance*>>& clusters);
   void reset();
 };
 
@@ -865,6 +793,22 @@ class NesterovBaseCommon
 // along with fillers and virtual blockages
 // Also stores the bin grid for the power domain
 // Used to calculate density gradient
+// Nesterov loop state of one region, as saved in placement checkpoints.
+// The coordinates cover instance and filler GCells.
+struct NesterovBaseState
+{
+  std::vector<FloatPoint> curCoordi;
+  std::vector<FloatPoint> curSLPCoordi;
+  std::vector<FloatPoint> curSLPSumGrads;
+  float densityPenalty = 0;
+  float stepLength = 0;
+  float sumOverflow = 0;
+  float sumOverflowUnscaled = 0;
+  int64_t prevHpwl = 0;
+  bool isMaxPhiCoefChanged = false;
+  bool isConverged = false;
+};
+
 class NesterovBase
 {
  public:
@@ -996,6 +940,13 @@ class NesterovBase
 
   void snapshot();
 
+  // checkpoint support
+  NesterovBaseState saveState() const;
+  // false when the state was saved with another GCell count
+  bool matchesState(const NesterovBaseState& state) const;
+  // returns false, and keeps the current state, when !matchesState(state)
+  bool restoreState(const NesterovBaseState& state);
+
   bool checkConvergence();
   bool checkDivergence();
   bool revertDivergence();
@@ -35,8 +35,13 @@
 
 #include "nesterovPlace.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #include "graphics.h"
@@ -68,7 +73,9 @@ NesterovPlace::NesterovPlace()
       isRoutabilityNeed_(true),
       divergeCode_(0),
       recursionCntWlCoef_(0),
-      recursionCntInitSLPCoef_(0)
+      recursionCntInitSLPCoef_(0),
+      startA_(1.0),
+      resumedOverflow_(std::numeric_limits<float>::max())
 {
 }
 
@@ -315,6 +322,9 @@ void NesterovPlace::reset()
 
   recursionCntWlCoef_ = 0;
   recursionCntInitSLPCoef_ = 0;
+
+  startA_ = 1.0;
+  resumedOverflow_ = std::numeric_limits<float>::max();
 }
 
 int NesterovPlace::doNesterovPlace(int start_iter)
@@ -339,7 +349,31 @@ int NesterovPlace::doNesterovPlace(int start_iter)
   bool isDivergeTriedRevert = false;
 
   // backTracking variable.
-  float curA = 1.0;
+  float curA = startA_;
+  startA_ = 1.0;
+
+  // overflow milestones still to be saved, from the highest
+  std::vector<float> checkpointOverflows = npVars_.checkpointOverflows;
+  std::sort(checkpointOverflows.begin(),
+            checkpointOverflows.end(),
+            std::greater<float>());
+  size_t nextCheckpoint = 0;
+  while (nextCheckpoint < checkpointOverflows.size()
+         && checkpointOverflows[nextCheckpoint] >= resumedOverflow_) {
+    nextCheckpoint++;
+  }
+  if (!npVars_.checkpointFile.empty()) {
+    // a resumed run adds its milestones to the existing ones
+    const auto mode = std::ios::binary
+                      | (start_iter > 0 ? std::ios::app : std::ios::trunc);
+    checkpointStream_.open(npVars_.checkpointFile, mode);
+    if (!checkpointStream_) {
+      log_->error(GPL,
+                  313,
+                  "Cannot open checkpoint file {}.",
+                  npVars_.checkpointFile);
+    }
+  }
 
   for (auto& nb : nbVec_) {
     nb->setIter(start_iter);
@@ -424,6 +458,14 @@ int NesterovPlace::doNesterovPlace(int start_iter)
 
     updateNextIter(iter);
 
+    while (checkpointStream_.is_open()
+           && nextCheckpoint < checkpointOverflows.size()
+           && average_overflow_unscaled_
+                  <= checkpointOverflows[nextCheckpoint]) {
+      saveCheckpoint(checkpointOverflows[nextCheckpoint], iter, curA);
+      nextCheckpoint++;
+    }
+
     // For JPEG Saving
     // debug
 
@@ -477,7 +519,7 @@ int NesterovPlace::doNesterovPlace(int start_iter)
 
       // revert back to the original rb solutions
       // one more opportunity
-      if (!isDivergeTriedRevert && rb_->numCall() >= 1) {
+      if (!isDivergeTriedRevert && rb_ && rb_->numCall() >= 1) {
         // get back to the working rc size
         rb_->revertGCellSizeToMinRc();
 
@@ -556,9 +598,15 @@ int NesterovPlace::doNesterovPlace(int start_iter)
       break;
     }
   }
+  if (checkpointStream_.is_open()) {
+    checkpointStream_.close();
+  }
+
   // in all case including diverge,
   // db should be updated.
-  updateDb();
+  if (npVars_.updateDb) {
+    updateDb();
+  }
 
   if (isDiverged_) {
     log_->error(GPL, divergeCode_, divergeMsg_);
@@ -611,4 +659,229 @@ void NesterovPlace::updateDb()
   nbc_->updateDbGCells();
 }
 
+////////////////////////////////////////////////
+// Checkpoints
+//
+// A checkpoint file is a sequence of records, one per overflow milestone:
+//   magic, version, milestone, iter, a_k, wlCoefX, wlCoefY,
+//   baseWlCoef, maxPhiCoef, numRegions,
+//   then per region: numCells, densityPenalty, stepLength, sumOverflow,
+//   sumOverflowUnscaled, prevHpwl, isMaxPhiCoefChanged, isConverged,
+//   curCoordi, curSLPCoordi, curSLPSumGrads.
+// Timing net weights are not saved; a resumed timing-driven run
+// reweights the nets at its first iteration.
+
+namespace {
+
+constexpr uint32_t kCheckpointMagic = 0x4b434c47;  // "GLCK"
+constexpr uint32_t kCheckpointVersion = 1;
+
+static_assert(sizeof(FloatPoint) == 2 * sizeof(float),
+              "FloatPoint is written as two floats");
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value)
+{
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void writePoints(std::ostream& out, const std::vector<FloatPoint>& points)
+{
+  out.write(reinterpret_cast<const char*>(points.data()),
+            points.size() * sizeof(FloatPoint));
+}
+
+bool readPoints(std::istream& in, std::vector<FloatPoint>& points, size_t size)
+{
+  points.resize(size);
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(points.data()),
+                                   size * sizeof(FloatPoint)));
+}
+
+void writeState(std::ostream& out, const NesterovBaseState& state)
+{
+  writeValue(out, static_cast<uint64_t>(state.curCoordi.size()));
+  writeValue(out, state.densityPenalty);
+  writeValue(out, state.stepLength);
+  writeValue(out, state.sumOverflow);
+  writeValue(out, state.sumOverflowUnscaled);
+  writeValue(out, state.prevHpwl);
+  writeValue(out, static_cast<uint8_t>(state.isMaxPhiCoefChanged));
+  writeValue(out, static_cast<uint8_t>(state.isConverged));
+  writePoints(out, state.curCoordi);
+  writePoints(out, state.curSLPCoordi);
+  writePoints(out, state.curSLPSumGrads);
+}
+
+// Reads the scalars of a region's state and its number of cells.
+// The caller checks numCells against the design before readStatePoints
+// sizes the coordinate arrays with it.
+bool readStateHeader(std::istream& in,
+                     NesterovBaseState& state,
+                     uint64_t& numCells)
+{
+  uint8_t isMaxPhiCoefChanged = 0;
+  uint8_t isConverged = 0;
+  if (!readValue(in, numCells) || !readValue(in, state.densityPenalty)
+      || !readValue(in, state.stepLength) || !readValue(in, state.sumOverflow)
+      || !readValue(in, state.sumOverflowUnscaled)
+      || !readValue(in, state.prevHpwl) || !readValue(in, isMaxPhiCoefChanged)
+      || !readValue(in, isConverged)) {
+    return false;
+  }
+  state.isMaxPhiCoefChanged = isMaxPhiCoefChanged;
+  state.isConverged = isConverged;
+  return true;
+}
+
+bool readStatePoints(std::istream& in,
+                     NesterovBaseState& state,
+                     uint64_t numCells)
+{
+  return readPoints(in, state.curCoordi, numCells)
+         && readPoints(in, state.curSLPCoordi, numCells)
+         && readPoints(in, state.curSLPSumGrads, numCells);
+}
+
+}  // namespace
+
+void NesterovPlace::saveCheckpoint(float overflow, int iter, float curA)
+{
+  std::ostream& out = checkpointStream_;
+  writeValue(out, kCheckpointMagic);
+  writeValue(out, kCheckpointVersion);
+  writeValue(out, overflow);
+  writeValue(out, static_cast<int32_t>(iter));
+  writeValue(out, curA);
+  writeValue(out, wireLengthCoefX_);
+  writeValue(out, wireLengthCoefY_);
+  writeValue(out, baseWireLengthCoef_);
+  writeValue(out, npVars_.maxPhiCoef);
+  writeValue(out, static_cast<uint32_t>(nbVec_.size()));
+  for (auto& nb : nbVec_) {
+    writeState(out, nb->saveState());
+  }
+  out.flush();
+
+  log_->info(GPL,
+             314,
+             "Checkpoint saved at overflow {:.3f}, iteration {}.",
+             overflow,
+             iter + 1);
+}
+
+int NesterovPlace::restoreCheckpoint(const std::string& file, float overflow)
+{
+  std::ifstream in(file, std::ios::binary);
+  if (!in) {
+    log_->error(GPL, 320, "Cannot read checkpoint file {}.", file);
+  }
+
+  uint32_t magic = 0;
+  while (readValue(in, magic)) {
+    uint32_t version = 0;
+    float milestone = 0;
+    int32_t iter = 0;
+    float curA = 0;
+    float wlCoefX = 0;
+    float wlCoefY = 0;
+    float baseWlCoef = 0;
+    float maxPhiCoef = 0;
+    uint32_t numRegions = 0;
+    if (magic != kCheckpointMagic || !readValue(in, version)
+        || version != kCheckpointVersion || !readValue(in, milestone)
+        || !readValue(in, iter) || !readValue(in, curA)
+        || !readValue(in, wlCoefX) || !readValue(in, wlCoefY)
+        || !readValue(in, baseWlCoef) || !readValue(in, maxPhiCoef)
+        || !readValue(in, numRegions)) {
+      log_->error(
+          GPL, 315, "{} is not a global placement checkpoint.", file);
+    }
+
+    // validate the sizes before anything is allocated from them
+    if (numRegions != nbVec_.size()) {
+      log_->error(GPL, 316, "Checkpoint {} does not match the design.", file);
+    }
+    std::vector<NesterovBaseState> states(numRegions);
+    for (size_t i = 0; i < nbVec_.size(); i++) {
+      uint64_t numCells = 0;
+      if (!readStateHeader(in, states[i], numCells)) {
+        log_->error(GPL, 321, "Checkpoint {} is truncated.", file);
+      }
+      if (numCells != nbVec_[i]->gCells().size()) {
+        log_->error(GPL,
+                    322,
+                    "Checkpoint {} does not match the instances of region {}.",
+                    file,
+                    i);
+      }
+      if (!readStatePoints(in, states[i], numCells)) {
+        log_->error(
+            GPL, 323, "Checkpoint {} is truncated in region {}.", file, i);
+      }
+    }
+
+    if (std::abs(milestone - overflow) > 1e-4) {
+      continue;
+    }
+
+    // check every region before restoring any, so a bad checkpoint never
+    // leaves the placement half restored
+    for (size_t i = 0; i < nbVec_.size(); i++) {
+      if (!nbVec_[i]->matchesState(states[i])) {
+        log_->error(GPL,
+                    324,
+                    "Checkpoint {} cannot be restored in region {}.",
+                    file,
+                    i);
+      }
+    }
+    for (size_t i = 0; i < nbVec_.size(); i++) {
+      if (!nbVec_[i]->restoreState(states[i])) {
+        log_->error(GPL,
+                    325,
+                    "Failed to restore region {} from checkpoint {}.",
+                    i,
+                    file);
+      }
+    }
+
+    wireLengthCoefX_ = wlCoefX;
+    wireLengthCoefY_ = wlCoefY;
+    baseWireLengthCoef_ = baseWlCoef;
+    npVars_.maxPhiCoef = maxPhiCoef;
+    startA_ = curA;
+    resumedOverflow_ = milestone;
+
+    total_sum_overflow_ = 0;
+    total_sum_overflow_unscaled_ = 0;
+    for (auto& nb : nbVec_) {
+      total_sum_overflow_ += nb->getSumOverflow();
+      total_sum_overflow_unscaled_ += nb->getSumOverflowUnscaled();
+    }
+    average_overflow_ = total_sum_overflow_ / nbVec_.size();
+    average_overflow_unscaled_ = total_sum_overflow_unscaled_ / nbVec_.size();
+
+    nbc_->updateWireLengthForceWA(wireLengthCoefX_, wireLengthCoefY_);
+
+    log_->info(GPL,
+               318,
+               "Resumed from the checkpoint at overflow {:.3f}, iteration {}.",
+               milestone,
+               iter + 1);
+    return iter + 1;
+  }
+
+  log_->error(
+      GPL, 317, "No checkpoint at overflow {} in {}.", overflow, file);
+  return 0;
+}
+
 }  // namespace gpl
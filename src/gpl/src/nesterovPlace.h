@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -74,6 +75,10 @@ class NesterovPlace
   // return iteration count
   int doNesterovPlace(int start_iter = 0);
 
+  // Restores the state saved at the given overflow milestone of a
+  // checkpoint file; returns the iteration to resume from.
+  int restoreCheckpoint(const std::string& file, float overflow);
+
   void updateWireLengthCoef(float overflow);
 
   void updateNextIter(const int iter);
@@ -128,7 +133,14 @@ class NesterovPlace
   int recursionCntWlCoef_;
   int recursionCntInitSLPCoef_;
 
+  // a_k of the first iteration; restored from checkpoints
+  float startA_;
+  // overflow milestone of the restored checkpoint
+  float resumedOverflow_;
+  std::ofstream checkpointStream_;
+
   void cutFillerCoordinates();
+  void saveCheckpoint(float overflow, int iter, float curA);
 
   void init();
   void reset();
@@ -36,6 +36,7 @@
 #include <iostream>
 
 #include "initialPlace.h"
+#include "multilevelPlace.h"
 #include "nesterovBase.h"
 #include "nesterovPlace.h"
 #include "odb/db.h"
@@ -66,8 +67,12 @@ Replace::Replace()
       initialPlaceMaxSolverIter_(100),
       initialPlaceMaxFanout_(200),
       initialPlaceNetWeightScale_(800),
+      initialPlaceIncompleteCholesky_(false),
       forceCPU_(false),
+      numThreads_(1),
+      legacyFFT_(true),
       nesterovPlaceMaxIter_(5000),
+      multilevelLevels_(0),
       binGridCntX_(0),
       binGridCntY_(0),
       overflow_(0.1),
@@ -90,9 +95,12 @@ Replace::Replace()
       routabilityMaxInflationIter_(4),
       timingNetWeightMax_(1.9),
       timingDrivenMode_(true),
+      timingDrivenIncremental_(false),
       routabilityDrivenMode_(true),
+      routabilityUseRudy_(false),
       uniformTargetDensityMode_(false),
       skipIoMode_(false),
+      resumeOverflow_(0),
       padLeft_(0),
       padRight_(0),
       gui_debug_(false),
@@ -138,9 +146,13 @@ void Replace::reset()
   initialPlaceMaxSolverIter_ = 100;
   initialPlaceMaxFanout_ = 200;
   initialPlaceNetWeightScale_ = 800;
+  initialPlaceIncompleteCholesky_ = false;
   forceCPU_ = false;
+  numThreads_ = 1;
+  legacyFFT_ = true;
 
   nesterovPlaceMaxIter_ = 5000;
+  multilevelLevels_ = 0;
   binGridCntX_ = binGridCntY_ = 0;
   overflow_ = 0.1;
   density_ = 1.0;
@@ -161,7 +173,9 @@ void Replace::reset()
   routabilityMaxInflationIter_ = 4;
 
   timingDrivenMode_ = true;
+  timingDrivenIncremental_ = false;
   routabilityDrivenMode_ = true;
+  routabilityUseRudy_ = false;
   uniformTargetDensityMode_ = false;
   skipIoMode_ = false;
 
@@ -169,6 +183,11 @@ void Replace::reset()
 
   timingNetWeightOverflows_.clear();
   timingNetWeightOverflows_.shrink_to_fit();
+
+  checkpointFile_.clear();
+  checkpointOverflows_.clear();
+  resumeCheckpoint_.clear();
+  resumeOverflow_ = 0;
   timingNetWeightMax_ = 1.9;
 
   gui_debug_ = false;
@@ -224,6 +243,8 @@ void Replace::doIncrementalPlace()
       pb->unlockAll();
     }
     // pbc_->unlockAll();
+    // start from the current locations (no multilevel levels)
+    initNesterovPlace();
     doNesterovPlace();
     return;
   }
@@ -256,7 +277,7 @@ void Replace::doIncrementalPlace()
   }
 }
 
-void Replace::doInitialPlace()
+void Replace::initPlacerBase()
 {
   if (pbc_ == nullptr) {
     PlacerBaseVars pbVars;
@@ -280,6 +301,11 @@ void Replace::doInitialPlace()
       total_placeable_insts_ += pb->placeInsts().size();
     }
   }
+}
+
+void Replace::doInitialPlace()
+{
+  initPlacerBase();
 
   InitialPlaceVars ipVars;
   ipVars.maxIter = initialPlaceMaxIter_;
@@ -289,37 +315,18 @@ void Replace::doInitialPlace()
   ipVars.netWeightScale = initialPlaceNetWeightScale_;
   ipVars.debug = gui_debug_initial_;
   ipVars.forceCPU = forceCPU_;
+  ipVars.numThreads = numThreads_;
+  ipVars.useIncompleteCholesky = initialPlaceIncompleteCholesky_;
 
   std::unique_ptr<InitialPlace> ip(
       new InitialPlace(ipVars, pbc_, pbVec_, log_));
   ip_ = std::move(ip);
-  ip_->doBicgstabPlace();
+  ip_->doInitialPlace();
 }
 
 bool Replace::initNesterovPlace()
 {
-  if (!pbc_) {
-    PlacerBaseVars pbVars;
-    pbVars.padLeft = padLeft_;
-    pbVars.padRight = padRight_;
-    pbVars.skipIoMode = skipIoMode_;
-
-    pbc_ = std::make_shared<PlacerBaseCommon>(db_, pbVars, log_);
-
-    pbVec_.push_back(std::make_shared<PlacerBase>(db_, pbc_, log_));
-
-    for (auto pd : db_->getChip()->getBlock()->getPowerDomains()) {
-      if (pd->getGroup()) {
-        pbVec_.push_back(
-            std::make_shared<PlacerBase>(db_, pbc_, log_, pd->getGroup()));
-      }
-    }
-
-    total_placeable_insts_ = 0;
-    for (const auto& pb : pbVec_) {
-      total_placeable_insts_ += pb->placeInsts().size();
-    }
-  }
+  initPlacerBase();
 
   if (total_placeable_insts_ == 0) {
     log_->warn(GPL, 136, "No placeable instances - skipping placement.");
@@ -327,17 +334,7 @@ bool Replace::initNesterovPlace()
   }
 
   if (!nbc_) {
-    NesterovBaseVars nbVars;
-    nbVars.targetDensity = density_;
-
-    if (binGridCntX_ != 0 && binGridCntY_ != 0) {
-      nbVars.isSetBinCnt = 1;
-      nbVars.binCntX = binGridCntX_;
-      nbVars.binCntY = binGridCntY_;
-    }
-
-    nbVars.useUniformTargetDensity = uniformTargetDensityMode_;
-
+    NesterovBaseVars nbVars = nesterovBaseVars();
     nbc_ = std::make_shared<NesterovBaseCommon>(nbVars, pbc_, log_);
 
     for (const auto& pb : pbVec_) {
@@ -357,6 +354,7 @@ bool Replace::initNesterovPlace()
     rbVars.rcK2 = routabilityRcK2_;
     rbVars.rcK3 = routabilityRcK3_;
     rbVars.rcK4 = routabilityRcK4_;
+    rbVars.useRudy = routabilityUseRudy_;
 
     rb_ = std::make_shared<RouteBase>(rbVars, db_, fr_, nbc_, nbVec_, log_);
   }
@@ -365,6 +363,8 @@ bool Replace::initNesterovPlace()
     tb_ = std::make_shared<TimingBase>(nbc_, rs_, log_);
     tb_->setTimingNetWeightOverflows(timingNetWeightOverflows_);
     tb_->setTimingNetWeightMax(timingNetWeightMax_);
+    // moves within a row barely change the Steiner estimates
+    tb_->setIncremental(timingDrivenIncremental_, pbc_->siteSizeY());
   }
 
   if (!np_) {
@@ -385,6 +385,8 @@ bool Replace::initNesterovPlace()
     npVars.debug_update_iterations = gui_debug_update_iterations_;
     npVars.debug_draw_bins = gui_debug_draw_bins_;
     npVars.debug_inst = gui_debug_inst_;
+    npVars.checkpointFile = checkpointFile_;
+    npVars.checkpointOverflows = checkpointOverflows_;
 
     for (const auto& nb : nbVec_) {
       nb->setNpVars(&npVars);
@@ -398,13 +400,64 @@ bool Replace::initNesterovPlace()
   return true;
 }
 
+NesterovBaseVars Replace::nesterovBaseVars() const
+{
+  NesterovBaseVars nbVars;
+  nbVars.targetDensity = density_;
+
+  if (binGridCntX_ != 0 && binGridCntY_ != 0) {
+    nbVars.isSetBinCnt = 1;
+    nbVars.binCntX = binGridCntX_;
+    nbVars.binCntY = binGridCntY_;
+  }
+
+  nbVars.useUniformTargetDensity = uniformTargetDensityMode_;
+  nbVars.numThreads = numThreads_;
+  nbVars.useLegacyFFT = legacyFFT_;
+  return nbVars;
+}
+
+void Replace::doMultilevelPlace()
+{
+  initPlacerBase();
+  if (total_placeable_insts_ == 0) {
+    return;
+  }
+
+  MultilevelPlaceVars mlVars;
+  mlVars.maxLevels = multilevelLevels_;
+
+  NesterovPlaceVars npVars;
+  npVars.minPhiCoef = minPhiCoef_;
+  npVars.maxPhiCoef = maxPhiCoef_;
+  npVars.referenceHpwl = referenceHpwl_;
+  npVars.initDensityPenalty = initDensityPenalityFactor_;
+  npVars.initWireLengthCoef = initWireLengthCoef_;
+  npVars.targetOverflow = overflow_;
+  npVars.maxNesterovIter = nesterovPlaceMaxIter_;
+
+  MultilevelPlace mp(mlVars, nesterovBaseVars(), npVars, pbc_, pbVec_, log_);
+  mp.doMultilevelPlace();
+}
+
 int Replace::doNesterovPlace(int start_iter)
 {
+  // Place the clustered coarse levels first to seed the flat placement.
+  // This has to happen before the flat GCells are built from the place
+  // instances.  A resumed checkpoint already holds the flat locations.
+  if (multilevelLevels_ > 0 && !nbc_ && start_iter == 0
+      && resumeCheckpoint_.empty()) {
+    doMultilevelPlace();
+  }
   if (!initNesterovPlace()) {
     return 0;
   }
   if (timingDrivenMode_)
     rs_->resizeSlackPreamble();
+  if (!resumeCheckpoint_.empty()) {
+    start_iter = np_->restoreCheckpoint(resumeCheckpoint_, resumeOverflow_);
+    resumeCheckpoint_.clear();
+  }
   return np_->doNesterovPlace(start_iter);
 }
 
@@ -433,6 +486,11 @@ void Replace::setInitialPlaceNetWeightScale(float scale)
   initialPlaceNetWeightScale_ = scale;
 }
 
+void Replace::setInitialPlaceIncompleteCholesky(bool mode)
+{
+  initialPlaceIncompleteCholesky_ = mode;
+}
+
 void Replace::setNesterovPlaceMaxIter(int iter)
 {
   nesterovPlaceMaxIter_ = iter;
@@ -441,6 +499,11 @@ void Replace::setNesterovPlaceMaxIter(int iter)
   }
 }
 
+void Replace::setMultilevelLevels(int levels)
+{
+  multilevelLevels_ = levels;
+}
+
 void Replace::setBinGridCnt(int binGridCntX, int binGridCntY)
 {
   binGridCntX_ = binGridCntX;
@@ -521,11 +584,26 @@ void Replace::setForceCPU(bool force_cpu)
   forceCPU_ = force_cpu;
 }
 
+void Replace::setNumThreads(int threads)
+{
+  numThreads_ = threads;
+}
+
+void Replace::setLegacyFFT(bool legacy_fft)
+{
+  legacyFFT_ = legacy_fft;
+}
+
 void Replace::setTimingDrivenMode(bool mode)
 {
   timingDrivenMode_ = mode;
 }
 
+void Replace::setTimingDrivenIncremental(bool mode)
+{
+  timingDrivenIncremental_ = mode;
+}
+
 void Replace::setRoutabilityDrivenMode(bool mode)
 {
   routabilityDrivenMode_ = mode;
@@ -551,6 +629,11 @@ void Replace::setRoutabilityMaxInflationIter(int iter)
   routabilityMaxInflationIter_ = iter;
 }
 
+void Replace::setRoutabilityUseRudy(bool mode)
+{
+  routabilityUseRudy_ = mode;
+}
+
 void Replace::setRoutabilityTargetRcMetric(float rc)
 {
   routabilityTargetRcMetric_ = rc;
@@ -587,6 +670,22 @@ void Replace::setPadRight(int pad)
   padRight_ = pad;
 }
 
+void Replace::setCheckpointFile(const std::string& file)
+{
+  checkpointFile_ = file;
+}
+
+void Replace::addCheckpointOverflow(float overflow)
+{
+  checkpointOverflows_.push_back(overflow);
+}
+
+void Replace::setResumeCheckpoint(const std::string& file, float overflow)
+{
+  resumeCheckpoint_ = file;
+  resumeOverflow_ = overflow;
+}
+
 void Replace::addTimingNetWeightOverflow(int overflow)
 {
   timingNetWeightOverflows_.push_back(overflow);
@@ -71,6 +71,34 @@ set_initial_place_max_fanout_cmd(int fanout)
   replace->setInitialPlaceMaxFanout(fanout);
 }
 
+void
+set_initial_place_ic_preconditioner_cmd(bool mode)
+{
+  Replace* replace = getReplace();
+  replace->setInitialPlaceIncompleteCholesky(mode);
+}
+
+void
+set_checkpoint_file_cmd(const char* file)
+{
+  Replace* replace = getReplace();
+  replace->setCheckpointFile(file);
+}
+
+void
+add_checkpoint_overflow_cmd(float overflow)
+{
+  Replace* replace = getReplace();
+  replace->addCheckpointOverflow(overflow);
+}
+
+void
+set_resume_checkpoint_cmd(const char* file, float overflow)
+{
+  Replace* replace = getReplace();
+  replace->setResumeCheckpoint(file, overflow);
+}
+
 void
 set_nesv_place_iter_cmd(int iter)
 {
@@ -142,12 +170,32 @@ set_force_cpu(bool force_cpu)
   replace->setForceCPU(force_cpu);
 }
 
+void
+set_num_threads(int threads)
+{
+  Replace* replace = getReplace();
+  replace->setNumThreads(threads);
+}
+
+void
+set_legacy_fft(bool legacy_fft)
+{
+  Replace* replace = getReplace();
+  replace->setLegacyFFT(legacy_fft);
+}
+
 void set_timing_driven_mode(bool timing_driven)
 {
   Replace* replace = getReplace();
   replace->setTimingDrivenMode(timing_driven);
 }
 
+void set_timing_driven_incremental_mode(bool incremental)
+{
+  Replace* replace = getReplace();
+  replace->setTimingDrivenIncremental(incremental);
+}
+
 
 void
 set_routability_driven_mode(bool routability_driven)
@@ -184,6 +232,20 @@ set_routability_max_inflation_iter_cmd(int iter)
   replace->setRoutabilityMaxInflationIter(iter);
 }
 
+void
+set_multilevel_levels_cmd(int levels)
+{
+  Replace* replace = getReplace();
+  replace->setMultilevelLevels(levels);
+}
+
+void
+set_routability_use_rudy_cmd(bool use_rudy)
+{
+  Replace* replace = getReplace();
+  replace->setRoutabilityUseRudy(use_rudy);
+}
+
 void
 set_routability_target_rc_metric_cmd(float rc)
 {
@@ -33,13 +33,17 @@
 
 sta::define_cmd_args "global_placement" {\
     [-skip_initial_place]\
+    [-initial_place_ic_preconditioner]\
     [-skip_nesterov_place]\
     [-timing_driven]\
+    [-timing_driven_incremental]\
     [-routability_driven]\
     [-disable_timing_driven]\
     [-disable_routability_driven]\
+    [-routability_use_rudy]\
     [-incremental]\
     [-force_cpu]\
+    [-dct_fft]\
     [-skip_io]\
     [-bin_grid_count grid_count]\
     [-density target_density]\
@@ -51,6 +55,7 @@ sta::define_cmd_args "global_placement" {\
     [-overflow overflow]\
     [-initial_place_max_iter initial_place_max_iter]\
     [-initial_place_max_fanout initial_place_max_fanout]\
+    [-multilevel_levels multilevel_levels]\
     [-routability_check_overflow routability_check_overflow]\
     [-routability_max_density routability_max_density]\
     [-routability_max_bloat_iter routability_max_bloat_iter]\
@@ -62,6 +67,10 @@ sta::define_cmd_args "global_placement" {\
     [-timing_driven_net_reweight_overflow timing_driven_net_reweight_overflow]\
     [-timing_driven_net_weight_max timing_driven_net_weight_max]\
     [-timing_driven_nets_percentage timing_driven_nets_percentage]\
+    [-checkpoint_file checkpoint_file]\
+    [-checkpoint_overflows checkpoint_overflows]\
+    [-resume_checkpoint resume_checkpoint]\
+    [-resume_overflow resume_overflow]\
     [-pad_left pad_left]\
     [-pad_right pad_right]\
 }
@@ -73,6 +82,7 @@ proc global_placement { args } {
       -min_phi_coef -max_phi_coef -overflow \
       -reference_hpwl \
       -initial_place_max_iter -initial_place_max_fanout \
+      -multilevel_levels \
       -routability_check_overflow -routability_max_density \
       -routability_max_bloat_iter -routability_max_inflation_iter \
       -routability_target_rc_metric \
@@ -82,16 +92,22 @@ proc global_placement { args } {
       -timing_driven_net_reweight_overflow \
       -timing_driven_net_weight_max \
       -timing_driven_nets_percentage \
+      -checkpoint_file -checkpoint_overflows \
+      -resume_checkpoint -resume_overflow \
       -pad_left -pad_right} \
     flags {-skip_initial_place \
+      -initial_place_ic_preconditioner \
       -skip_nesterov_place \
       -timing_driven \
+      -timing_driven_incremental \
       -routability_driven \
       -disable_timing_driven \
       -disable_routability_driven \
+      -routability_use_rudy \
       -skip_io \
       -incremental\
-      -force_cpu}
+      -force_cpu\
+      -dct_fft}
 
   # flow control for initial_place
   if { [info exists flags(-skip_initial_place)] } {
@@ -102,9 +118,40 @@ proc global_placement { args } {
     gpl::set_initial_place_max_iter_cmd $initial_place_max_iter
   }
 
+  gpl::set_initial_place_ic_preconditioner_cmd \
+    [info exists flags(-initial_place_ic_preconditioner)]
+
+  # checkpoints of the Nesterov state
+  if { [info exists keys(-checkpoint_file)] } {
+    gpl::set_checkpoint_file_cmd $keys(-checkpoint_file)
+    if { [info exists keys(-checkpoint_overflows)] } {
+      set checkpoint_overflows $keys(-checkpoint_overflows)
+    } else {
+      set checkpoint_overflows [list 0.3]
+    }
+    foreach overflow $checkpoint_overflows {
+      sta::check_positive_float "-checkpoint_overflows" $overflow
+      gpl::add_checkpoint_overflow_cmd $overflow
+    }
+  }
+
+  if { [info exists keys(-resume_checkpoint)] } {
+    set resume_overflow 0.3
+    if { [info exists keys(-resume_overflow)] } {
+      set resume_overflow $keys(-resume_overflow)
+      sta::check_positive_float "-resume_overflow" $resume_overflow
+    }
+    gpl::set_resume_checkpoint_cmd $keys(-resume_checkpoint) $resume_overflow
+    # the checkpoint replaces the initial placement
+    gpl::set_initial_place_max_iter_cmd 0
+  }
+
   set force_cpu [info exists flags(-force_cpu)]
   gpl::set_force_cpu $force_cpu
 
+  gpl::set_num_threads [ord::thread_count]
+  gpl::set_legacy_fft [expr ![info exists flags(-dct_fft)]]
+
   set skip_io [info exists flags(-skip_io)]
   gpl::set_skip_io_mode_cmd $skip_io
   if { $skip_io } {
@@ -113,6 +160,8 @@ proc global_placement { args } {
 
   set timing_driven [info exists flags(-timing_driven)]
   gpl::set_timing_driven_mode $timing_driven
+  gpl::set_timing_driven_incremental_mode \
+    [info exists flags(-timing_driven_incremental)]
   if { $timing_driven } {
     if { [get_libs -quiet "*"] == {} } {
       utl::error GPL 121 "No liberty libraries found."
@@ -154,6 +203,7 @@ proc global_placement { args } {
       gpl::set_routability_driven_mode 0 
     }
   }
+  gpl::set_routability_use_rudy_cmd [info exists flags(-routability_use_rudy)]
   if { [info exists flags(-disable_routability_driven)] } {
     utl::warn "GPL" 116 "-disable_routability_driven is deprecated."
   }
@@ -163,6 +213,12 @@ proc global_placement { args } {
     sta::check_positive_integer "-initial_place_max_fanout" $initial_place_max_fanout
     gpl::set_initial_place_max_fanout_cmd $initial_place_max_fanout
   }
+
+  if { [info exists keys(-multilevel_levels)] } {
+    set multilevel_levels $keys(-multilevel_levels)
+    sta::check_positive_integer "-multilevel_levels" $multilevel_levels
+    gpl::set_multilevel_levels_cmd $multilevel_levels
+  }
   
   # density settings    
   set target_density 0.7
@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -75,6 +76,7 @@ Tile::Tile(int x, int y, int lx, int ly, int ux, int uy, int layers) : Tile()
   ly_ = ly;
   ux_ = ux;
   uy_ = uy;
+  usageRatio_.assign(layers, std::numeric_limits<float>::lowest());
 }
 
 Tile::~Tile()
@@ -88,6 +90,7 @@ void Tile::reset()
   inflationRatio_ = 1.0;
 
   inflatedRatio_ = 0;
+  usageRatio_.clear();
 }
 
 float Tile::inflationRatio() const
@@ -288,6 +291,8 @@ void RouteBaseVars::reset()
   rcK3 = rcK4 = 0.0;
   maxBloatIter = 1;
   maxInflationIter = 4;
+  useRudy = false;
+  rudyPinWeight = 0.1;
 }
 
 /////////////////////////////////////////////
@@ -347,6 +352,8 @@ void RouteBase::reset()
   minRcCellSize_.clear();
   minRcCellSize_.shrink_to_fit();
 
+  routeCap_ = RouteCapacity();
+
   resetRoutabilityResources();
 }
 
@@ -476,6 +483,25 @@ void RouteBase::updateRoute()
   tg_->initTiles();
 
   for (int i = 1; i <= numLayers; i++) {
+    odb::dbTechLayer* layer = tech->findRoutingLayer(i);
+    for (auto& tile : tg_->tiles()) {
+      tile->setUsageRatio(
+          i,
+          getUsageCapacityRatio(tile, layer, gGrid, rbVars_.ignoreEdgeRatio));
+    }
+  }
+
+  if (rbVars_.useRudy) {
+    captureRouteCapacity(gGrid);
+  }
+
+  updateInflationRatio(true);
+}
+
+void RouteBase::updateInflationRatio(bool edgeBased)
+{
+  odb::dbTech* tech = db_->getTech();
+  for (int i = 1; i <= tg_->numRoutingLayers(); i++) {
     odb::dbTechLayer* layer = tech->findRoutingLayer(i);
     bool isHorizontalLayer
         = (layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL);
@@ -486,29 +512,24 @@ void RouteBase::updateRoute()
       // TileGrid setup.
 
       // first extract current tiles' usage
-      float ratio
-          = getUsageCapacityRatio(tile, layer, gGrid, rbVars_.ignoreEdgeRatio);
+      float ratio = tile->usageRatio(i);
 
       // if horizontal layer (i.e., vertical edges)
       // should consider LEFT tile's RIGHT edge == current 'tile's LEFT edge
       // (current 'ratio' points to RIGHT edges usage)
-      if (isHorizontalLayer && tile->x() >= 1) {
+      if (edgeBased && isHorizontalLayer && tile->x() >= 1) {
         Tile* leftTile
             = tg_->tiles()[tile->y() * tg_->tileCntX() + tile->x() - 1];
-        float leftRatio = getUsageCapacityRatio(
-            leftTile, layer, gGrid, rbVars_.ignoreEdgeRatio);
-        ratio = fmax(leftRatio, ratio);
+        ratio = fmax(leftTile->usageRatio(i), ratio);
       }
 
       // if vertical layer (i.e., horizontal edges)
       // should consider DOWN tile's UP edge == current 'tile's DOWN edge
       // (current 'ratio' points to UP edges usage)
-      if (!isHorizontalLayer && tile->y() >= 1) {
+      if (edgeBased && !isHorizontalLayer && tile->y() >= 1) {
         Tile* downTile
             = tg_->tiles()[(tile->y() - 1) * tg_->tileCntX() + tile->x()];
-        float downRatio = getUsageCapacityRatio(
-            downTile, layer, gGrid, rbVars_.ignoreEdgeRatio);
-        ratio = fmax(downRatio, ratio);
+        ratio = fmax(downTile->usageRatio(i), ratio);
       }
 
       ratio = fmax(ratio, 0.0f);
@@ -556,6 +577,199 @@ void RouteBase::updateRoute()
   }
 }
 
+void RouteBase::captureRouteCapacity(odb::dbGCellGrid* gGrid)
+{
+  odb::dbTech* tech = db_->getTech();
+  routeCap_.lx = tg_->lx();
+  routeCap_.ly = tg_->ly();
+  routeCap_.tileSizeX = tg_->tileSizeX();
+  routeCap_.tileSizeY = tg_->tileSizeY();
+  routeCap_.tileCntX = tg_->tileCntX();
+  routeCap_.tileCntY = tg_->tileCntY();
+  routeCap_.numLayers = tg_->numRoutingLayers();
+
+  const size_t tileCnt = tg_->tiles().size();
+  routeCap_.isHorizontal.assign(routeCap_.numLayers, 0);
+  routeCap_.capacity.assign(routeCap_.numLayers * tileCnt, 0);
+  routeCap_.blockage.assign(routeCap_.numLayers * tileCnt, 0);
+
+  // wire tracks the router actually used, to calibrate RUDY against
+  double routedH = 0, routedV = 0;
+  for (int i = 1; i <= routeCap_.numLayers; i++) {
+    odb::dbTechLayer* layer = tech->findRoutingLayer(i);
+    const bool isHorizontal
+        = (layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL);
+    routeCap_.isHorizontal[i - 1] = isHorizontal;
+
+    for (size_t t = 0; t < tileCnt; t++) {
+      const Tile* tile = tg_->tiles()[t];
+      unsigned int capH = 0, capV = 0, capU = 0;
+      unsigned int useH = 0, useV = 0, useU = 0;
+      unsigned int blockH = 0, blockV = 0, blockU = 0;
+      gGrid->getCapacity(layer, tile->x(), tile->y(), capH, capV, capU);
+      gGrid->getUsage(layer, tile->x(), tile->y(), useH, useV, useU);
+      gGrid->getBlockage(layer, tile->x(), tile->y(), blockH, blockV, blockU);
+
+      const unsigned int use = isHorizontal ? useH : useV;
+      const unsigned int blockage = isHorizontal ? blockH : blockV;
+      routeCap_.capacity[(i - 1) * tileCnt + t] = isHorizontal ? capH : capV;
+      routeCap_.blockage[(i - 1) * tileCnt + t] = blockage;
+
+      const double wire = use > blockage ? use - blockage : 0;
+      (isHorizontal ? routedH : routedV) += wire;
+    }
+  }
+
+  std::vector<float> demandH, demandV;
+  std::vector<int> pinCnt;
+  computeRudyDemand(demandH, demandV, pinCnt);
+  double rudyH = 0, rudyV = 0;
+  for (size_t t = 0; t < tileCnt; t++) {
+    rudyH += demandH[t];
+    rudyV += demandV[t];
+  }
+
+  routeCap_.scaleH = (rudyH > 0 && routedH > 0) ? routedH / rudyH : 1.0;
+  routeCap_.scaleV = (rudyV > 0 && routedV > 0) ? routedV / rudyV : 1.0;
+  log_->info(GPL,
+             307,
+             "RUDY calibration scale H: {:.3f} V: {:.3f}",
+             routeCap_.scaleH,
+             routeCap_.scaleV);
+}
+
+// RUDY: each net spreads its horizontal (vertical) wirelength, i.e. the
+// width (height) of its bounding box, uniformly over that box. Boxes
+// narrower than a tile are widened to one tile so straight nets still
+// land in the tiles they cross. Demand is in tracks: wirelength in a
+// tile divided by the tile's length along the wire.
+void RouteBase::computeRudyDemand(std::vector<float>& demandH,
+                                  std::vector<float>& demandV,
+                                  std::vector<int>& pinCnt)
+{
+  const RouteCapacity& rc = routeCap_;
+  const int tileCnt = rc.tileCntX * rc.tileCntY;
+  const int gridUx = rc.lx + rc.tileCntX * rc.tileSizeX;
+  const int gridUy = rc.ly + rc.tileCntY * rc.tileSizeY;
+
+  demandH.assign(tileCnt, 0.0f);
+  demandV.assign(tileCnt, 0.0f);
+  pinCnt.assign(tileCnt, 0);
+
+  for (auto& gNet : nbc_->gNets()) {
+    if (gNet->gPins().size() < 2) {
+      continue;
+    }
+    gNet->updateBox();
+
+    const int width = gNet->ux() - gNet->lx();
+    const int height = gNet->uy() - gNet->ly();
+
+    int lx = gNet->lx(), ux = gNet->ux();
+    if (width < rc.tileSizeX) {
+      lx = (gNet->lx() + gNet->ux() - rc.tileSizeX) / 2;
+      ux = lx + rc.tileSizeX;
+    }
+    int ly = gNet->ly(), uy = gNet->uy();
+    if (height < rc.tileSizeY) {
+      ly = (gNet->ly() + gNet->uy() - rc.tileSizeY) / 2;
+      uy = ly + rc.tileSizeY;
+    }
+
+    const double area = static_cast<double>(ux - lx) * (uy - ly);
+    const double densityH = width / area / rc.tileSizeX;
+    const double densityV = height / area / rc.tileSizeY;
+
+    lx = std::max(lx, rc.lx);
+    ly = std::max(ly, rc.ly);
+    ux = std::min(ux, gridUx);
+    uy = std::min(uy, gridUy);
+    if (lx >= ux || ly >= uy) {
+      continue;
+    }
+
+    const int minX = (lx - rc.lx) / rc.tileSizeX;
+    const int maxX = (ux - 1 - rc.lx) / rc.tileSizeX;
+    const int minY = (ly - rc.ly) / rc.tileSizeY;
+    const int maxY = (uy - 1 - rc.ly) / rc.tileSizeY;
+    for (int y = minY; y <= maxY; y++) {
+      const int tileLy = rc.ly + y * rc.tileSizeY;
+      const int overlapY
+          = std::min(uy, tileLy + rc.tileSizeY) - std::max(ly, tileLy);
+      for (int x = minX; x <= maxX; x++) {
+        const int tileLx = rc.lx + x * rc.tileSizeX;
+        const int overlapX
+            = std::min(ux, tileLx + rc.tileSizeX) - std::max(lx, tileLx);
+        const double overlap = static_cast<double>(overlapX) * overlapY;
+        demandH[y * rc.tileCntX + x] += overlap * densityH;
+        demandV[y * rc.tileCntX + x] += overlap * densityV;
+      }
+    }
+  }
+
+  for (auto& gPin : nbc_->gPins()) {
+    if (gPin->cx() < rc.lx || gPin->cx() >= gridUx || gPin->cy() < rc.ly
+        || gPin->cy() >= gridUy) {
+      continue;
+    }
+    const int x = (gPin->cx() - rc.lx) / rc.tileSizeX;
+    const int y = (gPin->cy() - rc.ly) / rc.tileSizeY;
+    pinCnt[y * rc.tileCntX + x]++;
+  }
+}
+
+void RouteBase::getRudyResult()
+{
+  const RouteCapacity& rc = routeCap_;
+  tg_->setNumRoutingLayers(rc.numLayers);
+  tg_->setLx(rc.lx);
+  tg_->setLy(rc.ly);
+  tg_->setTileSize(rc.tileSizeX, rc.tileSizeY);
+  tg_->setTileCnt(rc.tileCntX, rc.tileCntY);
+  tg_->initTiles();
+
+  std::vector<float> demandH, demandV;
+  std::vector<int> pinCnt;
+  computeRudyDemand(demandH, demandV, pinCnt);
+
+  // Each direction's demand is shared by the layers of that direction
+  // in proportion to their free tracks; layers the router would skip
+  // (no capacity or mostly blocked) get no share, as in getRC().
+  const size_t tileCnt = tg_->tiles().size();
+  for (size_t t = 0; t < tileCnt; t++) {
+    Tile* tile = tg_->tiles()[t];
+    const float pinTracks = rbVars_.rudyPinWeight * pinCnt[t];
+    const double demand[2] = {rc.scaleV * demandV[t] + pinTracks,
+                              rc.scaleH * demandH[t] + pinTracks};
+
+    double freeTracks[2] = {0, 0};
+    for (int i = 1; i <= rc.numLayers; i++) {
+      const unsigned int cap = rc.capacity[(i - 1) * tileCnt + t];
+      const unsigned int blockage = rc.blockage[(i - 1) * tileCnt + t];
+      if (cap == 0
+          || static_cast<float>(blockage) / cap >= rbVars_.ignoreEdgeRatio) {
+        continue;
+      }
+      freeTracks[rc.isHorizontal[i - 1] ? 1 : 0] += cap - blockage;
+    }
+
+    for (int i = 1; i <= rc.numLayers; i++) {
+      const unsigned int cap = rc.capacity[(i - 1) * tileCnt + t];
+      const unsigned int blockage = rc.blockage[(i - 1) * tileCnt + t];
+      const int dir = rc.isHorizontal[i - 1] ? 1 : 0;
+      if (cap == 0
+          || static_cast<float>(blockage) / cap >= rbVars_.ignoreEdgeRatio) {
+        tile->setUsageRatio(i, std::numeric_limits<float>::lowest());
+        continue;
+      }
+      const double share = demand[dir] * (cap - blockage) / freeTracks[dir];
+      tile->setUsageRatio(i, (blockage + share) / cap);
+    }
+  }
+
+  updateInflationRatio(false);
+}
+
 // first: is Routability Need
 // second: reverting procedure init need
 //          (e.g. calling NesterovPlace's init())
@@ -568,11 +782,30 @@ std::pair<bool, bool> RouteBase::routability()
   tg_ = std::move(tg);
   tg_->setLogger(log_);
 
-  getGlobalRouterResult();
+  const bool useRudy = rbVars_.useRudy && routeCap_.valid();
+  if (useRudy) {
+    getRudyResult();
+  } else {
+    getGlobalRouterResult();
+  }
 
   // no need routing if RC is lower than targetRC val
   float curRc = getRC();
 
+  // RUDY only decides to keep going; stopping is confirmed by a full
+  // global route, which also recalibrates the estimator
+  if (useRudy && curRc < rbVars_.targetRC) {
+    log_->info(GPL,
+               308,
+               "RUDY RC {:.4f} is below the target, checking with the "
+               "global router.",
+               curRc);
+    tg_ = std::make_unique<TileGrid>();
+    tg_->setLogger(log_);
+    getGlobalRouterResult();
+    curRc = getRC();
+  }
+
   if (curRc < rbVars_.targetRC) {
     resetRoutabilityResources();
     return make_pair(false, false);
@@ -764,7 +997,6 @@ float RouteBase::getRC() const
   std::vector<double> horEdgeCongArray;
   std::vector<double> verEdgeCongArray;
 
-  odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
   for (auto& tile : tg_->tiles()) {
     for (int i = 1; i <= tg_->numRoutingLayers(); i++) {
       odb::dbTechLayer* layer = db_->getTech()->findRoutingLayer(i);
@@ -772,8 +1004,7 @@ float RouteBase::getRC() const
           = (layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL);
 
       // extract the ratio in the same way as inflation ratio cals
-      float ratio
-          = getUsageCapacityRatio(tile, layer, gGrid, rbVars_.ignoreEdgeRatio);
+      float ratio = tile->usageRatio(i);
 
       // escape the case when blockageRatio is too huge
       if (ratio >= 0.0f) {
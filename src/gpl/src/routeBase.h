@@ -38,6 +38,7 @@
 
 namespace odb {
 class dbDatabase;
+class dbGCellGrid;
 }
 
 namespace grt {
@@ -78,8 +79,13 @@ class Tile
   float inflationRatio() const;
   float inflatedRatio() const;
 
+  // (used tracks + blockage) / capacity of a routing layer (1-based);
+  // lowest() when the layer is unusable in this tile
+  float usageRatio(int layer) const;
+
   // setter funcs
   void setInflationRatio(float ratio);
+  void setUsageRatio(int layer, float ratio);
 
   // accumulated Ratio as iteration goes on
   void setInflatedRatio(float ratio);
@@ -101,6 +107,8 @@ class Tile
   float inflationRatio_;
   float inflatedRatio_;
 
+  std::vector<float> usageRatio_;
+
   void reset();
 };
 
@@ -139,6 +147,16 @@ inline int64_t Tile::area() const
   return static_cast<int64_t>(ux_ - lx_) * static_cast<int64_t>(uy_ - ly_);
 }
 
+inline float Tile::usageRatio(int layer) const
+{
+  return usageRatio_[layer - 1];
+}
+
+inline void Tile::setUsageRatio(int layer, float ratio)
+{
+  usageRatio_[layer - 1] = ratio;
+}
+
 class TileGrid
 {
  public:
@@ -212,10 +230,37 @@ class RouteBaseVars
   int maxBloatIter;
   int maxInflationIter;
 
+  // estimate congestion with RUDY between full global routes
+  bool useRudy;
+  // tracks each pin takes from its tile in both directions
+  float rudyPinWeight;
+
   RouteBaseVars();
   void reset();
 };
 
+// Routing resources of the GlobalRouter grid, captured by the last full
+// global route and reused by rounds that use the RUDY estimator.
+// Per-layer vectors are indexed [(layer - 1) * tileCnt + tileIdx].
+struct RouteCapacity
+{
+  int lx = 0;
+  int ly = 0;
+  int tileSizeX = 0;
+  int tileSizeY = 0;
+  int tileCntX = 0;
+  int tileCntY = 0;
+  int numLayers = 0;
+  std::vector<char> isHorizontal;  // per layer
+  std::vector<unsigned int> capacity;
+  std::vector<unsigned int> blockage;
+  // routed wire tracks / RUDY tracks of the calibrating route
+  double scaleH = 1.0;
+  double scaleV = 1.0;
+
+  bool valid() const { return numLayers > 0; }
+};
+
 class RouteBase
 {
  public:
@@ -233,6 +278,10 @@ class RouteBase
   void updateRoute();
   void getGlobalRouterResult();
 
+  // update Route and Est info from the RUDY estimator
+  // (requires a previous getGlobalRouterResult)
+  void getRudyResult();
+
   // first: is Routability Need
   // second: reverting procedure need in NesterovPlace
   //         (e.g. calling NesterovPlace's init())
@@ -257,6 +306,7 @@ class RouteBase
   utl::Logger* log_;
 
   std::unique_ptr<TileGrid> tg_;
+  RouteCapacity routeCap_;
 
   int64_t inflatedAreaDelta_;
 
@@ -282,5 +332,15 @@ class RouteBase
 
   // routability funcs
   void initGCells();
+
+  // set tile inflation ratios from the tile usage ratios.
+  // edgeBased: ratios describe the tile's right/up edge (GlobalRouter)
+  void updateInflationRatio(bool edgeBased);
+
+  // RUDY wire demand (tracks) and pin counts on the routeCap_ grid
+  void computeRudyDemand(std::vector<float>& demandH,
+                         std::vector<float>& demandV,
+                         std::vector<int>& pinCnt);
+  void captureRouteCapacity(odb::dbGCellGrid* gGrid);
 };
 }  // namespace gpl
@@ -35,6 +35,11 @@
 
 #include "solver.h"
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
 namespace gpl {
 
 #ifdef ENABLE_GPU
@@ -58,6 +63,119 @@ ResidualError cudaSparseSolve(int iter,
   return error;
 }
 #endif
+
+namespace {
+
+// Dot products are summed in fixed chunks so that the result does not
+// depend on the number of threads.
+constexpr int kDotChunk = 4096;
+
+// One system of the joint CG solve
+struct CgSystem
+{
+  const SMatrix* matrix = nullptr;
+  const Eigen::VectorXf* rhs = nullptr;
+  Eigen::VectorXf* sol = nullptr;
+
+  Eigen::VectorXf residual;
+  Eigen::VectorXf precond;  // z = M^-1 r
+  Eigen::VectorXf dir;      // search direction p
+  Eigen::VectorXf product;  // A p
+  Eigen::VectorXf invDiag;
+  std::unique_ptr<Eigen::IncompleteCholesky<float>> ic;
+
+  double rz = 0;
+  double rhsNorm = 0;
+  float error = 0;
+  bool done = false;
+};
+
+double dot(const Eigen::VectorXf& a, const Eigen::VectorXf& b, int numThreads)
+{
+  const int size = a.size();
+  const int numChunks = (size + kDotChunk - 1) / kDotChunk;
+  std::vector<double> partial(numChunks, 0);
+
+#pragma omp parallel for num_threads(numThreads)
+  for (int c = 0; c < numChunks; c++) {
+    const int end = std::min(size, (c + 1) * kDotChunk);
+    double sum = 0;
+    for (int i = c * kDotChunk; i < end; i++) {
+      sum += static_cast<double>(a[i]) * b[i];
+    }
+    partial[c] = sum;
+  }
+
+  double sum = 0;
+  for (double value : partial) {
+    sum += value;
+  }
+  return sum;
+}
+
+// y = A x on the rows of the row-major matrices of every active system
+void multiply(std::vector<CgSystem*>& systems,
+              const std::vector<const Eigen::VectorXf*>& in,
+              const std::vector<Eigen::VectorXf*>& out,
+              int numThreads)
+{
+  const int size = systems[0]->matrix->rows();
+
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+  for (int row = 0; row < size; row++) {
+    for (size_t s = 0; s < systems.size(); s++) {
+      const SMatrix& matrix = *systems[s]->matrix;
+      const Eigen::VectorXf& x = *in[s];
+      float sum = 0;
+      for (SMatrix::InnerIterator it(matrix, row); it; ++it) {
+        sum += it.value() * x[it.col()];
+      }
+      (*out[s])[row] = sum;
+    }
+  }
+}
+
+void applyPreconditioner(CgSystem& system, int numThreads)
+{
+  if (system.ic) {
+    system.precond = system.ic->solve(system.residual);
+    return;
+  }
+
+  const int size = system.residual.size();
+#pragma omp parallel for num_threads(numThreads)
+  for (int i = 0; i < size; i++) {
+    system.precond[i] = system.invDiag[i] * system.residual[i];
+  }
+}
+
+void initPreconditioner(CgSystem& system,
+                        bool useIncompleteCholesky,
+                        utl::Logger* logger)
+{
+  if (useIncompleteCholesky) {
+    system.ic = std::make_unique<Eigen::IncompleteCholesky<float>>();
+    system.ic->compute(Eigen::SparseMatrix<float>(*system.matrix));
+    if (system.ic->info() == Eigen::Success) {
+      return;
+    }
+    logger->warn(GPL,
+                 252,
+                 "IC(0) factorization failed, using the Jacobi "
+                 "preconditioner.");
+    system.ic.reset();
+  }
+
+  // empty rows belong to unconnected instances and keep a unit diagonal
+  const Eigen::VectorXf diag = system.matrix->diagonal();
+  system.invDiag.resize(diag.size());
+  for (int i = 0; i < diag.size(); i++) {
+    system.invDiag[i] = diag[i] != 0 ? 1.0f / diag[i] : 1.0f;
+  }
+}
+
+}  // namespace
+
 ResidualError cpuSparseSolve(int maxSolverIter,
                              int iter,
                              SMatrix& placeInstForceMatrixX,
@@ -66,18 +184,112 @@ ResidualError cpuSparseSolve(int maxSolverIter,
                              SMatrix& placeInstForceMatrixY,
                              Eigen::VectorXf& fixedInstForceVecY,
                              Eigen::VectorXf& instLocVecY,
+                             int numThreads,
+                             bool useIncompleteCholesky,
                              utl::Logger* logger)
 {
+  // same stopping criterion as the Eigen iterative solvers
+  const double tolerance = Eigen::NumTraits<float>::epsilon();
+  const int size = instLocVecX.size();
+
+  CgSystem systems[2];
+  systems[0].matrix = &placeInstForceMatrixX;
+  systems[0].rhs = &fixedInstForceVecX;
+  systems[0].sol = &instLocVecX;
+  systems[1].matrix = &placeInstForceMatrixY;
+  systems[1].rhs = &fixedInstForceVecY;
+  systems[1].sol = &instLocVecY;
+
+  std::vector<CgSystem*> active;
+  std::vector<const Eigen::VectorXf*> in;
+  std::vector<Eigen::VectorXf*> out;
+  for (CgSystem& system : systems) {
+    initPreconditioner(system, useIncompleteCholesky, logger);
+    system.residual.resize(size);
+    system.precond.resize(size);
+    system.product.resize(size);
+    active.push_back(&system);
+    in.push_back(system.sol);
+    out.push_back(&system.product);
+  }
+
+  // r = b - A x for the warm start x
+  multiply(active, in, out, numThreads);
+  for (CgSystem& system : systems) {
+    system.residual = *system.rhs - system.product;
+    system.rhsNorm = std::sqrt(dot(*system.rhs, *system.rhs, numThreads));
+    if (system.rhsNorm == 0) {
+      system.sol->setZero();
+      system.done = true;
+      continue;
+    }
+    system.error
+        = std::sqrt(dot(system.residual, system.residual, numThreads))
+          / system.rhsNorm;
+    if (system.error <= tolerance) {
+      system.done = true;
+      continue;
+    }
+    applyPreconditioner(system, numThreads);
+    system.dir = system.precond;
+    system.rz = dot(system.residual, system.precond, numThreads);
+  }
+
+  for (int i = 0; i < maxSolverIter; i++) {
+    active.clear();
+    in.clear();
+    out.clear();
+    for (CgSystem& system : systems) {
+      if (!system.done) {
+        active.push_back(&system);
+        in.push_back(&system.dir);
+        out.push_back(&system.product);
+      }
+    }
+    if (active.empty()) {
+      break;
+    }
+
+    multiply(active, in, out, numThreads);
+
+    for (CgSystem* system : active) {
+      const double pq = dot(system->dir, system->product, numThreads);
+      if (pq == 0) {
+        system->done = true;
+        continue;
+      }
+      const float alpha = system->rz / pq;
+      Eigen::VectorXf& x = *system->sol;
+
+#pragma omp parallel for num_threads(numThreads)
+      for (int k = 0; k < size; k++) {
+        x[k] += alpha * system->dir[k];
+        system->residual[k] -= alpha * system->product[k];
+      }
+
+      system->error
+          = std::sqrt(dot(system->residual, system->residual, numThreads))
+            / system->rhsNorm;
+      if (system->error <= tolerance) {
+        system->done = true;
+        continue;
+      }
+
+      applyPreconditioner(*system, numThreads);
+      const double rzNew = dot(system->residual, system->precond, numThreads);
+      const float beta = rzNew / system->rz;
+      system->rz = rzNew;
+
+#pragma omp parallel for num_threads(numThreads)
+      for (int k = 0; k < size; k++) {
+        system->dir[k] = system->precond[k] + beta * system->dir[k];
+      }
+    }
+  }
+
   ResidualError error;
-  BiCGSTAB<SMatrix, IdentityPreconditioner> solver;
-  solver.setMaxIterations(maxSolverIter);
-  solver.compute(placeInstForceMatrixX);
-  instLocVecX = solver.solveWithGuess(fixedInstForceVecX, instLocVecX);
-  error.x = solver.error();
-
-  solver.compute(placeInstForceMatrixY);
-  instLocVecY = solver.solveWithGuess(fixedInstForceVecY, instLocVecY);
-  error.y = solver.error();
+  error.x = systems[0].error;
+  error.y = systems[1].error;
   return error;
 }
-}  // namespace gpl
\ No newline at end of file
+}  // namespace gpl
@@ -59,8 +59,6 @@ struct ResidualError
   float y;  // The relative residual error for Y
 };
 
-using Eigen::BiCGSTAB;
-using Eigen::IdentityPreconditioner;
 using utl::GPL;
 
 typedef Eigen::SparseMatrix<float, Eigen::RowMajor> SMatrix;
@@ -76,6 +74,10 @@ ResidualError cudaSparseSolve(int iter,
                               utl::Logger* logger);
 #endif
 
+// Solves the X and Y systems together with preconditioned conjugate
+// gradients, warm started from instLocVecX/Y. Both systems share every
+// threaded sparse matrix-vector product. The preconditioner is Jacobi,
+// or IC(0) when useIncompleteCholesky is set.
 ResidualError cpuSparseSolve(int maxSolverIter,
                              int iter,
                              SMatrix& placeInstForceMatrixX,
@@ -84,5 +86,7 @@ ResidualError cpuSparseSolve(int maxSolverIter,
                              SMatrix& placeInstForceMatrixY,
                              Eigen::VectorXf& fixedInstForceVecY,
                              Eigen::VectorXf& instLocVecY,
+                             int numThreads,
+                             bool useIncompleteCholesky,
                              utl::Logger* logger);
 }  // namespace gpl
@@ -35,6 +35,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <unordered_set>
 #include <utility>
 
 #include "nesterovBase.h"
@@ -49,7 +51,12 @@ using utl::GPL;
 
 // TimingBase
 TimingBase::TimingBase()
-    : rs_(nullptr), log_(nullptr), nbc_(nullptr), net_weight_max_(1.9)
+    : rs_(nullptr),
+      log_(nullptr),
+      nbc_(nullptr),
+      net_weight_max_(1.9),
+      incremental_(false),
+      moveThreshold_(0)
 {
 }
 
@@ -145,12 +152,66 @@ void TimingBase::setTimingNetWeightMax(float max)
   net_weight_max_ = max;
 }
 
+void TimingBase::setIncremental(bool incremental, int moveThreshold)
+{
+  incremental_ = incremental;
+  moveThreshold_ = moveThreshold;
+}
+
+void TimingBase::saveGCellLocations()
+{
+  const auto& gCells = nbc_->gCells();
+  lastCx_.resize(gCells.size());
+  lastCy_.resize(gCells.size());
+  for (size_t i = 0; i < gCells.size(); i++) {
+    lastCx_[i] = gCells[i]->dCx();
+    lastCy_[i] = gCells[i]->dCy();
+  }
+}
+
+std::vector<odb::dbNet*> TimingBase::collectMovedNets()
+{
+  std::vector<odb::dbNet*> nets;
+  std::unordered_set<GNet*> seen;
+
+  const auto& gCells = nbc_->gCells();
+  for (size_t i = 0; i < gCells.size(); i++) {
+    const GCell* gCell = gCells[i];
+    const int move = std::abs(gCell->dCx() - lastCx_[i])
+                     + std::abs(gCell->dCy() - lastCy_[i]);
+    if (move <= moveThreshold_) {
+      continue;
+    }
+    // small moves accumulate until they cross the threshold
+    lastCx_[i] = gCell->dCx();
+    lastCy_[i] = gCell->dCy();
+
+    for (GPin* gPin : gCell->gPins()) {
+      GNet* gNet = gPin->gNet();
+      if (gNet && seen.insert(gNet).second) {
+        nets.push_back(gNet->net()->dbNet());
+      }
+    }
+  }
+  return nets;
+}
+
 bool TimingBase::updateGNetWeights(float overflow)
 {
-  rs_->findResizeSlacks();
+  if (incremental_ && lastCx_.size() == nbc_->gCells().size()) {
+    std::vector<odb::dbNet*> moved_nets = collectMovedNets();
+    log_->info(
+        GPL, 319, "Timing update of {} moved nets.", moved_nets.size());
+    rs_->findResizeSlacksIncremental(moved_nets);
+  } else {
+    rs_->findResizeSlacks();
+    if (incremental_) {
+      saveGCellLocations();
+    }
+  }
 
   // get worst resize nets
-  sta::NetSeq& worst_slack_nets = rs_->resizeWorstSlackNets();
+  std::vector<odb::dbNet*> worst_slack_nets = rs_->resizeWorstSlackDbNets();
 
   if (worst_slack_nets.empty()) {
     log_->warn(GPL, 114, "No net slacks found. Timing-driven mode disabled.");
@@ -170,41 +231,45 @@ bool TimingBase::updateGNetWeights(float overflow)
     return false;
   }
 
-  int weighted_net_count = 0;
-  for (auto& gNet : nbc_->gNets()) {
-    // default weight
+  // default weight
+  for (GNet* gNet : weightedGNets_) {
     gNet->setTimingWeight(1.0);
-    if (gNet->gPins().size() > 1) {
-      auto net_slack_opt = rs_->resizeNetSlack(gNet->net()->dbNet());
-      if (!net_slack_opt) {
-        continue;
-      }
-      auto net_slack = net_slack_opt.value();
-      if (net_slack < slack_max) {
-        if (slack_max == slack_min) {
-          gNet->setTimingWeight(1.0);
-        } else {
-          // weight(min_slack) = net_weight_max_
-          // weight(max_slack) = 1
-          const float weight = 1
-                               + (net_weight_max_ - 1) * (slack_max - net_slack)
-                                     / (slack_max - slack_min);
-          gNet->setTimingWeight(weight);
-        }
-        weighted_net_count++;
-      }
-      debugPrint(log_,
-                 GPL,
-                 "timing",
-                 1,
-                 "net:{} slack:{} weight:{}",
-                 gNet->net()->dbNet()->getConstName(),
-                 net_slack,
-                 gNet->totalWeight());
+  }
+  weightedGNets_.clear();
+
+  // Every other net has a slack of at least slack_max,
+  // so only the sorted worst nets can get a weight.
+  for (odb::dbNet* db_net : worst_slack_nets) {
+    const auto net_slack_opt = rs_->resizeNetSlack(db_net);
+    if (!net_slack_opt) {
+      continue;
+    }
+    const auto net_slack = net_slack_opt.value();
+    if (net_slack >= slack_max) {
+      break;
+    }
+    GNet* gNet = nbc_->dbToNb(db_net);
+    if (!gNet || gNet->gPins().size() <= 1) {
+      continue;
     }
+    // weight(min_slack) = net_weight_max_
+    // weight(max_slack) = 1
+    const float weight = 1
+                         + (net_weight_max_ - 1) * (slack_max - net_slack)
+                               / (slack_max - slack_min);
+    gNet->setTimingWeight(weight);
+    weightedGNets_.push_back(gNet);
+    debugPrint(log_,
+               GPL,
+               "timing",
+               1,
+               "net:{} slack:{} weight:{}",
+               db_net->getConstName(),
+               net_slack,
+               gNet->totalWeight());
   }
 
-  log_->info(GPL, 103, "Weighted {} nets.", weighted_net_count);
+  log_->info(GPL, 103, "Weighted {} nets.", weightedGNets_.size());
   return true;
 }
 
@@ -44,6 +44,10 @@ namespace utl {
 class Logger;
 }
 
+namespace odb {
+class dbNet;
+}
+
 namespace gpl {
 
 class NesterovBaseCommon;
@@ -67,6 +71,10 @@ class TimingBase
 
   void setTimingNetWeightMax(float overflow);
 
+  // After the first reweight, only re-estimate the nets
+  // of GCells that moved more than moveThreshold.
+  void setIncremental(bool incremental, int moveThreshold);
+
   // updateNetWeight.
   // True: successfully reweighted gnets
   // False: no slacks found
@@ -80,7 +88,18 @@ class TimingBase
   std::vector<int> timingNetWeightOverflow_;
   std::vector<int> timingOverflowChk_;
   float net_weight_max_;
+
+  bool incremental_;
+  int moveThreshold_;
+  // GCell centers at the last parasitics estimate, by nbc_->gCells() index
+  std::vector<int> lastCx_;
+  std::vector<int> lastCy_;
+  // nets weighted by the last call, reset by the next one
+  std::vector<GNet*> weightedGNets_;
+
   void initTimingOverflowChk();
+  void saveGCellLocations();
+  std::vector<odb::dbNet*> collectMovedNets();
 };
 
 }  // namespace gpl
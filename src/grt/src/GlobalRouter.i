@@ -119,6 +119,12 @@ set_overflow_iterations(int iterations)
   getGlobalRouter()->setOverflowIterations(iterations);
 }
 
+void
+set_num_threads(int num_threads)
+{
+  getGlobalRouter()->setNumThreads(num_threads);
+}
+
 void
 set_congestion_report_iter_step(int congestion_report_iter_step)
 {
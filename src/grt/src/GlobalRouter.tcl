@@ -220,6 +220,7 @@ proc global_route { args } {
   }
 
   grt::set_verbose [info exists flags(-verbose)]
+  grt::set_num_threads [ord::thread_count]
 
   if { [info exists keys(-grid_origin)] } {
     set origin $keys(-grid_origin)
@@ -40,12 +40,14 @@
 #include <boost/icl/interval.hpp>
 #include <boost/icl/interval_set.hpp>
 #include <boost/multi_array.hpp>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
 #include "AbstractMakeWireParasitics.h"
 #include "DataType.h"
+#include "RadixHeap.h"
 #include "grt/GRoute.h"
 #include "odb/geom.h"
 #include "stt/SteinerTreeBuilder.h"
@@ -89,6 +91,55 @@ struct DebugSetting
   bool isOn() const { return renderer_ != nullptr; }
 };
 
+// Scratch grid of the 2D maze router covering only the routing region of a
+// tree edge. Views are indexed with global (y, x) grid coordinates and the
+// storage only grows, so it is reused across edges and nets.
+template <typename T>
+class MazeGrid
+{
+ public:
+  boost::multi_array_ref<T, 2> view(int x_lo, int y_lo, int width, int height)
+  {
+    const size_t size = static_cast<size_t>(width) * height;
+    if (size > capacity_) {
+      data_ = std::make_unique<T[]>(size);
+      capacity_ = size;
+    }
+    using range = boost::multi_array_types::extent_range;
+    return boost::multi_array_ref<T, 2>(
+        data_.get(),
+        boost::extents[range(y_lo, y_lo + height)][range(x_lo, x_lo + width)]);
+  }
+
+ private:
+  std::unique_ptr<T[]> data_;
+  size_t capacity_ = 0;
+};
+
+// Per-thread state of the 2D maze router
+struct MazeScratch
+{
+  MazeGrid<float> d1;
+  MazeGrid<float> d2;
+  MazeGrid<short> parent_x1;
+  MazeGrid<short> parent_y1;
+  MazeGrid<short> parent_x3;
+  MazeGrid<short> parent_y3;
+  MazeGrid<bool> hv;
+  MazeGrid<bool> hyper_h;
+  MazeGrid<bool> hyper_v;
+  MazeGrid<int> corr_edge;
+  std::vector<bool> pop_heap2;
+  RadixHeap<float> src_heap;
+  std::vector<int> dest_heap;
+  std::vector<OrderNetEdge> net_eo;
+  // 2D edges that received usage, committed to h/v_used_ggrid_ by the caller
+  std::vector<std::pair<int, int>> h_used;
+  std::vector<std::pair<int, int>> v_used;
+  // enlargement of the last rerouted tree edge, -1 if none was rerouted
+  int last_enlarge = -1;
+};
+
 using stt::Tree;
 
 class FastRouteCore
@@ -176,6 +227,7 @@ class FastRouteCore
   void setMaxNetDegree(int);
   void setVerbose(bool v);
   void setUpdateSlack(int u);
+  void setNumThreads(int num_threads);
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
   void setOverflowIterations(int iterations);
   void setCongestionReportIterStep(int congestion_report_iter_step);
@@ -242,6 +294,35 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteNet(const int netID,
+                    const int iter,
+                    const int expand,
+                    const float cost_height,
+                    const int ripup_threshold,
+                    const int maze_edge_threshold,
+                    const int cost_type,
+                    const float logis_cof,
+                    const int via,
+                    const int slope,
+                    const int L,
+                    const float slack_th,
+                    MazeScratch& scratch);
+  void commitMazeRoute(MazeScratch& scratch);
+  odb::Rect mazeRouteBox(const int netID, const int expand);
+  bool mazeNetNeedsRipup(const int netID,
+                         const int ripup_threshold,
+                         const int maze_edge_threshold,
+                         const float critical_slack);
+  void buildMazeBatch(std::vector<int>& pending,
+                      std::vector<int>& batch,
+                      std::vector<int>& bin_round,
+                      int& round,
+                      const int bin_size,
+                      const bool ordering,
+                      const int expand,
+                      const int ripup_threshold,
+                      const int maze_edge_threshold,
+                      const float slack_th);
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -278,10 +359,11 @@ class FastRouteCore
   void convertToMazerouteNet(const int netID);
   void setupHeap(const int netID,
                  const int edgeID,
-                 std::vector<float*>& src_heap,
-                 std::vector<float*>& dest_heap,
-                 multi_array<float, 2>& d1,
-                 multi_array<float, 2>& d2,
+                 RadixHeap<float>& src_heap,
+                 std::vector<int>& dest_heap,
+                 boost::multi_array_ref<float, 2>& d1,
+                 boost::multi_array_ref<float, 2>& d2,
+                 boost::multi_array_ref<int, 2>& corr_edge,
                  const int regionX1,
                  const int regionX2,
                  const int regionY1,
@@ -325,8 +407,8 @@ class FastRouteCore
                             int layerOrientation);
   void setupHeap3D(int netID,
                    int edgeID,
-                   std::vector<int*>& src_heap_3D,
-                   std::vector<int*>& dest_heap_3D,
+                   RadixHeap<int>& src_heap_3D,
+                   std::vector<int>& dest_heap_3D,
                    multi_array<Direction, 3>& directions_3D,
                    multi_array<int, 3>& corr_edge_3D,
                    multi_array<int, 3>& d1_3D,
@@ -432,6 +514,11 @@ class FastRouteCore
                 const int y2,
                 const int netID);
 
+  bool needsRipup(const TreeEdge* treeedge,
+                  const int ripup_threshold,
+                  const float critical_slack,
+                  const int netID,
+                  bool& is_critical) const;
   bool newRipupCheck(const TreeEdge* treeedge,
                      const int x1,
                      const int y1,
@@ -477,6 +564,7 @@ class FastRouteCore
   bool checkRoute2DTree(int netID);
   void removeLoops();
   void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo) const;
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -537,6 +625,7 @@ class FastRouteCore
   int grid_hv_;
   bool verbose_;
   int update_slack_;
+  int num_threads_;
   int via_cost_;
   int mazeedge_threshold_;
   float v_capacity_lb_;
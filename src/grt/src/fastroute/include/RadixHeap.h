@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018, Iowa State University All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace grt {
+
+// Monotone radix heap of grid node indices for the maze routers.
+//
+// The keys are the bits of non-negative int or float costs, which sort the
+// same way as the costs themselves, so the pop order is exact. Each entry
+// keeps its key next to the node index and popping never reads the cost
+// grid. Pushed costs must not be smaller than the last popped one, which
+// holds for Dijkstra with non-negative edge costs. A decreased cost is pushed
+// again and the superseded entry is dropped when it reaches the top.
+template <typename T>
+class RadixHeap
+{
+ public:
+  void clear()
+  {
+    for (std::vector<Entry>& bucket : buckets_) {
+      bucket.clear();
+    }
+    last_ = 0;
+    size_ = 0;
+  }
+
+  void push(const int node, const T cost)
+  {
+    const uint32_t key = toKey(cost);
+    buckets_[bucketIndex(key)].push_back({key, node});
+    size_++;
+  }
+
+  // Returns the node with the minimum cost, or -1 if the heap is empty.
+  // Entries whose key does not match cost[node] anymore are discarded.
+  int top(const T* cost)
+  {
+    while (size_ > 0) {
+      if (buckets_[0].empty()) {
+        redistribute();
+      }
+      const Entry& entry = buckets_[0].back();
+      if (entry.key == toKey(cost[entry.node])) {
+        return entry.node;
+      }
+      buckets_[0].pop_back();
+      size_--;
+    }
+    return -1;
+  }
+
+  // Removes the node returned by the last call to top().
+  void pop()
+  {
+    buckets_[0].pop_back();
+    size_--;
+  }
+
+ private:
+  struct Entry
+  {
+    uint32_t key;
+    int node;
+  };
+
+  static uint32_t toKey(const T cost)
+  {
+    static_assert(sizeof(T) == sizeof(uint32_t), "32 bit costs expected");
+    uint32_t key;
+    std::memcpy(&key, &cost, sizeof(key));
+    return key;
+  }
+
+  int bucketIndex(const uint32_t key) const
+  {
+    return key == last_ ? 0 : 32 - __builtin_clz(key ^ last_);
+  }
+
+  // Moves the entries with the minimum key to bucket 0.
+  void redistribute()
+  {
+    int i = 1;
+    while (buckets_[i].empty()) {
+      i++;
+    }
+    std::vector<Entry>& bucket = buckets_[i];
+    last_ = std::min_element(bucket.begin(),
+                             bucket.end(),
+                             [](const Entry& a, const Entry& b) {
+                               return a.key < b.key;
+                             })
+                ->key;
+    for (const Entry& entry : bucket) {
+      buckets_[bucketIndex(entry.key)].push_back(entry);
+    }
+    bucket.clear();
+  }
+
+  std::array<std::vector<Entry>, 33> buckets_;
+  uint32_t last_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace grt
@@ -75,6 +75,7 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
       grid_hv_(0),
       verbose_(false),
       update_slack_(0),
+      num_threads_(1),
       via_cost_(0),
       mazeedge_threshold_(0),
       v_capacity_lb_(0),
@@ -1304,6 +1305,11 @@ void FastRouteCore::setUpdateSlack(int u)
   update_slack_ = u;
 }
 
+void FastRouteCore::setNumThreads(int num_threads)
+{
+  num_threads_ = std::max(1, num_threads);
+}
+
 void FastRouteCore::setMakeWireParasiticsBuilder(
     AbstractMakeWireParasitics* builder)
 {
@@ -268,6 +268,44 @@ bool FastRouteCore::newRipupType2(const TreeEdge* treeedge,
   }
 }
 
+bool FastRouteCore::needsRipup(const TreeEdge* treeedge,
+                               const int ripup_threshold,
+                               const float critical_slack,
+                               const int netID,
+                               bool& is_critical) const
+{
+  is_critical = false;
+  const std::vector<short>& gridsX = treeedge->route.gridsX;
+  const std::vector<short>& gridsY = treeedge->route.gridsY;
+  for (int i = 0; i < treeedge->route.routelen; i++) {
+    if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
+      const int ymin = std::min(gridsY[i], gridsY[i + 1]);
+      if (v_edges_[ymin][gridsX[i]].usage_red()
+          >= v_capacity_ - ripup_threshold) {
+        return true;
+      }
+    } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
+      const int xmin = std::min(gridsX[i], gridsX[i + 1]);
+      if (h_edges_[gridsY[i]][xmin].usage_red()
+          >= h_capacity_ - ripup_threshold) {
+        return true;
+      }
+    }
+  }
+  if (update_slack_ && treeedge->route.last_routelen && critical_slack) {
+    const float delta = (float) treeedge->route.routelen
+                        / (float) treeedge->route.last_routelen;
+    if (nets_[netID]->getSlack() <= critical_slack
+        && (nets_[netID]->getSlack()
+            > std::ceil(std::numeric_limits<float>::lowest()))
+        && (delta >= 2)) {
+      is_critical = true;
+      return true;
+    }
+  }
+  return false;
+}
+
 bool FastRouteCore::newRipupCheck(const TreeEdge* treeedge,
                                   const int x1,
                                   const int y1,
@@ -282,41 +320,15 @@ bool FastRouteCore::newRipupCheck(const TreeEdge* treeedge,
     return false;
   }  // not ripup for degraded edge
 
-  bool needRipup = false;
-
   if (treeedge->route.type == RouteType::MazeRoute) {
-    const std::vector<short>& gridsX = treeedge->route.gridsX;
-    const std::vector<short>& gridsY = treeedge->route.gridsY;
-    for (int i = 0; i < treeedge->route.routelen; i++) {
-      if (gridsX[i] == gridsX[i + 1]) {  // a vertical edge
-        const int ymin = std::min(gridsY[i], gridsY[i + 1]);
-        if (v_edges_[ymin][gridsX[i]].usage_red()
-            >= v_capacity_ - ripup_threshold) {
-          needRipup = true;
-          break;
-        }
-      } else if (gridsY[i] == gridsY[i + 1]) {  // a horizontal edge
-        const int xmin = std::min(gridsX[i], gridsX[i + 1]);
-        if (h_edges_[gridsY[i]][xmin].usage_red()
-            >= h_capacity_ - ripup_threshold) {
-          needRipup = true;
-          break;
-        }
-      }
-    }
-    if (!needRipup && update_slack_ && treeedge->route.last_routelen
-        && critical_slack) {
-      const float delta = (float) treeedge->route.routelen
-                          / (float) treeedge->route.last_routelen;
-      if (nets_[netID]->getSlack() <= critical_slack
-          && (nets_[netID]->getSlack()
-              > std::ceil(std::numeric_limits<float>::lowest()))
-          && (delta >= 2)) {
+    bool is_critical;
+    if (needsRipup(
+            treeedge, ripup_threshold, critical_slack, netID, is_critical)) {
+      if (is_critical) {
         nets_[netID]->setIsCritical(true);
-        needRipup = true;
       }
-    }
-    if (needRipup) {
+      const std::vector<short>& gridsX = treeedge->route.gridsX;
+      const std::vector<short>& gridsY = treeedge->route.gridsY;
       const int edgeCost = nets_[netID]->getEdgeCost();
 
       for (int i = 0; i < treeedge->route.routelen; i++) {
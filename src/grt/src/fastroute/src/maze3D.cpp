@@ -46,76 +46,10 @@ struct parent3D
   int x, y;
 };
 
-static int parent_index(int i)
-{
-  return (i - 1) / 2;
-}
-
-static int left_index(int i)
-{
-  return 2 * i + 1;
-}
-
-static int right_index(int i)
-{
-  return 2 * i + 2;
-}
-
-// non recursive version of heapify-
-static void heapify3D(std::vector<int*>& array)
-{
-  bool stop = false;
-  const int heapSize = array.size();
-  int i = 0;
-
-  int* tmp = array[i];
-  do {
-    const int l = left_index(i);
-    const int r = right_index(i);
-
-    int smallest;
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      stop = true;
-    }
-  } while (!stop);
-}
-
-static void updateHeap3D(std::vector<int*>& array, int i)
-{
-  int* tmpi = array[i];
-  while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
-    const int parent = parent_index(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// extract the entry with minimum distance from Priority queue
-static void removeMin3D(std::vector<int*>& array)
-{
-  array[0] = array.back();
-  heapify3D(array);
-  array.pop_back();
-}
-
 void FastRouteCore::setupHeap3D(int netID,
                                 int edgeID,
-                                std::vector<int*>& src_heap_3D,
-                                std::vector<int*>& dest_heap_3D,
+                                RadixHeap<int>& src_heap_3D,
+                                std::vector<int>& dest_heap_3D,
                                 multi_array<Direction, 3>& directions_3D,
                                 multi_array<int, 3>& corr_edge_3D,
                                 multi_array<int, 3>& d1_3D,
@@ -130,6 +64,10 @@ void FastRouteCore::setupHeap3D(int netID,
 
   const int num_terminals = sttrees_[netID].num_terminals;
 
+  auto index = [this](const int l, const int y, const int x) {
+    return l * grid_hv_ + y * x_range_ + x;
+  };
+
   const int n1 = treeedges[edgeID].n1;
   const int n2 = treeedges[edgeID].n2;
   const int x1 = treenodes[n1].x;
@@ -143,10 +81,10 @@ void FastRouteCore::setupHeap3D(int netID,
   if (num_terminals == 2) {  // 2-pin net
     d1_3D[0][y1][x1] = 0;
     directions_3D[0][y1][x1] = Direction::Origin;
-    src_heap_3D.push_back(&d1_3D[0][y1][x1]);
+    src_heap_3D.push(index(0, y1, x1), 0);
     d2_3D[0][y2][x2] = 0;
     directions_3D[0][y2][x2] = Direction::Origin;
-    dest_heap_3D.push_back(&d2_3D[0][y2][x2]);
+    dest_heap_3D.push_back(index(0, y2, x2));
   } else {  // net with more than 2 pins
     for (int i = regionY1; i <= regionY2; i++) {
       for (int j = regionX1; j <= regionX2; j++) {
@@ -166,7 +104,7 @@ void FastRouteCore::setupHeap3D(int netID,
 
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d1_3D[l][y1][x1] = 0;
-        src_heap_3D.push_back(&d1_3D[l][y1][x1]);
+        src_heap_3D.push(index(l, y1, x1), 0);
         directions_3D[l][y1][x1] = Direction::Origin;
         heapVisited[n1] = true;
       }
@@ -180,7 +118,7 @@ void FastRouteCore::setupHeap3D(int netID,
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d1_3D[l][y1][x1] = 0;
         directions_3D[l][y1][x1] = Direction::Origin;
-        src_heap_3D.push_back(&d1_3D[l][y1][x1]);
+        src_heap_3D.push(index(l, y1, x1), 0);
         heapVisited[n1] = true;
       }
 
@@ -218,7 +156,7 @@ void FastRouteCore::setupHeap3D(int netID,
               for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
                 d1_3D[l][nbrY][nbrX] = 0;
                 directions_3D[l][nbrY][nbrX] = Direction::Origin;
-                src_heap_3D.push_back(&d1_3D[l][nbrY][nbrX]);
+                src_heap_3D.push(index(l, nbrY, nbrX), 0);
                 corr_edge_3D[l][nbrY][nbrX] = edge;
               }
             }
@@ -235,7 +173,7 @@ void FastRouteCore::setupHeap3D(int netID,
 
                 if (in_region_[y_grid][x_grid]) {
                   d1_3D[l_grid][y_grid][x_grid] = 0;
-                  src_heap_3D.push_back(&d1_3D[l_grid][y_grid][x_grid]);
+                  src_heap_3D.push(index(l_grid, y_grid, x_grid), 0);
                   directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
                   corr_edge_3D[l_grid][y_grid][x_grid] = edge;
                 }
@@ -262,7 +200,7 @@ void FastRouteCore::setupHeap3D(int netID,
         // just need to put n1 itself into heap1_3D
         d2_3D[l][y2][x2] = 0;
         directions_3D[l][y2][x2] = Direction::Origin;
-        dest_heap_3D.push_back(&d2_3D[l][y2][x2]);
+        dest_heap_3D.push_back(index(l, y2, x2));
         heapVisited[n2] = true;
       }
     } else {  // n2 is a Steiner node
@@ -274,7 +212,7 @@ void FastRouteCore::setupHeap3D(int netID,
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d2_3D[l][y2][x2] = 0;
         directions_3D[l][y2][x2] = Direction::Origin;
-        dest_heap_3D.push_back(&d2_3D[l][y2][x2]);
+        dest_heap_3D.push_back(index(l, y2, x2));
       }
       heapVisited[n2] = true;
 
@@ -315,7 +253,7 @@ void FastRouteCore::setupHeap3D(int netID,
 
                 d2_3D[l][nbrY][nbrX] = 0;
                 directions_3D[l][nbrY][nbrX] = Direction::Origin;
-                dest_heap_3D.push_back(&d2_3D[l][nbrY][nbrX]);
+                dest_heap_3D.push_back(index(l, nbrY, nbrX));
                 corr_edge_3D[l][nbrY][nbrX] = edge;
               }
             }
@@ -333,7 +271,7 @@ void FastRouteCore::setupHeap3D(int netID,
                 if (in_region_[y_grid][x_grid]) {
                   d2_3D[l_grid][y_grid][x_grid] = 0;
                   directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
-                  dest_heap_3D.push_back(&d2_3D[l_grid][y_grid][x_grid]);
+                  dest_heap_3D.push_back(index(l_grid, y_grid, x_grid));
 
                   corr_edge_3D[l_grid][y_grid][x_grid] = edge;
                 }
@@ -863,10 +801,12 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
   int64 total_size = static_cast<int64>(num_layers_) * y_range_ * x_range_;
   static std::vector<bool> pop_heap2_3D(total_size, false);
 
-  // allocate memory for priority queue
-  total_size = static_cast<int64>(y_grid_) * x_grid_ * num_layers_;
-  static std::vector<int*> src_heap_3D(total_size);
-  static std::vector<int*> dest_heap_3D(total_size);
+  // priority queue of d1_3D indices
+  static RadixHeap<int> src_heap_3D;
+  static std::vector<int> dest_heap_3D;
+  auto index = [this](const int l, const int y, const int x) {
+    return l * grid_hv_ + y * x_range_ + x;
+  };
 
   for (int i = 0; i < y_grid_; i++) {
     for (int j = 0; j < x_grid_; j++) {
@@ -957,11 +897,23 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                   regionY1,
                   regionY2);
 
+      // the source heap runs empty only if the destinations are unreachable
+      auto heapTop = [&]() {
+        const int ind = src_heap_3D.top(d1_3D.data());
+        if (ind < 0) {
+          logger_->error(GRT,
+                         183,
+                         "Net {}: heap underflow during 3D maze routing.",
+                         nets_[netID]->getName());
+        }
+        return ind;
+      };
+
       // while loop to find shortest path
-      int ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
+      int ind1 = heapTop();
 
       for (int i = 0; i < dest_heap_3D.size(); i++)
-        pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = true;
+        pop_heap2_3D[dest_heap_3D[i]] = true;
 
       while (pop_heap2_3D[ind1]
              == false)  // stop until the grid position been popped out from
@@ -973,7 +925,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         const int remd = ind1 % (grid_hv_);
         const int curX = remd % x_range_;
         const int curY = remd / x_range_;
-        removeMin3D(src_heap_3D);
+        src_heap_3D.pop();
 
         const bool Horizontal = (((curL % 2) - layerOrientation) == 0);
 
@@ -987,30 +939,15 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
               const int tmpX = curX - 1;  // the left neighbor
 
-              if (d1_3D[curL][curY][tmpX] >= BIG_INT)  // left neighbor not been
-                                                       // put into src_heap_3D
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::West;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][curY][tmpX]
-                         > tmp)  // left neighbor been put into src_heap_3D
-                                 // but needs update
-              {
+              // the neighbor is not in src_heap_3D yet or needs an update
+              if (d1_3D[curL][curY][tmpX] > tmp) {
                 d1_3D[curL][curY][tmpX] = tmp;
                 pr_3D_[curL][curY][tmpX].l = curL;
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::West;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.push(index(curL, curY, tmpX),
+                                 d1_3D[curL][curY][tmpX]);
               }
             }
           }
@@ -1023,31 +960,15 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             if (h_edges_3D_[curL][curY][curX].usage
                     < h_edges_3D_[curL][curY][curX].cap
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][curY][tmpX]
-                  >= BIG_INT)  // right neighbor not been put into
-                               // src_heap_3D
-              {
+              // the neighbor is not in src_heap_3D yet or needs an update
+              if (d1_3D[curL][curY][tmpX] > tmp) {
                 d1_3D[curL][curY][tmpX] = tmp;
                 pr_3D_[curL][curY][tmpX].l = curL;
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::East;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][curY][tmpX]
-                         > tmp)  // right neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][curY][tmpX] = tmp;
-                pr_3D_[curL][curY][tmpX].l = curL;
-                pr_3D_[curL][curY][tmpX].x = curX;
-                pr_3D_[curL][curY][tmpX].y = curY;
-                directions_3D[curL][curY][tmpX] = Direction::East;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.push(index(curL, curY, tmpX),
+                                 d1_3D[curL][curY][tmpX]);
               }
             }
           }
@@ -1060,31 +981,15 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             if (v_edges_3D_[curL][curY - 1][curX].usage
                     < v_edges_3D_[curL][curY - 1][curX].cap
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][tmpY][curX]
-                  >= BIG_INT)  // bottom neighbor not been put into
-                               // src_heap_3D
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::North;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][tmpY][curX]
-                         > tmp)  // bottom neighbor been put into
-                                 // src_heap_3D but needs update
-              {
+              // the neighbor is not in src_heap_3D yet or needs an update
+              if (d1_3D[curL][tmpY][curX] > tmp) {
                 d1_3D[curL][tmpY][curX] = tmp;
                 pr_3D_[curL][tmpY][curX].l = curL;
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::North;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.push(index(curL, tmpY, curX),
+                                 d1_3D[curL][tmpY][curX]);
               }
             }
           }
@@ -1096,30 +1001,15 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             if (v_edges_3D_[curL][curY][curX].usage
                     < v_edges_3D_[curL][curY][curX].cap
                 && net->getMinLayer() <= curL && curL <= net->getMaxLayer()) {
-              if (d1_3D[curL][tmpY][curX]
-                  >= BIG_INT)  // top neighbor not been put into src_heap_3D
-              {
+              // the neighbor is not in src_heap_3D yet or needs an update
+              if (d1_3D[curL][tmpY][curX] > tmp) {
                 d1_3D[curL][tmpY][curX] = tmp;
                 pr_3D_[curL][tmpY][curX].l = curL;
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::South;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-              } else if (d1_3D[curL][tmpY][curX]
-                         > tmp)  // top neighbor been put into src_heap_3D
-                                 // but needs update
-              {
-                d1_3D[curL][tmpY][curX] = tmp;
-                pr_3D_[curL][tmpY][curX].l = curL;
-                pr_3D_[curL][tmpY][curX].x = curX;
-                pr_3D_[curL][tmpY][curX].y = curY;
-                directions_3D[curL][tmpY][curX] = Direction::South;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.push(index(curL, tmpY, curX),
+                                 d1_3D[curL][tmpY][curX]);
               }
             }
           }
@@ -1130,30 +1020,14 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
           const float tmp = d1_3D[curL][curY][curX] + via_cost_;
           const int tmpL = curL - 1;  // the bottom neighbor
 
-          if (d1_3D[tmpL][curY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
-          {
+          // the neighbor is not in src_heap_3D yet or needs an update
+          if (d1_3D[tmpL][curY][curX] > tmp) {
             d1_3D[tmpL][curY][curX] = tmp;
             pr_3D_[tmpL][curY][curX].l = curL;
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Down;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-          } else if (d1_3D[tmpL][curY][curX]
-                     > tmp)  // bottom neighbor been put into src_heap_3D
-                             // but needs update
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Down;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            src_heap_3D.push(index(tmpL, curY, curX), d1_3D[tmpL][curY][curX]);
           }
         }
 
@@ -1162,45 +1036,23 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             && directions_3D[curL][curY][curX] != Direction::Down) {
           const float tmp = d1_3D[curL][curY][curX] + via_cost_;
           const int tmpL = curL + 1;  // the bottom neighbor
-          if (d1_3D[tmpL][curY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap_3D
-          {
-            d1_3D[tmpL][curY][curX] = tmp;
-            pr_3D_[tmpL][curY][curX].l = curL;
-            pr_3D_[tmpL][curY][curX].x = curX;
-            pr_3D_[tmpL][curY][curX].y = curY;
-            directions_3D[tmpL][curY][curX] = Direction::Up;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
-          } else if (d1_3D[tmpL][curY][curX]
-                     > tmp)  // bottom neighbor been put into src_heap_3D
-                             // but needs update
-          {
+          // the neighbor is not in src_heap_3D yet or needs an update
+          if (d1_3D[tmpL][curY][curX] > tmp) {
             d1_3D[tmpL][curY][curX] = tmp;
             pr_3D_[tmpL][curY][curX].l = curL;
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Up;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            src_heap_3D.push(index(tmpL, curY, curX), d1_3D[tmpL][curY][curX]);
           }
         }
 
-        if (src_heap_3D.empty()) {
-          logger_->error(GRT,
-                         183,
-                         "Net {}: heap underflow during 3D maze routing.",
-                         nets_[netID]->getName());
-        }
         // update ind1 for next loop
-        ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
+        ind1 = heapTop();
       }  // while loop
 
       for (int i = 0; i < dest_heap_3D.size(); i++)
-        pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = false;
+        pop_heap2_3D[dest_heap_3D[i]] = false;
 
       // get the new route for the edge and store it in gridsX[] and
       // gridsY[] temporarily
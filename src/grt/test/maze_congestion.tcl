@@ -0,0 +1,40 @@
+# Rip-up and reroute must still clear the congestion of a tight grid with
+# the radix heap maze router; global_route errors out on remaining overflow
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def ../../drt/test/gcd_nangate45_preroute.def
+
+set_global_routing_layer_adjustment metal2-metal10 0.7
+set_routing_layers -signal metal2-metal10
+
+set guide_file [make_result_file maze_congestion.guide]
+global_route -guide_file $guide_file -congestion_iterations 50
+
+set stream [open $guide_file r]
+set guides [read $stream]
+close $stream
+
+# every net with two or more pins gets a guide
+set routed 0
+foreach net [[ord::get_db_block] getNets] {
+  if { [$net getSigType] != "SIGNAL" } {
+    continue
+  }
+  if { [llength [$net getITerms]] + [llength [$net getBTerms]] < 2 } {
+    continue
+  }
+  if { [string first "\n[$net getName]\n(" "\n$guides"] < 0 } {
+    puts "FAIL: No route guide for net [$net getName]"
+    exit 1
+  }
+  incr routed
+}
+if { $routed == 0 } {
+  puts "FAIL: No routed nets"
+  exit 1
+}
+
+puts "pass"
+exit 0
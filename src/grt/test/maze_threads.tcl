@@ -0,0 +1,37 @@
+# Maze routing congested nets in parallel batches must give the same
+# global routes as the sequential router
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def ../../drt/test/gcd_nangate45_preroute.def
+
+# congest the grid so the rip-up and reroute iterations maze route nets
+set_global_routing_layer_adjustment metal2-metal10 0.9
+set_routing_layers -signal metal2-metal10
+
+proc route_guides { threads } {
+  set_thread_count $threads
+  set guide_file [make_result_file maze_threads_$threads.guide]
+  global_route -guide_file $guide_file -allow_congestion \
+    -congestion_iterations 20
+  set stream [open $guide_file r]
+  set guides [read $stream]
+  close $stream
+  return $guides
+}
+
+set sequential [route_guides 1]
+set parallel [route_guides 4]
+
+if { $sequential == "" } {
+  puts "FAIL: No route guides"
+  exit 1
+}
+if { $parallel != $sequential } {
+  puts "FAIL: Routes with 4 threads differ from the routes with 1 thread"
+  exit 1
+}
+
+puts "pass"
+exit 0
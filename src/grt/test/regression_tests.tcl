@@ -0,0 +1,4 @@
+record_pass_fail_tests {
+  maze_congestion
+  maze_threads
+}
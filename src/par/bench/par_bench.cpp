@@ -0,0 +1,545 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// par_bench is a standalone benchmark driver for the multi-level
+// partitioner.  It loads hypergraphs in the hMETIS text format or in the
+// binary format (see BinaryHypergraph.h), or generates synthetic
+// hypergraphs, sweeps the fine-tuning parameters of TritonPart
+// (see TritonPart::SetFineTuneParams), and reports the cutsize, the
+// balance and the runtime of each phase in JSON.
+//
+// Usage:
+//   par_bench [-hypergraph <file>]... [-synthetic <vertices>,<hyperedges>]...
+//             [-vertex_dimension <n>] [-hyperedge_dimension <n>]
+//             [-num_parts <k>] [-balance_constraint <ub>] [-seed <seed>]
+//             [-synthetic_seed <seed>] [-threads <n>] [-repeat <n>]
+//             [-set <param>=<value>]... [-sweep <param>=<v0>,<v1>,...]...
+//             [-write_synthetic <file>] [-json <file>]
+//
+// Each -sweep adds one dimension, and all the combinations of the swept
+// values are run on every hypergraph.  The inputs are read and partitioned
+// through TritonPart (TritonPart::ReadHypergraphFile and
+// TritonPart::PartitionHypergraph), so the benchmark runs the same flow as
+// triton_part_hypergraph.  The timing-driven features of TritonPart need
+// OpenSTA and are not exercised here.
+// run-par-bench.py runs the regression suite built on par_bench.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BinaryHypergraph.h"
+#include "Evaluator.h"
+#include "Hypergraph.h"
+#include "Multilevel.h"
+#include "TritonPart.h"
+#include "Utilities.h"
+#include "utl/Logger.h"
+
+namespace par {
+
+using utl::PAR;
+
+namespace {
+
+// The fine-tuning parameters of TritonPart and their default values
+// (see TritonPart::SetFineTuneParams).  All the values are stored as
+// double and are converted to the type of the parameter when used.
+std::map<std::string, double> DefaultParams(utl::Logger* logger)
+{
+  return TritonPart(nullptr, nullptr, nullptr, logger).GetFineTuneParams();
+}
+
+struct BenchInput
+{
+  std::string name;
+  HGraphPtr hgraph;
+};
+
+struct BenchResult
+{
+  std::string input;
+  std::map<std::string, double> params;
+  int repeat = 0;
+  float cutsize = 0.0f;
+  float max_imbalance = 0.0f;  // max block weight / average block weight - 1
+  bool balanced = false;
+  double phase_seconds[kNumPartitionPhases] = {0.0};
+  double total_seconds = 0.0;
+};
+
+int ToInt(const std::map<std::string, double>& params, const char* name)
+{
+  return static_cast<int>(params.at(name));
+}
+
+float ToFloat(const std::map<std::string, double>& params, const char* name)
+{
+  return static_cast<float>(params.at(name));
+}
+
+// Read a hypergraph in the hMETIS text format or in the binary format
+// with the reader of triton_part_hypergraph
+HGraphPtr ReadInput(const std::string& file_name,
+                    int vertex_dimension,
+                    int hyperedge_dimension,
+                    utl::Logger* logger)
+{
+  TritonPart triton_part(nullptr, nullptr, nullptr, logger);
+  return triton_part.ReadHypergraphFile(
+      file_name, vertex_dimension, hyperedge_dimension);
+}
+
+// Generate a synthetic hypergraph with unit weights.
+// The vertices are laid out on a line, and each hyperedge connects an
+// anchor vertex with vertices close to it, such that the hypergraph has
+// the locality of a netlist.  Most of the hyperedges are small, and a few
+// of them are large, similar to the distribution of net degrees.
+HGraphPtr GenerateSynthetic(int num_vertices,
+                            int num_hyperedges,
+                            int seed,
+                            utl::Logger* logger)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> anchor_dist(0, num_vertices - 1);
+  std::geometric_distribution<int> size_dist(0.45);
+  std::uniform_real_distribution<float> global_dist(0.0f, 1.0f);
+  const int max_hyperedge_size = std::min(num_vertices, 64);
+  const int window = std::max(8, num_vertices / 100);
+
+  std::vector<int> eptr;
+  std::vector<int> eind;
+  eptr.reserve(num_hyperedges + 1);
+  eptr.push_back(0);
+  std::vector<int> hyperedge;
+  for (int e = 0; e < num_hyperedges; e++) {
+    const int size = std::min(2 + size_dist(rng), max_hyperedge_size);
+    const int anchor = anchor_dist(rng);
+    hyperedge.clear();
+    hyperedge.push_back(anchor);
+    while (static_cast<int>(hyperedge.size()) < size) {
+      int vertex = anchor_dist(rng);
+      // 5% of the pins are global connections
+      if (global_dist(rng) >= 0.05f) {
+        const int offset = vertex % (2 * window + 1) - window;
+        vertex = std::clamp(anchor + offset, 0, num_vertices - 1);
+      }
+      if (std::find(hyperedge.begin(), hyperedge.end(), vertex)
+          == hyperedge.end()) {
+        hyperedge.push_back(vertex);
+      }
+    }
+    eind.insert(eind.end(), hyperedge.begin(), hyperedge.end());
+    eptr.push_back(static_cast<int>(eind.size()));
+  }
+
+  return std::make_shared<Hypergraph>(1,
+                                      1,
+                                      0,
+                                      std::move(eptr),
+                                      std::move(eind),
+                                      std::vector<float>(num_vertices, 1.0),
+                                      std::vector<float>(num_hyperedges, 1.0),
+                                      std::vector<int>(),
+                                      std::vector<int>(),
+                                      std::vector<float>(),
+                                      logger);
+}
+
+// Write a hypergraph in the binary format or in the hMETIS text format,
+// based on the file extension.
+void WriteInput(const std::string& file_name,
+                const HGraphPtr& hgraph,
+                utl::Logger* logger)
+{
+  if (IsBinaryHypergraphFileName(file_name)) {
+    BinaryHypergraph binary_hgraph;
+    binary_hgraph.num_vertices = hgraph->GetNumVertices();
+    binary_hgraph.num_hyperedges = hgraph->GetNumHyperedges();
+    binary_hgraph.eptr.push_back(0);
+    for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+      for (const int vertex : hgraph->Vertices(e)) {
+        binary_hgraph.eind.push_back(vertex);
+      }
+      binary_hgraph.eptr.push_back(static_cast<int>(binary_hgraph.eind.size()));
+    }
+    WriteBinaryHypergraph(file_name, binary_hgraph, logger);
+    return;
+  }
+
+  std::ofstream file_output(file_name);
+  if (!file_output.is_open()) {
+    logger->error(PAR, 2528, "Can not open the output file : {}", file_name);
+  }
+  file_output << hgraph->GetNumHyperedges() << " " << hgraph->GetNumVertices()
+              << '\n';
+  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+    for (const int vertex : hgraph->Vertices(e)) {
+      file_output << vertex + 1 << " ";
+    }
+    file_output << '\n';
+  }
+}
+
+// Run the multi-level partitioner of TritonPart on hgraph with the given
+// parameters, as triton_part_hypergraph does without the input files.
+// The partitioner updates the attributes of the hypergraph, so it runs on
+// a copy of it.
+BenchResult RunPartitioner(const BenchInput& input,
+                           const std::map<std::string, double>& params,
+                           int num_parts,
+                           float ub_factor,
+                           int seed,
+                           int num_threads,
+                           utl::Logger* logger)
+{
+  auto start_time_stamp = std::chrono::high_resolution_clock::now();
+  TritonPart triton_part(nullptr, nullptr, nullptr, logger);
+  triton_part.SetFineTuneParams(
+      ToInt(params, "thr_coarsen_hyperedge_size_skip"),
+      ToInt(params, "thr_coarsen_vertices"),
+      ToInt(params, "thr_coarsen_hyperedges"),
+      ToFloat(params, "coarsening_ratio"),
+      ToInt(params, "max_coarsen_iters"),
+      ToFloat(params, "adj_diff_ratio"),
+      ToInt(params, "min_num_vertices_each_part"),
+      ToInt(params, "num_initial_solutions"),
+      ToInt(params, "num_best_initial_solutions"),
+      ToInt(params, "refiner_iters"),
+      ToInt(params, "max_moves"),
+      ToFloat(params, "early_stop_ratio"),
+      ToInt(params, "total_corking_passes"),
+      ToInt(params, "v_cycle_flag") != 0,
+      ToInt(params, "max_num_vcycle"),
+      ToInt(params, "num_coarsen_solutions"),
+      ToInt(params, "num_vertices_threshold_ilp"),
+      ToInt(params, "num_vertices_threshold_lp"),
+      ToInt(params, "global_net_threshold"));
+  triton_part.SetNumThreads(num_threads);
+  auto phase_timer = std::make_shared<PhaseTimer>();
+  triton_part.SetPhaseTimer(phase_timer);
+  const std::vector<int> solution = triton_part.PartitionHypergraph(
+      std::make_shared<Hypergraph>(*input.hgraph), num_parts, ub_factor, seed);
+  const std::chrono::duration<double> total_time
+      = std::chrono::high_resolution_clock::now() - start_time_stamp;
+
+  // the cutsize is the cost of the cut hyperedges with unit weight factors
+  const HGraphPtr& hgraph = input.hgraph;
+  const std::vector<float> base_balance(num_parts, 1.0f / num_parts);
+  GoldenEvaluator evaluator(
+      num_parts,
+      std::vector<float>(hgraph->GetHyperedgeDimensions(), 1.0f),
+      std::vector<float>(hgraph->GetVertexDimensions(), 1.0f),
+      std::vector<float>(),
+      1.0f,
+      1.0f,
+      1.0f,
+      2.0f,
+      1.0f,
+      hgraph,
+      logger);
+
+  BenchResult result;
+  result.input = input.name;
+  result.params = params;
+  const PartitionToken token = evaluator.CutEvaluator(hgraph, solution, false);
+  result.cutsize = token.cost;
+  const float total_weight = hgraph->GetTotalVertexWeights().front();
+  const float average_weight = total_weight / num_parts;
+  for (const auto& block_balance : token.block_balance) {
+    result.max_imbalance = std::max(
+        result.max_imbalance, block_balance.front() / average_weight - 1.0f);
+  }
+  result.balanced = evaluator.ConstraintAndCutEvaluator(
+      hgraph, solution, ub_factor, base_balance, Matrix<int>(), false);
+  for (int phase = 0; phase < kNumPartitionPhases; phase++) {
+    result.phase_seconds[phase]
+        = phase_timer->GetSeconds(static_cast<PartitionPhase>(phase));
+  }
+  result.total_seconds = total_time.count();
+  return result;
+}
+
+std::string JsonString(const std::string& value)
+{
+  std::string json = "\"";
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      json += '\\';
+    }
+    json += c;
+  }
+  json += '"';
+  return json;
+}
+
+void WriteJson(std::ostream& out,
+               int num_parts,
+               float ub_factor,
+               int seed,
+               int num_threads,
+               const std::vector<BenchInput>& inputs,
+               const std::vector<BenchResult>& results)
+{
+  out << "{\n";
+  out << "  \"num_parts\": " << num_parts << ",\n";
+  out << "  \"balance_constraint\": " << ub_factor << ",\n";
+  out << "  \"seed\": " << seed << ",\n";
+  out << "  \"threads\": " << num_threads << ",\n";
+  out << "  \"inputs\": [";
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const HGraphPtr& hgraph = inputs[i].hgraph;
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": "
+        << JsonString(inputs[i].name)
+        << ", \"num_vertices\": " << hgraph->GetNumVertices()
+        << ", \"num_hyperedges\": " << hgraph->GetNumHyperedges() << "}";
+  }
+  out << "\n  ],\n";
+  out << "  \"runs\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& result = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\n";
+    out << "      \"input\": " << JsonString(result.input) << ",\n";
+    out << "      \"repeat\": " << result.repeat << ",\n";
+    out << "      \"params\": {";
+    bool first = true;
+    for (const auto& [name, value] : result.params) {
+      out << (first ? "" : ", ") << JsonString(name) << ": " << value;
+      first = false;
+    }
+    out << "},\n";
+    out << "      \"cutsize\": " << result.cutsize << ",\n";
+    out << "      \"max_imbalance\": " << result.max_imbalance << ",\n";
+    out << "      \"balanced\": " << (result.balanced ? "true" : "false")
+        << ",\n";
+    out << "      \"phase_seconds\": {";
+    for (int phase = 0; phase < kNumPartitionPhases; phase++) {
+      out << (phase == 0 ? "" : ", ")
+          << JsonString(ToString(static_cast<PartitionPhase>(phase))) << ": "
+          << result.phase_seconds[phase];
+    }
+    out << "},\n";
+    out << "      \"total_seconds\": " << result.total_seconds << "\n";
+    out << "    }";
+  }
+  out << "\n  ]\n";
+  out << "}\n";
+}
+
+// Parse "<name>=<v0>,<v1>,..." and check the name of the parameter
+std::pair<std::string, std::vector<double>> ParseParam(
+    const std::string& arg,
+    const std::map<std::string, double>& params,
+    utl::Logger* logger)
+{
+  const size_t pos = arg.find('=');
+  const std::string name = arg.substr(0, pos);
+  if (pos == std::string::npos || params.find(name) == params.end()) {
+    logger->error(PAR, 2529, "Unknown fine-tuning parameter : {}", arg);
+  }
+  std::vector<double> values;
+  std::stringstream values_stream(arg.substr(pos + 1));
+  std::string value;
+  while (std::getline(values_stream, value, ',')) {
+    values.push_back(std::stod(value));
+  }
+  if (values.empty()) {
+    logger->error(PAR, 2530, "No value is specified for {}", name);
+  }
+  return {name, values};
+}
+
+int RunBench(int argc, char** argv, utl::Logger* logger)
+{
+  std::vector<std::string> hypergraph_files;
+  std::vector<std::pair<int, int>> synthetic_sizes;
+  std::vector<std::pair<std::string, std::vector<double>>> sweeps;
+  std::map<std::string, double> params = DefaultParams(logger);
+  std::string json_file;
+  std::string synthetic_file;
+  int num_parts = 2;
+  int vertex_dimension = 1;
+  int hyperedge_dimension = 1;
+  float ub_factor = 1.0;
+  int seed = 0;
+  int synthetic_seed = 0;
+  int repeat = 1;
+  int num_threads
+      = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      logger->error(PAR, 2531, "Missing value for {}", arg);
+    }
+    const std::string value = argv[++i];
+    if (arg == "-hypergraph") {
+      hypergraph_files.push_back(value);
+    } else if (arg == "-synthetic") {
+      std::vector<int> sizes;
+      ParseNumbers(value, sizes);
+      if (sizes.size() != 2 || sizes[0] <= 0 || sizes[1] <= 0) {
+        logger->error(PAR, 2532, "Invalid synthetic hypergraph : {}", value);
+      }
+      synthetic_sizes.emplace_back(sizes[0], sizes[1]);
+    } else if (arg == "-num_parts") {
+      num_parts = std::stoi(value);
+    } else if (arg == "-vertex_dimension") {
+      vertex_dimension = std::stoi(value);
+    } else if (arg == "-hyperedge_dimension") {
+      hyperedge_dimension = std::stoi(value);
+    } else if (arg == "-balance_constraint") {
+      ub_factor = std::stof(value);
+    } else if (arg == "-seed") {
+      seed = std::stoi(value);
+    } else if (arg == "-synthetic_seed") {
+      synthetic_seed = std::stoi(value);
+    } else if (arg == "-threads") {
+      num_threads = std::stoi(value);
+    } else if (arg == "-repeat") {
+      repeat = std::stoi(value);
+    } else if (arg == "-set") {
+      auto [name, values] = ParseParam(value, params, logger);
+      params[name] = values.front();
+    } else if (arg == "-sweep") {
+      sweeps.push_back(ParseParam(value, params, logger));
+    } else if (arg == "-write_synthetic") {
+      synthetic_file = value;
+    } else if (arg == "-json") {
+      json_file = value;
+    } else {
+      logger->error(PAR, 2533, "Unknown option : {}", arg);
+    }
+  }
+
+  std::vector<BenchInput> inputs;
+  for (const auto& file_name : hypergraph_files) {
+    inputs.push_back(
+        {file_name,
+         ReadInput(file_name, vertex_dimension, hyperedge_dimension, logger)});
+  }
+  for (const auto& [num_vertices, num_hyperedges] : synthetic_sizes) {
+    const std::string name = "synthetic_" + std::to_string(num_vertices) + "_"
+                             + std::to_string(num_hyperedges) + "_"
+                             + std::to_string(synthetic_seed);
+    inputs.push_back(
+        {name,
+         GenerateSynthetic(
+             num_vertices, num_hyperedges, synthetic_seed, logger)});
+    if (!synthetic_file.empty()) {
+      WriteInput(synthetic_file, inputs.back().hgraph, logger);
+    }
+  }
+  if (inputs.empty()) {
+    logger->error(PAR,
+                  2534,
+                  "No hypergraph is specified. Use -hypergraph or -synthetic.");
+  }
+
+  // enumerate all the combinations of the swept values
+  Matrix<double> combinations(1);
+  for (const auto& sweep : sweeps) {
+    Matrix<double> expanded;
+    for (const auto& combination : combinations) {
+      for (const double value : sweep.second) {
+        expanded.push_back(combination);
+        expanded.back().push_back(value);
+      }
+    }
+    combinations = std::move(expanded);
+  }
+
+  std::vector<BenchResult> results;
+  for (const auto& input : inputs) {
+    for (const auto& combination : combinations) {
+      std::map<std::string, double> run_params = params;
+      for (size_t i = 0; i < sweeps.size(); i++) {
+        run_params[sweeps[i].first] = combination[i];
+      }
+      for (int run = 0; run < repeat; run++) {
+        results.push_back(RunPartitioner(input,
+                                         run_params,
+                                         num_parts,
+                                         ub_factor,
+                                         seed,
+                                         num_threads,
+                                         logger));
+        results.back().repeat = run;
+        logger->report("[par_bench] {} : cutsize = {}, imbalance = {}, {} s",
+                       input.name,
+                       results.back().cutsize,
+                       results.back().max_imbalance,
+                       results.back().total_seconds);
+      }
+    }
+  }
+
+  if (json_file.empty()) {
+    WriteJson(
+        std::cout, num_parts, ub_factor, seed, num_threads, inputs, results);
+  } else {
+    std::ofstream json_output(json_file);
+    if (!json_output.is_open()) {
+      logger->error(PAR, 2535, "Can not open the output file : {}", json_file);
+    }
+    WriteJson(
+        json_output, num_parts, ub_factor, seed, num_threads, inputs, results);
+  }
+  return 0;
+}
+
+}  // namespace
+
+}  // namespace par
+
+int main(int argc, char** argv)
+{
+  utl::Logger logger;
+  try {
+    return par::RunBench(argc, argv, &logger);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+}
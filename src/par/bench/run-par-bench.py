@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+'''
+This runs the par_bench regression suite.  Each case partitions a synthetic
+hypergraph with one thread and with several threads, and checks that:
+  - every solution satisfies the balance constraint;
+  - the cutsize does not depend on the number of threads;
+  - the cutsize is not worse than the baseline (if one is given) by more
+    than the tolerance.  A case missing from the baseline fails.
+If the baseline file does not exist yet, the baseline check is skipped
+with a note, so the suite passes on a fresh checkout.
+The total runtime is reported against the baseline but not checked, since
+it depends on the machine.  Use --update to record a new baseline.
+'''
+
+import argparse
+import json
+import multiprocessing
+import os
+import subprocess
+import sys
+import tempfile
+
+# (name, num_vertices, num_hyperedges, num_parts, extra par_bench arguments)
+CASES = [
+    ("small_2way", 2000, 2200, 2, []),
+    ("small_4way", 2000, 2200, 4, []),
+    ("medium_2way", 20000, 22000, 2, []),
+    ("medium_8way", 20000, 22000, 8, []),
+    ("medium_2way_lp", 20000, 22000, 2,
+     ["-set", "num_vertices_threshold_lp=5000"]),
+    ("large_2way", 100000, 110000, 2, ["-set", "num_coarsen_solutions=4"]),
+]
+
+parser = argparse.ArgumentParser(
+    prog="run-par-bench",
+    description="Run the par_bench regression suite.",
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument(
+    "-b",
+    "--bench",
+    required=True,
+    help="Path to the par_bench executable"
+)
+parser.add_argument(
+    "-t",
+    "--threads",
+    type=int,
+    default=multiprocessing.cpu_count(),
+    help="Number of threads of the multi-threaded runs"
+)
+parser.add_argument(
+    "--baseline",
+    help="JSON file with the results of a previous run"
+)
+parser.add_argument(
+    "--tolerance",
+    type=float,
+    default=0.02,
+    help="Allowed relative increase of the cutsize over the baseline"
+)
+parser.add_argument(
+    "--update",
+    action="store_true",
+    help="Write the results to the baseline file instead of checking them"
+)
+parser.add_argument(
+    "-c",
+    "--cases",
+    nargs="+",
+    help="Only run the cases with these names"
+)
+args = parser.parse_args()
+
+
+def run_case(case, threads, work_dir):
+    name, num_vertices, num_hyperedges, num_parts, extra_args = case
+    json_file = os.path.join(work_dir, "{}_{}.json".format(name, threads))
+    command = [
+        args.bench,
+        "-synthetic", "{},{}".format(num_vertices, num_hyperedges),
+        "-num_parts", str(num_parts),
+        "-threads", str(threads),
+        "-json", json_file,
+    ] + extra_args
+    subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+    with open(json_file) as f:
+        return json.load(f)["runs"][0]
+
+
+def main():
+    cases = [case for case in CASES
+             if args.cases is None or case[0] in args.cases]
+    baseline = None
+    if args.baseline and not args.update:
+        if os.path.exists(args.baseline):
+            with open(args.baseline) as f:
+                baseline = json.load(f)
+        else:
+            print("No baseline {}, skipping the cutsize check. Record one "
+                  "with --update (make par_bench_baseline).".format(
+                      args.baseline))
+
+    failures = []
+    results = {}
+    with tempfile.TemporaryDirectory() as work_dir:
+        for case in cases:
+            name = case[0]
+            serial = run_case(case, 1, work_dir)
+            parallel = run_case(case, args.threads, work_dir)
+            results[name] = {
+                "cutsize": parallel["cutsize"],
+                "total_seconds": parallel["total_seconds"],
+                "phase_seconds": parallel["phase_seconds"],
+            }
+            status = []
+            if not serial["balanced"] or not parallel["balanced"]:
+                status.append("unbalanced")
+            if serial["cutsize"] != parallel["cutsize"]:
+                status.append("cutsize {} with 1 thread, {} with {}".format(
+                    serial["cutsize"], parallel["cutsize"], args.threads))
+            if baseline is not None and name not in baseline:
+                status.append("no baseline")
+                runtime = "{:.2f}s".format(parallel["total_seconds"])
+            elif baseline is not None:
+                limit = baseline[name]["cutsize"] * (1.0 + args.tolerance)
+                if parallel["cutsize"] > limit:
+                    status.append("cutsize {} over baseline {}".format(
+                        parallel["cutsize"], baseline[name]["cutsize"]))
+                runtime = "{:.2f}s (baseline {:.2f}s)".format(
+                    parallel["total_seconds"],
+                    baseline[name]["total_seconds"])
+            else:
+                runtime = "{:.2f}s".format(parallel["total_seconds"])
+            print("{:20} cutsize {:>10} {:>28}  {}".format(
+                name, parallel["cutsize"], runtime,
+                "; ".join(status) if status else "pass"))
+            if status:
+                failures.append(name)
+
+    if args.update:
+        if not args.baseline:
+            sys.exit("--update needs --baseline")
+        with open(args.baseline, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+        print("Wrote baseline {}".format(args.baseline))
+
+    if failures:
+        sys.exit("Failed cases: {}".format(" ".join(failures)))
+
+
+if __name__ == "__main__":
+    main()
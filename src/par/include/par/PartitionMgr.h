@@ -66,9 +66,15 @@ class Logger;
 
 namespace par {
 
+class TritonPart;
+class TimingPathCache;
+
 class PartitionMgr
 {
  public:
+  PartitionMgr();
+  ~PartitionMgr();
+
   void init(odb::dbDatabase* db,
             sta::dbNetwork* db_network,
             sta::dbSta* sta,
@@ -121,6 +127,7 @@ class PartitionMgr
                             int max_num_vcycle,
                             int num_coarsen_solutions,
                             int num_vertices_threshold_ilp,
+                            int num_vertices_threshold_lp,
                             int global_net_threshold);
 
     void tritonPartRefine(unsigned int num_parts,
@@ -162,6 +169,7 @@ class PartitionMgr
                             int max_num_vcycle,
                             int num_coarsen_solutions,
                             int num_vertices_threshold_ilp,
+                            int num_vertices_threshold_lp,
                             int global_net_threshold);
 
   // Evaluate a given solution of a hypergraph
@@ -240,8 +248,15 @@ class PartitionMgr
                         int max_num_vcycle,
                         int num_coarsen_solutions,
                         int num_vertices_threshold_ilp,
+                        int num_vertices_threshold_lp,
                         int global_net_threshold);
 
+  // Incremental re-partitioning for small netlist ECOs.
+  // It reuses the hypergraph and solution of the previous tritonPartDesign
+  // call and only refines the vertices around the netlist changes
+  // (recorded through the OpenDB callbacks since the previous call).
+  void tritonPartDesignEco(const char* solution_filename_arg);
+
   void evaluatePartDesignSolution(unsigned int num_parts_arg,
                                   float balance_constraint_arg,
                                   const std::vector<float>& base_balance_arg,
@@ -287,6 +302,8 @@ class PartitionMgr
 
  private:
   odb::dbBlock* getDbBlock() const;
+  // a TritonPart instance using the OpenROAD thread count
+  std::unique_ptr<TritonPart> makeTritonPart() const;
   sta::Instance* buildPartitionedInstance(
       const char* name,
       const char* port_prefix,
@@ -304,6 +321,12 @@ class PartitionMgr
   sta::dbNetwork* db_network_ = nullptr;
   sta::dbSta* sta_ = nullptr;
   utl::Logger* logger_ = nullptr;
+
+  // the partitioner of the last tritonPartDesign call (for netlist ECOs)
+  std::unique_ptr<TritonPart> design_triton_part_;
+  // the timing paths extracted by tritonPartDesign (reused while the
+  // netlist is unchanged)
+  std::shared_ptr<TimingPathCache> timing_path_cache_;
 };
 
 }  // namespace par
@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "BinaryHypergraph.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace par {
+
+using utl::PAR;
+
+namespace {
+
+const char kMagic[8] = {'P', 'A', 'R', 'H', 'G', 'R', '\0', '\1'};
+const char* const kFileExtension = ".bhgr";
+
+const int kFixedFlag = 1;
+const int kCommunityFlag = 2;
+
+struct Header
+{
+  char magic[8];
+  int32_t num_vertices;
+  int32_t num_hyperedges;
+  int32_t vertex_dimensions;
+  int32_t hyperedge_dimensions;
+  int32_t placement_dimensions;
+  int32_t flags;
+  int64_t num_pins;
+};
+
+// A read-only memory mapped file
+class MappedFile
+{
+ public:
+  explicit MappedFile(const std::string& file_name)
+  {
+    fd_ = open(file_name.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      return;
+    }
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0 || file_stat.st_size == 0) {
+      return;
+    }
+    void* data
+        = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (data == MAP_FAILED) {
+      return;
+    }
+    data_ = static_cast<const char*>(data);
+    size_ = file_stat.st_size;
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile()
+  {
+    if (data_ != nullptr) {
+      munmap(const_cast<char*>(data_), size_);
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  bool IsValid() const { return data_ != nullptr; }
+  const char* Data() const { return data_; }
+  size_t Size() const { return size_; }
+
+ private:
+  int fd_ = -1;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Copy a block of num_values values starting at offset into values
+// and move the offset to the end of the block
+template <typename T>
+bool ReadBlock(const MappedFile& file,
+               size_t& offset,
+               const size_t num_values,
+               std::vector<T>& values)
+{
+  const size_t num_bytes = num_values * sizeof(T);
+  if (offset + num_bytes > file.Size()) {
+    return false;
+  }
+  values.resize(num_values);
+  std::memcpy(values.data(), file.Data() + offset, num_bytes);
+  offset += num_bytes;
+  return true;
+}
+
+template <typename T>
+void WriteBlock(std::ofstream& file_output, const std::vector<T>& values)
+{
+  file_output.write(reinterpret_cast<const char*>(values.data()),
+                    static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+}  // namespace
+
+bool IsBinaryHypergraphFileName(const std::string& file_name)
+{
+  const size_t extension_size = std::strlen(kFileExtension);
+  return file_name.size() >= extension_size
+         && file_name.compare(file_name.size() - extension_size,
+                              extension_size,
+                              kFileExtension)
+                == 0;
+}
+
+bool IsBinaryHypergraphFile(const std::string& file_name)
+{
+  std::ifstream file_input(file_name, std::ios::binary);
+  char magic[sizeof(kMagic)];
+  if (!file_input.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+void ReadBinaryHypergraph(const std::string& file_name,
+                          BinaryHypergraph& hgraph,
+                          utl::Logger* logger)
+{
+  const MappedFile file(file_name);
+  if (!file.IsValid()) {
+    logger->error(
+        PAR, 2515, "Can not map the binary hypergraph file : {}", file_name);
+  }
+  Header header;
+  if (file.Size() < sizeof(Header)) {
+    logger->error(
+        PAR, 2516, "Binary hypergraph file is too short : {}", file_name);
+  }
+  std::memcpy(&header, file.Data(), sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+      || header.num_vertices < 0 || header.num_hyperedges < 0
+      || header.vertex_dimensions < 0 || header.hyperedge_dimensions < 0
+      || header.placement_dimensions < 0 || header.num_pins < 0
+      || header.num_pins > std::numeric_limits<int>::max()) {
+    logger->error(PAR,
+                  2536,
+                  "Invalid header in binary hypergraph file : {}",
+                  file_name);
+  }
+
+  hgraph.num_vertices = header.num_vertices;
+  hgraph.num_hyperedges = header.num_hyperedges;
+  hgraph.vertex_dimensions = header.vertex_dimensions;
+  hgraph.hyperedge_dimensions = header.hyperedge_dimensions;
+  hgraph.placement_dimensions = header.placement_dimensions;
+  const size_t num_vertices = header.num_vertices;
+  const size_t num_hyperedges = header.num_hyperedges;
+  size_t offset = sizeof(Header);
+  bool valid_flag
+      = ReadBlock(file, offset, num_hyperedges + 1, hgraph.eptr)
+        && ReadBlock(file, offset, header.num_pins, hgraph.eind)
+        && ReadBlock(file,
+                     offset,
+                     num_hyperedges * header.hyperedge_dimensions,
+                     hgraph.hyperedge_weights)
+        && ReadBlock(file,
+                     offset,
+                     num_vertices * header.vertex_dimensions,
+                     hgraph.vertex_weights);
+  hgraph.fixed_attr.clear();
+  if (valid_flag && (header.flags & kFixedFlag) != 0) {
+    valid_flag = ReadBlock(file, offset, num_vertices, hgraph.fixed_attr);
+  }
+  hgraph.community_attr.clear();
+  if (valid_flag && (header.flags & kCommunityFlag) != 0) {
+    valid_flag = ReadBlock(file, offset, num_vertices, hgraph.community_attr);
+  }
+  valid_flag = valid_flag
+               && ReadBlock(file,
+                            offset,
+                            num_vertices * header.placement_dimensions,
+                            hgraph.placement_attr);
+  if (!valid_flag) {
+    logger->error(
+        PAR, 2517, "Truncated binary hypergraph file : {}", file_name);
+  }
+
+  // check the CSR representation
+  valid_flag
+      = hgraph.eptr.front() == 0 && hgraph.eptr.back() == header.num_pins;
+  for (size_t e = 0; valid_flag && e < num_hyperedges; e++) {
+    valid_flag = hgraph.eptr[e] <= hgraph.eptr[e + 1];
+  }
+  for (size_t i = 0; valid_flag && i < hgraph.eind.size(); i++) {
+    valid_flag = hgraph.eind[i] >= 0 && hgraph.eind[i] < header.num_vertices;
+  }
+  if (!valid_flag) {
+    logger->error(PAR,
+                  2518,
+                  "Invalid hyperedges in binary hypergraph file : {}",
+                  file_name);
+  }
+}
+
+void WriteBinaryHypergraph(const std::string& file_name,
+                           const BinaryHypergraph& hgraph,
+                           utl::Logger* logger)
+{
+  std::ofstream file_output(file_name, std::ios::binary);
+  if (!file_output.is_open()) {
+    logger->error(
+        PAR, 2519, "Can not open the binary hypergraph file : {}", file_name);
+  }
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.num_vertices = hgraph.num_vertices;
+  header.num_hyperedges = hgraph.num_hyperedges;
+  header.vertex_dimensions = hgraph.vertex_dimensions;
+  header.hyperedge_dimensions = hgraph.hyperedge_dimensions;
+  header.placement_dimensions = hgraph.placement_dimensions;
+  header.flags = (hgraph.fixed_attr.empty() ? 0 : kFixedFlag)
+                 | (hgraph.community_attr.empty() ? 0 : kCommunityFlag);
+  header.num_pins = static_cast<int64_t>(hgraph.eind.size());
+  file_output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  WriteBlock(file_output, hgraph.eptr);
+  WriteBlock(file_output, hgraph.eind);
+  WriteBlock(file_output, hgraph.hyperedge_weights);
+  WriteBlock(file_output, hgraph.vertex_weights);
+  WriteBlock(file_output, hgraph.fixed_attr);
+  WriteBlock(file_output, hgraph.community_attr);
+  WriteBlock(file_output, hgraph.placement_attr);
+  file_output.close();
+}
+
+}  // namespace par
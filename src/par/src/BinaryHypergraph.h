@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// The binary hypergraph format.
+// Parsing the hMETIS text format dominates the runtime of loading large
+// hypergraphs, so we also support a compact binary format which stores the
+// CSR representation of the hypergraph, the weights and the attributes of
+// vertices as raw arrays.  The file is memory mapped and each array is
+// copied into place with a single bulk copy, i.e., there is no parsing.
+//
+// Layout (all the values are stored in native byte order):
+//   char    magic[8]                "PARHGR\0\1"
+//   int32   num_vertices
+//   int32   num_hyperedges
+//   int32   vertex_dimensions       (0 : no vertex weights, i.e., unit weight)
+//   int32   hyperedge_dimensions    (0 : no hyperedge weights)
+//   int32   placement_dimensions    (0 : no placement information)
+//   int32   flags                   (bit 0 : fixed, bit 1 : community)
+//   int64   num_pins
+//   int32   eptr[num_hyperedges + 1]
+//   int32   eind[num_pins]          (vertex id starts from 0)
+//   float   hyperedge_weights[num_hyperedges * hyperedge_dimensions]
+//   float   vertex_weights[num_vertices * vertex_dimensions]
+//   int32   fixed_attr[num_vertices]       (if flags & 1)
+//   int32   community_attr[num_vertices]   (if flags & 2)
+//   float   placement_attr[num_vertices * placement_dimensions]
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "utl/Logger.h"
+
+namespace par {
+
+// The content of a binary hypergraph file.
+// The weights and placement are flat row-major arrays (see Hypergraph).
+struct BinaryHypergraph
+{
+  int num_vertices = 0;
+  int num_hyperedges = 0;
+  int vertex_dimensions = 0;     // 0 means no vertex weights
+  int hyperedge_dimensions = 0;  // 0 means no hyperedge weights
+  int placement_dimensions = 0;  // 0 means no placement information
+  std::vector<int> eptr;
+  std::vector<int> eind;
+  std::vector<float> hyperedge_weights;
+  std::vector<float> vertex_weights;
+  std::vector<int> fixed_attr;      // empty means no fixed vertices
+  std::vector<int> community_attr;  // empty means no community information
+  std::vector<float> placement_attr;
+};
+
+// The binary files are identified by the file extension when writing
+bool IsBinaryHypergraphFileName(const std::string& file_name);
+
+// The binary files are identified by the magic number when reading
+bool IsBinaryHypergraphFile(const std::string& file_name);
+
+void ReadBinaryHypergraph(const std::string& file_name,
+                          BinaryHypergraph& hgraph,
+                          utl::Logger* logger);
+
+void WriteBinaryHypergraph(const std::string& file_name,
+                           const BinaryHypergraph& hgraph,
+                           utl::Logger* logger);
+
+}  // namespace par
@@ -40,9 +40,13 @@
 
 #include "Coarsener.h"
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
 #include <numeric>
 #include <random>
 #include <set>
+#include <unordered_map>
 
 #include "Evaluator.h"
 #include "Hypergraph.h"
@@ -52,6 +56,32 @@ using utl::PAR;
 
 namespace par {
 
+namespace {
+
+// the attributes of clusters are stored in flat row-major arrays,
+// i.e., the row_id-th cluster occupies [row_id * num_cols, (row_id + 1) *
+// num_cols)
+Span<float> Row(std::vector<float>& flat, const int row_id, const int num_cols)
+{
+  return {flat.data() + static_cast<size_t>(row_id) * num_cols,
+          static_cast<size_t>(num_cols)};
+}
+
+Span<const float> Row(const std::vector<float>& flat,
+                      const int row_id,
+                      const int num_cols)
+{
+  return {flat.data() + static_cast<size_t>(row_id) * num_cols,
+          static_cast<size_t>(num_cols)};
+}
+
+void AppendRow(std::vector<float>& flat, Span<const float> row)
+{
+  flat.insert(flat.end(), row.begin(), row.end());
+}
+
+}  // namespace
+
 Coarsener::Coarsener(const int num_parts,
                      const int thr_coarsen_hyperedge_size_skip,
                      const int thr_coarsen_vertices,
@@ -171,10 +201,10 @@ HGraphPtr Coarsener::GroupVertices(
 {
   std::vector<int>
       vertex_cluster_id_vec;          // map current vertex_id to cluster_id
-  Matrix<float> vertex_weights_c;     // cluster weight
-  std::vector<int> community_attr_c;  // cluster community information
-  std::vector<int> fixed_attr_c;      // cluster fixed attribute
-  Matrix<float> placement_attr_c;     // cluster placement attribute
+  std::vector<float> vertex_weights_c;  // cluster weight (flat)
+  std::vector<int> community_attr_c;    // cluster community information
+  std::vector<int> fixed_attr_c;        // cluster fixed attribute
+  std::vector<float> placement_attr_c;  // cluster placement attribute (flat)
 
   // Cluster based group information
   ClusterBasedGroupInfo(hgraph,
@@ -188,10 +218,10 @@ HGraphPtr Coarsener::GroupVertices(
   // coarsen the input hypergraph based on vertex matching map
   auto clustered_hgraph = Contraction(hgraph,
                                       vertex_cluster_id_vec,
-                                      vertex_weights_c,
+                                      std::move(vertex_weights_c),
                                       community_attr_c,
                                       fixed_attr_c,
-                                      placement_attr_c);
+                                      std::move(placement_attr_c));
 
   // update the timing cost of the clusterd_hgraph
   // hgraph will be updated here
@@ -217,10 +247,10 @@ HGraphPtr Coarsener::GroupVertices(
 HGraphPtr Coarsener::Aggregate(const HGraphPtr& hgraph) const
 {
   std::vector<int> vertex_cluster_id_vec;
-  Matrix<float> vertex_weights_c;
+  std::vector<float> vertex_weights_c;
   std::vector<int> community_attr_c;
   std::vector<int> fixed_attr_c;
-  Matrix<float> placement_attr_c;
+  std::vector<float> placement_attr_c;
 
   // find the vertex matching scheme
   VertexMatching(hgraph,
@@ -233,10 +263,10 @@ HGraphPtr Coarsener::Aggregate(const HGraphPtr& hgraph) const
   // coarsen the input hypergraph based on vertex matching map
   auto clustered_hgraph = Contraction(hgraph,
                                       vertex_cluster_id_vec,
-                                      vertex_weights_c,
+                                      std::move(vertex_weights_c),
                                       community_attr_c,
                                       fixed_attr_c,
-                                      placement_attr_c);
+                                      std::move(placement_attr_c));
 
   // update the timing cost of the clusterd_hgraph
   // hgraph will be updated here
@@ -262,10 +292,10 @@ void Coarsener::VertexMatching(
     std::vector<int>&
         vertex_cluster_id_vec,  // map current vertex_id to cluster_id
     // the remaining arguments are related to clusters
-    Matrix<float>& vertex_weights_c,
+    std::vector<float>& vertex_weights_c,
     std::vector<int>& community_attr_c,
     std::vector<int>& fixed_attr_c,
-    Matrix<float>& placement_attr_c) const
+    std::vector<float>& placement_attr_c) const
 {
   // vertex_cluster_map_vec has the size of the number of vertices of hgraph
   vertex_cluster_id_vec.clear();
@@ -276,6 +306,8 @@ void Coarsener::VertexMatching(
   community_attr_c.clear();  // cluster community
   fixed_attr_c.clear();      // cluster fixed attribute
   placement_attr_c.clear();  // cluster location
+  const int vertex_dim = hgraph->GetVertexDimensions();
+  const int placement_dim = hgraph->GetPlacementDimensions();
   // check all the vertices to be clustered
   int cluster_id = 0;  // the id of cluster
   std::vector<int> unvisited;
@@ -290,13 +322,13 @@ void Coarsener::VertexMatching(
       // mark fixed vertices as single-vertex clusters
       if (hgraph->GetFixedAttr(v) > -1) {
         vertex_cluster_id_vec[v] = cluster_id++;
-        vertex_weights_c.push_back(hgraph->GetVertexWeights(v));
+        AppendRow(vertex_weights_c, hgraph->GetVertexWeights(v));
         fixed_attr_c.push_back(hgraph->GetFixedAttr(v));
         if (hgraph->HasCommunity()) {
           community_attr_c.push_back(hgraph->GetCommunity(v));
         }
         if (hgraph->HasPlacement()) {
-          placement_attr_c.push_back(hgraph->GetPlacement(v));
+          AppendRow(placement_attr_c, hgraph->GetPlacement(v));
         }
       } else {
         unvisited.push_back(v);  // this vertex is not fixed
@@ -351,12 +383,18 @@ void Coarsener::VertexMatching(
           continue;
         }
         // check the vertex weight constraint
-        const std::vector<float>& nbr_v_weight
+        const Span<const float> nbr_v_weight
             = vertex_cluster_id_vec[nbr_v] > -1
-                  ? vertex_weights_c[vertex_cluster_id_vec[nbr_v]]
+                  ? Row(vertex_weights_c,
+                        vertex_cluster_id_vec[nbr_v],
+                        vertex_dim)
                   : hgraph->GetVertexWeights(nbr_v);
-        // This line needs to be updated
-        if (hgraph->GetVertexWeights(v) + nbr_v_weight > thr_cluster_weight_) {
+        // (weight of v + nbr_v_weight) > thr_cluster_weight_
+        if (ShiftedLexCompare(hgraph->GetVertexWeights(v),
+                              nbr_v_weight,
+                              1.0f,
+                              thr_cluster_weight_)
+            > 0) {
           continue;  // cannot satisfy the vertex weight constraint
         }
         score_map[nbr_v] = he_score;
@@ -367,9 +405,9 @@ void Coarsener::VertexMatching(
     if (score_map.empty()) {
       num_visited_vertices++;
       vertex_cluster_id_vec[v] = cluster_id++;
-      vertex_weights_c.push_back(hgraph->GetVertexWeights(v));
+      AppendRow(vertex_weights_c, hgraph->GetVertexWeights(v));
       if (hgraph->HasPlacement()) {
-        placement_attr_c.push_back(hgraph->GetPlacement(v));
+        AppendRow(placement_attr_c, hgraph->GetPlacement(v));
       }
       if (hgraph->HasCommunity()) {
         community_attr_c.push_back(hgraph->GetCommunity(v));
@@ -441,9 +479,9 @@ void Coarsener::VertexMatching(
       num_visited_vertices += 1;
       vertex_cluster_id_vec[v] = cluster_id;
       cluster_id++;
-      vertex_weights_c.push_back(hgraph->GetVertexWeights(v));
+      AppendRow(vertex_weights_c, hgraph->GetVertexWeights(v));
       if (hgraph->HasPlacement()) {
-        placement_attr_c.push_back(hgraph->GetPlacement(v));
+        AppendRow(placement_attr_c, hgraph->GetPlacement(v));
       }
       if (hgraph->HasCommunity()) {
         community_attr_c.push_back(hgraph->GetCommunity(v));
@@ -464,26 +502,35 @@ void Coarsener::VertexMatching(
       // you cannot change the order here
       // update the placement location
       if (hgraph->HasPlacement()) {
-        placement_attr_c[best_cluster_id]
-            = evaluator_->GetAvgPlacementLoc(vertex_weights_c[best_cluster_id],
-                                             hgraph->GetVertexWeights(v),
-                                             placement_attr_c[best_cluster_id],
-                                             hgraph->GetPlacement(v));
+        const Span<float> cluster_loc
+            = Row(placement_attr_c, best_cluster_id, placement_dim);
+        evaluator_->GetAvgPlacementLoc(
+            Row(vertex_weights_c, best_cluster_id, vertex_dim),
+            hgraph->GetVertexWeights(v),
+            cluster_loc,
+            hgraph->GetPlacement(v),
+            cluster_loc);
       }
       // update the weight of cluster
-      vertex_weights_c[best_cluster_id]
-          = vertex_weights_c[best_cluster_id] + hgraph->GetVertexWeights(v);
+      Accumulate(Row(vertex_weights_c, best_cluster_id, vertex_dim),
+                 hgraph->GetVertexWeights(v));
     } else {
       num_visited_vertices += 2;
       vertex_cluster_id_vec[best_vertex] = cluster_id;
       vertex_cluster_id_vec[v] = cluster_id;
-      cluster_id++;
-      vertex_weights_c.push_back(hgraph->GetVertexWeights(best_vertex)
-                                 + hgraph->GetVertexWeights(v));
+      AppendRow(vertex_weights_c, hgraph->GetVertexWeights(best_vertex));
+      Accumulate(Row(vertex_weights_c, cluster_id, vertex_dim),
+                 hgraph->GetVertexWeights(v));
       if (hgraph->HasPlacement()) {
-        placement_attr_c.push_back(
-            evaluator_->GetAvgPlacementLoc(v, best_vertex, hgraph));
+        placement_attr_c.resize(placement_attr_c.size() + placement_dim);
+        evaluator_->GetAvgPlacementLoc(
+            hgraph->GetVertexWeights(v),
+            hgraph->GetVertexWeights(best_vertex),
+            hgraph->GetPlacement(v),
+            hgraph->GetPlacement(best_vertex),
+            Row(placement_attr_c, cluster_id, placement_dim));
       }
+      cluster_id++;
       if (hgraph->HasCommunity()) {
         community_attr_c.push_back(hgraph->GetCommunity(v));
       }
@@ -510,9 +557,9 @@ void Coarsener::VertexMatching(
           continue;  // this vertex has been visited
         }
         vertex_cluster_id_vec[cur_vertex] = cluster_id++;
-        vertex_weights_c.push_back(hgraph->GetVertexWeights(cur_vertex));
+        AppendRow(vertex_weights_c, hgraph->GetVertexWeights(cur_vertex));
         if (hgraph->HasPlacement()) {
-          placement_attr_c.push_back(hgraph->GetPlacement(cur_vertex));
+          AppendRow(placement_attr_c, hgraph->GetPlacement(cur_vertex));
         }
         if (hgraph->HasCommunity()) {
           community_attr_c.push_back(hgraph->GetCommunity(cur_vertex));
@@ -540,10 +587,10 @@ void Coarsener::ClusterBasedGroupInfo(
     std::vector<int>&
         vertex_cluster_id_vec,  // map current vertex_id to cluster_id
     // the remaining arguments are related to clusters
-    Matrix<float>& vertex_weights_c,
+    std::vector<float>& vertex_weights_c,
     std::vector<int>& community_attr_c,
     std::vector<int>& fixed_attr_c,
-    Matrix<float>& placement_attr_c) const
+    std::vector<float>& placement_attr_c) const
 {
   // convert group_attr to vertex_cluster_id_vec
   if (group_attr.empty() == true && hgraph->GetFixedAttrSize() == 0) {
@@ -551,7 +598,7 @@ void Coarsener::ClusterBasedGroupInfo(
     vertex_cluster_id_vec.clear();
     vertex_cluster_id_vec.resize(hgraph->GetNumVertices());
     std::iota(vertex_cluster_id_vec.begin(), vertex_cluster_id_vec.end(), 0);
-    vertex_weights_c = hgraph->GetVertexWeights();
+    vertex_weights_c = hgraph->GetVertexWeights();  // flat copy
     hgraph->CopyCommunity(community_attr_c);
     hgraph->CopyFixedAttr(fixed_attr_c);
     hgraph->CopyPlacement(placement_attr_c);
@@ -614,11 +661,9 @@ void Coarsener::ClusterBasedGroupInfo(
   fixed_attr_c.clear();
   placement_attr_c.clear();
   // update vertex weights
-  vertex_weights_c.clear();
-  for (int v = 0; v < num_clusters; v++) {
-    std::vector<float> v_wt(hgraph->GetVertexDimensions(), 0.0);
-    vertex_weights_c.push_back(v_wt);
-  }
+  const int vertex_dim = hgraph->GetVertexDimensions();
+  const int placement_dim = hgraph->GetPlacementDimensions();
+  vertex_weights_c.assign(static_cast<size_t>(num_clusters) * vertex_dim, 0.0);
   if (hgraph->HasCommunity()) {
     community_attr_c.clear();
     community_attr_c.resize(num_clusters);
@@ -630,11 +675,8 @@ void Coarsener::ClusterBasedGroupInfo(
     std::fill(fixed_attr_c.begin(), fixed_attr_c.end(), -1);
   }
   if (hgraph->HasPlacement()) {
-    placement_attr_c.clear();
-    for (int v = 0; v < num_clusters; v++) {
-      std::vector<float> v_placement(hgraph->GetPlacementDimensions(), 0.0);
-      placement_attr_c.push_back(v_placement);
-    }
+    placement_attr_c.assign(static_cast<size_t>(num_clusters) * placement_dim,
+                            0.0);
   }
 
   // Update the attributes of clusters
@@ -649,14 +691,17 @@ void Coarsener::ClusterBasedGroupInfo(
           = std::max(fixed_attr_c[cluster_id], hgraph->GetFixedAttr(v));
     }
     if (hgraph->HasPlacement()) {
-      placement_attr_c[cluster_id]
-          = evaluator_->GetAvgPlacementLoc(vertex_weights_c[cluster_id],
-                                           hgraph->GetVertexWeights(v),
-                                           placement_attr_c[cluster_id],
-                                           hgraph->GetPlacement(v));
-    }
-    vertex_weights_c[cluster_id]
-        = vertex_weights_c[cluster_id] + hgraph->GetVertexWeights(v);
+      const Span<float> cluster_loc
+          = Row(placement_attr_c, cluster_id, placement_dim);
+      evaluator_->GetAvgPlacementLoc(
+          Row(vertex_weights_c, cluster_id, vertex_dim),
+          hgraph->GetVertexWeights(v),
+          cluster_loc,
+          hgraph->GetPlacement(v),
+          cluster_loc);
+    }
+    Accumulate(Row(vertex_weights_c, cluster_id, vertex_dim),
+               hgraph->GetVertexWeights(v));
   }
 }
 
@@ -715,6 +760,106 @@ void Coarsener::OrderVertices(const HGraphPtr& hgraph,
   }
 }
 
+// Detect the parallel sequences (hyperedges or timing paths).
+// The sequences are distributed into buckets based on their hash values,
+// such that identical sequences always fall into the same bucket. Then the
+// buckets are processed independently in parallel. Within each bucket the
+// sequences are visited in increasing order, so rep[i] is always the first
+// occurrence and the result does not depend on the number of threads.
+void Coarsener::DetectParallelSequences(const std::vector<int>& sequences,
+                                        const std::vector<int>& offsets,
+                                        const std::vector<int>& lengths,
+                                        std::vector<int>& rep) const
+{
+  const int num_sequences = static_cast<int>(lengths.size());
+  rep.clear();
+  rep.resize(num_sequences, -1);
+  // hash each sequence
+  std::vector<size_t> hash_values(num_sequences, 0);
+  ParallelForRange(num_sequences, [&](const int first, const int last) {
+    for (int i = first; i < last; i++) {
+      if (lengths[i] > 0) {
+        const auto begin = sequences.begin() + offsets[i];
+        hash_values[i] = boost::hash_range(begin, begin + lengths[i]);
+      }
+    }
+  });
+
+  // distribute the sequences into buckets (counting sort)
+  const int num_threads
+      = thread_pool_ == nullptr ? 1 : thread_pool_->GetNumThreads();
+  const int num_buckets = num_threads == 1 ? 1 : num_threads * 8;
+  std::vector<int> bucket_ptr(num_buckets + 1, 0);
+  for (int i = 0; i < num_sequences; i++) {
+    if (lengths[i] > 0) {
+      bucket_ptr[hash_values[i] % num_buckets + 1]++;
+    }
+  }
+  std::partial_sum(bucket_ptr.begin(), bucket_ptr.end(), bucket_ptr.begin());
+  std::vector<int> bucket_items(bucket_ptr.back());
+  std::vector<int> bucket_fill(bucket_ptr.begin(), bucket_ptr.end() - 1);
+  for (int i = 0; i < num_sequences; i++) {
+    if (lengths[i] > 0) {
+      bucket_items[bucket_fill[hash_values[i] % num_buckets]++] = i;
+    }
+  }
+
+  // detect the identical sequences in each bucket
+  ParallelFor(num_buckets, [&](const int bucket) {
+    // hash value -> the representatives with this hash value
+    std::unordered_map<size_t, std::vector<int>> hash_map;
+    for (int idx = bucket_ptr[bucket]; idx < bucket_ptr[bucket + 1]; idx++) {
+      const int i = bucket_items[idx];
+      const auto begin = sequences.begin() + offsets[i];
+      auto& candidates = hash_map[hash_values[i]];
+      for (const int candidate : candidates) {
+        const auto candidate_begin = sequences.begin() + offsets[candidate];
+        if (lengths[candidate] == lengths[i]
+            && std::equal(begin, begin + lengths[i], candidate_begin)) {
+          rep[i] = candidate;
+          break;  // found the identical sequence
+        }
+      }
+      if (rep[i] == -1) {
+        rep[i] = i;  // the first occurrence
+        candidates.push_back(i);
+      }
+    }
+  });
+}
+
+void Coarsener::ParallelForRange(
+    const int num_items,
+    const std::function<void(int, int)>& func) const
+{
+  if (num_items <= 0) {
+    return;
+  }
+  const int num_threads
+      = thread_pool_ == nullptr ? 1 : thread_pool_->GetNumThreads();
+  const int num_ranges = std::min(num_items, num_threads * 4);
+  const int range_size = (num_items + num_ranges - 1) / num_ranges;
+  ParallelFor(num_ranges, [&](const int range_id) {
+    const int first = range_id * range_size;
+    const int last = std::min(num_items, first + range_size);
+    if (first < last) {
+      func(first, last);
+    }
+  });
+}
+
+void Coarsener::ParallelFor(const int num_tasks,
+                            const std::function<void(int)>& func) const
+{
+  if (thread_pool_ == nullptr) {
+    for (int i = 0; i < num_tasks; i++) {
+      func(i);
+    }
+    return;
+  }
+  thread_pool_->ParallelFor(num_tasks, func);
+}
+
 //  create the contracted hypergraph based on the vertex matching in
 //  vertex_cluster_id_vec
 HGraphPtr Coarsener::Contraction(
@@ -722,57 +867,74 @@ HGraphPtr Coarsener::Contraction(
     const std::vector<int>&
         vertex_cluster_id_vec,  // map current vertex_id to cluster_id
     // the remaining arguments are related to clusters
-    const Matrix<float>& vertex_weights_c,
+    std::vector<float>&& vertex_weights_c,
     const std::vector<int>& community_attr_c,
     const std::vector<int>& fixed_attr_c,
-    const Matrix<float>& placement_attr_c) const
+    std::vector<float>&& placement_attr_c) const
 {
   // Step 1:  identify the contracted hyperedges
+  // The contraction runs in three phases:
+  // (a) each hyperedge is mapped to its sorted set of clusters in parallel,
+  // (b) identical (parallel) hyperedges are detected in parallel,
+  //     see DetectParallelSequences(),
+  // (c) the clustered hyperedges are merged in the order of the original
+  //     hyperedges, so the result does not depend on the number of threads.
+  const int num_hyperedges = hgraph->GetNumHyperedges();
+  std::vector<int> hyperedge_offsets(num_hyperedges + 1, 0);
+  for (int e = 0; e < num_hyperedges; e++) {
+    hyperedge_offsets[e + 1]
+        = hyperedge_offsets[e] + static_cast<int>(hgraph->Vertices(e).size());
+  }
+  std::vector<int> hyperedge_clusters(hyperedge_offsets.back());
+  std::vector<int> hyperedge_lengths(num_hyperedges, 0);
+  ParallelForRange(num_hyperedges, [&](const int first, const int last) {
+    for (int e = first; e < last; e++) {
+      const auto range = hgraph->Vertices(e);
+      const int he_size = range.size();
+      if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
+        continue;  // ignore the single-vertex hyperedge and large hyperedge
+      }
+      auto begin = hyperedge_clusters.begin() + hyperedge_offsets[e];
+      auto end = begin;
+      for (const int vertex_id : range) {
+        *end++ = vertex_cluster_id_vec[vertex_id];  // get cluster id
+      }
+      std::sort(begin, end);
+      end = std::unique(begin, end);
+      if (end - begin <= 1) {
+        continue;  // ignore the single-vertex hyperedge
+      }
+      hyperedge_lengths[e] = static_cast<int>(end - begin);
+    }
+  });
+  // the representative of each hyperedge, i.e., the first hyperedge with
+  // the same set of clusters
+  std::vector<int> hyperedge_rep;
+  DetectParallelSequences(
+      hyperedge_clusters, hyperedge_offsets, hyperedge_lengths, hyperedge_rep);
+
   std::vector<int> hyperedge_cluster_id_vec;  // map the hyperedge to hyperedge
                                               // in clustered hypergraph
-  hyperedge_cluster_id_vec.resize(hgraph->GetNumHyperedges());
   // -1 means the hyperedge is fully within one cluster
-  std::fill(
-      hyperedge_cluster_id_vec.begin(), hyperedge_cluster_id_vec.end(), -1);
+  hyperedge_cluster_id_vec.resize(num_hyperedges, -1);
   Matrix<int> hyperedges_c;  // represent each hyperedge as a set of clusters
-  Matrix<float> hyperedges_weights_c;  // each element represents the weight of
-                                       // the clustered hyperedge
+  // the weights of the clustered hyperedges (flat)
+  std::vector<float> hyperedges_weights_c;
+  const int hyperedge_dim = hgraph->GetHyperedgeDimensions();
   std::vector<float> hyperedge_slack_c;  // the slack for clustered hyperedge.
   std::vector<std::set<int>>
       hyperedge_arc_set_c;  // map current hyperedge into arcs in timing graph.
                             // We need this for propagation
-  std::map<size_t, int>
-      hash_map;  // store the hash value of each contracted hyperedge
-  std::map<size_t, std::vector<int>>
-      parallel_hash_map;  // store the hyperedges_c with the same hash_value
-                          // (candidate)
-  for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-    const auto range = hgraph->Vertices(e);
-    const int he_size = range.size();
-    if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_skip_) {
-      continue;  // ignore the single-vertex hyperedge and large hyperedge
-    }
-    std::set<int> hyperedge_c;
-    for (const int vertex_id : range) {
-      hyperedge_c.insert(vertex_cluster_id_vec[vertex_id]);  // get cluster id
-    }
-    if (hyperedge_c.size() <= 1) {
-      continue;  // ignore the single-vertex hyperedge
-    }
-    size_t hash_value = std::inner_product(hyperedge_c.begin(),
-                                           hyperedge_c.end(),
-                                           hyperedge_c.begin(),
-                                           static_cast<size_t>(0));
-    // check if the hash value has been used
-    // for detecting parallel hyperedge
-    // hyperedge_slack_c[e] = min_slack(hyperedge_arc_set_c[e])
-    if (hash_map.find(hash_value) == hash_map.end()) {
-      const int hyperedge_c_id = static_cast<int>(hyperedges_c.size());
-      hyperedge_cluster_id_vec[e] = hyperedge_c_id;
-      hash_map[hash_value] = hyperedge_c_id;
-      hyperedges_c.push_back(
-          std::vector<int>(hyperedge_c.begin(), hyperedge_c.end()));
-      hyperedges_weights_c.push_back(hgraph->GetHyperedgeWeights(e));
+  for (int e = 0; e < num_hyperedges; e++) {
+    if (hyperedge_rep[e] == -1) {
+      continue;  // this hyperedge has been ignored
+    }
+    if (hyperedge_rep[e] == e) {
+      // hyperedge_slack_c[e] = min_slack(hyperedge_arc_set_c[e])
+      hyperedge_cluster_id_vec[e] = static_cast<int>(hyperedges_c.size());
+      const auto begin = hyperedge_clusters.begin() + hyperedge_offsets[e];
+      hyperedges_c.emplace_back(begin, begin + hyperedge_lengths[e]);
+      AppendRow(hyperedges_weights_c, hgraph->GetHyperedgeWeights(e));
       if (hgraph->HasTiming()) {
         hyperedge_slack_c.push_back(
             hgraph->GetHyperedgeTimingAttr(e));  // the slack of hyperedge
@@ -781,138 +943,92 @@ HGraphPtr Coarsener::Contraction(
       }
       continue;
     }
-
-    // there may be parallel hyperedges
-    const int hash_hyperedge_c_id
-        = hash_map[hash_value];  // the hyperedge_c has been found
-    std::vector<int> hyperedge_vec(hyperedge_c.begin(), hyperedge_c.end());
-    // check the representative hyperedge_c
-    int parallel_hyperedge_c_id
-        = -1;  // the hyperedge_c_id of parallel hyperedge
-    // find the parallel_hyperedge_c_id
-    if (hyperedge_vec == hyperedges_c[hash_hyperedge_c_id]) {
-      // check the representative hyperedge_c
-      parallel_hyperedge_c_id = hash_hyperedge_c_id;
-    } else {
-      // check the parallel hyperedge_c_id
-      for (const auto& candidate_id : parallel_hash_map[hash_value]) {
-        if (hyperedge_vec == hyperedges_c[candidate_id]) {
-          parallel_hyperedge_c_id = candidate_id;
-          break;  // found the same hyperedge_c
-        }
-      }
-    }
-    // check if the hyperedge has been existed
-    if (parallel_hyperedge_c_id == -1) {
-      // not existed
-      const int hyperedge_c_id = static_cast<int>(hyperedges_c.size());
-      hyperedge_cluster_id_vec[e] = hyperedge_c_id;
-      parallel_hash_map[hash_value].push_back(hyperedge_c_id);
-      hyperedges_c.push_back(hyperedge_vec);
-      hyperedges_weights_c.push_back(hgraph->GetHyperedgeWeights(e));
-      if (hgraph->HasTiming()) {
-        hyperedge_slack_c.push_back(
-            hgraph->GetHyperedgeTimingAttr(e));  // the slack of hyperedge
-        hyperedge_arc_set_c.push_back(
-            hgraph->GetHyperedgeArcSet(e));  // map the hyperedge to timing arcs
-      }
-    } else {
-      // existed
-      hyperedges_weights_c[parallel_hyperedge_c_id]
-          = hyperedges_weights_c[parallel_hyperedge_c_id]
-            + hgraph->GetHyperedgeWeights(e);
-      hyperedge_cluster_id_vec[e] = parallel_hyperedge_c_id;
-      if (hgraph->HasTiming()) {
-        hyperedge_slack_c[parallel_hyperedge_c_id]
-            = std::min(hyperedge_slack_c[parallel_hyperedge_c_id],
-                       hgraph->GetHyperedgeTimingAttr(e));
-        hyperedge_arc_set_c[parallel_hyperedge_c_id].insert(
-            hgraph->GetHyperedgeArcSet(e).begin(),
-            hgraph->GetHyperedgeArcSet(e).end());
-      }
+    // parallel hyperedge
+    const int parallel_hyperedge_c_id
+        = hyperedge_cluster_id_vec[hyperedge_rep[e]];
+    hyperedge_cluster_id_vec[e] = parallel_hyperedge_c_id;
+    Accumulate(
+        Row(hyperedges_weights_c, parallel_hyperedge_c_id, hyperedge_dim),
+        hgraph->GetHyperedgeWeights(e));
+    if (hgraph->HasTiming()) {
+      hyperedge_slack_c[parallel_hyperedge_c_id]
+          = std::min(hyperedge_slack_c[parallel_hyperedge_c_id],
+                     hgraph->GetHyperedgeTimingAttr(e));
+      hyperedge_arc_set_c[parallel_hyperedge_c_id].insert(
+          hgraph->GetHyperedgeArcSet(e).begin(),
+          hgraph->GetHyperedgeArcSet(e).end());
     }
   }
 
   // Step 2: identify all the timing paths
+  // The parallel timing paths are detected in the same way as hyperedges.
+  // Here the vertex representation of a timing path is a sequence of
+  // clusters (not sorted).
   std::vector<TimingPath> timing_paths_c;
-  hash_map.clear();           // used to detect parallel timing path
-  parallel_hash_map.clear();  // used to detect parallel timing path
   if (hgraph->HasTiming() && hgraph->GetNumTimingPaths() > 0) {
-    for (int p = 0; p < hgraph->GetNumTimingPaths(); ++p) {
-      // check vertex representation
-      auto path_range = hgraph->PathVertices(p);
-      const int path_size_original = path_range.size();
-
-      if (path_size_original <= 1) {
-        continue;  // ignore single-vertex path
-      }
-      std::vector<int> path_c;  // create path_c
-      for (const int vertex_id : path_range) {
-        const int cluster_id = vertex_cluster_id_vec[vertex_id];
-        if (path_c.empty() == true || path_c.back() != cluster_id) {
-          path_c.push_back(cluster_id);
+    const int num_paths = hgraph->GetNumTimingPaths();
+    std::vector<int> path_offsets(num_paths + 1, 0);
+    for (int p = 0; p < num_paths; p++) {
+      path_offsets[p + 1]
+          = path_offsets[p] + static_cast<int>(hgraph->PathVertices(p).size());
+    }
+    std::vector<int> path_clusters(path_offsets.back());
+    std::vector<int> path_lengths(num_paths, 0);
+    ParallelForRange(num_paths, [&](const int first, const int last) {
+      for (int p = first; p < last; p++) {
+        // check vertex representation
+        auto path_range = hgraph->PathVertices(p);
+        if (path_range.size() <= 1) {
+          continue;  // ignore single-vertex path
         }
-      }
-      if (path_c.size() <= 1) {
-        continue;  // ignore single-vertex path
-      }
-      const size_t hash_value = std::inner_product(
-          path_c.begin(), path_c.end(), path_c.begin(), static_cast<size_t>(0));
-      if (hash_map.find(hash_value) == hash_map.end()) {
-        // the path does not exists
-        // check hyperedge representation
-        std::vector<int> arcs_c;
-        for (const int edge : hgraph->PathEdges(p)) {
-          const int hyperedge_c_id = hyperedge_cluster_id_vec[edge];
-          // if hyperedge_c_id is -1, that means that hyperedge has been merged
-          // during coarsening
-          if ((hyperedge_c_id > -1)
-              && (arcs_c.empty() == true || arcs_c.back() != hyperedge_c_id)) {
-            arcs_c.push_back(hyperedge_c_id);
+        const auto begin = path_clusters.begin() + path_offsets[p];
+        auto end = begin;
+        for (const int vertex_id : path_range) {
+          const int cluster_id = vertex_cluster_id_vec[vertex_id];
+          if (end == begin || *(end - 1) != cluster_id) {
+            *end++ = cluster_id;
           }
         }
-        hash_map[hash_value] = static_cast<int>(timing_paths_c.size());
-        TimingPath timing_path_c(path_c, arcs_c, hgraph->PathTimingSlack(p));
-        timing_paths_c.push_back(timing_path_c);
-      } else {
-        const int timing_path_c_id = hash_map[hash_value];
-        int parallel_timing_path_c_id
-            = -1;  // the timing_path_id of parallel timing path
-        if (path_c == timing_paths_c[timing_path_c_id].path) {
-          // check the representative timing path
-          parallel_timing_path_c_id = timing_path_c_id;
-        } else {
-          // check the parallel timing paths
-          for (const auto& candidate_id : parallel_hash_map[hash_value]) {
-            if (path_c == timing_paths_c[candidate_id].path) {
-              parallel_timing_path_c_id = candidate_id;
-              break;  // found the same timing path
-            }
-          }
+        if (end - begin <= 1) {
+          continue;  // ignore single-vertex path
         }
-        // check if the timing path has been existed
-        if (parallel_timing_path_c_id == -1) {
-          // not existed
-          std::vector<int> arcs_c;
-          for (const int edge : hgraph->PathEdges(p)) {
-            const int hyperedge_c_id = hyperedge_cluster_id_vec[edge];
-            if ((hyperedge_c_id > -1)
-                && (arcs_c.empty() == true
-                    || arcs_c.back() != hyperedge_c_id)) {
-              arcs_c.push_back(hyperedge_c_id);
-            }
-          }
-          parallel_hash_map[hash_value].push_back(
-              static_cast<int>(timing_paths_c.size()));
-          timing_paths_c.emplace_back(
-              path_c, arcs_c, hgraph->PathTimingSlack(p));
-        } else {
-          // existed
-          timing_paths_c[parallel_timing_path_c_id].slack
-              = std::min(timing_paths_c[parallel_timing_path_c_id].slack,
-                         hgraph->PathTimingSlack(p));
+        path_lengths[p] = static_cast<int>(end - begin);
+      }
+    });
+    std::vector<int> path_rep;
+    DetectParallelSequences(
+        path_clusters, path_offsets, path_lengths, path_rep);
+
+    // merge the parallel timing paths
+    std::vector<int> path_cluster_id_vec(num_paths, -1);
+    for (int p = 0; p < num_paths; p++) {
+      if (path_rep[p] == -1) {
+        continue;  // this path has been ignored
+      }
+      if (path_rep[p] != p) {
+        // existed
+        auto& timing_path_c = timing_paths_c[path_cluster_id_vec[path_rep[p]]];
+        timing_path_c.slack
+            = std::min(timing_path_c.slack, hgraph->PathTimingSlack(p));
+        continue;
+      }
+      // check hyperedge representation
+      std::vector<int> arcs_c;
+      for (const int edge : hgraph->PathEdges(p)) {
+        const int hyperedge_c_id = hyperedge_cluster_id_vec[edge];
+        // if hyperedge_c_id is -1, that means that hyperedge has been merged
+        // during coarsening
+        if ((hyperedge_c_id > -1)
+            && (arcs_c.empty() == true || arcs_c.back() != hyperedge_c_id)) {
+          arcs_c.push_back(hyperedge_c_id);
         }
       }
+      const auto begin = path_clusters.begin() + path_offsets[p];
+      path_cluster_id_vec[p] = static_cast<int>(timing_paths_c.size());
+      timing_paths_c.emplace_back(
+          std::vector<int>(begin, begin + path_lengths[p]),
+          arcs_c,
+          hgraph->PathTimingSlack(p));
     }
   }
 
@@ -928,12 +1044,12 @@ HGraphPtr Coarsener::Contraction(
                                      hgraph->GetHyperedgeDimensions(),
                                      hgraph->GetPlacementDimensions(),
                                      hyperedges_c,
-                                     vertex_weights_c,
-                                     hyperedges_weights_c,
+                                     std::move(vertex_weights_c),
+                                     std::move(hyperedges_weights_c),
                                      // vertex attributes
                                      fixed_attr_c,
                                      community_attr_c,
-                                     placement_attr_c,
+                                     std::move(placement_attr_c),
                                      vertex_types_c,
                                      // timing information
                                      hyperedge_slack_c,
@@ -40,8 +40,11 @@
 // It will accept a HGraphPtr (std::shared_ptr<Hypergraph>) as input
 // and return a sequence of coarser hypergraphs
 
+#include <functional>
+
 #include "Evaluator.h"
 #include "Hypergraph.h"
+#include "ThreadPool.h"
 #include "utl/Logger.h"
 
 namespace par {
@@ -124,6 +127,17 @@ class Coarsener
   }
 
   void IncreaseRandomSeed() { random_seed_++; }
+  void SetRandomSeed(int random_seed) { random_seed_ = random_seed; }
+  int GetRandomSeed() const { return random_seed_; }
+
+  void SetLogger(utl::Logger* logger) { logger_ = logger; }
+
+  // The worker pool used for contracting hyperedges in parallel.
+  // If no pool is specified, the contraction is performed serially.
+  void SetThreadPool(ThreadPoolPtr thread_pool)
+  {
+    thread_pool_ = std::move(thread_pool);
+  }
 
  private:
   // private functions (utilities)
@@ -144,10 +158,11 @@ class Coarsener
       std::vector<int>&
           vertex_cluster_id_vec,  // map current vertex_id to cluster_id
       // the remaining arguments are related to clusters
-      Matrix<float>& vertex_weights_c,
+      // (vertex_weights_c and placement_attr_c are flat row-major arrays)
+      std::vector<float>& vertex_weights_c,
       std::vector<int>& community_attr_c,
       std::vector<int>& fixed_attr_c,
-      Matrix<float>& placement_attr_c) const;
+      std::vector<float>& placement_attr_c) const;
 
   // order the vertices based on user-specified parameters
   void OrderVertices(const HGraphPtr& hgraph, std::vector<int>& vertices) const;
@@ -164,10 +179,11 @@ class Coarsener
       std::vector<int>&
           vertex_cluster_id_vec,  // map current vertex_id to cluster_id
       // the remaining arguments are related to clusters
-      Matrix<float>& vertex_weights_c,
+      // (vertex_weights_c and placement_attr_c are flat row-major arrays)
+      std::vector<float>& vertex_weights_c,
       std::vector<int>& community_attr_c,
       std::vector<int>& fixed_attr_c,
-      Matrix<float>& placement_attr_c) const;
+      std::vector<float>& placement_attr_c) const;
 
   // create the contracted hypergraph based on the vertex matching in
   // vertex_cluster_id_vec
@@ -176,10 +192,28 @@ class Coarsener
       const std::vector<int>&
           vertex_cluster_id_vec,  // map current vertex_id to cluster_id
       // the remaining arguments are related to clusters
-      const Matrix<float>& vertex_weights_c,
+      std::vector<float>&& vertex_weights_c,
       const std::vector<int>& community_attr_c,
       const std::vector<int>& fixed_attr_c,
-      const Matrix<float>& placement_attr_c) const;
+      std::vector<float>&& placement_attr_c) const;
+
+  // Detect the parallel (identical) sequences in parallel.
+  // The i-th sequence is stored in
+  // sequences[offsets[i], offsets[i] + lengths[i]), and lengths[i] == 0
+  // means the sequence is ignored. rep[i] is set to the smallest index j
+  // such that the j-th sequence is identical to the i-th sequence
+  // (rep[i] == i for the first occurrence), or -1 if it is ignored.
+  void DetectParallelSequences(const std::vector<int>& sequences,
+                               const std::vector<int>& offsets,
+                               const std::vector<int>& lengths,
+                               std::vector<int>& rep) const;
+
+  // Split [0, num_items) into contiguous ranges and run func(first, last)
+  // on each range in parallel
+  void ParallelForRange(int num_items,
+                        const std::function<void(int, int)>& func) const;
+
+  void ParallelFor(int num_tasks, const std::function<void(int)>& func) const;
 
   const int num_parts_ = 2;
   // coarsening related parameters (stop conditions)
@@ -212,6 +246,7 @@ class Coarsener
   int random_seed_ = 0;
   CoarsenOrder vertex_order_choice_ = CoarsenOrder::RANDOM;
   EvaluatorPtr evaluator_ = nullptr;
+  ThreadPoolPtr thread_pool_ = nullptr;
   utl::Logger* logger_ = nullptr;
 };
 
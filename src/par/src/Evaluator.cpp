@@ -38,6 +38,7 @@
 #include <functional>
 #include <numeric>
 
+#include "BinaryHypergraph.h"
 #include "Hypergraph.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
@@ -97,8 +98,7 @@ Matrix<float> GoldenEvaluator::GetBlockBalance(const HGraphPtr& hgraph,
       num_parts_, std::vector<float>(hgraph->GetVertexDimensions(), 0.0));
   // update the block_balance
   for (int v = 0; v < hgraph->GetNumVertices(); v++) {
-    block_balance[solution[v]]
-        = block_balance[solution[v]] + hgraph->GetVertexWeights(v);
+    Accumulate(block_balance[solution[v]], hgraph->GetVertexWeights(v));
   }
   return block_balance;
 }
@@ -179,10 +179,13 @@ std::vector<float> GoldenEvaluator::GetPathsCost(
         PAR, 113, "This no timing-critical paths when calling GetPathsCost()");
     return paths_cost;
   }
-  // check each timing path
-  for (auto path_id = 0; path_id < hgraph->GetNumTimingPaths(); path_id++) {
-    paths_cost.push_back(CalculatePathCost(path_id, hgraph, solution));
-  }
+  // check each timing path (the paths are independent of each other)
+  paths_cost.resize(hgraph->GetNumTimingPaths());
+  ParallelForRange(hgraph->GetNumTimingPaths(), [&](int first, int last) {
+    for (int path_id = first; path_id < last; path_id++) {
+      paths_cost[path_id] = CalculatePathCost(path_id, hgraph, solution);
+    }
+  });
   return paths_cost;
 }
 
@@ -374,10 +377,9 @@ float GoldenEvaluator::CalculateHyperedgeVertexWtSum(
 // This is usually used to sort the vertices
 float GoldenEvaluator::GetVertexWeightNorm(int v, const HGraphPtr& hgraph) const
 {
-  return std::inner_product(hgraph->GetVertexWeights(v).begin(),
-                            hgraph->GetVertexWeights(v).end(),
-                            v_wt_factors_.begin(),
-                            0.0f);
+  const Span<const float> vertex_weight = hgraph->GetVertexWeights(v);
+  return std::inner_product(
+      vertex_weight.begin(), vertex_weight.end(), v_wt_factors_.begin(), 0.0f);
 }
 
 // calculate the placement score between vertex v and u
@@ -385,8 +387,8 @@ float GoldenEvaluator::GetPlacementScore(int v,
                                          int u,
                                          const HGraphPtr& hgraph) const
 {
-  const float dist = norm2(hgraph->GetPlacement(v) - hgraph->GetPlacement(u),
-                           placement_wt_factors_);
+  const float dist = WeightedDistance(
+      hgraph->GetPlacement(v), hgraph->GetPlacement(u), placement_wt_factors_);
   if (dist == 0.0) {
     return std::numeric_limits<float>::max() / 2.0;
   }
@@ -401,16 +403,21 @@ GoldenEvaluator::GetAvgPlacementLoc(int v, int u, const HGraphPtr& hgraph) const
   const float u_weight = GetVertexWeightNorm(u, hgraph);
   const float weight_sum = v_weight + u_weight;
 
-  return MultiplyFactor(hgraph->GetPlacement(v), v_weight / weight_sum)
-         + MultiplyFactor(hgraph->GetPlacement(u), u_weight / weight_sum);
+  std::vector<float> avg_loc(hgraph->GetPlacementDimensions());
+  WeightedSum(hgraph->GetPlacement(v),
+              v_weight / weight_sum,
+              hgraph->GetPlacement(u),
+              u_weight / weight_sum,
+              avg_loc);
+  return avg_loc;
 }
 
 // calculate the average placement location
-std::vector<float> GoldenEvaluator::GetAvgPlacementLoc(
-    const std::vector<float>& vertex_weight_a,
-    const std::vector<float>& vertex_weight_b,
-    const std::vector<float>& placement_loc_a,
-    const std::vector<float>& placement_loc_b) const
+void GoldenEvaluator::GetAvgPlacementLoc(Span<const float> vertex_weight_a,
+                                         Span<const float> vertex_weight_b,
+                                         Span<const float> placement_loc_a,
+                                         Span<const float> placement_loc_b,
+                                         Span<float> result) const
 {
   const float a_weight = std::inner_product(vertex_weight_a.begin(),
                                             vertex_weight_a.end(),
@@ -423,8 +430,11 @@ std::vector<float> GoldenEvaluator::GetAvgPlacementLoc(
                                             0.0f);
 
   const float weight_sum = a_weight + b_weight;
-  return MultiplyFactor(placement_loc_a, a_weight / weight_sum)
-         + MultiplyFactor(placement_loc_b, b_weight / weight_sum);
+  WeightedSum(placement_loc_a,
+              a_weight / weight_sum,
+              placement_loc_b,
+              b_weight / weight_sum,
+              result);
 }
 
 // get vertex weight summation
@@ -432,9 +442,9 @@ std::vector<float> GoldenEvaluator::GetVertexWeightSum(
     const HGraphPtr& hgraph,
     const std::vector<int>& group) const
 {
-  std::vector<float> group_weight(hgraph->GetPlacementDimensions(), 0.0f);
+  std::vector<float> group_weight(hgraph->GetVertexDimensions(), 0.0f);
   for (const auto& v : group) {
-    group_weight = group_weight + hgraph->GetVertexWeights(v);
+    Accumulate(group_weight, hgraph->GetVertexWeights(v));
   }
   return group_weight;
 }
@@ -476,21 +486,22 @@ std::vector<float> GoldenEvaluator::GetGroupPlacementLoc(
     const HGraphPtr& hgraph,
     const std::vector<int>& group) const
 {
-  std::vector<float> group_weight(hgraph->GetPlacementDimensions(), 0.0f);
+  std::vector<float> group_weight(hgraph->GetVertexDimensions(), 0.0f);
   std::vector<float> group_loc(hgraph->GetPlacementDimensions(), 0.0f);
   if (!hgraph->HasPlacement()) {
-    return group_weight;
+    return group_loc;
   }
 
   for (const auto& v : group) {
-    group_loc = GetAvgPlacementLoc(group_weight,
-                                   hgraph->GetVertexWeights(v),
-                                   group_loc,
-                                   hgraph->GetPlacement(v));
-    group_weight = group_weight + hgraph->GetVertexWeights(v);
+    GetAvgPlacementLoc(group_weight,
+                       hgraph->GetVertexWeights(v),
+                       group_loc,
+                       hgraph->GetPlacement(v),
+                       group_loc);
+    Accumulate(group_weight, hgraph->GetVertexWeights(v));
   }
 
-  return group_weight;
+  return group_loc;
 }
 
 // calculate the hyperedges being cut
@@ -674,22 +685,25 @@ void GoldenEvaluator::InitializeTiming(const HGraphPtr& hgraph) const
 
   // Step 1: calculate the path_timing_cost_
   hgraph->ResetPathTimingCost();
-  for (int path_id = 0; path_id < hgraph->GetNumTimingPaths(); path_id++) {
-    hgraph->SetPathTimingCost(path_id, GetPathTimingScore(path_id, hgraph));
-  }
+  ParallelForRange(hgraph->GetNumTimingPaths(), [&](int first, int last) {
+    for (int path_id = first; path_id < last; path_id++) {
+      hgraph->SetPathTimingCost(path_id, GetPathTimingScore(path_id, hgraph));
+    }
+  });
 
   // Step 2: calculate the hyperedge timing cost
   {
-    std::vector<float> costs;
-    costs.reserve(hgraph->GetNumHyperedges());
-    for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
-      costs.push_back(CalculateHyperedgeTimingCost(e, hgraph));
-    }
+    std::vector<float> costs(hgraph->GetNumHyperedges());
+    ParallelForRange(hgraph->GetNumHyperedges(), [&](int first, int last) {
+      for (int e = first; e < last; e++) {
+        costs[e] = CalculateHyperedgeTimingCost(e, hgraph);
+      }
+    });
     hgraph->SetHyperedgeTimingCost(std::move(costs));
   }
 
   // Step 3: traverse all the paths and lay the path weight on corresponding
-  // hyperedges
+  // hyperedges (serially, to keep the order of the float additions)
   for (int path_id = 0; path_id < hgraph->GetNumTimingPaths(); path_id++) {
     for (const int e : hgraph->PathEdges(path_id)) {
       hgraph->AddHyperedgeTimingCost(e, hgraph->PathTimingCost(path_id));
@@ -818,23 +832,70 @@ void GoldenEvaluator::UpdateTiming(const HGraphPtr& hgraph,
   // Step 2: update the path_timing_attr_.
   // the slack of a path is the worst slack of all its hyperedges
   hgraph->ResetPathTimingSlack();
-  for (int path_id = 0; path_id < hgraph->GetNumTimingPaths(); path_id++) {
-    float slack = std::numeric_limits<float>::max();
-    for (const int e : hgraph->PathEdges(path_id)) {
-      slack = std::min(slack, hgraph->GetHyperedgeTimingAttr(e));
+  ParallelForRange(hgraph->GetNumTimingPaths(), [&](int first, int last) {
+    for (int path_id = first; path_id < last; path_id++) {
+      float slack = std::numeric_limits<float>::max();
+      for (const int e : hgraph->PathEdges(path_id)) {
+        slack = std::min(slack, hgraph->GetHyperedgeTimingAttr(e));
+      }
+      hgraph->SetPathTimingSlack(path_id, slack);
     }
-    hgraph->SetPathTimingSlack(path_id, slack);
-  }
+  });
 
   // update the corresponding path and hyperedge timing weight
   InitializeTiming(hgraph);
 }
 
 // Write the weighted hypergraph in hMETIS format
+// (or in the binary format if the file name ends with ".bhgr")
 void GoldenEvaluator::WriteWeightedHypergraph(const HGraphPtr& hgraph,
                                               const std::string& file_name,
                                               bool with_weight_flag) const
 {
+  if (IsBinaryHypergraphFileName(file_name)) {
+    BinaryHypergraph binary_hgraph;
+    binary_hgraph.num_vertices = hgraph->GetNumVertices();
+    binary_hgraph.num_hyperedges = hgraph->GetNumHyperedges();
+    binary_hgraph.eptr.reserve(binary_hgraph.num_hyperedges + 1);
+    binary_hgraph.eptr.push_back(0);
+    for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+      for (const int vertex : hgraph->Vertices(e)) {
+        binary_hgraph.eind.push_back(vertex);
+      }
+      binary_hgraph.eptr.push_back(binary_hgraph.eind.size());
+    }
+    if (with_weight_flag == true) {
+      binary_hgraph.hyperedge_dimensions = 1;
+      binary_hgraph.hyperedge_weights.reserve(hgraph->GetNumHyperedges());
+      for (int e = 0; e < hgraph->GetNumHyperedges(); e++) {
+        binary_hgraph.hyperedge_weights.push_back(
+            CalculateHyperedgeCost(e, hgraph));
+      }
+      binary_hgraph.vertex_dimensions = 1;
+      binary_hgraph.vertex_weights.reserve(hgraph->GetNumVertices());
+      for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+        binary_hgraph.vertex_weights.push_back(GetVertexWeightNorm(v, hgraph));
+      }
+    }
+    // the attributes of vertices are kept in the binary format
+    if (hgraph->HasFixedVertices()) {
+      for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+        binary_hgraph.fixed_attr.push_back(hgraph->GetFixedAttr(v));
+      }
+    }
+    if (hgraph->HasCommunity()) {
+      for (int v = 0; v < hgraph->GetNumVertices(); v++) {
+        binary_hgraph.community_attr.push_back(hgraph->GetCommunity(v));
+      }
+    }
+    if (hgraph->HasPlacement()) {
+      binary_hgraph.placement_dimensions = hgraph->GetPlacementDimensions();
+      hgraph->CopyPlacement(binary_hgraph.placement_attr);
+    }
+    WriteBinaryHypergraph(file_name, binary_hgraph, logger_);
+    return;
+  }
+
   std::ofstream file_output;
   file_output.open(file_name);
   if (with_weight_flag == true) {
@@ -889,4 +950,23 @@ void GoldenEvaluator::WriteIntWeightHypergraph(
   file_output.close();
 }
 
+// Run func(first, last) on the chunks of [0, num_items) on the worker pool.
+// The chunk size does not depend on the number of threads.
+void GoldenEvaluator::ParallelForRange(
+    const int num_items,
+    const std::function<void(int, int)>& func) const
+{
+  const int chunk_size = 256;
+  if (thread_pool_ == nullptr || num_items <= chunk_size) {
+    func(0, num_items);
+    return;
+  }
+  const int num_chunks = (num_items + chunk_size - 1) / chunk_size;
+  thread_pool_->ParallelFor(num_chunks, [&](const int chunk) {
+    const int first = chunk * chunk_size;
+    const int last = std::min(first + chunk_size, num_items);
+    func(first, last);
+  });
+}
+
 }  // namespace par
@@ -38,6 +38,7 @@
 #include <tuple>
 
 #include "Hypergraph.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
 
@@ -101,6 +102,13 @@ class GoldenEvaluator
   GoldenEvaluator(GoldenEvaluator&) = delete;
   virtual ~GoldenEvaluator() = default;
 
+  // The worker pool used for evaluating the timing paths in parallel.
+  // If no pool is specified, the paths are evaluated serially.
+  void SetThreadPool(ThreadPoolPtr thread_pool)
+  {
+    thread_pool_ = std::move(thread_pool);
+  }
+
   // calculate the vertex distribution of each net
   Matrix<int> GetNetDegrees(const HGraphPtr& hgraph,
                             const Partitions& solution) const;
@@ -168,12 +176,13 @@ class GoldenEvaluator
                                         int u,
                                         const HGraphPtr& hgraph) const;
 
-  // calculate the average placement location
-  std::vector<float> GetAvgPlacementLoc(
-      const std::vector<float>& vertex_weight_a,
-      const std::vector<float>& vertex_weight_b,
-      const std::vector<float>& placement_loc_a,
-      const std::vector<float>& placement_loc_b) const;
+  // calculate the average placement location and write it into result
+  // (result may alias placement_loc_a or placement_loc_b)
+  void GetAvgPlacementLoc(Span<const float> vertex_weight_a,
+                          Span<const float> vertex_weight_b,
+                          Span<const float> placement_loc_a,
+                          Span<const float> placement_loc_b,
+                          Span<float> result) const;
 
   // calculate the hyperedges being cut
   std::vector<int> GetCutHyperedges(const HGraphPtr& hgraph,
@@ -223,6 +232,7 @@ class GoldenEvaluator
   void UpdateTiming(const HGraphPtr& hgraph, const Partitions& solution) const;
 
   // Write the weighted hypergraph in hMETIS format
+  // (or in the binary format if the file name ends with ".bhgr")
   void WriteWeightedHypergraph(const HGraphPtr& hgraph,
                                const std::string& file_name,
                                bool with_weight_flag = true) const;
@@ -232,6 +242,12 @@ class GoldenEvaluator
                                 const std::string& file_name) const;
 
  private:
+  // Run func(first, last) on the chunks of [0, num_items) on the worker pool.
+  // Each item is handled by exactly one call, so the results written per
+  // item do not depend on the number of threads.
+  void ParallelForRange(int num_items,
+                        const std::function<void(int, int)>& func) const;
+
   // user specified parameters
   const int num_parts_ = 2;            // number of blocks in the partitioning
   const float extra_cut_delay_ = 1.0;  // the extra delay introduced by a cut
@@ -272,6 +288,7 @@ class GoldenEvaluator
   const float timing_exp_factor_ = 2.0;  // exponential factor
 
   HGraphPtr timing_graph_ = nullptr;
+  ThreadPoolPtr thread_pool_ = nullptr;
   utl::Logger* logger_ = nullptr;
 };
 
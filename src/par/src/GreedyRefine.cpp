@@ -34,6 +34,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "GreedyRefine.h"
 
+#include <algorithm>
+
 // ------------------------------------------------------------------------------
 // K-way hyperedge greedy refinement
 // ------------------------------------------------------------------------------
@@ -68,6 +70,15 @@ float GreedyRefine::Pass(
     if (block_set.size() <= 1) {
       continue;
     }
+    // ignore the hyperedge if any of its vertices cannot be moved
+    if (!active_vertices_.empty()) {
+      const auto vertices = hgraph->Vertices(hyperedge_id);
+      if (std::any_of(vertices.begin(), vertices.end(), [&](const int v) {
+            return !active_vertices_[v];
+          })) {
+        continue;
+      }
+    }
     // updated the iteration
     num_move++;
     if (num_move >= max_move_) {
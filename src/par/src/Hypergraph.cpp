@@ -35,7 +35,9 @@
 
 #include "Hypergraph.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <string>
 
 #include "Utilities.h"
@@ -43,6 +45,51 @@
 
 namespace par {
 
+using utl::PAR;
+
+namespace {
+
+// flatten a row-major Matrix into a single contiguous array
+std::vector<float> Flatten(const Matrix<float>& matrix)
+{
+  std::vector<float> flat;
+  if (!matrix.empty()) {
+    flat.reserve(matrix.size() * matrix.front().size());
+  }
+  for (const auto& row : matrix) {
+    flat.insert(flat.end(), row.begin(), row.end());
+  }
+  return flat;
+}
+
+// the CSR representation of hyperedges
+std::vector<int> HyperedgePtr(const Matrix<int>& hyperedges)
+{
+  std::vector<int> eptr;
+  eptr.reserve(hyperedges.size() + 1);
+  eptr.push_back(0);
+  for (const auto& hyperedge : hyperedges) {
+    eptr.push_back(eptr.back() + static_cast<int>(hyperedge.size()));
+  }
+  return eptr;
+}
+
+std::vector<int> HyperedgeIndices(const Matrix<int>& hyperedges)
+{
+  size_t num_pins = 0;
+  for (const auto& hyperedge : hyperedges) {
+    num_pins += hyperedge.size();
+  }
+  std::vector<int> eind;
+  eind.reserve(num_pins);
+  for (const auto& hyperedge : hyperedges) {
+    eind.insert(eind.end(), hyperedge.begin(), hyperedge.end());
+  }
+  return eind;
+}
+
+}  // namespace
+
 Hypergraph::Hypergraph(
     const int vertex_dimensions,
     const int hyperedge_dimensions,
@@ -57,35 +104,116 @@ Hypergraph::Hypergraph(
     // placement information
     const std::vector<std::vector<float>>& placement_attr,
     utl::Logger* logger)
-    : num_vertices_(static_cast<int>(vertex_weights.size())),
-      num_hyperedges_(static_cast<int>(hyperedge_weights.size())),
+    : Hypergraph(vertex_dimensions,
+                 hyperedge_dimensions,
+                 placement_dimensions,
+                 hyperedges,
+                 Flatten(vertex_weights),
+                 Flatten(hyperedge_weights),
+                 fixed_attr,
+                 community_attr,
+                 Flatten(placement_attr),
+                 logger)
+{
+}
+
+Hypergraph::Hypergraph(
+    const int vertex_dimensions,
+    const int hyperedge_dimensions,
+    const int placement_dimensions,
+    const std::vector<std::vector<int>>& hyperedges,
+    const std::vector<std::vector<float>>& vertex_weights,
+    const std::vector<std::vector<float>>& hyperedge_weights,
+    // fixed vertices
+    const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+    // community attribute
+    const std::vector<int>& community_attr,
+    // placement information
+    const std::vector<std::vector<float>>& placement_attr,
+    // the type of each vertex
+    const std::vector<VertexType>&
+        vertex_types,  // except the original timing graph,
+                       // users do not need to specify this
+    // slack information
+    const std::vector<float>& hyperedges_slack,
+    const std::vector<std::set<int>>& hyperedges_arc_set,
+    const std::vector<TimingPath>& timing_paths,
+    utl::Logger* logger)
+    : Hypergraph(vertex_dimensions,
+                 hyperedge_dimensions,
+                 placement_dimensions,
+                 hyperedges,
+                 Flatten(vertex_weights),
+                 Flatten(hyperedge_weights),
+                 fixed_attr,
+                 community_attr,
+                 Flatten(placement_attr),
+                 vertex_types,
+                 hyperedges_slack,
+                 hyperedges_arc_set,
+                 timing_paths,
+                 logger)
+{
+}
+
+Hypergraph::Hypergraph(
+    const int vertex_dimensions,
+    const int hyperedge_dimensions,
+    const int placement_dimensions,
+    const std::vector<std::vector<int>>& hyperedges,
+    std::vector<float>&& vertex_weights,
+    std::vector<float>&& hyperedge_weights,
+    // fixed vertices
+    const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+    // community attribute
+    const std::vector<int>& community_attr,
+    // placement information
+    std::vector<float>&& placement_attr,
+    utl::Logger* logger)
+    : Hypergraph(vertex_dimensions,
+                 hyperedge_dimensions,
+                 placement_dimensions,
+                 HyperedgePtr(hyperedges),
+                 HyperedgeIndices(hyperedges),
+                 std::move(vertex_weights),
+                 std::move(hyperedge_weights),
+                 fixed_attr,
+                 community_attr,
+                 std::move(placement_attr),
+                 logger)
+{
+}
+
+Hypergraph::Hypergraph(
+    const int vertex_dimensions,
+    const int hyperedge_dimensions,
+    const int placement_dimensions,
+    std::vector<int>&& eptr,
+    std::vector<int>&& eind,
+    std::vector<float>&& vertex_weights,
+    std::vector<float>&& hyperedge_weights,
+    // fixed vertices
+    const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+    // community attribute
+    const std::vector<int>& community_attr,
+    // placement information
+    std::vector<float>&& placement_attr,
+    utl::Logger* logger)
+    : num_vertices_(static_cast<int>(vertex_weights.size())
+                    / vertex_dimensions),
+      num_hyperedges_(static_cast<int>(eptr.size()) - 1),
       vertex_dimensions_(vertex_dimensions),
       hyperedge_dimensions_(hyperedge_dimensions),
-      vertex_weights_(vertex_weights),
-      hyperedge_weights_(hyperedge_weights)
+      vertex_weights_(std::move(vertex_weights)),
+      hyperedge_weights_(std::move(hyperedge_weights))
 {
   // add hyperedge
   // hyperedges: each hyperedge is a set of vertices
-  eptr_.push_back(0);
-  for (const auto& hyperedge : hyperedges) {
-    eind_.insert(eind_.end(), hyperedge.begin(), hyperedge.end());
-    eptr_.push_back(static_cast<int>(eind_.size()));
-  }
+  eptr_ = std::move(eptr);
+  eind_ = std::move(eind);
 
   // add vertex
-  // create vertices from hyperedges
-  std::vector<std::vector<int>> vertices(num_vertices_);
-  for (int e = 0; e < num_hyperedges_; e++) {
-    for (auto v : hyperedges[e]) {
-      vertices[v].push_back(e);  // e is the hyperedge id
-    }
-  }
-
-  vptr_.push_back(0);
-  for (const auto& vertex : vertices) {
-    vind_.insert(vind_.end(), vertex.begin(), vertex.end());
-    vptr_.push_back(static_cast<int>(vind_.size()));
-  }
+  BuildVertexIncidence();
 
   // fixed vertices
   fixed_vertex_flag_ = (fixed_attr.size() == num_vertices_);
@@ -100,11 +228,13 @@ Hypergraph::Hypergraph(
   }
 
   // placement information
-  placement_flag_
-      = (placement_dimensions > 0 && placement_attr.size() == num_vertices_);
+  placement_flag_ = (placement_dimensions > 0
+                     && placement_attr.size()
+                            == static_cast<size_t>(num_vertices_)
+                                   * placement_dimensions);
   if (placement_flag_) {
     placement_dimensions_ = placement_dimensions;
-    placement_attr_ = placement_attr;
+    placement_attr_ = std::move(placement_attr);
   } else {
     placement_dimensions_ = 0;
   }
@@ -117,18 +247,16 @@ Hypergraph::Hypergraph(
     const int hyperedge_dimensions,
     const int placement_dimensions,
     const std::vector<std::vector<int>>& hyperedges,
-    const std::vector<std::vector<float>>& vertex_weights,
-    const std::vector<std::vector<float>>& hyperedge_weights,
+    std::vector<float>&& vertex_weights,
+    std::vector<float>&& hyperedge_weights,
     // fixed vertices
     const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
     // community attribute
     const std::vector<int>& community_attr,
     // placement information
-    const std::vector<std::vector<float>>& placement_attr,
+    std::vector<float>&& placement_attr,
     // the type of each vertex
-    const std::vector<VertexType>&
-        vertex_types,  // except the original timing graph,
-                       // users do not need to specify this
+    const std::vector<VertexType>& vertex_types,
     // slack information
     const std::vector<float>& hyperedges_slack,
     const std::vector<std::set<int>>& hyperedges_arc_set,
@@ -138,11 +266,11 @@ Hypergraph::Hypergraph(
                  hyperedge_dimensions,
                  placement_dimensions,
                  hyperedges,
-                 vertex_weights,
-                 hyperedge_weights,
+                 std::move(vertex_weights),
+                 std::move(hyperedge_weights),
                  fixed_attr,
                  community_attr,
-                 placement_attr,
+                 std::move(placement_attr),
                  logger)
 {
   // add vertex types
@@ -185,8 +313,8 @@ Hypergraph::Hypergraph(
 std::vector<float> Hypergraph::GetTotalVertexWeights() const
 {
   std::vector<float> total_weight(vertex_dimensions_, 0.0);
-  for (auto& weight : vertex_weights_) {
-    total_weight = total_weight + weight;
+  for (int v = 0; v < num_vertices_; v++) {
+    Accumulate(total_weight, GetVertexWeights(v));
   }
   return total_weight;
 }
@@ -203,8 +331,7 @@ std::vector<std::vector<float>> Hypergraph::GetUpperVertexBalance(
   std::vector<std::vector<float>> upper_block_balance(num_parts,
                                                       vertex_balance);
   for (int i = 0; i < num_parts; i++) {
-    upper_block_balance[i]
-        = MultiplyFactor(upper_block_balance[i], base_balance[i]);
+    MultiplyFactor(upper_block_balance[i], base_balance[i]);
   }
   return upper_block_balance;
 }
@@ -224,12 +351,132 @@ std::vector<std::vector<float>> Hypergraph::GetLowerVertexBalance(
   std::vector<std::vector<float>> lower_block_balance(num_parts,
                                                       vertex_balance);
   for (int i = 0; i < num_parts; i++) {
-    lower_block_balance[i]
-        = MultiplyFactor(lower_block_balance[i], base_balance[i]);
+    MultiplyFactor(lower_block_balance[i], base_balance[i]);
   }
   return lower_block_balance;
 }
 
+int Hypergraph::AddVertex(Span<const float> weights,
+                          VertexType vertex_type,
+                          Span<const float> placement)
+{
+  const int vertex_id = num_vertices_++;
+  vertex_weights_.insert(vertex_weights_.end(), weights.begin(), weights.end());
+  vertex_weights_.resize(
+      static_cast<size_t>(num_vertices_) * vertex_dimensions_, 0.0);
+  // the new vertex is not connected to any hyperedge
+  vptr_.push_back(vptr_.back());
+  if (!vertex_types_.empty()) {
+    vertex_types_.push_back(vertex_type);
+  }
+  if (fixed_vertex_flag_) {
+    fixed_attr_.push_back(-1);
+  }
+  if (community_flag_) {
+    community_attr_.push_back(-1);
+  }
+  if (placement_flag_) {
+    placement_attr_.insert(
+        placement_attr_.end(), placement.begin(), placement.end());
+    placement_attr_.resize(
+        static_cast<size_t>(num_vertices_) * placement_dimensions_, 0.0);
+  }
+  if (timing_flag_) {
+    pptr_v_.push_back(pptr_v_.back());
+  }
+  if (!vertex_c_attr_.empty()) {
+    vertex_c_attr_.push_back(std::vector<int>{vertex_id});
+  }
+  return vertex_id;
+}
+
+void Hypergraph::SetVertexWeights(const int vertex_id,
+                                  Span<const float> weights)
+{
+  std::copy(weights.begin(),
+            weights.end(),
+            vertex_weights_.begin() + vertex_id * vertex_dimensions_);
+}
+
+void Hypergraph::UpdateHyperedges(
+    const std::map<int, std::vector<int>>& hyperedges,
+    const std::map<int, float>& hyperedge_slacks)
+{
+  if (hyperedges.empty()) {
+    return;
+  }
+  const int num_hyperedges = std::max(num_hyperedges_,
+                                      hyperedges.rbegin()->first + 1);
+  if (num_hyperedges - num_hyperedges_
+      != std::distance(hyperedges.lower_bound(num_hyperedges_),
+                       hyperedges.end())) {
+    logger_->error(PAR,
+                   2523,
+                   "The new hyperedges should be numbered from {}",
+                   num_hyperedges_);
+  }
+  // Rebuild the hyperedge CSR in a single pass:
+  // the unchanged hyperedges are copied in bulk
+  std::vector<int> eptr;
+  std::vector<int> eind;
+  eptr.reserve(num_hyperedges + 1);
+  eind.reserve(eind_.size());
+  eptr.push_back(0);
+  auto update_iter = hyperedges.begin();
+  for (int e = 0; e < num_hyperedges; e++) {
+    if (update_iter != hyperedges.end() && update_iter->first == e) {
+      const std::vector<int>& vertices = update_iter->second;
+      eind.insert(eind.end(), vertices.begin(), vertices.end());
+      ++update_iter;
+    } else {
+      eind.insert(
+          eind.end(), eind_.begin() + eptr_[e], eind_.begin() + eptr_[e + 1]);
+    }
+    eptr.push_back(static_cast<int>(eind.size()));
+  }
+  eptr_ = std::move(eptr);
+  eind_ = std::move(eind);
+
+  // append the new hyperedges
+  hyperedge_weights_.resize(
+      static_cast<size_t>(num_hyperedges) * hyperedge_dimensions_, 1.0);
+  if (timing_flag_) {
+    for (int e = num_hyperedges_; e < num_hyperedges; e++) {
+      hyperedge_arc_set_.push_back(std::set<int>{e});
+    }
+    hyperedge_timing_attr_.resize(num_hyperedges, 1.0);
+    if (!hyperedge_timing_cost_.empty()) {
+      hyperedge_timing_cost_.resize(num_hyperedges, 0.0);
+    }
+    for (const auto& [e, slack] : hyperedge_slacks) {
+      hyperedge_timing_attr_[e] = slack;
+    }
+  }
+  num_hyperedges_ = num_hyperedges;
+
+  BuildVertexIncidence();
+}
+
+void Hypergraph::BuildVertexIncidence()
+{
+  // create vertices from hyperedges (counting sort over the pins)
+  vptr_.clear();
+  vptr_.resize(num_vertices_ + 1, 0);
+  for (const int v : eind_) {
+    vptr_[v + 1]++;
+  }
+  for (int v = 0; v < num_vertices_; v++) {
+    vptr_[v + 1] += vptr_[v];
+  }
+  vind_.resize(eind_.size());
+  std::vector<int> vertex_fill(vptr_.begin(), vptr_.end() - 1);
+  for (int e = 0; e < num_hyperedges_; e++) {
+    for (int idx = eptr_[e]; idx < eptr_[e + 1]; idx++) {
+      vind_[vertex_fill[eind_[idx]]++] = e;  // e is the hyperedge id
+    }
+  }
+}
+
 void Hypergraph::ResetVertexCAttr()
 {
   vertex_c_attr_.clear();
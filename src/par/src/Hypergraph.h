@@ -45,6 +45,7 @@
 #pragma once
 #include <boost/range/iterator_range.hpp>
 #include <functional>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -125,6 +126,64 @@ class Hypergraph
       const std::vector<TimingPath>& timing_paths,
       utl::Logger* logger);
 
+  // The constructors with flat (row-major) weights and placement:
+  // the weights of vertex v are
+  // vertex_weights[v * vertex_dimensions, (v + 1) * vertex_dimensions).
+  // The arrays are moved into the hypergraph without any copy.
+  Hypergraph(
+      int vertex_dimensions,
+      int hyperedge_dimensions,
+      int placement_dimensions,
+      const std::vector<std::vector<int>>& hyperedges,
+      std::vector<float>&& vertex_weights,
+      std::vector<float>&& hyperedge_weights,
+      // fixed vertices
+      const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+      // community attribute
+      const std::vector<int>& community_attr,
+      // placement information
+      std::vector<float>&& placement_attr,
+      utl::Logger* logger);
+
+  // The constructor with the CSR representation of hyperedges:
+  // the vertices of hyperedge e are eind[eptr[e], eptr[e + 1]).
+  Hypergraph(
+      int vertex_dimensions,
+      int hyperedge_dimensions,
+      int placement_dimensions,
+      std::vector<int>&& eptr,
+      std::vector<int>&& eind,
+      std::vector<float>&& vertex_weights,
+      std::vector<float>&& hyperedge_weights,
+      // fixed vertices
+      const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+      // community attribute
+      const std::vector<int>& community_attr,
+      // placement information
+      std::vector<float>&& placement_attr,
+      utl::Logger* logger);
+
+  Hypergraph(
+      int vertex_dimensions,
+      int hyperedge_dimensions,
+      int placement_dimensions,
+      const std::vector<std::vector<int>>& hyperedges,
+      std::vector<float>&& vertex_weights,
+      std::vector<float>&& hyperedge_weights,
+      // fixed vertices
+      const std::vector<int>& fixed_attr,  // the block id of fixed vertices.
+      // community attribute
+      const std::vector<int>& community_attr,
+      // placement information
+      std::vector<float>&& placement_attr,
+      // the type of each vertex
+      const std::vector<VertexType>& vertex_types,
+      // slack information
+      const std::vector<float>& hyperedges_slack,
+      const std::vector<std::set<int>>& hyperedges_arc_set,
+      const std::vector<TimingPath>& timing_paths,
+      utl::Logger* logger);
+
   int GetNumVertices() const { return num_vertices_; }
   int GetNumHyperedges() const { return num_hyperedges_; }
   int GetNumTimingPaths() const { return num_timing_paths_; }
@@ -134,15 +193,18 @@ class Hypergraph
 
   std::vector<float> GetTotalVertexWeights() const;
 
-  const std::vector<float>& GetVertexWeights(const int vertex_id) const
+  Span<const float> GetVertexWeights(const int vertex_id) const
   {
-    return vertex_weights_[vertex_id];
+    return {vertex_weights_.data() + vertex_id * vertex_dimensions_,
+            static_cast<size_t>(vertex_dimensions_)};
   }
-  const Matrix<float>& GetVertexWeights() const { return vertex_weights_; }
+  // the flat vertex weights of all the vertices
+  const std::vector<float>& GetVertexWeights() const { return vertex_weights_; }
 
-  const std::vector<float>& GetHyperedgeWeights(const int edge_id) const
+  Span<const float> GetHyperedgeWeights(const int edge_id) const
   {
-    return hyperedge_weights_[edge_id];
+    return {hyperedge_weights_.data() + edge_id * hyperedge_dimensions_,
+            static_cast<size_t>(hyperedge_dimensions_)};
   }
 
   float GetHyperedgeTimingAttr(const int edge_id) const
@@ -231,12 +293,14 @@ class Hypergraph
 
   bool HasTiming() const { return timing_flag_; }
 
-  const std::vector<float>& GetPlacement(const int vertex_id) const
+  Span<const float> GetPlacement(const int vertex_id) const
   {
-    return placement_attr_[vertex_id];
+    return {placement_attr_.data() + vertex_id * placement_dimensions_,
+            static_cast<size_t>(placement_dimensions_)};
   }
 
-  void CopyPlacement(Matrix<float>& attr) const { attr = placement_attr_; }
+  // copy the flat placement attributes of all the vertices
+  void CopyPlacement(std::vector<float>& attr) const { attr = placement_attr_; }
   float PathTimingCost(const int path_id) const
   {
     return path_timing_cost_[path_id];
@@ -316,15 +380,44 @@ class Hypergraph
       float ub_factor,
       std::vector<float> base_balance) const;
 
+  // Functions for patching the hypergraph in place (netlist ECO).
+  // The ids of the existing vertices and hyperedges never change.
+
+  // Append a new vertex and return its id.
+  // The new vertex is not fixed, has no community (-1),
+  // is not connected to any hyperedge and is not on any timing path.
+  int AddVertex(Span<const float> weights,
+                VertexType vertex_type,
+                Span<const float> placement);
+
+  // Update the weights of an existing vertex, e.g., after resizing.
+  // A removed vertex is modeled as a vertex with zero weight
+  // and without any hyperedge.
+  void SetVertexWeights(int vertex_id, Span<const float> weights);
+
+  // Replace the vertices of hyperedges. The key is the hyperedge id.
+  // An empty list disconnects the hyperedge but keeps its id.
+  // The keys GetNumHyperedges(), GetNumHyperedges() + 1, ... append new
+  // hyperedges with unit weights and the slack in hyperedge_slacks
+  // (only used if the hypergraph has timing information).
+  void UpdateHyperedges(const std::map<int, std::vector<int>>& hyperedges,
+                        const std::map<int, float>& hyperedge_slacks);
+
  private:
+  // create vertices from hyperedges (vptr_ and vind_)
+  void BuildVertexIncidence();
+
   // basic hypergraph
-  const int num_vertices_ = 0;
-  const int num_hyperedges_ = 0;
+  int num_vertices_ = 0;
+  int num_hyperedges_ = 0;
   const int vertex_dimensions_ = 1;
   const int hyperedge_dimensions_ = 1;
 
-  const Matrix<float> vertex_weights_;
-  const Matrix<float> hyperedge_weights_;  // weights can be negative
+  // The weights are stored in flat row-major arrays,
+  // i.e., num_vertices_ x vertex_dimensions_ and
+  // num_hyperedges_ x hyperedge_dimensions_
+  std::vector<float> vertex_weights_;
+  std::vector<float> hyperedge_weights_;  // weights can be negative
 
   // slack for hyperedge
   std::vector<float> hyperedge_timing_attr_;
@@ -370,8 +463,8 @@ class Hypergraph
   // If placement_flag = false, placement_attr_ is empty
   bool placement_flag_ = false;
   int placement_dimensions_ = 0;
-  // the embedding for vertices
-  std::vector<std::vector<float>> placement_attr_;
+  // the embedding for vertices (num_vertices_ x placement_dimensions_)
+  std::vector<float> placement_attr_;
 
   // Timing information
   bool timing_flag_ = false;
@@ -79,10 +79,9 @@ float IlpRefine::Pass(
   for (const auto& v : boundary_vertices) {
     vertices_extracted.push_back(v);
     vertices_extracted_map[v] = vertex_id++;
-    vertices_weight_extracted.push_back(hgraph->GetVertexWeights(v));
+    vertices_weight_extracted.push_back(hgraph->GetVertexWeights(v).ToVector());
     const int block_id = solution[v];
-    block_balance[block_id]
-        = block_balance[block_id] - hgraph->GetVertexWeights(v);
+    Subtract(block_balance[block_id], hgraph->GetVertexWeights(v));
   }
   const int part_vertex_id_base = vertex_id;
   // the remaining vertices in each block are modeled as a fixed vertex
@@ -153,7 +152,6 @@ float IlpRefine::Pass(
                                              solution,
                                              cur_paths_cost,
                                              net_degs);
-    moves_trace.push_back(gain_cell);
     // accept the gain
     AcceptVertexGain(gain_cell,
                      hgraph,
@@ -163,6 +161,7 @@ float IlpRefine::Pass(
                      cur_paths_cost,
                      block_balance,
                      net_degs);
+    moves_trace.push_back(std::move(gain_cell));
     if (total_gain >= best_gain) {
       best_gain = total_gain;
       best_vertex_id = vertex_id;
@@ -175,7 +174,7 @@ float IlpRefine::Pass(
        move_iter++) {
     // stop when we encounter the best_vertex_id
     auto& vertex_move = *move_iter;
-    if (vertex_move->GetVertex() == best_vertex_id) {
+    if (vertex_move.GetVertex() == best_vertex_id) {
       break;  // stop here
     }
     RollBackVertexGain(vertex_move,
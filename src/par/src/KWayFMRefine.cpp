@@ -34,7 +34,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "KWayFMRefine.h"
 
-#include <thread>
+#include <numeric>
 
 // Implement the direct k-way FM refinement
 namespace par {
@@ -109,6 +109,9 @@ float KWayFMRefine::Pass(
   }
 
   int best_vertex_id = -1;  // dummy best vertex id
+  // all the gain buckets are updated after each move
+  std::vector<int> all_blocks(num_parts_);
+  std::iota(all_blocks.begin(), all_blocks.end(), 0);
   // main loop of FM pass
   for (int i = 0; i < max_move_; i++) {
     auto candidate = PickMoveKWay(buckets,
@@ -117,12 +120,11 @@ float KWayFMRefine::Pass(
                                   upper_block_balance,
                                   lower_block_balance);
     // check the status of candidate
-    const int vertex = candidate->GetVertex();  // candidate vertex
+    const int vertex = candidate.GetVertex();  // candidate vertex
     if (vertex < 0) {
       break;  // no valid vertex found
     }
     AcceptKWayMove(candidate,
-                   buckets,
                    moves_trace,
                    total_delta_gain,
                    visited_vertices_flag,
@@ -131,26 +133,17 @@ float KWayFMRefine::Pass(
                    net_degs,
                    cur_paths_cost,
                    solution);
-    std::vector<int> neighbors
+    const std::vector<int> neighbors
         = FindNeighbors(hgraph, vertex, visited_vertices_flag);
-    // update the neighbors of v for all gain buckets in parallel
-    std::vector<std::thread> threads;
-    threads.reserve(num_parts_);
-    for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
-      threads.emplace_back(&KWayFMRefine::UpdateSingleGainBucket,
-                           this,
-                           to_pid,
-                           std::ref(buckets),
-                           hgraph,
-                           std::ref(neighbors),
-                           std::ref(net_degs),
-                           std::ref(cur_paths_cost),
-                           std::ref(solution));
-    }
-    for (auto& t : threads) {
-      t.join();  // wait for all threads to finish
-    }
-    threads.clear();
+    // remove v and update the neighbors of v for all gain buckets in parallel
+    UpdateGainBucketsAfterMove(vertex,
+                               all_blocks,
+                               buckets,
+                               hgraph,
+                               neighbors,
+                               net_degs,
+                               cur_paths_cost,
+                               solution);
     if (total_delta_gain >= best_gain) {
       best_gain = total_delta_gain;
       best_vertex_id = vertex;
@@ -163,7 +156,7 @@ float KWayFMRefine::Pass(
        move_iter++) {
     // stop when we encounter the best_vertex_id
     auto& vertex_move = *move_iter;
-    if (vertex_move->GetVertex() == best_vertex_id) {
+    if (vertex_move.GetVertex() == best_vertex_id) {
       break;  // stop here
     }
     RollBackVertexGain(vertex_move,
@@ -196,25 +189,16 @@ void KWayFMRefine::InitializeGainBucketsKWay(
     const std::vector<float>& cur_paths_cost,
     const Partitions& solution) const
 {
-  std::vector<std::thread> threads;  // for parallel updating
-  threads.reserve(num_parts_);
   // parallel initialize the num_parts gain_buckets
-  for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
-    threads.emplace_back(
-        &KWayFMRefine::InitializeSingleGainBucket,
-        this,
-        std::ref(buckets),
-        to_pid,
-        hgraph,
-        std::ref(boundary_vertices),  // we only consider boundary vertices
-        std::ref(net_degs),
-        std::ref(cur_paths_cost),
-        std::ref(solution));
-  }
-  for (auto& t : threads) {
-    t.join();  // wait for all threads to finish
-  }
-  threads.clear();
+  ParallelFor(num_parts_, [&](const int to_pid) {
+    InitializeSingleGainBucket(buckets,
+                               to_pid,
+                               hgraph,
+                               boundary_vertices,  // only boundary vertices
+                               net_degs,
+                               cur_paths_cost,
+                               solution);
+  });
 }
 
 // Initialize the single bucket
@@ -237,7 +221,7 @@ void KWayFMRefine::InitializeSingleGainBucket(
     }
     auto gain_cell = CalculateVertexGain(
         v, from_part, to_pid, hgraph, solution, cur_paths_cost, net_degs);
-    buckets[to_pid]->InsertIntoPQ(gain_cell);
+    buckets[to_pid]->InsertIntoPQ(std::move(gain_cell));
   }
   // if the current bucket is empty, set the bucket to deactive
   if (buckets[to_pid]->GetTotalElements() == 0) {
@@ -246,7 +230,7 @@ void KWayFMRefine::InitializeSingleGainBucket(
 }
 
 // Determine which vertex gain to be picked
-std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
+GainCell KWayFMRefine::PickMoveKWay(
     GainBuckets& buckets,
     const HGraphPtr& hgraph,
     const Matrix<float>& curr_block_balance,
@@ -255,24 +239,24 @@ std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
 {
   // dummy candidate
   int to_pid = -1;
-  auto candidate = std::make_shared<VertexGain>();
+  const GainCell dummy_cell;
+  const GainCell* candidate = &dummy_cell;
 
   // best gain bucket for "corking effect".
   // i.e., if there is no normal candidate available,
   // we will traverse the best_to_pid bucket
   int best_to_pid = -1;  // block id with best_gain
   float best_gain = -std::numeric_limits<float>::max();
-  auto dummy_cell = std::make_shared<VertexGain>();
 
   // checking the first elements in each bucket
   for (int i = 0; i < num_parts_; ++i) {
     if (buckets[i]->GetStatus() == false) {
       continue;  // This bucket is empty
     }
-    auto ele = buckets[i]->GetMax();
-    const int vertex = ele->GetVertex();
-    const float gain = ele->GetGain();
-    const int from_pid = ele->GetSourcePart();
+    const GainCell& ele = buckets[i]->GetMax();
+    const int vertex = ele.GetVertex();
+    const float gain = ele.GetGain();
+    const int from_pid = ele.GetSourcePart();
     if ((gain > candidate->GetGain())
         && CheckVertexMoveLegality(vertex,
                                    i,
@@ -283,7 +267,7 @@ std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
                                    lower_block_balance)
                == true) {
       to_pid = i;
-      candidate = ele;
+      candidate = &ele;
     }
     // record part for solving corking effect
     if (gain > best_gain) {
@@ -293,7 +277,7 @@ std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
   }
   // Case 1:  if there is a candidate available or no vertex to move
   if (to_pid > -1 || best_to_pid == -1) {
-    return candidate;
+    return *candidate;
   }
   // Case 2:  "corking effect", i.e., no candidate
   return buckets.at(best_to_pid)
@@ -302,8 +286,7 @@ std::shared_ptr<VertexGain> KWayFMRefine::PickMoveKWay(
 }
 
 // move one vertex based on the calculated gain_cell
-void KWayFMRefine::AcceptKWayMove(const std::shared_ptr<VertexGain>& gain_cell,
-                                  GainBuckets& gain_buckets,
+void KWayFMRefine::AcceptKWayMove(const GainCell& gain_cell,
                                   std::vector<GainCell>& moves_trace,
                                   float& total_delta_gain,
                                   std::vector<bool>& visited_vertices_flag,
@@ -313,7 +296,6 @@ void KWayFMRefine::AcceptKWayMove(const std::shared_ptr<VertexGain>& gain_cell,
                                   std::vector<float>& cur_paths_cost,
                                   std::vector<int>& solution) const
 {
-  const int vertex_id = gain_cell->GetVertex();
   moves_trace.push_back(gain_cell);
   AcceptVertexGain(gain_cell,
                    hgraph,
@@ -323,19 +305,30 @@ void KWayFMRefine::AcceptKWayMove(const std::shared_ptr<VertexGain>& gain_cell,
                    cur_paths_cost,
                    curr_block_balance,
                    net_degs);
-  // Remove vertex from all buckets where vertex is present
-  std::vector<std::thread> deletion_threads;
-  deletion_threads.reserve(num_parts_);
-  for (int i = 0; i < num_parts_; ++i) {
-    deletion_threads.emplace_back(&par::KWayFMRefine::HeapEleDeletion,
-                                  this,
-                                  vertex_id,
-                                  i,
-                                  std::ref(gain_buckets));
-  }
-  for (auto& th : deletion_threads) {
-    th.join();
-  }
+  // The vertex is removed from all the buckets together with the
+  // update of its neighbors (see UpdateGainBucketsAfterMove)
+}
+
+// After accepting the move of vertex_id, remove vertex_id from the buckets
+// of blocks and update the gains of its neighbors. Each bucket is handled
+// by exactly one task, in the same order as the serial implementation,
+// so the result does not depend on the number of threads.
+void KWayFMRefine::UpdateGainBucketsAfterMove(
+    int vertex_id,
+    const std::vector<int>& blocks,
+    GainBuckets& buckets,
+    const HGraphPtr& hgraph,
+    const std::vector<int>& neighbors,
+    const Matrix<int>& net_degs,
+    const std::vector<float>& cur_paths_cost,
+    const Partitions& solution) const
+{
+  ParallelFor(static_cast<int>(blocks.size()), [&](const int i) {
+    const int part = blocks[i];
+    HeapEleDeletion(vertex_id, part, buckets);
+    UpdateSingleGainBucket(
+        part, buckets, hgraph, neighbors, net_degs, cur_paths_cost, solution);
+  });
 }
 
 // Remove vertex from a heap
@@ -372,9 +365,9 @@ void KWayFMRefine::UpdateSingleGainBucket(
     // check if the vertex exists in current bucket
     if (buckets[part]->CheckIfVertexExists(v) == true) {
       // update the bucket with new gain
-      buckets[part]->ChangePriority(v, gain_cell);
+      buckets[part]->ChangePriority(v, std::move(gain_cell));
     } else {
-      buckets[part]->InsertIntoPQ(gain_cell);
+      buckets[part]->InsertIntoPQ(std::move(gain_cell));
     }
   }
 }
@@ -62,7 +62,7 @@ class KWayFMRefine : public Refiner
       utl::Logger* logger);
 
   // Mark these two functions as public.
-  // Because they will be called by multi-threading
+  // Because they will be called by the worker pool
   // Initialize the single bucket
   void InitializeSingleGainBucket(
       GainBuckets& buckets,
@@ -107,16 +107,14 @@ class KWayFMRefine : public Refiner
                                  const Partitions& solution) const;
 
   // Determine which vertex gain to be picked
-  std::shared_ptr<VertexGain> PickMoveKWay(
-      GainBuckets& buckets,
-      const HGraphPtr& hgraph,
-      const Matrix<float>& curr_block_balance,
-      const Matrix<float>& upper_block_balance,
-      const Matrix<float>& lower_block_balance) const;
+  GainCell PickMoveKWay(GainBuckets& buckets,
+                        const HGraphPtr& hgraph,
+                        const Matrix<float>& curr_block_balance,
+                        const Matrix<float>& upper_block_balance,
+                        const Matrix<float>& lower_block_balance) const;
 
   // move one vertex based on the calculated gain_cell
-  void AcceptKWayMove(const std::shared_ptr<VertexGain>& gain_cell,
-                      GainBuckets& gain_buckets,
+  void AcceptKWayMove(const GainCell& gain_cell,
                       std::vector<GainCell>& moves_trace,
                       float& total_delta_gain,
                       std::vector<bool>& visited_vertices_flag,
@@ -126,6 +124,17 @@ class KWayFMRefine : public Refiner
                       std::vector<float>& cur_paths_cost,
                       std::vector<int>& solution) const;
 
+  // Remove vertex_id from the buckets of blocks and update the gains of its
+  // neighbors in these buckets. One task per bucket on the worker pool.
+  void UpdateGainBucketsAfterMove(int vertex_id,
+                                  const std::vector<int>& blocks,
+                                  GainBuckets& buckets,
+                                  const HGraphPtr& hgraph,
+                                  const std::vector<int>& neighbors,
+                                  const Matrix<int>& net_degs,
+                                  const std::vector<float>& cur_paths_cost,
+                                  const Partitions& solution) const;
+
   // Remove vertex from a heap
   // Remove the vertex id related vertex gain
   void HeapEleDeletion(int vertex_id, int part, GainBuckets& buckets) const;
@@ -34,8 +34,6 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "KWayPMRefine.h"
 
-#include <thread>
-
 // ------------------------------------------------------------------------------
 // K-way pair-wise FM refinement
 // ------------------------------------------------------------------------------
@@ -248,12 +246,11 @@ float KWayPMRefine::PerformPairFM(
                                   upper_block_balance,
                                   lower_block_balance);
     // check the status of candidate
-    const int vertex = candidate->GetVertex();  // candidate vertex
+    const int vertex = candidate.GetVertex();  // candidate vertex
     if (vertex < 0) {
       break;  // no valid vertex found
     }
     AcceptKWayMove(candidate,
-                   buckets,
                    moves_trace,
                    total_delta_gain,
                    visited_vertices_flag,
@@ -265,24 +262,16 @@ float KWayPMRefine::PerformPairFM(
     // find the neighbors of vertex in partition_pair blocks
     const std::vector<int> neighbors = FindNeighbors(
         hgraph, vertex, visited_vertices_flag, solution, partition_pair);
-    // update the neighbors of v for all gain buckets in parallel
-    std::vector<std::thread> threads;
-    threads.reserve(blocks.size());
-    for (auto& to_pid : blocks) {
-      threads.emplace_back(&KWayFMRefine::UpdateSingleGainBucket,
-                           this,
-                           to_pid,
-                           std::ref(buckets),
-                           hgraph,
-                           std::ref(neighbors),
-                           std::ref(net_degs),
-                           std::ref(paths_cost),
-                           std::ref(solution));
-    }
-    for (auto& t : threads) {
-      t.join();  // wait for all threads to finish
-    }
-    threads.clear();
+    // remove v and update the neighbors of v for the gain buckets of
+    // partition_pair in parallel. The other buckets are empty.
+    UpdateGainBucketsAfterMove(vertex,
+                               blocks,
+                               buckets,
+                               hgraph,
+                               neighbors,
+                               net_degs,
+                               paths_cost,
+                               solution);
     if (total_delta_gain >= best_gain) {
       best_gain = total_delta_gain;
       best_vertex_id = vertex;
@@ -294,7 +283,7 @@ float KWayPMRefine::PerformPairFM(
        move_iter++) {
     // stop when we encounter the best_vertex_id
     auto& vertex_move = *move_iter;
-    if (vertex_move->GetVertex() == best_vertex_id) {
+    if (vertex_move.GetVertex() == best_vertex_id) {
       break;  // stop here
     }
     RollBackVertexGain(vertex_move,
@@ -327,27 +316,18 @@ void KWayPMRefine::InitializeGainBucketsPM(
     const Partitions& solution,
     const std::pair<int, int>& partition_pair) const
 {
-  std::vector<int> blocks_id{partition_pair.first, partition_pair.second};
-  std::vector<std::thread> threads;  // for parallel updating
-  threads.reserve(blocks_id.size());
-
-  // parallel initialize the num_parts gain_buckets
-  for (const auto to_pid : blocks_id) {
-    threads.emplace_back(
-        &KWayFMRefine::InitializeSingleGainBucket,
-        this,
-        std::ref(buckets),
-        to_pid,
-        hgraph,
-        std::ref(boundary_vertices),  // we only consider boundary vertices
-        std::ref(net_degs),
-        std::ref(cur_paths_cost),
-        std::ref(solution));
-  }
-  for (auto& t : threads) {
-    t.join();  // wait for all threads to finish
-  }
-  threads.clear();
+  const std::vector<int> blocks_id{partition_pair.first,
+                                   partition_pair.second};
+  // parallel initialize the gain_buckets of partition_pair
+  ParallelFor(static_cast<int>(blocks_id.size()), [&](const int i) {
+    InitializeSingleGainBucket(buckets,
+                               blocks_id[i],
+                               hgraph,
+                               boundary_vertices,  // only boundary vertices
+                               net_degs,
+                               cur_paths_cost,
+                               solution);
+  });
 }
 
 }  // namespace par
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "LabelPropagationRefine.h"
+
+#include <algorithm>
+#include <numeric>
+
+// -----------------------------------------------------------------------------
+// K-way parallel label propagation refinement
+// -----------------------------------------------------------------------------
+
+namespace par {
+
+// Implement the label propagation pass
+// Step 1: every boundary vertex proposes its best move in parallel
+// Step 2: apply the proposals in the order of decreasing gain
+float LabelPropagationRefine::Pass(
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    Matrix<float>& block_balance,        // the current block balance
+    Matrix<int>& net_degs,               // the current net degree
+    std::vector<float>& cur_paths_cost,  // the current path cost
+    Partitions& solution,
+    std::vector<bool>& visited_vertices_flag)
+{
+  // fixed vertices will not be identified as boundary vertices
+  const std::vector<int> boundary_vertices
+      = FindBoundaryVertices(hgraph, net_degs, visited_vertices_flag);
+  if (boundary_vertices.empty() == true) {
+    return 0.0f;  // no vertices are available
+  }
+
+  // Step 1: all the proposals are calculated against the same solution.
+  // Each proposal is written into its own slot.
+  const int num_boundary_vertices = static_cast<int>(boundary_vertices.size());
+  std::vector<GainCell> proposals(num_boundary_vertices);
+  const int num_chunks = (num_boundary_vertices + kChunkSize - 1) / kChunkSize;
+  ParallelFor(num_chunks, [&](const int chunk) {
+    const int begin = chunk * kChunkSize;
+    const int end = std::min(begin + kChunkSize, num_boundary_vertices);
+    for (int i = begin; i < end; i++) {
+      proposals[i] = ProposeMove(boundary_vertices[i],
+                                 hgraph,
+                                 upper_block_balance,
+                                 lower_block_balance,
+                                 block_balance,
+                                 net_degs,
+                                 cur_paths_cost,
+                                 solution);
+    }
+  });
+
+  // Step 2: apply the proposals with larger gain first.
+  // Ties are broken by the vertex id to keep the order deterministic.
+  std::vector<int> order;
+  order.reserve(num_boundary_vertices);
+  for (int i = 0; i < num_boundary_vertices; i++) {
+    if (proposals[i].GetVertex() > -1) {
+      order.push_back(i);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&](const int a, const int b) {
+    if (proposals[a].GetGain() != proposals[b].GetGain()) {
+      return proposals[a].GetGain() > proposals[b].GetGain();
+    }
+    return proposals[a].GetVertex() < proposals[b].GetVertex();
+  });
+
+  float total_gain = 0.0;  // total gain improvement
+  for (const int i : order) {
+    const int vertex = proposals[i].GetVertex();
+    const int from_pid = proposals[i].GetSourcePart();
+    const int to_pid = proposals[i].GetDestinationPart();
+    // the previous moves may have changed the block balance
+    if (CheckVertexMoveLegality(vertex,
+                                to_pid,
+                                from_pid,
+                                hgraph,
+                                block_balance,
+                                upper_block_balance,
+                                lower_block_balance)
+        == false) {
+      continue;
+    }
+    // the previous moves may also have changed the gain and the
+    // path costs of this move, so the gain is recalculated
+    GainCell gain_cell = CalculateVertexGain(
+        vertex, from_pid, to_pid, hgraph, solution, cur_paths_cost, net_degs);
+    if (gain_cell.GetGain() <= 0.0) {
+      continue;
+    }
+    AcceptVertexGain(gain_cell,
+                     hgraph,
+                     total_gain,
+                     visited_vertices_flag,
+                     solution,
+                     cur_paths_cost,
+                     block_balance,
+                     net_degs);
+  }
+  return total_gain;
+}
+
+// Find the best move of vertex v against the current solution
+GainCell LabelPropagationRefine::ProposeMove(
+    const int v,
+    const HGraphPtr& hgraph,
+    const Matrix<float>& upper_block_balance,
+    const Matrix<float>& lower_block_balance,
+    const Matrix<float>& block_balance,
+    const Matrix<int>& net_degs,
+    const std::vector<float>& cur_paths_cost,
+    const Partitions& solution) const
+{
+  const int from_pid = solution[v];
+  // the blocks connected to v through its hyperedges
+  std::vector<bool> connected_blocks(num_parts_, false);
+  for (const int e : hgraph->Edges(v)) {
+    for (int block_id = 0; block_id < num_parts_; block_id++) {
+      if (net_degs[e][block_id] > 0) {
+        connected_blocks[block_id] = true;
+      }
+    }
+  }
+  GainCell best_move;  // dummy cell
+  for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
+    if (to_pid == from_pid || connected_blocks[to_pid] == false
+        || CheckVertexMoveLegality(v,
+                                   to_pid,
+                                   from_pid,
+                                   hgraph,
+                                   block_balance,
+                                   upper_block_balance,
+                                   lower_block_balance)
+               == false) {
+      continue;
+    }
+    GainCell gain_cell = CalculateVertexGain(
+        v, from_pid, to_pid, hgraph, solution, cur_paths_cost, net_degs);
+    if (gain_cell.GetGain() > 0.0
+        && gain_cell.GetGain() > best_move.GetGain()) {
+      best_move = std::move(gain_cell);
+    }
+  }
+  return best_move;
+}
+
+}  // namespace par
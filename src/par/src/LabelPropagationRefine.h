@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Refiner.h"
+
+namespace par {
+
+class LabelPropagationRefine;
+using LabelPropagationRefinerPtr = std::shared_ptr<LabelPropagationRefine>;
+
+// -----------------------------------------------------------------------------
+// K-way parallel label propagation refinement
+// FM and greedy refinement move one vertex (or hyperedge) at a time, which
+// does not scale to the finest levels of very large hypergraphs.  In each
+// pass of label propagation, every boundary vertex proposes its best move
+// against the same snapshot of the solution, in parallel.  The proposals are
+// then applied in the order of decreasing gain: a proposal is dropped if it
+// violates the balance constraint, or if its gain (recalculated after the
+// previous moves of this pass) is not positive any more.
+// The result does not depend on the number of threads.
+// -----------------------------------------------------------------------------
+class LabelPropagationRefine : public Refiner
+{
+ public:
+  using Refiner::Refiner;
+
+ private:
+  // In each pass, all the boundary vertices are moved simultaneously,
+  // so the number of moves is not limited by max_move_.
+  // the return value is the gain improvement
+  float Pass(const HGraphPtr& hgraph,
+             const Matrix<float>& upper_block_balance,
+             const Matrix<float>& lower_block_balance,
+             Matrix<float>& block_balance,        // the current block balance
+             Matrix<int>& net_degs,               // the current net degree
+             std::vector<float>& cur_paths_cost,  // the current path cost
+             Partitions& solution,
+             std::vector<bool>& visited_vertices_flag) override;
+
+  // Find the best move of vertex v against the current solution.
+  // Only the blocks connected to v are considered.
+  // The returned gain cell has vertex -1 if there is no positive move.
+  GainCell ProposeMove(int v,
+                       const HGraphPtr& hgraph,
+                       const Matrix<float>& upper_block_balance,
+                       const Matrix<float>& lower_block_balance,
+                       const Matrix<float>& block_balance,
+                       const Matrix<int>& net_degs,
+                       const std::vector<float>& cur_paths_cost,
+                       const Partitions& solution) const;
+
+  // number of boundary vertices handled by one parallel task
+  static constexpr int kChunkSize = 1024;
+};
+
+}  // namespace par
@@ -35,26 +35,125 @@
 
 #include "Multilevel.h"
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <functional>
 #include <queue>
 #include <random>
-#include <thread>
+#include <sstream>
 
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "Partitioner.h"
+#include "spdlog/sinks/ostream_sink.h"
 #include "utl/Logger.h"
 
 namespace par {
 
 using utl::PAR;
 
+std::string ToString(const PartitionPhase phase)
+{
+  switch (phase) {
+    case PartitionPhase::COARSENING:
+      return std::string("coarsening");
+
+    case PartitionPhase::INITIAL_PARTITIONING:
+      return std::string("initial_partitioning");
+
+    case PartitionPhase::REFINEMENT:
+      return std::string("refinement");
+
+    case PartitionPhase::CUT_OVERLAY_ILP:
+      return std::string("cut_overlay_ilp");
+
+    case PartitionPhase::VCYCLE:
+      return std::string("vcycle");
+
+    default:
+      return std::string("unknown");
+  }
+}
+
+void PhaseTimer::Add(const PartitionPhase phase, const double seconds)
+{
+  nanoseconds_[static_cast<int>(phase)].fetch_add(
+      static_cast<int64_t>(seconds * 1e9), std::memory_order_relaxed);
+}
+
+void PhaseTimer::AddConcurrent(const std::vector<PhaseTimerPtr>& timers,
+                               const int num_workers)
+{
+  if (timers.empty()) {
+    return;
+  }
+  const int num_concurrent
+      = std::max(1, std::min(num_workers, static_cast<int>(timers.size())));
+  for (int phase = 0; phase < kNumPartitionPhases; phase++) {
+    double max_seconds = 0.0;
+    double total_seconds = 0.0;
+    for (const auto& timer : timers) {
+      const double seconds
+          = timer->GetSeconds(static_cast<PartitionPhase>(phase));
+      max_seconds = std::max(max_seconds, seconds);
+      total_seconds += seconds;
+    }
+    Add(static_cast<PartitionPhase>(phase),
+        std::max(max_seconds, total_seconds / num_concurrent));
+  }
+}
+
+double PhaseTimer::GetSeconds(const PartitionPhase phase) const
+{
+  return nanoseconds_[static_cast<int>(phase)].load(std::memory_order_relaxed)
+         * 1e-9;
+}
+
+void PhaseTimer::Reset()
+{
+  for (auto& nanoseconds : nanoseconds_) {
+    nanoseconds.store(0, std::memory_order_relaxed);
+  }
+}
+
+namespace {
+
+// Charge the runtime of the enclosing scope to a phase (if recorded)
+class ScopedPhaseTimer
+{
+ public:
+  ScopedPhaseTimer(const PhaseTimerPtr& timer, const PartitionPhase phase)
+      : timer_(timer.get()),
+        phase_(phase),
+        start_(std::chrono::high_resolution_clock::now())
+  {
+  }
+
+  ~ScopedPhaseTimer()
+  {
+    if (timer_ != nullptr) {
+      const std::chrono::duration<double> elapsed
+          = std::chrono::high_resolution_clock::now() - start_;
+      timer_->Add(phase_, elapsed.count());
+    }
+  }
+
+ private:
+  PhaseTimer* timer_ = nullptr;
+  const PartitionPhase phase_;
+  const std::chrono::high_resolution_clock::time_point start_;
+};
+
+}  // namespace
+
 MultilevelPartitioner::MultilevelPartitioner(
     const int num_parts,
     const bool v_cycle_flag,
     const int num_initial_solutions,
     const int num_best_initial_solutions,
     const int num_vertices_threshold_ilp,
+    const int num_vertices_threshold_lp,
     const int max_num_vcycle,
     const int num_coarsen_solutions,
     const int seed,
@@ -64,10 +163,13 @@ MultilevelPartitioner::MultilevelPartitioner(
     KWayPMRefinerPtr k_way_pm_refiner,
     GreedyRefinerPtr greedy_refiner,
     IlpRefinerPtr ilp_refiner,
+    LabelPropagationRefinerPtr label_propagation_refiner,
     EvaluatorPtr evaluator,
+    ThreadPoolPtr thread_pool,
     utl::Logger* logger)
     : num_parts_(num_parts),
       num_vertices_threshold_ilp_(num_vertices_threshold_ilp),
+      num_vertices_threshold_lp_(num_vertices_threshold_lp),
       num_initial_random_solutions_(num_initial_solutions),
       num_best_initial_solutions_(num_best_initial_solutions),
       max_num_vcycle_(max_num_vcycle),
@@ -81,8 +183,17 @@ MultilevelPartitioner::MultilevelPartitioner(
   k_way_pm_refiner_ = std::move(k_way_pm_refiner);
   greedy_refiner_ = std::move(greedy_refiner);
   ilp_refiner_ = std::move(ilp_refiner);
+  label_propagation_refiner_ = std::move(label_propagation_refiner);
   evaluator_ = std::move(evaluator);
+  thread_pool_ = std::move(thread_pool);
   logger_ = logger;
+  // the coarsener and all the FM-based refiners share the same worker pool
+  coarsener_->SetThreadPool(thread_pool_);
+  k_way_fm_refiner_->SetThreadPool(thread_pool_);
+  k_way_pm_refiner_->SetThreadPool(thread_pool_);
+  if (label_propagation_refiner_ != nullptr) {
+    label_propagation_refiner_->SetThreadPool(thread_pool_);
+  }
 }
 
 // Main function
@@ -102,15 +213,74 @@ std::vector<int> MultilevelPartitioner::Partition(
   // In experiments, we observe that the benefits of increasing number of
   // vcycles is very limited. However, the quality of solutions will change a
   // lot with different random seed
-  Matrix<int> top_solutions;
+  // The candidates are generated concurrently. Each candidate runs on its
+  // own copy of the coarsener, partitioner and refiners, and the seed of the
+  // id-th candidate is the same as the one used by the id-th sequential run,
+  // so the result does not depend on the number of threads. The number of
+  // candidates running at the same time is capped by the size of the worker
+  // pool.
+  // Each candidate reports to its own buffer, and the buffers are reported in
+  // id order once all the candidates are done, so the messages of concurrent
+  // candidates are not interleaved.
+  // The timing cost of hgraph is initialized here (if it has been not),
+  // because the candidates share hgraph.
+  if (hgraph->HasTiming() && hgraph->GetTimingPathCostSize() == 0
+      && !hgraph->HasHyperedgeTimingCost()) {
+    evaluator_->InitializeTiming(hgraph);
+  }
+  const int base_coarsen_seed = coarsener_->GetRandomSeed();
+  std::vector<std::ostringstream> candidate_logs(num_coarsen_solutions_);
+  std::vector<std::unique_ptr<utl::Logger>> candidate_loggers;
+  std::vector<MultiLevelPartitioner> candidate_partitioners;
+  candidate_loggers.reserve(num_coarsen_solutions_);
+  candidate_partitioners.reserve(num_coarsen_solutions_);
+  for (int id = 0; id < num_coarsen_solutions_; id++) {
+    candidate_loggers.push_back(logger_->cloneWithSink(
+        std::make_shared<spdlog::sinks::ostream_sink_mt>(candidate_logs[id])));
+    candidate_partitioners.push_back(CloneForCandidate(
+        base_coarsen_seed + id + 1, candidate_loggers[id].get()));
+  }
+  coarsener_->SetRandomSeed(base_coarsen_seed + num_coarsen_solutions_);
+
+  // an error of a candidate is raised after the messages are reported
+  Matrix<int> top_solutions(num_coarsen_solutions_);
+  std::vector<std::exception_ptr> candidate_errors(num_coarsen_solutions_);
+  thread_pool_->ParallelFor(num_coarsen_solutions_, [&](const int id) {
+    try {
+      top_solutions[id] = candidate_partitioners[id]->SingleLevelPartition(
+          hgraph, upper_block_balance, lower_block_balance);
+    } catch (...) {
+      candidate_errors[id] = std::current_exception();
+    }
+  });
+  for (int id = 0; id < num_coarsen_solutions_; id++) {
+    std::istringstream log(candidate_logs[id].str());
+    std::string line;
+    while (std::getline(log, line)) {
+      logger_->report("{}", line);
+    }
+  }
+  for (const auto& error : candidate_errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+  if (phase_timer_ != nullptr) {
+    std::vector<PhaseTimerPtr> candidate_timers;
+    candidate_timers.reserve(candidate_partitioners.size());
+    for (const auto& candidate : candidate_partitioners) {
+      candidate_timers.push_back(candidate->phase_timer_);
+    }
+    phase_timer_->AddConcurrent(candidate_timers,
+                                thread_pool_->GetNumThreads());
+  }
+  candidate_partitioners.clear();
+
   float best_cost = std::numeric_limits<float>::max();
   int best_solution_id = -1;
   for (int id = 0; id < num_coarsen_solutions_; id++) {
-    coarsener_->IncreaseRandomSeed();
-    top_solutions.push_back(
-        SingleLevelPartition(hgraph, upper_block_balance, lower_block_balance));
     const float cost
-        = evaluator_->CutEvaluator(hgraph, top_solutions.back(), false).cost;
+        = evaluator_->CutEvaluator(hgraph, top_solutions[id], false).cost;
     if (cost <= best_cost) {
       best_cost = cost;
       best_solution_id = id;
@@ -120,11 +290,15 @@ std::vector<int> MultilevelPartitioner::Partition(
   logger_->info(PAR, 151, "Finish Candidate Solutions Generation");
 
   // Step 2: run cut-overlay clustering to enhance the solution
-  std::vector<int> best_solution = CutOverlayILPPart(hgraph,
-                                                     upper_block_balance,
-                                                     lower_block_balance,
-                                                     top_solutions,
-                                                     best_solution_id);
+  std::vector<int> best_solution;
+  {
+    ScopedPhaseTimer timer(phase_timer_, PartitionPhase::CUT_OVERLAY_ILP);
+    best_solution = CutOverlayILPPart(hgraph,
+                                      upper_block_balance,
+                                      lower_block_balance,
+                                      top_solutions,
+                                      best_solution_id);
+  }
 
   logger_->info(
       PAR, 152, "Finish Cut-Overlay Clustering and Optimal Partitioning");
@@ -134,6 +308,7 @@ std::vector<int> MultilevelPartitioner::Partition(
   // The initial value of best solution will be used to guide the coarsening
   // process and use as the initial solution
   if (v_cycle_flag_ == true) {
+    ScopedPhaseTimer timer(phase_timer_, PartitionPhase::VCYCLE);
     VcycleRefinement(
         hgraph, upper_block_balance, lower_block_balance, best_solution);
   }
@@ -145,6 +320,56 @@ std::vector<int> MultilevelPartitioner::Partition(
 
 // Private functions (Utilities)
 
+// Create a copy of this partitioner for generating one candidate solution
+MultiLevelPartitioner MultilevelPartitioner::CloneForCandidate(
+    int coarsen_seed,
+    utl::Logger* logger) const
+{
+  auto coarsener = std::make_shared<Coarsener>(*coarsener_);
+  coarsener->SetRandomSeed(coarsen_seed);
+  coarsener->SetLogger(logger);
+  auto partitioner = std::make_shared<Partitioner>(*partitioner_);
+  partitioner->SetLogger(logger);
+  auto k_way_fm_refiner = std::make_shared<KWayFMRefine>(*k_way_fm_refiner_);
+  k_way_fm_refiner->SetLogger(logger);
+  auto k_way_pm_refiner = std::make_shared<KWayPMRefine>(*k_way_pm_refiner_);
+  k_way_pm_refiner->SetLogger(logger);
+  auto greedy_refiner = std::make_shared<GreedyRefine>(*greedy_refiner_);
+  greedy_refiner->SetLogger(logger);
+  auto ilp_refiner = std::make_shared<IlpRefine>(*ilp_refiner_);
+  ilp_refiner->SetLogger(logger);
+  LabelPropagationRefinerPtr label_propagation_refiner = nullptr;
+  if (label_propagation_refiner_ != nullptr) {
+    label_propagation_refiner = std::make_shared<LabelPropagationRefine>(
+        *label_propagation_refiner_);
+    label_propagation_refiner->SetLogger(logger);
+  }
+  auto candidate = std::make_shared<MultilevelPartitioner>(
+      num_parts_,
+      v_cycle_flag_,
+      num_initial_random_solutions_,
+      num_best_initial_solutions_,
+      num_vertices_threshold_ilp_,
+      num_vertices_threshold_lp_,
+      max_num_vcycle_,
+      num_coarsen_solutions_,
+      seed_,
+      coarsener,
+      partitioner,
+      k_way_fm_refiner,
+      k_way_pm_refiner,
+      greedy_refiner,
+      ilp_refiner,
+      label_propagation_refiner,
+      evaluator_,
+      thread_pool_,
+      logger);
+  if (phase_timer_ != nullptr) {
+    candidate->SetPhaseTimer(std::make_shared<PhaseTimer>());
+  }
+  return candidate;
+}
+
 // Run single-level partitioning
 std::vector<int> MultilevelPartitioner::SingleLevelPartition(
     const HGraphPtr& hgraph,
@@ -157,7 +382,11 @@ std::vector<int> MultilevelPartitioner::SingleLevelPartition(
   // Step 4: cut-overlay clustering and ILP-based partitioning
 
   // Step 1: run coarsening
-  CoarseGraphPtrs hierarchy = coarsener_->LazyFirstChoice(hgraph);
+  CoarseGraphPtrs hierarchy;
+  {
+    ScopedPhaseTimer timer(phase_timer_, PartitionPhase::COARSENING);
+    hierarchy = coarsener_->LazyFirstChoice(hgraph);
+  }
 
   // Step 2: run initial partitioning
   HGraphPtr coarsest_hgraph = hierarchy.back();
@@ -172,24 +401,31 @@ std::vector<int> MultilevelPartitioner::SingleLevelPartition(
     top_solutions.back().reserve(hgraph->GetNumVertices());  // reserve the size
   }
   int best_solution_id = -1;
-  InitialPartition(coarsest_hgraph,
-                   upper_block_balance,
-                   lower_block_balance,
-                   top_solutions,
-                   best_solution_id);
+  {
+    ScopedPhaseTimer timer(phase_timer_, PartitionPhase::INITIAL_PARTITIONING);
+    InitialPartition(coarsest_hgraph,
+                     upper_block_balance,
+                     lower_block_balance,
+                     top_solutions,
+                     best_solution_id);
+  }
 
   // Step 3: run refinement
   // Here we need to do rebugetting on the best solution
-  RefinePartition(hierarchy,
-                  upper_block_balance,
-                  lower_block_balance,
-                  top_solutions,
-                  best_solution_id);
+  {
+    ScopedPhaseTimer timer(phase_timer_, PartitionPhase::REFINEMENT);
+    RefinePartition(hierarchy,
+                    upper_block_balance,
+                    lower_block_balance,
+                    top_solutions,
+                    best_solution_id);
+  }
 
   // Step 4: cut-overlay clustering and ILP-based partitioning
   // Perform cut-overlay clustering and ILP-based partitioning
   // The ILP-based partitioning uses top_solutions[best_solution_id] as a hint,
   // such that the runtime can be signficantly reduced
+  ScopedPhaseTimer timer(phase_timer_, PartitionPhase::CUT_OVERLAY_ILP);
   return CutOverlayILPPart(hgraph,
                            upper_block_balance,
                            lower_block_balance,
@@ -486,20 +722,13 @@ void MultilevelPartitioner::RefinePartition(
     }
 
     // Parallel refine all the solutions
-    std::vector<std::thread> threads;
-    threads.reserve(top_solutions.size());
-    for (auto& top_solution : top_solutions) {
-      threads.emplace_back(&par::MultilevelPartitioner::CallRefiner,
-                           this,
-                           hgraph,
-                           std::ref(upper_block_balance),
-                           std::ref(lower_block_balance),
-                           std::ref(top_solution));
-    }
-    for (auto& th : threads) {
-      th.join();
-    }
-    threads.clear();
+    thread_pool_->ParallelFor(
+        static_cast<int>(top_solutions.size()), [&](const int i) {
+          CallRefiner(hgraph,
+                      upper_block_balance,
+                      lower_block_balance,
+                      top_solutions[i]);
+        });
 
     // update the best_solution_id
     float best_cost = std::numeric_limits<float>::max();
@@ -523,7 +752,7 @@ void MultilevelPartitioner::RefinePartition(
 }
 
 // Refine function
-// k_way_pm_refinement,
+// label propagation (large hypergraphs only), k_way_pm_refinement,
 // k_way_fm_refinement and greedy refinement
 void MultilevelPartitioner::CallRefiner(
     const HGraphPtr& hgraph,
@@ -531,6 +760,13 @@ void MultilevelPartitioner::CallRefiner(
     const Matrix<float>& lower_block_balance,
     std::vector<int>& solution) const
 {
+  // The parallel label propagation removes most of the easy moves,
+  // such that the sequential FM refinements only need to polish the solution
+  if (label_propagation_refiner_ != nullptr && num_vertices_threshold_lp_ > 0
+      && hgraph->GetNumVertices() >= num_vertices_threshold_lp_) {
+    label_propagation_refiner_->Refine(
+        hgraph, upper_block_balance, lower_block_balance, solution);
+  }
   if (num_parts_ > 1) {  // Pair-wise FM only used for multi-way partitioning
     k_way_pm_refiner_->Refine(
         hgraph, upper_block_balance, lower_block_balance, solution);
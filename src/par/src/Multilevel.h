@@ -34,6 +34,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "Coarsener.h"
 #include "Evaluator.h"
 #include "GreedyRefine.h"
@@ -41,12 +47,55 @@
 #include "ILPRefine.h"
 #include "KWayFMRefine.h"
 #include "KWayPMRefine.h"
+#include "LabelPropagationRefine.h"
 #include "Partitioner.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
 
 namespace par {
 
+// The phases of the multi-level partitioner whose runtime can be recorded
+enum class PartitionPhase
+{
+  COARSENING,
+  INITIAL_PARTITIONING,
+  REFINEMENT,
+  CUT_OVERLAY_ILP,
+  VCYCLE
+};
+
+inline constexpr int kNumPartitionPhases = 5;
+
+std::string ToString(PartitionPhase phase);
+
+// PhaseTimer accumulates the runtime of each phase.
+// The candidate solutions are generated concurrently, each candidate with
+// its own timer.  The candidate timers are merged phase by phase with
+// AddConcurrent, which charges the estimated wall time of the concurrent
+// runs instead of their sum.  The phases nested in the cut-overlay
+// clustering and in the v-cycle refinement are charged to CUT_OVERLAY_ILP
+// and VCYCLE.
+class PhaseTimer;
+using PhaseTimerPtr = std::shared_ptr<PhaseTimer>;
+
+class PhaseTimer
+{
+ public:
+  void Add(PartitionPhase phase, double seconds);
+  // Add the runtime of timers that ran concurrently on num_workers workers.
+  // Each phase is charged the critical path of the concurrent runs:
+  // the longest single run, or the total runtime evenly spread over the
+  // workers if that is longer.
+  void AddConcurrent(const std::vector<PhaseTimerPtr>& timers,
+                     int num_workers);
+  double GetSeconds(PartitionPhase phase) const;
+  void Reset();
+
+ private:
+  std::array<std::atomic<int64_t>, kNumPartitionPhases> nanoseconds_{};
+};
+
 // Multilevel partitioner
 class MultilevelPartitioner;
 using MultiLevelPartitioner = std::shared_ptr<MultilevelPartitioner>;
@@ -60,6 +109,7 @@ class MultilevelPartitioner
                         const int num_initial_solutions,
                         const int num_best_initial_solutions,
                         const int num_vertices_threshold_ilp,
+                        const int num_vertices_threshold_lp,
                         const int max_num_vcycle,
                         const int num_coarsen_solutions,
                         const int seed,
@@ -70,7 +120,9 @@ class MultilevelPartitioner
                         KWayPMRefinerPtr k_way_pm_refiner,
                         GreedyRefinerPtr greedy_refiner,
                         IlpRefinerPtr ilp_refiner,
+                        LabelPropagationRefinerPtr label_propagation_refiner,
                         EvaluatorPtr evaluator,
+                        ThreadPoolPtr thread_pool,
                         utl::Logger* logger);
 
   // Main function
@@ -87,7 +139,22 @@ class MultilevelPartitioner
                         const Matrix<float>& lower_block_balance,
                         std::vector<int>& best_solution) const;
 
+  // Record the runtime of each phase in phase_timer (nullptr disables it).
+  // The partitioners of the candidate solutions record into their own
+  // timers, which are merged into phase_timer after the candidates finish.
+  void SetPhaseTimer(PhaseTimerPtr phase_timer)
+  {
+    phase_timer_ = std::move(phase_timer);
+  }
+
  private:
+  // Create a copy of this partitioner which owns its own coarsener,
+  // partitioner and refiners, so that several candidate solutions can be
+  // generated concurrently. The copy reports to logger. The evaluator and
+  // the worker pool are shared with this partitioner.
+  MultiLevelPartitioner CloneForCandidate(int coarsen_seed,
+                                          utl::Logger* logger) const;
+
   // Run single-level partitioning
   std::vector<int> SingleLevelPartition(
       const HGraphPtr& hgraph,
@@ -118,7 +185,7 @@ class MultilevelPartitioner
 
   // For last minute improvement
   // Refine function
-  // Ilp refinement, k_way_pm_refinement,
+  // label propagation (large hypergraphs only), k_way_pm_refinement,
   // k_way_fm_refinement and greedy refinement
   void CallRefiner(const HGraphPtr& hgraph,
                    const Matrix<float>& upper_block_balance,
@@ -138,6 +205,9 @@ class MultilevelPartitioner
   const int num_parts_ = 2;
   const int num_vertices_threshold_ilp_
       = 20;  // number of vertices used for ILP partitioning
+  // number of vertices from which label propagation runs before FM
+  // (0 disables label propagation)
+  const int num_vertices_threshold_lp_ = 0;
 
   // user-specified parameters
   const int num_initial_random_solutions_ = 50;
@@ -155,7 +225,11 @@ class MultilevelPartitioner
   KWayPMRefinerPtr k_way_pm_refiner_ = nullptr;
   GreedyRefinerPtr greedy_refiner_ = nullptr;
   IlpRefinerPtr ilp_refiner_ = nullptr;
+  LabelPropagationRefinerPtr label_propagation_refiner_ = nullptr;
   EvaluatorPtr evaluator_ = nullptr;
+  // the persistent worker pool shared by all the refiners
+  ThreadPoolPtr thread_pool_ = nullptr;
+  PhaseTimerPtr phase_timer_ = nullptr;
   utl::Logger* logger_ = nullptr;
 };
 
@@ -46,6 +46,7 @@
 #include "Utilities.h"
 #include "db_sta/dbSta.hh"
 #include "odb/db.h"
+#include "ord/OpenRoad.hh"
 #include "sta/MakeConcreteNetwork.hh"
 #include "sta/ParseBus.hh"
 #include "sta/PortDirection.hh"
@@ -78,6 +79,10 @@ using utl::PAR;
 
 namespace par {
 
+PartitionMgr::PartitionMgr() = default;
+
+PartitionMgr::~PartitionMgr() = default;
+
 void PartitionMgr::init(odb::dbDatabase* db,
                         sta::dbNetwork* db_network,
                         sta::dbSta* sta,
@@ -87,6 +92,7 @@ void PartitionMgr::init(odb::dbDatabase* db,
   db_network_ = db_network;
   sta_ = sta;
   logger_ = logger;
+  timing_path_cache_ = std::make_shared<TimingPathCache>();
 }
 
 // The function for partitioning a hypergraph
@@ -137,13 +143,13 @@ void PartitionMgr::tritonPartHypergraph(
     int max_num_vcycle,
     int num_coarsen_solutions,
     int num_vertices_threshold_ilp,
+    int num_vertices_threshold_lp,
     int global_net_threshold)
 {
   // Use TritonPart to partition a hypergraph
   // In this mode, TritonPart works as hMETIS.
   // Thus users can use this function to partition the input hypergraph
-  auto triton_part
-      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  auto triton_part = makeTritonPart();
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -169,6 +175,7 @@ void PartitionMgr::tritonPartHypergraph(
       max_num_vcycle,
       num_coarsen_solutions,
       num_vertices_threshold_ilp,
+      num_vertices_threshold_lp,
       global_net_threshold);
 
   triton_part->PartitionHypergraph(num_parts,
@@ -226,13 +233,13 @@ void PartitionMgr::tritonPartRefine(
     int max_num_vcycle,
     int num_coarsen_solutions,
     int num_vertices_threshold_ilp,
+    int num_vertices_threshold_lp,
     int global_net_threshold)
 {
   // Use TritonPart to partition a hypergraph
   // In this mode, TritonPart works as hMETIS.
   // Thus users can use this function to partition the input hypergraph
-  auto triton_part
-      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  auto triton_part = makeTritonPart();
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -258,6 +265,7 @@ void PartitionMgr::tritonPartRefine(
       max_num_vcycle,
       num_coarsen_solutions,
       num_vertices_threshold_ilp,
+      num_vertices_threshold_lp,
       global_net_threshold);
 
   triton_part->RefineHypergraphPartition(num_parts,
@@ -295,8 +303,7 @@ void PartitionMgr::evaluateHypergraphSolution(
     const std::vector<float>& e_wt_factors,
     const std::vector<float>& v_wt_factors)
 {
-  auto triton_part
-      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  auto triton_part = makeTritonPart();
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -371,10 +378,11 @@ void PartitionMgr::tritonPartDesign(
     int max_num_vcycle,
     int num_coarsen_solutions,
     int num_vertices_threshold_ilp,
+    int num_vertices_threshold_lp,
     int global_net_threshold)
 {
-  auto triton_part
-      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  auto triton_part = makeTritonPart();
+  triton_part->SetTimingPathCache(timing_path_cache_);
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -406,6 +414,7 @@ void PartitionMgr::tritonPartDesign(
       max_num_vcycle,
       num_coarsen_solutions,
       num_vertices_threshold_ilp,
+      num_vertices_threshold_lp,
       global_net_threshold);
 
   triton_part->PartitionDesign(num_parts_arg,
@@ -425,6 +434,21 @@ void PartitionMgr::tritonPartDesign(
                                community_file_arg,
                                group_file_arg,
                                solution_filename_arg);
+
+  // keep the partitioner for the incremental re-partitioning
+  design_triton_part_ = std::move(triton_part);
+}
+
+// Incremental re-partitioning for small netlist ECOs
+void PartitionMgr::tritonPartDesignEco(const char* solution_filename_arg)
+{
+  if (design_triton_part_ == nullptr) {
+    logger_->error(
+        PAR, 2525, "Please run triton_part_design before the ECO mode.");
+  }
+  design_triton_part_->SetNumThreads(
+      ord::OpenRoad::openRoad()->getThreadCount());
+  design_triton_part_->PartitionDesignEco(solution_filename_arg);
 }
 
 // Function to evaluate the hypergraph partitioning solution
@@ -464,8 +488,8 @@ void PartitionMgr::evaluatePartDesignSolution(
     const std::vector<float>& e_wt_factors,
     const std::vector<float>& v_wt_factors)
 {
-  auto triton_part
-      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  auto triton_part = makeTritonPart();
+  triton_part->SetTimingPathCache(timing_path_cache_);
   // Convert the string e_wt_factors_str to vector
   triton_part->SetNetWeight(e_wt_factors);
   triton_part->SetVertexWeight(v_wt_factors);
@@ -506,8 +530,7 @@ std::vector<int> PartitionMgr::PartitionKWaySimpleMode(
     const std::vector<float>& vertex_weights,
     const std::vector<float>& hyperedge_weights)
 {
-  auto triton_part
-      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  auto triton_part = makeTritonPart();
   return triton_part->PartitionKWaySimpleMode(num_parts_arg,
                                               balance_constraint_arg,
                                               seed_arg,
@@ -840,6 +863,14 @@ odb::dbBlock* PartitionMgr::getDbBlock() const
   return block;
 }
 
+std::unique_ptr<TritonPart> PartitionMgr::makeTritonPart() const
+{
+  auto triton_part
+      = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetNumThreads(ord::OpenRoad::openRoad()->getThreadCount());
+  return triton_part;
+}
+
 void PartitionMgr::writePartitionVerilog(const char* file_name,
                                          const char* port_prefix,
                                          const char* module_suffix)
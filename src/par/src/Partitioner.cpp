@@ -134,8 +134,7 @@ void Partitioner::RandomPart(const HGraphPtr& hgraph,
     for (int v = 0; v < hgraph->GetNumVertices(); v++) {
       if (hgraph->GetFixedAttr(v) > -1) {
         solution[v] = hgraph->GetFixedAttr(v);
-        block_balance[solution[v]]
-            = block_balance[solution[v]] + hgraph->GetVertexWeights(v);
+        Accumulate(block_balance[solution[v]], hgraph->GetVertexWeights(v));
         visited[v] = true;
       }
     }
@@ -172,8 +171,7 @@ void Partitioner::RandomPart(const HGraphPtr& hgraph,
     int block_id = 0;
     for (const auto& v : vertices) {
       solution[v] = block_id;
-      block_balance[block_id]
-          = block_balance[block_id] + hgraph->GetVertexWeights(v);
+      Accumulate(block_balance[block_id], hgraph->GetVertexWeights(v));
       if (block_balance[block_id] >= lower_block_balance[block_id]) {
         block_id++;
         block_id = block_id % num_parts_;  // adjust the block_id
@@ -187,8 +185,7 @@ void Partitioner::RandomPart(const HGraphPtr& hgraph,
     bool stop_flag = false;
     for (const auto& v : vertices) {
       solution[v] = block_id;
-      block_balance[block_id]
-          = block_balance[block_id] + hgraph->GetVertexWeights(v);
+      Accumulate(block_balance[block_id], hgraph->GetVertexWeights(v));
       if (block_balance[block_id] >= upper_block_balance[block_id]
           && stop_flag == false) {
         block_id++;
@@ -215,7 +212,7 @@ void Partitioner::ILPPart(const HGraphPtr& hgraph,
   std::vector<float> hyperedge_weights;  // one-dimensional
   // set vertices
   for (int v = 0; v < hgraph->GetNumVertices(); v++) {
-    vertex_weights.push_back(hgraph->GetVertexWeights(v));
+    vertex_weights.push_back(hgraph->GetVertexWeights(v).ToVector());
   }
   // check fixed vertices
   if (hgraph->HasFixedVertices()) {
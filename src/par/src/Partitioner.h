@@ -80,6 +80,8 @@ class Partitioner
 
   void SetRandomSeed(int seed) { seed_ = seed; }
 
+  void SetLogger(utl::Logger* logger) { logger_ = logger; }
+
   void EnableIlpAcceleration(float acceleration_factor);
 
   void DisableIlpAcceleration();
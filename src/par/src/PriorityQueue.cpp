@@ -54,45 +54,61 @@ PriorityQueue::PriorityQueue(const int total_elements,
 void PriorityQueue::Clear()
 {
   active_ = false;
-  vertices_.clear();
+  pool_.clear();
+  free_slots_.clear();
+  heap_.clear();
   total_elements_ = 0;
   std::fill(vertices_map_.begin(), vertices_map_.end(), -1);
 }
 
+// take a slot from the arena for a new element
+int PriorityQueue::AllocateSlot(VertexGain&& element)
+{
+  if (free_slots_.empty()) {
+    pool_.push_back(std::move(element));
+    return static_cast<int>(pool_.size()) - 1;
+  }
+  const int slot = free_slots_.back();
+  free_slots_.pop_back();
+  pool_[slot] = std::move(element);
+  return slot;
+}
+
 // insert one element into the priority queue
-void PriorityQueue::InsertIntoPQ(const std::shared_ptr<VertexGain>& element)
+void PriorityQueue::InsertIntoPQ(VertexGain element)
 {
   total_elements_++;
-  vertices_.push_back(element);
-  vertices_map_[element->GetVertex()] = total_elements_ - 1;
+  heap_.push_back(AllocateSlot(std::move(element)));
+  Place(total_elements_ - 1, heap_.back());
   HeapifyUp(total_elements_ - 1);
 }
 
 // get the largest element
-std::shared_ptr<VertexGain> PriorityQueue::ExtractMax()
+VertexGain PriorityQueue::ExtractMax()
 {
-  auto max_element = vertices_.front();
+  const int max_slot = heap_.front();
+  VertexGain max_element = std::move(pool_[max_slot]);
+  free_slots_.push_back(max_slot);
   // replace the first element with the last element, then
   // call HeapifyDown to update the order of elements
-  vertices_[0] = vertices_[total_elements_ - 1];
-  vertices_map_[vertices_[total_elements_ - 1]->GetVertex()] = 0;
+  Place(0, heap_[total_elements_ - 1]);
   total_elements_--;
-  vertices_.pop_back();
+  heap_.pop_back();
   HeapifyDown(0);
   // Set location of this vertex to -1 in the map
-  vertices_map_[max_element->GetVertex()] = -1;
+  vertices_map_[max_element.GetVertex()] = -1;
   return max_element;
 }
 
 // find the vertex gain which can satisfy the balance constraint
-std::shared_ptr<VertexGain> PriorityQueue::GetBestCandidate(
+VertexGain PriorityQueue::GetBestCandidate(
     const Matrix<float>& curr_block_balance,
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance,
-    const HGraphPtr& hgraph)
+    const HGraphPtr& hgraph) const
 {
-  if (total_elements_ <= 0) {               // empty
-    return std::make_shared<VertexGain>();  // return the dummy cell
+  if (total_elements_ <= 0) {  // empty
+    return VertexGain();       // return the dummy cell
   }
   int pass = 0;
   int candidate_index = -1;  // the index of the candidate vertex gain
@@ -100,21 +116,25 @@ std::shared_ptr<VertexGain> PriorityQueue::GetBestCandidate(
 
   // define the lambda function to check the balance constraint
   auto CheckBalance = [&](int index) {
-    const int vertex_id = vertices_[index]->GetVertex();
-    const int to_pid = vertices_[index]->GetDestinationPart();
-    const int from_pid = vertices_[index]->GetSourcePart();
-    if ((curr_block_balance[to_pid] + hgraph->GetVertexWeights(vertex_id)
-         < upper_block_balance[to_pid])
-        && (curr_block_balance[from_pid] - hgraph->GetVertexWeights(vertex_id)
-            > lower_block_balance[from_pid])) {
-      return true;
-    }
-    return false;
+    const VertexGain& element = Element(index);
+    const int vertex_id = element.GetVertex();
+    const int to_pid = element.GetDestinationPart();
+    const int from_pid = element.GetSourcePart();
+    const Span<const float> vertex_weight = hgraph->GetVertexWeights(vertex_id);
+    return ShiftedLess(curr_block_balance[to_pid],
+                       vertex_weight,
+                       1.0f,
+                       upper_block_balance[to_pid])
+           && ShiftedLexCompare(curr_block_balance[from_pid],
+                                vertex_weight,
+                                -1.0f,
+                                lower_block_balance[from_pid])
+                  > 0;
   };
 
   // check the first index
   if (CheckBalance(index) == true) {
-    return vertices_[index];
+    return Element(index);
   }
 
   // traverse the max heap
@@ -135,17 +155,17 @@ std::shared_ptr<VertexGain> PriorityQueue::GetBestCandidate(
     }
 
     if (candidate_index > 0) {
-      return vertices_[candidate_index];  // return the candidate gain cell
+      return Element(candidate_index);  // return the candidate gain cell
     }
     if (left_child >= total_elements_ || right_child >= total_elements_) {
       // no valid candidate
-      return std::make_shared<VertexGain>();  // return the dummy cell
+      return VertexGain();  // return the dummy cell
     }
     index = CompareElementLargeThan(right_child, left_child) == true
                 ? right_child
                 : left_child;
   }
-  return std::make_shared<VertexGain>();  // return the dummy cell
+  return VertexGain();  // return the dummy cell
 }
 
 // Remove the specifid vertex
@@ -156,7 +176,7 @@ void PriorityQueue::Remove(int vertex_id)
     return;  // This vertex does not exists
   }
   // set the gain of this element to maximum + 1
-  vertices_[index]->SetGain(GetMax()->GetGain() + 1.0);
+  Element(index).SetGain(GetMax().GetGain() + 1.0);
   // Shift the element to top of the heap
   HeapifyUp(index);
   // Extract the element from the heap
@@ -167,17 +187,17 @@ void PriorityQueue::Remove(int vertex_id)
 }
 
 // Update the priority (gain) for the specified vertex
-void PriorityQueue::ChangePriority(
-    int vertex_id,
-    const std::shared_ptr<VertexGain>& new_element)
+void PriorityQueue::ChangePriority(int vertex_id, VertexGain new_element)
 {
   const int index = vertices_map_[vertex_id];
   if (index == -1) {
     return;  // This vertex does not exists
   }
-  const float old_priority = vertices_[index]->GetGain();
-  vertices_[index] = new_element;
-  if (new_element->GetGain() > old_priority) {
+  const float old_priority = Element(index).GetGain();
+  const float new_priority = new_element.GetGain();
+  // reuse the slot of the old element
+  Element(index) = std::move(new_element);
+  if (new_priority > old_priority) {
     HeapifyUp(index);
   } else {
     HeapifyDown(index);
@@ -191,15 +211,16 @@ void PriorityQueue::ChangePriority(
 // Compare the two elements
 // If the gains are equal then pick the vertex with the smaller weight
 // The hope is doing this will incentivize in preventing corking effect
-bool PriorityQueue::CompareElementLargeThan(int index_a, int index_b)
+bool PriorityQueue::CompareElementLargeThan(int index_a, int index_b) const
 {
-  if (vertices_[index_a]->GetGain() > vertices_[index_b]->GetGain()) {
+  const VertexGain& element_a = Element(index_a);
+  const VertexGain& element_b = Element(index_b);
+  if (element_a.GetGain() > element_b.GetGain()) {
     return true;
   }
-  return (
-      (vertices_[index_a]->GetGain() == vertices_[index_b]->GetGain())
-      && (hypergraph_->GetVertexWeights(vertices_[index_a]->GetVertex())
-          < hypergraph_->GetVertexWeights(vertices_[index_b]->GetVertex())));
+  return ((element_a.GetGain() == element_b.GetGain())
+          && (hypergraph_->GetVertexWeights(element_a.GetVertex())
+              < hypergraph_->GetVertexWeights(element_b.GetVertex())));
 }
 
 // push the element at location index to its ordered location
@@ -207,52 +228,48 @@ bool PriorityQueue::CompareElementLargeThan(int index_a, int index_b)
 void PriorityQueue::HeapifyUp(int index)
 {
   while (index > 0 && CompareElementLargeThan(index, Parent(index)) == true) {
-    // Update the map (exchange parent and child)
-    auto& parent_heap_element = vertices_[Parent(index)];
-    auto& child_heap_element = vertices_[index];
-    vertices_map_[child_heap_element->GetVertex()] = Parent(index);
-    vertices_map_[parent_heap_element->GetVertex()] = index;
-    // Swap the elements
-    std::swap(parent_heap_element, child_heap_element);
+    // Swap the slots of parent and child, and update the map
+    const int parent = Parent(index);
+    const int child_slot = heap_[index];
+    Place(index, heap_[parent]);
+    Place(parent, child_slot);
     // Next iteration
-    index = Parent(index);
+    index = parent;
   }
 }
 
 // This function is called when we delete an existing element
 void PriorityQueue::HeapifyDown(int index)
 {
-  int max_index = index;
+  while (true) {
+    int max_index = index;
 
-  // Basically, we need order index, left child and right child
-  // Step 1: check if current index is less than left child
-  const int left_child = LeftChild(index);
-  if (left_child < total_elements_
-      && CompareElementLargeThan(left_child, max_index) == true) {
-    max_index = left_child;
-  }
+    // Basically, we need order index, left child and right child
+    // Step 1: check if current index is less than left child
+    const int left_child = LeftChild(index);
+    if (left_child < total_elements_
+        && CompareElementLargeThan(left_child, max_index) == true) {
+      max_index = left_child;
+    }
 
-  // Step 2: check if the max index is less than right child
-  const int right_child = RightChild(index);
-  if (right_child < total_elements_
-      && CompareElementLargeThan(right_child, max_index) == true) {
-    max_index = right_child;
-  }
+    // Step 2: check if the max index is less than right child
+    const int right_child = RightChild(index);
+    if (right_child < total_elements_
+        && CompareElementLargeThan(right_child, max_index) == true) {
+      max_index = right_child;
+    }
 
-  if (index == max_index) {
-    return;  // we do not need to further heapifydown
-  }
+    if (index == max_index) {
+      return;  // we do not need to further heapifydown
+    }
 
-  // swap index and max_index
-  auto& cur_heap_element = vertices_[index];
-  auto& large_heap_element = vertices_[max_index];
-  // Update the map
-  vertices_map_[cur_heap_element->GetVertex()] = max_index;
-  vertices_map_[large_heap_element->GetVertex()] = index;
-  // Swap the elements
-  std::swap(cur_heap_element, large_heap_element);
-  // Next recursive iteration
-  HeapifyDown(max_index);
+    // Swap the slots of index and max_index, and update the map
+    const int cur_slot = heap_[index];
+    Place(index, heap_[max_index]);
+    Place(max_index, cur_slot);
+    // Next iteration
+    index = max_index;
+  }
 }
 
 }  // namespace par
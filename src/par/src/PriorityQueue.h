@@ -35,11 +35,18 @@
 #pragma once
 
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "Hypergraph.h"
 
 namespace par {
 
+// The DELTA path cost of a move, stored as sparse (path_id, delta) pairs
+// sorted by path_id.  A flat vector avoids one tree-node allocation per path
+// for every gain evaluation.
+using PathCostDelta = std::vector<std::pair<int, float>>;
+
 // Vertex Gain is the basic elements of FM
 // We do not use the classical gain-bucket data structure
 // We design our own priority-queue based gain-bucket data structure
@@ -54,7 +61,7 @@ class VertexGain
              int src_block_id,
              int destination_block_id,
              float gain,
-             const std::map<int, float>& path_cost);
+             PathCostDelta path_cost);
 
   // accessor functions
   int GetVertex() const { return vertex_; }
@@ -64,7 +71,7 @@ class VertexGain
   void SetGain(float gain) { gain_ = gain; }
 
   // get the delta path cost
-  const std::map<int, float>& GetPathCost() const { return path_cost_; }
+  const PathCostDelta& GetPathCost() const { return path_cost_; }
 
   int GetSourcePart() const { return source_part_; }
   int GetDestinationPart() const { return destination_part_; }
@@ -75,11 +82,10 @@ class VertexGain
   int destination_part_ = -1;  // the destination block id
   float gain_
       = -std::numeric_limits<float>::max();  // gain value of moving this vertex
-  std::map<int, float>
-      path_cost_;  // the updated DELTA path cost after moving vertex
-                   // the path_cost will change because we will dynamically
-                   // update the the weight of the path based on the number of
-                   // the cut on the path
+  PathCostDelta path_cost_;  // the updated DELTA path cost after moving vertex
+                             // the path_cost will change because we will
+                             // dynamically update the the weight of the path
+                             // based on the number of the cut on the path
 };
 
 // ------------------------------------------------------------
@@ -87,6 +93,13 @@ class VertexGain
 // Actually we implement the priority queue with Max Heap
 // We did not use the STL priority queue becuase we need
 // to record the location of each element (vertex gain)
+//
+// The vertex gains are stored by value in a pooled arena and the heap
+// only orders slot indices into the arena.  Slots are recycled through a
+// free list, so the queue itself stops allocating once the arena has grown
+// to the number of boundary vertices.  The PathCostDelta of each gain is
+// still a separate vector built by the caller; it is moved into its slot,
+// so a gain with timing paths costs one allocation when it is computed.
 // -------------------------------------------------------------
 class PriorityQueue
 {
@@ -96,32 +109,31 @@ class PriorityQueue
                 int maximum_traverse_level,
                 HGraphPtr hypergraph);
 
-  // insert one element (std::shared_ptr<VertexGain>) into the priority queue
-  void InsertIntoPQ(const std::shared_ptr<VertexGain>& element);
+  // insert one element (VertexGain) into the priority queue
+  void InsertIntoPQ(VertexGain element);
 
   // extract the largest element, i.e.,
   // get the largest element and remove it from the heap
-  std::shared_ptr<VertexGain> ExtractMax();
+  VertexGain ExtractMax();
 
   // get the largest element without removing it from the heap
-  std::shared_ptr<VertexGain> GetMax() { return vertices_.front(); }
+  const VertexGain& GetMax() const { return Element(0); }
 
   // find the vertex gain which can satisfy the balance constraint
-  std::shared_ptr<VertexGain> GetBestCandidate(
-      const Matrix<float>& curr_block_balance,
-      const Matrix<float>& upper_block_balance,
-      const Matrix<float>& lower_block_balance,
-      const HGraphPtr& hgraph);
+  // (a dummy VertexGain with vertex -1 is returned if there is none)
+  VertexGain GetBestCandidate(const Matrix<float>& curr_block_balance,
+                              const Matrix<float>& upper_block_balance,
+                              const Matrix<float>& lower_block_balance,
+                              const HGraphPtr& hgraph) const;
 
   // update the priority (gain) for the specified vertex
-  void ChangePriority(int vertex_id,
-                      const std::shared_ptr<VertexGain>& new_element);
+  void ChangePriority(int vertex_id, VertexGain new_element);
 
   // Remove the specified vertex
   void Remove(int vertex_id);
 
   // Basic accessors
-  bool CheckIfEmpty() const { return vertices_.empty(); }
+  bool CheckIfEmpty() const { return heap_.empty(); }
   int GetTotalElements() const { return total_elements_; }
   // the size of the max heap
   int GetSizeOfMap() const { return vertices_map_.size(); }
@@ -131,18 +143,32 @@ class PriorityQueue
   void SetActive() { active_ = true; }
   void SetDeactive() { active_ = false; }
   bool GetStatus() const { return active_; }
-  // clear the heap
+  // clear the heap (the arena keeps its capacity)
   void Clear();
 
  private:
   // The max heap (priority queue) is organized as a binary tree
   // Get parent, left child and right child index
   // Generic functions of max heap
-  int Parent(int element) const { return std::floor((element - 1) / 2); }
+  int Parent(int element) const { return (element - 1) / 2; }
+
+  int LeftChild(int element) const { return 2 * element + 1; }
+
+  int RightChild(int element) const { return 2 * element + 2; }
+
+  // the vertex gain at location index of the heap
+  const VertexGain& Element(int index) const { return pool_[heap_[index]]; }
+  VertexGain& Element(int index) { return pool_[heap_[index]]; }
 
-  int LeftChild(int& element) const { return 2 * element + 1; }
+  // place the element at location index of the heap
+  void Place(int index, int slot)
+  {
+    heap_[index] = slot;
+    vertices_map_[pool_[slot].GetVertex()] = index;
+  }
 
-  int RightChild(int& element) const { return 2 * element + 2; }
+  // take a slot from the arena for a new element
+  int AllocateSlot(VertexGain&& element);
 
   // This is called when we add a new element
   void HeapifyUp(int index);
@@ -153,12 +179,14 @@ class PriorityQueue
   // Compare the two elements
   // If the gains are equal then pick the vertex with the smaller weight
   // The hope is doing this will incentivize in preventing corking effect
-  bool CompareElementLargeThan(int index_a, int index_b);
+  bool CompareElementLargeThan(int index_a, int index_b) const;
 
   // private variables
   bool active_;
   HGraphPtr hypergraph_;
-  std::vector<std::shared_ptr<VertexGain>> vertices_;  // elements
+  std::vector<VertexGain> pool_;  // arena of elements, indexed by slot
+  std::vector<int> free_slots_;   // released slots of pool_
+  std::vector<int> heap_;         // slots of the elements in heap order
   std::vector<int> vertices_map_;  // store the location of vertex_gain for each
                                    // vertex vertices_map_ always has the size
                                    // of hypergraph_->num_vertices_
@@ -34,6 +34,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Refiner.h"
 
+#include <chrono>
+
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "Utilities.h"
@@ -47,12 +49,12 @@ VertexGain::VertexGain(const int vertex,
                        const int src_block_id,
                        const int destination_block_id,
                        const float gain,
-                       const std::map<int, float>& path_cost)
+                       PathCostDelta path_cost)
     : vertex_(vertex),
       source_part_(src_block_id),
       destination_part_(destination_block_id),
       gain_(gain),
-      path_cost_(path_cost)
+      path_cost_(std::move(path_cost))
 {
 }
 
@@ -100,6 +102,16 @@ void Refiner::SetRefineIters(const int refiner_iters)
   refiner_iters_ = refiner_iters;
 }
 
+void Refiner::SetThreadPool(ThreadPoolPtr thread_pool)
+{
+  thread_pool_ = std::move(thread_pool);
+}
+
+void Refiner::SetActiveVertices(std::vector<bool> active_vertices)
+{
+  active_vertices_ = std::move(active_vertices);
+}
+
 void Refiner::RestoreDefaultParameters()
 {
   max_move_ = max_move_default_;
@@ -139,6 +151,15 @@ void Refiner::Refine(const HGraphPtr& hgraph,
         }
       }
     }
+    // mark all inactive vertices as visited vertices
+    if (!active_vertices_.empty()) {
+      for (auto v = 0; v < hgraph->GetNumVertices(); v++) {
+        if (!active_vertices_[v]) {
+          visited_vertices_flag[v] = true;
+        }
+      }
+    }
+    auto pass_start_time = std::chrono::high_resolution_clock::now();
     const float gain = Pass(hgraph,
                             upper_block_balance,
                             lower_block_balance,
@@ -147,6 +168,20 @@ void Refiner::Refine(const HGraphPtr& hgraph,
                             cur_paths_cost,
                             solution,
                             visited_vertices_flag);
+    auto pass_end_time = std::chrono::high_resolution_clock::now();
+    const double pass_time = std::chrono::duration<double>(pass_end_time
+                                                           - pass_start_time)
+                                 .count();
+    debugPrint(logger_,
+               PAR,
+               "refiner",
+               1,
+               "[Refinement] pass {} :: num_vertices = {}, gain = {}, "
+               "runtime = {} seconds",
+               i,
+               hgraph->GetNumVertices(),
+               gain,
+               pass_time);
     if (gain <= 0.0) {
       return;  // stop if there is no improvement
     }
@@ -157,6 +192,20 @@ void Refiner::Refine(const HGraphPtr& hgraph,
 // Protected functions
 // ---------------------------------------------------------------
 
+// Run the tasks on the persistent worker pool.
+// Fall back to a serial loop if no pool is specified.
+void Refiner::ParallelFor(const int num_tasks,
+                          const std::function<void(int)>& func) const
+{
+  if (thread_pool_ == nullptr) {
+    for (int i = 0; i < num_tasks; i++) {
+      func(i);
+    }
+    return;
+  }
+  thread_pool_->ParallelFor(num_tasks, func);
+}
+
 // By default, v = -1 and to_pid = -1
 // if to_pid == -1, we are calculate the current cost
 // of the path;
@@ -341,11 +390,9 @@ GainCell Refiner::CalculateVertexGain(int v,
   // we need solution argument to update the score related to path
   float cut_score = 0.0;
   float path_score = 0.0;
-  std::map<int, float>
-      delta_path_cost;       // map path_id to the change of path cost
-  if (from_pid == to_pid) {  // no gain for this case
-    return std::make_shared<VertexGain>(
-        v, from_pid, to_pid, 0.0f, delta_path_cost);
+  PathCostDelta delta_path_cost;  // path_id and the change of path cost
+  if (from_pid == to_pid) {       // no gain for this case
+    return VertexGain(v, from_pid, to_pid, 0.0f, std::move(delta_path_cost));
   }
   // define lambda function
   // for checking connectivity (number of blocks connected by a hyperedge)
@@ -381,18 +428,25 @@ GainCell Refiner::CalculateVertexGain(int v,
   }
   // check the timing path
   if (hgraph->GetNumTimingPaths() > 0) {
-    for (const int path_id : hgraph->TimingPathsThrough(v)) {
+    const auto paths = hgraph->TimingPathsThrough(v);
+    delta_path_cost.reserve(paths.size());
+    // the paths through v are sorted by path id, so a path visiting v
+    // more than once shows up as adjacent duplicates
+    for (const int path_id : paths) {
       // Get updated path costs if vertex is moved to a different partition
       const float cost
           = CalculatePathCost(path_id, hgraph, solution, v, to_pid);
-      delta_path_cost[path_id] = cost - cur_paths_cost[path_id];
+      if (!delta_path_cost.empty() && delta_path_cost.back().first == path_id) {
+        delta_path_cost.back().second = cost - cur_paths_cost[path_id];
+      } else {
+        delta_path_cost.emplace_back(path_id, cost - cur_paths_cost[path_id]);
+      }
       // gain accomodates for the change in the cost of the timing path
       path_score += cur_paths_cost[path_id] - cost;  // score in minus cost
     }
   }
   const float score = cut_score + path_score;
-  return std::make_shared<VertexGain>(
-      v, from_pid, to_pid, score, delta_path_cost);
+  return VertexGain(v, from_pid, to_pid, score, std::move(delta_path_cost));
 }
 
 // move one vertex based on the calculated gain_cell
@@ -405,23 +459,23 @@ void Refiner::AcceptVertexGain(const GainCell& gain_cell,
                                Matrix<float>& curr_block_balance,
                                Matrix<int>& net_degs) const
 {
-  const int vertex_id = gain_cell->GetVertex();
+  const int vertex_id = gain_cell.GetVertex();
   visited_vertices_flag[vertex_id] = true;
-  total_delta_gain += gain_cell->GetGain();  // increase the total gain
+  total_delta_gain += gain_cell.GetGain();  // increase the total gain
   // Update the path cost first
-  for (const auto& [path_id, delta_path_cost] : gain_cell->GetPathCost()) {
+  for (const auto& [path_id, delta_path_cost] : gain_cell.GetPathCost()) {
     cur_paths_cost[path_id] += delta_path_cost;
   }
   // get partition id
-  const int pre_part_id = gain_cell->GetSourcePart();
-  const int new_part_id = gain_cell->GetDestinationPart();
+  const int pre_part_id = gain_cell.GetSourcePart();
+  const int new_part_id = gain_cell.GetDestinationPart();
   // update the solution vector
   solution[vertex_id] = new_part_id;
   // Update the partition balance
-  curr_block_balance[pre_part_id]
-      = curr_block_balance[pre_part_id] - hgraph->GetVertexWeights(vertex_id);
-  curr_block_balance[new_part_id]
-      = curr_block_balance[new_part_id] + hgraph->GetVertexWeights(vertex_id);
+  Subtract(curr_block_balance[pre_part_id],
+           hgraph->GetVertexWeights(vertex_id));
+  Accumulate(curr_block_balance[new_part_id],
+             hgraph->GetVertexWeights(vertex_id));
   // update net_degs
   for (const int he : hgraph->Edges(vertex_id)) {
     --net_degs[he][pre_part_id];
@@ -438,22 +492,22 @@ void Refiner::RollBackVertexGain(const GainCell& gain_cell,
                                  Matrix<float>& curr_block_balance,
                                  Matrix<int>& net_degs) const
 {
-  const int vertex_id = gain_cell->GetVertex();
+  const int vertex_id = gain_cell.GetVertex();
   visited_vertices_flag[vertex_id] = false;
   // Update the path cost first
-  for (const auto& [path_id, delta_path_cost] : gain_cell->GetPathCost()) {
+  for (const auto& [path_id, delta_path_cost] : gain_cell.GetPathCost()) {
     cur_paths_cost[path_id] -= delta_path_cost;
   }
   // get partition id
-  const int pre_part_id = gain_cell->GetSourcePart();
-  const int new_part_id = gain_cell->GetDestinationPart();
+  const int pre_part_id = gain_cell.GetSourcePart();
+  const int new_part_id = gain_cell.GetDestinationPart();
   // update the solution vector
   solution[vertex_id] = pre_part_id;
   // Update the partition balance
-  curr_block_balance[pre_part_id]
-      = curr_block_balance[pre_part_id] + hgraph->GetVertexWeights(vertex_id);
-  curr_block_balance[new_part_id]
-      = curr_block_balance[new_part_id] - hgraph->GetVertexWeights(vertex_id);
+  Accumulate(curr_block_balance[pre_part_id],
+             hgraph->GetVertexWeights(vertex_id));
+  Subtract(curr_block_balance[new_part_id],
+           hgraph->GetVertexWeights(vertex_id));
   // update net_degs
   for (const int he : hgraph->Edges(vertex_id)) {
     ++net_degs[he][pre_part_id];
@@ -472,12 +526,20 @@ bool Refiner::CheckVertexMoveLegality(
     const Matrix<float>& upper_block_balance,
     const Matrix<float>& lower_block_balance) const
 {
-  const std::vector<float> total_wt_to_block
-      = curr_block_balance[to_pid] + hgraph->GetVertexWeights(v);
-  const std::vector<float> total_wt_from_block
-      = curr_block_balance[from_pid] - hgraph->GetVertexWeights(v);
-  return total_wt_to_block <= upper_block_balance[to_pid]
-         && lower_block_balance[from_pid] <= total_wt_from_block;
+  // (curr_block_balance[to_pid] + weight) <= upper_block_balance[to_pid]
+  // and lower_block_balance[from_pid] <= (curr_block_balance[from_pid] -
+  // weight), compared lexicographically without temporary vectors
+  const Span<const float> vertex_weight = hgraph->GetVertexWeights(v);
+  return ShiftedLexCompare(curr_block_balance[to_pid],
+                           vertex_weight,
+                           1.0f,
+                           upper_block_balance[to_pid])
+             <= 0
+         && ShiftedLexCompare(curr_block_balance[from_pid],
+                              vertex_weight,
+                              -1.0f,
+                              lower_block_balance[from_pid])
+                >= 0;
 }
 
 // calculate the possible gain of moving a entire hyperedge
@@ -614,10 +676,10 @@ void Refiner::AcceptHyperedgeGain(const HyperedgeGainPtr& hyperedge_gain,
     // update solution
     solution[vertex_id] = new_part_id;
     // Update the partition balance
-    cur_block_balance[pre_part_id]
-        = cur_block_balance[pre_part_id] - hgraph->GetVertexWeights(vertex_id);
-    cur_block_balance[new_part_id]
-        = cur_block_balance[new_part_id] + hgraph->GetVertexWeights(vertex_id);
+    Subtract(cur_block_balance[pre_part_id],
+             hgraph->GetVertexWeights(vertex_id));
+    Accumulate(cur_block_balance[new_part_id],
+               hgraph->GetVertexWeights(vertex_id));
     // update net_degs
     // not just this hyperedge, we need to update all the related hyperedges
     for (const int he : hgraph->Edges(vertex_id)) {
@@ -644,10 +706,8 @@ bool Refiner::CheckHyperedgeMoveLegality(
     }
     const int pid = solution[v];
     if (solution[v] != to_pid) {
-      update_block_balance[to_pid]
-          = update_block_balance[to_pid] + hgraph->GetVertexWeights(v);
-      update_block_balance[pid]
-          = update_block_balance[pid] - hgraph->GetVertexWeights(v);
+      Accumulate(update_block_balance[to_pid], hgraph->GetVertexWeights(v));
+      Subtract(update_block_balance[pid], hgraph->GetVertexWeights(v));
     }
   }
   // Violate the upper bound
@@ -39,6 +39,7 @@
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "PriorityQueue.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "utl/Logger.h"
 
@@ -50,12 +51,14 @@ enum class RefinerChoice
   GREEDY,         // greedy refinement. try to one entire hyperedge each time
   FLAT_K_WAY_FM,  // direct k-way FM
   KPM_FM,         // K-way pair-wise FM
-  ILP_REFINE      // ILP-based partitioning (only for two-way since k-way ILP
+  ILP_REFINE,     // ILP-based partitioning (only for two-way since k-way ILP
                   // partitioning is too timing-consuming)
+  LABEL_PROPAGATION  // parallel label propagation (run before FM on the
+                     // finest levels of very large hypergraphs)
 };
 
-class VertexGain;
-using GainCell = std::shared_ptr<VertexGain>;  // for abbreviation
+// Vertex gains are plain values owned by the gain buckets (PriorityQueue)
+using GainCell = VertexGain;  // for abbreviation
 
 class HyperedgeGain;
 using HyperedgeGainPtr = std::shared_ptr<HyperedgeGain>;
@@ -113,8 +116,7 @@ class Refiner
           EvaluatorPtr evaluator,
           utl::Logger* logger);
 
-  Refiner(const Refiner&) = delete;
-  Refiner(Refiner&) = delete;
+  Refiner& operator=(const Refiner&) = delete;
   virtual ~Refiner() = default;
 
   // The main function
@@ -126,9 +128,23 @@ class Refiner
   void SetMaxMove(int max_move);
   void SetRefineIters(int refiner_iters);
 
+  void SetLogger(utl::Logger* logger) { logger_ = logger; }
+
+  // The persistent worker pool used for parallel gain bucket updates.
+  // If no pool is specified, the updates are performed serially.
+  void SetThreadPool(ThreadPoolPtr thread_pool);
+
+  // Only the vertices marked as active can be moved, e.g., the vertices
+  // around a netlist ECO. An empty vector means all the vertices are active.
+  void SetActiveVertices(std::vector<bool> active_vertices);
+
   void RestoreDefaultParameters();
 
  protected:
+  // Only the concrete refiners can be copied (without slicing), e.g.,
+  // to generate several candidate solutions concurrently
+  Refiner(const Refiner&) = default;
+
   virtual float Pass(const HGraphPtr& hgraph,
                      const Matrix<float>& upper_block_balance,
                      const Matrix<float>& lower_block_balance,
@@ -139,6 +155,9 @@ class Refiner
                      std::vector<bool>& visited_vertices_flag)
       = 0;
 
+  // Run func(0), ..., func(num_tasks - 1) on the worker pool
+  void ParallelFor(int num_tasks, const std::function<void(int)>& func) const;
+
   // If to_pid == -1, we are calculate the current cost of the path;
   // else if to_pid != -1, we are calculate the cost of the path
   // after moving v to block to_pid
@@ -282,6 +301,10 @@ class Refiner
 
   utl::Logger* logger_ = nullptr;
   EvaluatorPtr evaluator_ = nullptr;
+  ThreadPoolPtr thread_pool_ = nullptr;
+
+  // the vertices can be moved (empty means all the vertices)
+  std::vector<bool> active_vertices_;
 };
 
 }  // namespace par
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace par {
+
+ThreadPool::ThreadPool(const int num_threads)
+{
+  // the calling thread is one of the num_threads
+  const int num_workers = std::max(num_threads - 1, 0);
+  workers_.reserve(num_workers);
+  for (int i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(const int num_tasks,
+                             const std::function<void(int)>& func)
+{
+  if (num_tasks <= 0) {
+    return;
+  }
+  // No need to wake up the workers for a single task
+  if (workers_.empty() || num_tasks == 1) {
+    for (int i = 0; i < num_tasks; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  auto job = std::make_shared<Job>(num_tasks, func);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(job);
+  }
+  // the caller handles one task itself
+  const int num_helpers
+      = std::min(num_tasks - 1, static_cast<int>(workers_.size()));
+  for (int i = 0; i < num_helpers; i++) {
+    cond_.notify_one();
+  }
+
+  RunTasks(*job);
+
+  // wait for the tasks claimed by the workers
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->finished.wait(lock, [&job]() {
+    return job->finished_tasks.load() == job->num_tasks;
+  });
+}
+
+void ThreadPool::RunTasks(Job& job)
+{
+  while (true) {
+    const int task_id = job.next_task.fetch_add(1);
+    if (task_id >= job.num_tasks) {
+      return;
+    }
+    job.func(task_id);
+    if (job.finished_tasks.fetch_add(1) + 1 == job.num_tasks) {
+      std::lock_guard<std::mutex> lock(job.mutex);
+      job.finished.notify_all();
+    }
+  }
+}
+
+void ThreadPool::WorkerLoop()
+{
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+      if (stop_ && jobs_.empty()) {
+        return;
+      }
+      job = jobs_.front();
+      // keep the job in the queue while there are unclaimed tasks,
+      // so other idle workers can also help
+      if (job->next_task.load() >= job->num_tasks - 1) {
+        jobs_.pop_front();
+      }
+    }
+    RunTasks(*job);
+  }
+}
+
+}  // namespace par
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2022, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+// High-level description
+// A persistent worker pool shared by the multilevel partitioner.
+// The refiners used to create and join fresh std::threads after every
+// accepted move.  Here the workers are created once and the same threads
+// are reused for all the parallel loops (gain bucket initialization,
+// neighbor updates and heap deletions).
+// The calling thread always participates in its own loop, so nested
+// ParallelFor calls (e.g. refining several candidate solutions in parallel,
+// each of which updates its gain buckets in parallel) cannot deadlock.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace par {
+
+class ThreadPool;
+using ThreadPoolPtr = std::shared_ptr<ThreadPool>;
+
+class ThreadPool
+{
+ public:
+  // num_threads is the total number of threads working on a loop,
+  // including the calling thread.  num_threads <= 1 means serial execution.
+  explicit ThreadPool(int num_threads);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  int GetNumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Run func(0), func(1), ..., func(num_tasks - 1) and wait for all of them.
+  // Each index is executed exactly once.  The tasks must not depend on the
+  // order of execution; results stay deterministic as long as each task
+  // only writes to the state owned by its index.
+  void ParallelFor(int num_tasks, const std::function<void(int)>& func);
+
+ private:
+  // a single ParallelFor loop shared by the caller and the workers
+  struct Job
+  {
+    Job(int num_tasks_arg, const std::function<void(int)>& func_arg)
+        : num_tasks(num_tasks_arg), func(func_arg)
+    {
+    }
+
+    const int num_tasks = 0;
+    const std::function<void(int)>& func;
+    std::atomic<int> next_task{0};
+    std::atomic<int> finished_tasks{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+
+  // claim and run the tasks of job until no task is left
+  static void RunTasks(Job& job);
+
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::shared_ptr<Job>> jobs_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool stop_ = false;
+};
+
+}  // namespace par
@@ -40,15 +40,21 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "TritonPart.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <numeric>
 #include <set>
 #include <string>
+#include <type_traits>
 
+#include "BinaryHypergraph.h"
 #include "Coarsener.h"
 #include "Hypergraph.h"
 #include "Multilevel.h"
 #include "Partitioner.h"
 #include "Refiner.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 #include "odb/db.h"
 #include "sta/ArcDelayCalc.hh"
@@ -79,6 +85,145 @@ using utl::PAR;
 
 namespace par {
 
+// -----------------------------------------------------------------------------------
+// Netlist ECO
+// -----------------------------------------------------------------------------------
+
+bool NetlistEco::Empty() const
+{
+  return added_insts.empty() && resized_insts.empty()
+         && removed_vertices.empty() && added_nets.empty()
+         && modified_nets.empty() && removed_hyperedges.empty();
+}
+
+void NetlistEco::Clear()
+{
+  added_insts.clear();
+  resized_insts.clear();
+  removed_vertices.clear();
+  added_nets.clear();
+  modified_nets.clear();
+  removed_hyperedges.clear();
+}
+
+void NetlistEcoRecorder::inDbInstCreate(odb::dbInst* inst)
+{
+  eco_.added_insts.insert(inst);
+}
+
+void NetlistEcoRecorder::inDbInstCreate(odb::dbInst* inst,
+                                        odb::dbRegion* region)
+{
+  eco_.added_insts.insert(inst);
+}
+
+void NetlistEcoRecorder::inDbInstDestroy(odb::dbInst* inst)
+{
+  if (eco_.added_insts.erase(inst) > 0) {
+    return;  // the instance has never been partitioned
+  }
+  eco_.resized_insts.erase(inst);
+  auto vertex_id_property = odb::dbIntProperty::find(inst, "vertex_id");
+  if (vertex_id_property != nullptr && vertex_id_property->getValue() > -1) {
+    eco_.removed_vertices.insert(vertex_id_property->getValue());
+  }
+}
+
+void NetlistEcoRecorder::inDbInstSwapMasterAfter(odb::dbInst* inst)
+{
+  if (eco_.added_insts.find(inst) == eco_.added_insts.end()) {
+    eco_.resized_insts.insert(inst);
+  }
+}
+
+void NetlistEcoRecorder::inDbNetCreate(odb::dbNet* net)
+{
+  eco_.added_nets.insert(net);
+}
+
+void NetlistEcoRecorder::inDbNetDestroy(odb::dbNet* net)
+{
+  if (eco_.added_nets.erase(net) > 0) {
+    return;  // the net has never been partitioned
+  }
+  eco_.modified_nets.erase(net);
+  auto hyperedge_id_property = odb::dbIntProperty::find(net, "hyperedge_id");
+  if (hyperedge_id_property != nullptr
+      && hyperedge_id_property->getValue() > -1) {
+    eco_.removed_hyperedges.insert(hyperedge_id_property->getValue());
+  }
+}
+
+void NetlistEcoRecorder::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  ModifyNet(iterm->getNet());
+}
+
+void NetlistEcoRecorder::inDbITermPreDisconnect(odb::dbITerm* iterm)
+{
+  ModifyNet(iterm->getNet());
+}
+
+void NetlistEcoRecorder::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  ModifyNet(bterm->getNet());
+}
+
+void NetlistEcoRecorder::inDbBTermPreDisconnect(odb::dbBTerm* bterm)
+{
+  ModifyNet(bterm->getNet());
+}
+
+void NetlistEcoRecorder::ModifyNet(odb::dbNet* net)
+{
+  if (net != nullptr && eco_.added_nets.find(net) == eco_.added_nets.end()) {
+    eco_.modified_nets.insert(net);
+  }
+}
+
+// -----------------------------------------------------------------------------------
+// Timing path cache
+// -----------------------------------------------------------------------------------
+
+bool TimingPathCache::Key::operator==(const Key& key) const
+{
+  return netlist_version == key.netlist_version && top_n == key.top_n
+         && num_vertices == key.num_vertices
+         && num_hyperedges == key.num_hyperedges
+         && fence_flag == key.fence_flag && fence.lx == key.fence.lx
+         && fence.ly == key.fence.ly && fence.ux == key.fence.ux
+         && fence.uy == key.fence.uy && net_slacks == key.net_slacks;
+}
+
+void TimingPathCache::Track(odb::dbBlock* block)
+{
+  // The owner is removed when the block is destroyed, so a new block
+  // allocated at the same address is attached again.
+  if (block_ == block && hasOwner()) {
+    return;
+  }
+  removeOwner();
+  addOwner(block);
+  block_ = block;
+  netlist_version_++;
+  key_ = Key();
+  entry_ = Entry();
+}
+
+const TimingPathCache::Entry* TimingPathCache::Find(const Key& key) const
+{
+  if (key.netlist_version < 0 || !(key == key_)) {
+    return nullptr;
+  }
+  return &entry_;
+}
+
+void TimingPathCache::Store(const Key& key, Entry entry)
+{
+  key_ = key;
+  entry_ = std::move(entry);
+}
+
 // -----------------------------------------------------------------------------------
 // Public functions
 // -----------------------------------------------------------------------------------
@@ -137,6 +282,7 @@ void TritonPart::SetFineTuneParams(
     int max_num_vcycle,
     int num_coarsen_solutions,
     int num_vertices_threshold_ilp,
+    int num_vertices_threshold_lp,
     int global_net_threshold)
 {
   // coarsening related parameters (stop conditions)
@@ -204,10 +350,36 @@ void TritonPart::SetFineTuneParams(
   // ILP threshold
   num_vertices_threshold_ilp_ = num_vertices_threshold_ilp;
 
+  // label propagation threshold
+  num_vertices_threshold_lp_ = num_vertices_threshold_lp;
+
   // global net threshold
   global_net_threshold_ = global_net_threshold;
 }
 
+std::map<std::string, double> TritonPart::GetFineTuneParams() const
+{
+  return {{"thr_coarsen_hyperedge_size_skip", thr_coarsen_hyperedge_size_skip_},
+          {"thr_coarsen_vertices", thr_coarsen_vertices_},
+          {"thr_coarsen_hyperedges", thr_coarsen_hyperedges_},
+          {"coarsening_ratio", coarsening_ratio_},
+          {"max_coarsen_iters", max_coarsen_iters_},
+          {"adj_diff_ratio", adj_diff_ratio_},
+          {"min_num_vertices_each_part", min_num_vertices_each_part_},
+          {"num_initial_solutions", num_initial_solutions_},
+          {"num_best_initial_solutions", num_best_initial_solutions_},
+          {"refiner_iters", refiner_iters_},
+          {"max_moves", max_moves_},
+          {"early_stop_ratio", early_stop_ratio_},
+          {"total_corking_passes", total_corking_passes_},
+          {"v_cycle_flag", v_cycle_flag_ ? 1 : 0},
+          {"max_num_vcycle", max_num_vcycle_},
+          {"num_coarsen_solutions", num_coarsen_solutions_},
+          {"num_vertices_threshold_ilp", num_vertices_threshold_ilp_},
+          {"num_vertices_threshold_lp", num_vertices_threshold_lp_},
+          {"global_net_threshold", global_net_threshold_}};
+}
+
 // The function for partitioning a hypergraph
 // This is used for replacing hMETIS
 // Key supports:
@@ -306,6 +478,36 @@ void TritonPart::PartitionHypergraph(unsigned int num_parts_arg,
   logger_->report("Exiting TritonPart");
 }
 
+std::vector<int> TritonPart::PartitionHypergraph(HGraphPtr hypergraph,
+                                                 unsigned int num_parts,
+                                                 float balance_constraint,
+                                                 unsigned int seed)
+{
+  num_parts_ = num_parts;
+  ub_factor_ = balance_constraint;
+  seed_ = seed;
+  vertex_dimensions_ = hypergraph->GetVertexDimensions();
+  hyperedge_dimensions_ = hypergraph->GetHyperedgeDimensions();
+  placement_dimensions_ = hypergraph->GetPlacementDimensions();
+  timing_aware_flag_ = false;
+  group_attr_.clear();
+  original_hypergraph_ = std::move(hypergraph);
+  srand(seed_);
+  MultiLevelPartition();
+  return solution_;
+}
+
+HGraphPtr TritonPart::ReadHypergraphFile(const std::string& hypergraph_file,
+                                         int vertex_dimension,
+                                         int hyperedge_dimension)
+{
+  vertex_dimensions_ = vertex_dimension;
+  hyperedge_dimensions_ = hyperedge_dimension;
+  placement_dimensions_ = 0;
+  ReadHypergraph(hypergraph_file, "", "", "", "");
+  return original_hypergraph_;
+}
+
 void TritonPart::RefineHypergraphPartition(unsigned int num_parts_arg,
                                      float balance_constraint_arg,
                                      std::vector<float> base_balance_arg,
@@ -523,79 +725,346 @@ void TritonPart::PartitionDesign(unsigned int num_parts_arg,
   // but the evaluation is the original_hypergraph_
   MultiLevelPartition();
 
-  // Write out the solution.
-  // Format 1: write the clustered netlist in verilog directly
-  for (auto term : block_->getBTerms()) {
-    auto vertex_id_property = odb::dbIntProperty::find(term, "vertex_id");
-    const int vertex_id = vertex_id_property->getValue();
-    if (vertex_id == -1) {
-      continue;  // This instance is not used
-    }
-    const int partition_id = solution_[vertex_id];
-    if (auto property = odb::dbIntProperty::find(term, "partition_id")) {
-      property->setValue(partition_id);
-    } else {
-      odb::dbIntProperty::create(term, "partition_id", partition_id);
+  // Write out the solution
+  WriteDesignSolution(solution_file);
+
+  // record the netlist changes for the incremental re-partitioning
+  eco_recorder_.Clear();
+  if (!eco_recorder_.hasOwner()) {
+    eco_recorder_.addOwner(block_);
+  }
+
+  logger_->report("===============================================");
+  logger_->report("Exiting TritonPart");
+}
+
+// Incremental re-partitioning for small netlist ECOs.
+// The hypergraph and solution_ of the previous PartitionDesign call are
+// patched in place, then only the vertices around the touched vertices
+// are refined.
+void TritonPart::PartitionDesignEco(const NetlistEco& eco,
+                                    const char* solution_filename_arg)
+{
+  if (original_hypergraph_ == nullptr || solution_.empty()) {
+    logger_->error(PAR,
+                   2524,
+                   "There is no previous partitioning solution. Please "
+                   "run triton_part_design first.");
+  }
+  auto start_time_stamp_global = std::chrono::high_resolution_clock::now();
+  logger_->report("========================================");
+  logger_->report("[STATUS] Starting TritonPart ECO Partitioner");
+  logger_->report("========================================");
+  const std::string solution_file = solution_filename_arg;
+  const int num_vertices = original_hypergraph_->GetNumVertices();
+  const int num_hyperedges = original_hypergraph_->GetNumHyperedges();
+
+  // the objects are traversed in the order of ids to be deterministic
+  auto sorted_by_id = [](const auto& objects) {
+    std::vector<typename std::decay_t<decltype(objects)>::value_type> sorted(
+        objects.begin(), objects.end());
+    std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+      return a->getId() < b->getId();
+    });
+    return sorted;
+  };
+
+  std::set<int> touched_vertices;  // the vertices affected by the ECO
+  std::set<int> stale_hyperedges;  // the hyperedges need to be rebuilt
+  std::set<odb::dbNet*> dirty_nets(eco.modified_nets.begin(),
+                                   eco.modified_nets.end());
+  dirty_nets.insert(eco.added_nets.begin(), eco.added_nets.end());
+
+  // Step 1: the removed instances have zero weight and no hyperedges
+  const std::vector<float> zero_weights(vertex_dimensions_, 0.0);
+  for (const int v : eco.removed_vertices) {
+    original_hypergraph_->SetVertexWeights(v, zero_weights);
+    for (const int e : original_hypergraph_->Edges(v)) {
+      stale_hyperedges.insert(e);
     }
   }
 
-  for (auto inst : block_->getInsts()) {
+  // Step 2: update the area of the resized instances
+  for (odb::dbInst* inst : sorted_by_id(eco.resized_insts)) {
     auto vertex_id_property = odb::dbIntProperty::find(inst, "vertex_id");
+    const sta::LibertyCell* liberty_cell = network_->libertyCell(inst);
+    if (vertex_id_property == nullptr || vertex_id_property->getValue() == -1
+        || liberty_cell == nullptr) {
+      continue;
+    }
     const int vertex_id = vertex_id_property->getValue();
-    if (vertex_id == -1) {
-      continue;  // This instance is not used
+    const std::vector<float> vwts(vertex_dimensions_, liberty_cell->area());
+    original_hypergraph_->SetVertexWeights(vertex_id, vwts);
+    touched_vertices.insert(vertex_id);
+  }
+
+  // Step 3: append the added instances
+  std::vector<int> added_vertices;
+  for (odb::dbInst* inst : sorted_by_id(eco.added_insts)) {
+    // -1 means that the instance is not used by the partitioner
+    auto vertex_id_property = odb::dbIntProperty::find(inst, "vertex_id");
+    if (vertex_id_property == nullptr) {
+      vertex_id_property = odb::dbIntProperty::create(inst, "vertex_id", -1);
     }
-    const int partition_id = solution_[vertex_id];
-    if (auto property = odb::dbIntProperty::find(inst, "partition_id")) {
-      property->setValue(partition_id);
-    } else {
-      odb::dbIntProperty::create(inst, "partition_id", partition_id);
+    const sta::LibertyCell* liberty_cell = network_->libertyCell(inst);
+    if (liberty_cell == nullptr) {
+      continue;  // ignore the instance with no liberty
+    }
+    odb::dbMaster* master = inst->getMaster();
+    // check if the instance is a pad or a cover macro
+    if (master->isPad() || master->isCover()) {
+      continue;
+    }
+    odb::dbBox* box = inst->getBBox();
+    if (fence_flag_ == true
+        && (box->xMin() < fence_.lx || box->xMax() > fence_.ux
+            || box->yMin() < fence_.ly || box->yMax() > fence_.uy)) {
+      continue;  // the instance is outside the fence
+    }
+    VertexType vertex_type = COMB_STD_CELL;
+    if (master->isBlock()) {
+      vertex_type = MACRO;
+    } else if (liberty_cell->hasSequentials()) {
+      vertex_type = SEQ_STD_CELL;
+    }
+    const std::vector<float> vwts(vertex_dimensions_, liberty_cell->area());
+    std::vector<float> loc;
+    if (placement_flag_ == true) {
+      loc = {(box->xMin() + box->xMax()) / 2.0f,
+             (box->yMin() + box->yMax()) / 2.0f};
+    }
+    const int vertex_id
+        = original_hypergraph_->AddVertex(vwts, vertex_type, loc);
+    vertex_id_property->setValue(vertex_id);
+    vertex_types_.push_back(vertex_type);
+    added_vertices.push_back(vertex_id);
+    touched_vertices.insert(vertex_id);
+    solution_.push_back(-1);  // assigned after updating the hyperedges
+    for (odb::dbITerm* iterm : inst->getITerms()) {
+      if (iterm->getNet() != nullptr) {
+        dirty_nets.insert(iterm->getNet());
+      }
     }
   }
 
-  // Format 2: write the explicit solution
-  // each line :  instance_name  partition_id
-  if (!solution_file.empty()) {
-    std::string solution_file_name = solution_file;
-    if (fence_flag_ == true) {
-      // if the fence_flag_ is set to true, we need to update the solution file
-      // to reflect the fence
-      std::stringstream str_ss;
-      str_ss.setf(std::ios::fixed);
-      str_ss.precision(3);
-      str_ss << ".lx_" << fence_.lx / dbu;
-      str_ss << ".ly_" << fence_.ly / dbu;
-      str_ss << ".ux_" << fence_.ux / dbu;
-      str_ss << ".uy_" << fence_.uy / dbu;
-      solution_file_name = solution_file_name + str_ss.str();
+  // Step 4: rebuild the hyperedges of the removed, modified and added nets
+  std::map<int, std::vector<int>> hyperedge_updates;
+  std::map<int, float> hyperedge_slack_updates;
+  auto update_hyperedge = [&](int hyperedge_id, odb::dbNet* net) {
+    std::vector<int> hyperedge;
+    if (net != nullptr) {
+      hyperedge = GetNetVertices(net);
     }
-    logger_->info(
-        PAR, 110, "Updated solution file name = {}", solution_file_name);
-    std::ofstream file_output;
-    file_output.open(solution_file_name);
-
-    for (auto term : block_->getBTerms()) {
-      if (auto property = odb::dbIntProperty::find(term, "partition_id")) {
-        file_output << term->getName() << "  ";
-        file_output << property->getValue() << "  ";
-        file_output << std::endl;
+    if (hyperedge.size() <= 1) {
+      hyperedge.clear();  // ignore all the single-vertex hyperedges
+    }
+    if (hyperedge_id == -1) {
+      if (hyperedge.empty()) {
+        return;
+      }
+      hyperedge_id = static_cast<int>(hyperedge_nets_.size());
+      hyperedge_nets_.push_back(net);
+      odb::dbIntProperty::find(net, "hyperedge_id")->setValue(hyperedge_id);
+    }
+    if (timing_aware_flag_ == true && net != nullptr) {
+      bool unconstrained = false;
+      hyperedge_slack_updates[hyperedge_id] = GetNetSlack(net, unconstrained);
+    }
+    if (hyperedge_id < num_hyperedges) {
+      for (const int v : original_hypergraph_->Vertices(hyperedge_id)) {
+        touched_vertices.insert(v);
       }
     }
+    touched_vertices.insert(hyperedge.begin(), hyperedge.end());
+    hyperedge_updates[hyperedge_id] = std::move(hyperedge);
+  };
 
-    for (auto inst : block_->getInsts()) {
-      if (auto property = odb::dbIntProperty::find(inst, "partition_id")) {
-        file_output << inst->getName() << "  ";
-        file_output << property->getValue() << "  ";
-        file_output << std::endl;
+  for (const int e : eco.removed_hyperedges) {
+    hyperedge_nets_[e] = nullptr;  // the net has been destroyed
+    update_hyperedge(e, nullptr);
+  }
+  for (odb::dbNet* net : sorted_by_id(dirty_nets)) {
+    // ignore all the power net
+    if (net->getSigType().isSupply()) {
+      continue;
+    }
+    auto hyperedge_id_property = odb::dbIntProperty::find(net, "hyperedge_id");
+    if (hyperedge_id_property == nullptr) {
+      hyperedge_id_property
+          = odb::dbIntProperty::create(net, "hyperedge_id", -1);
+    }
+    update_hyperedge(hyperedge_id_property->getValue(), net);
+  }
+  for (const int e : stale_hyperedges) {
+    if (hyperedge_updates.find(e) == hyperedge_updates.end()) {
+      update_hyperedge(e, hyperedge_nets_[e]);
+    }
+  }
+  original_hypergraph_->UpdateHyperedges(hyperedge_updates,
+                                         hyperedge_slack_updates);
+  num_vertices_ = original_hypergraph_->GetNumVertices();
+  num_hyperedges_ = original_hypergraph_->GetNumHyperedges();
+
+  // Step 5: assign each added vertex to the block most connected to it.
+  // Break ties by choosing the lightest block.
+  std::vector<float> block_weights(num_parts_, 0.0);
+  for (int v = 0; v < num_vertices; v++) {
+    const auto vwts = original_hypergraph_->GetVertexWeights(v);
+    block_weights[solution_[v]]
+        += std::accumulate(vwts.begin(), vwts.end(), 0.0f);
+  }
+  for (const int v : added_vertices) {
+    std::vector<float> connectivity(num_parts_, 0.0);
+    for (const int e : original_hypergraph_->Edges(v)) {
+      for (const int u : original_hypergraph_->Vertices(e)) {
+        if (solution_[u] > -1) {
+          connectivity[solution_[u]] += 1.0;
+        }
       }
     }
-    file_output.close();
+    int best_part = 0;
+    for (int part_id = 1; part_id < num_parts_; part_id++) {
+      if (connectivity[part_id] > connectivity[best_part]
+          || (connectivity[part_id] == connectivity[best_part]
+              && block_weights[part_id] < block_weights[best_part])) {
+        best_part = part_id;
+      }
+    }
+    solution_[v] = best_part;
+    const auto vwts = original_hypergraph_->GetVertexWeights(v);
+    block_weights[best_part]
+        += std::accumulate(vwts.begin(), vwts.end(), 0.0f);
+  }
+
+  // Step 6: only the touched vertices and their neighbors can be moved.
+  // The removed vertices and the grouped vertices stay where they are.
+  std::vector<bool> active_vertices(num_vertices_, false);
+  for (const int v : touched_vertices) {
+    active_vertices[v] = true;
+    for (const int e : original_hypergraph_->Edges(v)) {
+      for (const int u : original_hypergraph_->Vertices(e)) {
+        active_vertices[u] = true;
+      }
+    }
+  }
+  for (const int v : eco.removed_vertices) {
+    active_vertices[v] = false;
+  }
+  for (const auto& group : group_attr_) {
+    for (const int v : group) {
+      active_vertices[v] = false;
+    }
+  }
+  const int num_active_vertices
+      = std::count(active_vertices.begin(), active_vertices.end(), true);
+  logger_->info(PAR,
+                183,
+                "ECO : {} added vertices, {} removed vertices, {} updated "
+                "hyperedges, {} active vertices",
+                added_vertices.size(),
+                eco.removed_vertices.size(),
+                hyperedge_updates.size(),
+                num_active_vertices);
+
+  // Step 7: localized refinement
+  auto tritonpart_evaluator
+      = std::make_shared<GoldenEvaluator>(num_parts_,
+                                          // weight vectors
+                                          e_wt_factors_,
+                                          v_wt_factors_,
+                                          placement_wt_factors_,
+                                          // timing related weight
+                                          net_timing_factor_,
+                                          path_timing_factor_,
+                                          path_snaking_factor_,
+                                          timing_exp_factor_,
+                                          extra_delay_,
+                                          original_hypergraph_,
+                                          logger_);
+
+  Matrix<float> upper_block_balance
+      = original_hypergraph_->GetUpperVertexBalance(
+          num_parts_, ub_factor_, base_balance_);
+
+  Matrix<float> lower_block_balance
+      = original_hypergraph_->GetLowerVertexBalance(
+          num_parts_, ub_factor_, base_balance_);
+
+  if (timing_aware_flag_ == true) {
+    // Initialize the timing on original_hypergraph_
+    tritonpart_evaluator->InitializeTiming(original_hypergraph_);
+  }
+
+  if (num_active_vertices > 0) {
+    auto greedy_refiner = std::make_shared<GreedyRefine>(num_parts_,
+                                                         refiner_iters_,
+                                                         path_timing_factor_,
+                                                         path_snaking_factor_,
+                                                         max_moves_,
+                                                         tritonpart_evaluator,
+                                                         logger_);
+    auto k_way_fm_refiner
+        = std::make_shared<KWayFMRefine>(num_parts_,
+                                         refiner_iters_,
+                                         path_timing_factor_,
+                                         path_snaking_factor_,
+                                         max_moves_,
+                                         total_corking_passes_,
+                                         tritonpart_evaluator,
+                                         logger_);
+    // Only the FM refiner has parallel loops (its per-block gain bucket
+    // updates). The greedy pass applies each hyperedge move before
+    // evaluating the next one, so it has no independent work to share.
+    auto thread_pool = std::make_shared<ThreadPool>(num_threads_);
+    k_way_fm_refiner->SetThreadPool(thread_pool);
+    greedy_refiner->SetActiveVertices(active_vertices);
+    k_way_fm_refiner->SetActiveVertices(std::move(active_vertices));
+    greedy_refiner->Refine(original_hypergraph_,
+                           upper_block_balance,
+                           lower_block_balance,
+                           solution_);
+    k_way_fm_refiner->Refine(original_hypergraph_,
+                             upper_block_balance,
+                             lower_block_balance,
+                             solution_);
   }
 
+  // evaluate on the original hypergraph
+  tritonpart_evaluator->ConstraintAndCutEvaluator(original_hypergraph_,
+                                                  solution_,
+                                                  ub_factor_,
+                                                  base_balance_,
+                                                  group_attr_,
+                                                  true);
+
+  // print the runtime
+  auto end_timestamp_global = std::chrono::high_resolution_clock::now();
+  double total_global_time
+      = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end_timestamp_global - start_time_stamp_global)
+            .count();
+  total_global_time *= 1e-9;
+  logger_->info(PAR,
+                184,
+                "The runtime of ECO partitioner : {} seconds",
+                total_global_time);
+
+  // Write out the solution
+  WriteDesignSolution(solution_file);
+
   logger_->report("===============================================");
   logger_->report("Exiting TritonPart");
 }
 
+void TritonPart::PartitionDesignEco(const char* solution_filename_arg)
+{
+  // copy the recorded changes since the partitioner may modify the netlist
+  // (e.g., creating the properties)
+  const NetlistEco eco = eco_recorder_.GetEco();
+  eco_recorder_.Clear();
+  PartitionDesignEco(eco, solution_filename_arg);
+}
+
 void TritonPart::EvaluateHypergraphSolution(unsigned int num_parts_arg,
                                             float balance_constraint_arg,
                                             std::vector<float> base_balance_arg,
@@ -1102,98 +1571,159 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
                                 const std::string& group_file,
                                 const std::string& placement_file)
 {
-  // read hypergraph file
-  std::ifstream hypergraph_file_input(hypergraph_file);
-  if (!hypergraph_file_input.is_open()) {
-    logger_->error(PAR,
-                   2500,
-                   "Can not open the input hypergraph file : {}",
-                   hypergraph_file);
-  }
-  // Check the number of vertices, number of hyperedges, weight flag
-  std::string cur_line;
-  std::getline(hypergraph_file_input, cur_line);
-  std::istringstream cur_line_buf(cur_line);
-  std::vector<int> stats{std::istream_iterator<int>(cur_line_buf),
-                         std::istream_iterator<int>()};
-  num_hyperedges_ = stats[0];
-  num_vertices_ = stats[1];
-  bool hyperedge_weight_flag = false;
-  bool vertex_weight_flag = false;
-  if (stats.size() == 3) {
-    if ((stats[2] % 10) == 1) {
-      hyperedge_weight_flag = true;
-    }
-    if (stats[2] >= 10) {
-      vertex_weight_flag = true;
-    }
-  }
+  // The hypergraph is read directly into the CSR representation
+  // and the flat weight arrays (see Hypergraph)
+  std::vector<int> eptr;
+  std::vector<int> eind;
+  std::vector<float> vertex_weights;
+  std::vector<float> hyperedge_weights;
+  std::vector<float> placement_attr;
 
   // clear the related vectors
   hyperedges_.clear();
   hyperedge_weights_.clear();
   vertex_weights_.clear();
-  hyperedges_.reserve(num_hyperedges_);
-  hyperedge_weights_.reserve(num_hyperedges_);
-  vertex_weights_.reserve(num_vertices_);
-
-  // Read hyperedge information
-  for (int i = 0; i < num_hyperedges_; i++) {
-    std::getline(hypergraph_file_input, cur_line);
-    if (hyperedge_weight_flag == true) {
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<float> hvec{std::istream_iterator<float>(cur_line_buf),
-                              std::istream_iterator<float>()};
-      std::vector<float>::iterator breakpoint{hvec.begin()
-                                              + hyperedge_dimensions_};
-      // read first hyperedge_dimensions_ elements as hyperege weights
-      std::vector<float> hwts(hvec.begin(), breakpoint);
-      // read remaining elements as hyperedge
-      std::vector<int> hyperedge(breakpoint, hvec.end());
-      for (auto& value : hyperedge) {
-        value--;  // the vertex id starts from 1 in the hypergraph file
-      }
-      hyperedge_weights_.push_back(hwts);
-      hyperedges_.push_back(hyperedge);
+  fixed_attr_.clear();
+  community_attr_.clear();
+  placement_attr_.clear();
+
+  if (IsBinaryHypergraphFile(hypergraph_file)) {
+    // read the binary hypergraph file (no parsing)
+    BinaryHypergraph binary_hgraph;
+    ReadBinaryHypergraph(hypergraph_file, binary_hgraph, logger_);
+    num_hyperedges_ = binary_hgraph.num_hyperedges;
+    num_vertices_ = binary_hgraph.num_vertices;
+    if (binary_hgraph.hyperedge_dimensions == 0) {
+      // each dimension has the same weight
+      hyperedge_weights.resize(
+          static_cast<size_t>(num_hyperedges_) * hyperedge_dimensions_, 1.0);
+    } else if (binary_hgraph.hyperedge_dimensions == hyperedge_dimensions_) {
+      hyperedge_weights = std::move(binary_hgraph.hyperedge_weights);
     } else {
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<int> hyperedge{std::istream_iterator<int>(cur_line_buf),
-                                 std::istream_iterator<int>()};
+      logger_->error(PAR,
+                     2521,
+                     "The hyperedge dimensions of {} is {}, expected {}",
+                     hypergraph_file,
+                     binary_hgraph.hyperedge_dimensions,
+                     hyperedge_dimensions_);
+    }
+    if (binary_hgraph.vertex_dimensions == 0) {
+      vertex_weights.resize(
+          static_cast<size_t>(num_vertices_) * vertex_dimensions_, 1.0);
+    } else if (binary_hgraph.vertex_dimensions == vertex_dimensions_) {
+      vertex_weights = std::move(binary_hgraph.vertex_weights);
+    } else {
+      logger_->error(PAR,
+                     2522,
+                     "The vertex dimensions of {} is {}, expected {}",
+                     hypergraph_file,
+                     binary_hgraph.vertex_dimensions,
+                     vertex_dimensions_);
+    }
+    eptr = std::move(binary_hgraph.eptr);
+    eind = std::move(binary_hgraph.eind);
+    // the attributes stored in the binary file can be overridden
+    // by the fixed file, community file and placement file
+    fixed_attr_ = std::move(binary_hgraph.fixed_attr);
+    community_attr_ = std::move(binary_hgraph.community_attr);
+    if (binary_hgraph.placement_dimensions == placement_dimensions_) {
+      placement_attr = std::move(binary_hgraph.placement_attr);
+    } else if (binary_hgraph.placement_dimensions > 0) {
+      logger_->warn(PAR,
+                    187,
+                    "The binary hypergraph has {} placement dimensions, "
+                    "expected {}. Reset the placement attributes to NONE.",
+                    binary_hgraph.placement_dimensions,
+                    placement_dimensions_);
+    }
+  } else {
+    // read hypergraph file
+    std::string content;
+    if (!ReadWholeFile(hypergraph_file, content)) {
+      logger_->error(PAR,
+                     2500,
+                     "Can not open the input hypergraph file : {}",
+                     hypergraph_file);
+    }
+    std::string_view text(content);
+    std::string_view cur_line;
+    // Check the number of vertices, number of hyperedges, weight flag
+    PopLine(text, cur_line);
+    std::vector<int> stats;
+    ParseNumbers(cur_line, stats);
+    if (stats.size() < 2) {
+      logger_->error(PAR,
+                     2520,
+                     "Invalid header in the input hypergraph file : {}",
+                     hypergraph_file);
+    }
+    num_hyperedges_ = stats[0];
+    num_vertices_ = stats[1];
+    bool hyperedge_weight_flag = false;
+    bool vertex_weight_flag = false;
+    if (stats.size() == 3) {
+      if ((stats[2] % 10) == 1) {
+        hyperedge_weight_flag = true;
+      }
+      if (stats[2] >= 10) {
+        vertex_weight_flag = true;
+      }
+    }
+
+    eptr.reserve(num_hyperedges_ + 1);
+    eptr.push_back(0);
+    hyperedge_weights.reserve(static_cast<size_t>(num_hyperedges_)
+                              * hyperedge_dimensions_);
+    vertex_weights.reserve(static_cast<size_t>(num_vertices_)
+                           * vertex_dimensions_);
+
+    // Read hyperedge information
+    std::vector<int> hyperedge;
+    for (int i = 0; i < num_hyperedges_; i++) {
+      PopLine(text, cur_line);
+      hyperedge.clear();
+      if (hyperedge_weight_flag == true) {
+        // read first hyperedge_dimensions_ elements as hyperege weights
+        const size_t breakpoint = ParseNumbers(
+            cur_line, hyperedge_weights, hyperedge_dimensions_);
+        // read remaining elements as hyperedge
+        ParseNumbers(cur_line.substr(breakpoint), hyperedge);
+      } else {
+        ParseNumbers(cur_line, hyperedge);
+        // each dimension has the same weight
+        hyperedge_weights.insert(
+            hyperedge_weights.end(), hyperedge_dimensions_, 1.0);
+      }
       for (auto& value : hyperedge) {
         value--;  // the vertex id starts from 1 in the hypergraph file
       }
-      std::vector<float> hwts(hyperedge_dimensions_,
-                              1.0);  // each dimension has the same weight
-      hyperedge_weights_.push_back(hwts);
-      hyperedges_.push_back(hyperedge);
+      eind.insert(eind.end(), hyperedge.begin(), hyperedge.end());
+      eptr.push_back(static_cast<int>(eind.size()));
     }
-  }
 
-  // Read weight for vertices
-  for (int i = 0; i < num_vertices_; i++) {
-    if (vertex_weight_flag == true) {
-      std::getline(hypergraph_file_input, cur_line);
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<float> vwts{std::istream_iterator<float>(cur_line_buf),
-                              std::istream_iterator<float>()};
-      vertex_weights_.push_back(vwts);
-    } else {
-      std::vector<float> vwts(vertex_dimensions_, 1.0);
-      vertex_weights_.push_back(vwts);
+    // Read weight for vertices
+    std::vector<float> vwts;
+    for (int i = 0; i < num_vertices_; i++) {
+      if (vertex_weight_flag == true) {
+        PopLine(text, cur_line);
+        vwts.clear();
+        ParseNumbers(cur_line, vwts);
+        vwts.resize(vertex_dimensions_, 1.0);
+        vertex_weights.insert(vertex_weights.end(), vwts.begin(), vwts.end());
+      } else {
+        vertex_weights.insert(vertex_weights.end(), vertex_dimensions_, 1.0);
+      }
     }
   }
 
   // Read fixed vertices
   if (!fixed_file.empty()) {
-    int part_id = -1;
-    std::ifstream fixed_file_input(fixed_file);
-    if (!fixed_file_input.is_open()) {
+    std::string content;
+    if (!ReadWholeFile(fixed_file, content)) {
       logger_->error(PAR, 2501, "Can not open the fixed file : {}", fixed_file);
     }
-    while (fixed_file_input >> part_id) {
-      fixed_attr_.push_back(part_id);
-    }
-    fixed_file_input.close();
+    fixed_attr_.clear();
+    ParseNumbers(content, fixed_attr_);
     if (static_cast<int>(fixed_attr_.size()) != num_vertices_) {
       logger_->warn(PAR, 129, "Reset the fixed attributes to NONE.");
       fixed_attr_.clear();
@@ -1202,16 +1732,13 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
 
   // Read community file
   if (!community_file.empty()) {
-    int part_id = -1;
-    std::ifstream community_file_input(community_file);
-    if (!community_file_input.is_open()) {
+    std::string content;
+    if (!ReadWholeFile(community_file, content)) {
       logger_->error(
           PAR, 2502, "Can not open the community file : {}", community_file);
     }
-    while (community_file_input >> part_id) {
-      community_attr_.push_back(part_id);
-    }
-    community_file_input.close();
+    community_attr_.clear();
+    ParseNumbers(content, community_attr_);
     if (static_cast<int>(community_attr_.size()) != num_vertices_) {
       logger_->warn(PAR, 130, "Reset the community attributes to NONE.");
       community_attr_.clear();
@@ -1220,16 +1747,16 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
 
   // read group file
   if (!group_file.empty()) {
-    std::ifstream group_file_input(group_file);
-    if (!group_file_input.is_open()) {
+    std::string content;
+    if (!ReadWholeFile(group_file, content)) {
       logger_->error(PAR, 2503, "Can not open the group file : {}", group_file);
     }
     group_attr_.clear();
-    std::string cur_line;
-    while (std::getline(group_file_input, cur_line)) {
-      std::istringstream cur_line_buf(cur_line);
-      std::vector<int> group_info{std::istream_iterator<int>(cur_line_buf),
-                                  std::istream_iterator<int>()};
+    std::string_view text(content);
+    std::string_view cur_line;
+    while (PopLine(text, cur_line)) {
+      std::vector<int> group_info;
+      ParseNumbers(cur_line, group_info);
       // reduce by 1 because definition of hMETIS
       for (auto& value : group_info) {
         value--;
@@ -1238,17 +1765,15 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
         group_attr_.push_back(group_info);
       }
     }
-    group_file_input.close();
   }
 
   // Read placement file
   if (!placement_file.empty()) {
-    std::ifstream placement_file_input(placement_file);
-    if (!placement_file_input.is_open()) {
+    std::string content;
+    if (!ReadWholeFile(placement_file, content)) {
       logger_->error(
           PAR, 2504, "Can not open the placement file : {}", placement_file);
     }
-    std::string cur_line;
     // We assume the embedding has been normalized
     const float max_placement_value
         = 1.0;  // we assume the embedding has been normalized,
@@ -1258,28 +1783,22 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
           / 2.0;  // The threshold
                   // for detecting invalid placement value. If the abs(emb) is
                   // larger than invalid_placement_thr, we think the placement
-                  // is invalid
+                  // is invalid (NaN is also invalid)
     const float default_placement_value = 0.0;  // default placement value
     std::vector<std::vector<float>> temp_placement_attr;
-    while (std::getline(placement_file_input, cur_line)) {
-      std::vector<std::string> elements = SplitLine(
-          cur_line);  // split the line based on deliminator empty space, ','
+    std::string_view text(content);
+    std::string_view cur_line;
+    while (PopLine(text, cur_line)) {
       std::vector<float> vertex_placement;
-      for (auto& ele : elements) {
-        if (ele == "NaN" || ele == "nan" || ele == "NAN") {
-          vertex_placement.push_back(default_placement_value);
-        } else {
-          const float ele_value = std::stof(ele);
-          if (std::abs(ele_value) < invalid_placement_thr) {
-            vertex_placement.push_back(std::stof(ele));
-          } else {
-            vertex_placement.push_back(default_placement_value);
-          }
+      // split the line based on deliminator empty space, ','
+      ParseNumbers(cur_line, vertex_placement);
+      for (auto& value : vertex_placement) {
+        if (!(std::abs(value) < invalid_placement_thr)) {
+          value = default_placement_value;
         }
       }
       temp_placement_attr.push_back(vertex_placement);
     }
-    placement_file_input.close();
     // Here comes the very important part for placement-driven clustering
     // Since we have so many vertices, the embedding value for each single
     // vertex usually very small, around e-5 - e-7 So we need to normalize the
@@ -1303,19 +1822,25 @@ void TritonPart::ReadHypergraph(const std::string& hypergraph_file,
       logger_->warn(PAR, 132, "Reset the placement attributes to NONE.");
       placement_attr_.clear();
     }
+    placement_attr.clear();
+    for (const auto& emb : placement_attr_) {
+      placement_attr.insert(placement_attr.end(), emb.begin(), emb.end());
+    }
   }
 
   // Build the original hypergraph first
-  original_hypergraph_ = std::make_shared<Hypergraph>(vertex_dimensions_,
-                                                      hyperedge_dimensions_,
-                                                      placement_dimensions_,
-                                                      hyperedges_,
-                                                      vertex_weights_,
-                                                      hyperedge_weights_,
-                                                      fixed_attr_,
-                                                      community_attr_,
-                                                      placement_attr_,
-                                                      logger_);
+  original_hypergraph_
+      = std::make_shared<Hypergraph>(vertex_dimensions_,
+                                     hyperedge_dimensions_,
+                                     placement_dimensions_,
+                                     std::move(eptr),
+                                     std::move(eind),
+                                     std::move(vertex_weights),
+                                     std::move(hyperedge_weights),
+                                     fixed_attr_,
+                                     community_attr_,
+                                     std::move(placement_attr),
+                                     logger_);
 
   // show the status of hypergraph
   logger_->info(PAR, 171, "Hypergraph Information**");
@@ -1536,6 +2061,7 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
   // because we need to consider timing graph
   hyperedges_.clear();
   hyperedge_weights_.clear();
+  hyperedge_nets_.clear();
   // Each net correponds to an hyperedge
   // Traverse the hyperedge and assign hyperedge_id to each net
   // the hyperedge_id property will be removed after partitioning
@@ -1547,50 +2073,13 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
       continue;
     }
     // check the hyperedge
-    int driver_id = -1;      // vertex id of the driver instance
-    std::set<int> loads_id;  // vertex id of sink instances
-    // check the connected instances
-    for (odb::dbITerm* iterm : net->getITerms()) {
-      odb::dbInst* inst = iterm->getInst();
-      const int vertex_id
-          = odb::dbIntProperty::find(inst, "vertex_id")->getValue();
-      if (vertex_id == -1) {
-        continue;  // the current instance is not used
-      }
-      if (iterm->getIoType() == odb::dbIoType::OUTPUT) {
-        driver_id = vertex_id;
-      } else {
-        loads_id.insert(vertex_id);
-      }
-    }
-    // check the connected IO pins
-    for (odb::dbBTerm* bterm : net->getBTerms()) {
-      const int vertex_id
-          = odb::dbIntProperty::find(bterm, "vertex_id")->getValue();
-      if (vertex_id == -1) {
-        continue;  // the current bterm is not used
-      }
-      if (bterm->getIoType() == odb::dbIoType::INPUT) {
-        driver_id = vertex_id;
-      } else {
-        loads_id.insert(vertex_id);
-      }
-    }
-    // check the hyperedges
-    std::vector<int> hyperedge;
-    if (driver_id != -1 && !loads_id.empty()) {
-      hyperedge.push_back(driver_id);
-      for (auto& load_id : loads_id) {
-        if (load_id != driver_id) {
-          hyperedge.push_back(load_id);
-        }
-      }
-    }
+    std::vector<int> hyperedge = GetNetVertices(net);
     // Ignore all the single-vertex hyperedge and large global netthreshold
     // if (hyperedge.size() > 1 && hyperedge.size() <= global_net_threshold_) {
     if (hyperedge.size() > 1) {
       hyperedges_.push_back(hyperedge);
       hyperedge_weights_.emplace_back(hyperedge_dimensions_, 1.0);
+      hyperedge_nets_.push_back(net);
       odb::dbIntProperty::find(net, "hyperedge_id")->setValue(hyperedge_id++);
     }
   }  // finish hyperedge
@@ -1637,6 +2126,147 @@ void TritonPart::ReadNetlist(const std::string& fixed_file,
   logger_->info(PAR, 177, "Number of timing paths = {}", timing_paths_.size());
 }
 
+// The vertices connected by the net.
+// The driver is the first vertex, followed by the loads in increasing order.
+// The result is empty if there is no driver or no loads.
+std::vector<int> TritonPart::GetNetVertices(odb::dbNet* net) const
+{
+  int driver_id = -1;      // vertex id of the driver instance
+  std::set<int> loads_id;  // vertex id of sink instances
+  // check the connected instances
+  for (odb::dbITerm* iterm : net->getITerms()) {
+    odb::dbInst* inst = iterm->getInst();
+    auto vertex_id_property = odb::dbIntProperty::find(inst, "vertex_id");
+    if (vertex_id_property == nullptr || vertex_id_property->getValue() == -1) {
+      continue;  // the current instance is not used
+    }
+    const int vertex_id = vertex_id_property->getValue();
+    if (iterm->getIoType() == odb::dbIoType::OUTPUT) {
+      driver_id = vertex_id;
+    } else {
+      loads_id.insert(vertex_id);
+    }
+  }
+  // check the connected IO pins
+  for (odb::dbBTerm* bterm : net->getBTerms()) {
+    auto vertex_id_property = odb::dbIntProperty::find(bterm, "vertex_id");
+    if (vertex_id_property == nullptr || vertex_id_property->getValue() == -1) {
+      continue;  // the current bterm is not used
+    }
+    const int vertex_id = vertex_id_property->getValue();
+    if (bterm->getIoType() == odb::dbIoType::INPUT) {
+      driver_id = vertex_id;
+    } else {
+      loads_id.insert(vertex_id);
+    }
+  }
+  // check the hyperedges
+  std::vector<int> hyperedge;
+  if (driver_id != -1 && !loads_id.empty()) {
+    hyperedge.push_back(driver_id);
+    for (auto& load_id : loads_id) {
+      if (load_id != driver_id) {
+        hyperedge.push_back(load_id);
+      }
+    }
+  }
+  return hyperedge;
+}
+
+// The slack of the net normalized by the maximum clock period.
+// The slack of unconstrained net is set to 1.0.
+float TritonPart::GetNetSlack(odb::dbNet* db_net, bool& unconstrained) const
+{
+  sta::Net* net = network_->dbToSta(db_net);
+  return NormalizeNetSlack(sta_->netSlack(net, sta::MinMax::max()),
+                           unconstrained);
+}
+
+// Normalize the slack of a net by the maximum clock period
+float TritonPart::NormalizeNetSlack(float slack, bool& unconstrained) const
+{
+  unconstrained = slack > maximum_clock_period_;
+  if (unconstrained) {
+    return 1.0;
+  }
+  if (guardband_flag_ == false) {
+    return slack / maximum_clock_period_;
+  }
+  return slack / maximum_clock_period_ - extra_delay_;
+}
+
+// Write the solution_ of design partitioning
+// Format 1: the partition_id property of each instance and IO port
+// Format 2: the explicit solution file (instance_name  partition_id)
+void TritonPart::WriteDesignSolution(const std::string& solution_file)
+{
+  const int dbu = db_->getTech()->getDbUnitsPerMicron();
+  for (auto term : block_->getBTerms()) {
+    auto vertex_id_property = odb::dbIntProperty::find(term, "vertex_id");
+    if (vertex_id_property == nullptr || vertex_id_property->getValue() == -1) {
+      continue;  // This instance is not used
+    }
+    const int partition_id = solution_[vertex_id_property->getValue()];
+    if (auto property = odb::dbIntProperty::find(term, "partition_id")) {
+      property->setValue(partition_id);
+    } else {
+      odb::dbIntProperty::create(term, "partition_id", partition_id);
+    }
+  }
+
+  for (auto inst : block_->getInsts()) {
+    auto vertex_id_property = odb::dbIntProperty::find(inst, "vertex_id");
+    if (vertex_id_property == nullptr || vertex_id_property->getValue() == -1) {
+      continue;  // This instance is not used
+    }
+    const int partition_id = solution_[vertex_id_property->getValue()];
+    if (auto property = odb::dbIntProperty::find(inst, "partition_id")) {
+      property->setValue(partition_id);
+    } else {
+      odb::dbIntProperty::create(inst, "partition_id", partition_id);
+    }
+  }
+
+  // Format 2: write the explicit solution
+  // each line :  instance_name  partition_id
+  if (!solution_file.empty()) {
+    std::string solution_file_name = solution_file;
+    if (fence_flag_ == true) {
+      // if the fence_flag_ is set to true, we need to update the solution file
+      // to reflect the fence
+      std::stringstream str_ss;
+      str_ss.setf(std::ios::fixed);
+      str_ss.precision(3);
+      str_ss << ".lx_" << fence_.lx / dbu;
+      str_ss << ".ly_" << fence_.ly / dbu;
+      str_ss << ".ux_" << fence_.ux / dbu;
+      str_ss << ".uy_" << fence_.uy / dbu;
+      solution_file_name = solution_file_name + str_ss.str();
+    }
+    logger_->info(
+        PAR, 110, "Updated solution file name = {}", solution_file_name);
+    std::ofstream file_output;
+    file_output.open(solution_file_name);
+
+    for (auto term : block_->getBTerms()) {
+      if (auto property = odb::dbIntProperty::find(term, "partition_id")) {
+        file_output << term->getName() << "  ";
+        file_output << property->getValue() << "  ";
+        file_output << std::endl;
+      }
+    }
+
+    for (auto inst : block_->getInsts()) {
+      if (auto property = odb::dbIntProperty::find(inst, "partition_id")) {
+        file_output << inst->getName() << "  ";
+        file_output << property->getValue() << "  ";
+        file_output << std::endl;
+      }
+    }
+    file_output.close();
+  }
+}
+
 // Find all the critical timing paths
 // The codes below similar to gui/src/staGui.cpp
 // Please refer to sta/Search/ReportPath.cc for how to check the timing path
@@ -1651,7 +2281,99 @@ void TritonPart::BuildTimingPaths()
   sta_->ensureGraph();     // Ensure that the timing graph has been built
   sta_->searchPreamble();  // Make graph and find delays
   sta_->ensureLevelized();
-  // Step 1:  find the top_n critical timing paths
+
+  // the raw slack of each hyperedge
+  std::vector<float> net_slacks(num_hyperedges_);
+  for (int e = 0; e < num_hyperedges_; e++) {
+    sta::Net* net = network_->dbToSta(hyperedge_nets_[e]);
+    net_slacks[e] = sta_->netSlack(net, sta::MinMax::max());
+  }
+
+  // Extract the critical timing paths, or reuse them if neither the netlist
+  // nor any net slack has changed since the previous extraction
+  TimingPathCache::Key key;
+  if (timing_path_cache_ != nullptr) {
+    timing_path_cache_->Track(block_);
+    key.netlist_version = timing_path_cache_->GetNetlistVersion();
+    key.top_n = top_n_;
+    key.num_vertices = num_vertices_;
+    key.num_hyperedges = num_hyperedges_;
+    key.fence_flag = fence_flag_;
+    key.fence = fence_;
+    key.net_slacks = net_slacks;
+  }
+  const TimingPathCache::Entry* entry
+      = timing_path_cache_ == nullptr ? nullptr
+                                      : timing_path_cache_->Find(key);
+  if (entry != nullptr) {
+    logger_->info(
+        PAR, 186, "Reuse {} cached timing paths", entry->timing_paths.size());
+    timing_paths_ = entry->timing_paths;
+    maximum_clock_period_ = entry->maximum_clock_period;
+  } else {
+    ExtractTimingPaths();
+    if (timing_path_cache_ != nullptr) {
+      TimingPathCache::Entry new_entry;
+      new_entry.timing_paths = timing_paths_;
+      new_entry.maximum_clock_period = maximum_clock_period_;
+      timing_path_cache_->Store(key, std::move(new_entry));
+    }
+  }
+
+  // normalize all the slack
+  logger_->info(
+      PAR, 178, "maximum_clock_period : {} second", maximum_clock_period_);
+  extra_delay_ = extra_delay_ / maximum_clock_period_;
+  logger_->info(PAR, 179, "normalized extra delay : {}", extra_delay_);
+  if (guardband_flag_ == false) {
+    for (auto& timing_path : timing_paths_) {
+      timing_path.slack = timing_path.slack / maximum_clock_period_;
+    }
+  } else {
+    for (auto& timing_path : timing_paths_) {
+      timing_path.slack
+          = timing_path.slack / maximum_clock_period_ - extra_delay_;
+    }
+  }
+  logger_->info(PAR,
+                180,
+                "We normalized the slack of each path based on maximum clock "
+                "period");
+  // resize the hyperedge_slacks_
+  hyperedge_slacks_.clear();
+  hyperedge_slacks_.resize(num_hyperedges_);
+  logger_->info(
+      PAR,
+      181,
+      "We normalized the slack of each net based on maximum clock period");
+  int num_unconstrained_hyperedges = 0;
+  // check the slack on each net
+  for (int e = 0; e < num_hyperedges_; e++) {
+    bool unconstrained = false;
+    hyperedge_slacks_[e] = NormalizeNetSlack(net_slacks[e], unconstrained);
+    if (unconstrained) {
+      num_unconstrained_hyperedges++;
+    }
+  }
+  logger_->report("[STATUS] Finish traversing timing graph");
+  if (num_unconstrained_hyperedges > 0) {
+    logger_->warn(PAR,
+                  137,
+                  "{} unconstrained hyperedges !",
+                  num_unconstrained_hyperedges);
+  }
+  logger_->warn(PAR,
+                138,
+                "Reset the slack of all unconstrained hyperedges to {} seconds",
+                maximum_clock_period_);
+}
+
+// Find the top_n_ critical timing paths with OpenSTA and convert them into
+// vertex / hyperedge lists. The slacks are not normalized here.
+void TritonPart::ExtractTimingPaths()
+{
+  timing_paths_.clear();
+  // find the top_n critical timing paths
   sta::ExceptionFrom* e_from = nullptr;
   sta::ExceptionThruSeq* e_thrus = nullptr;
   sta::ExceptionTo* e_to = nullptr;
@@ -1776,69 +2498,6 @@ void TritonPart::BuildTimingPaths()
     }
   }
 
-  // normalize all the slack
-  logger_->info(
-      PAR, 178, "maximum_clock_period : {} second", maximum_clock_period_);
-  extra_delay_ = extra_delay_ / maximum_clock_period_;
-  logger_->info(PAR, 179, "normalized extra delay : {}", extra_delay_);
-  if (guardband_flag_ == false) {
-    for (auto& timing_path : timing_paths_) {
-      timing_path.slack = timing_path.slack / maximum_clock_period_;
-    }
-  } else {
-    for (auto& timing_path : timing_paths_) {
-      timing_path.slack
-          = timing_path.slack / maximum_clock_period_ - extra_delay_;
-    }
-  }
-  logger_->info(PAR,
-                180,
-                "We normalized the slack of each path based on maximum clock "
-                "period");
-  // resize the hyperedge_slacks_
-  hyperedge_slacks_.clear();
-  hyperedge_slacks_.resize(num_hyperedges_);
-  std::fill(hyperedge_slacks_.begin(),
-            hyperedge_slacks_.end(),
-            maximum_clock_period_);
-  logger_->info(
-      PAR,
-      181,
-      "We normalized the slack of each net based on maximum clock period");
-  int num_unconstrained_hyperedges = 0;
-  // check the slack on each net
-  for (auto db_net : block_->getNets()) {
-    const int hyperedge_id
-        = odb::dbIntProperty::find(db_net, "hyperedge_id")->getValue();
-    if (hyperedge_id == -1) {
-      continue;  // this net is not used
-    }
-    sta::Net* net = network_->dbToSta(db_net);
-    const float slack = sta_->netSlack(net, sta::MinMax::max());
-    // set the slack of unconstrained net to max_clock_period_
-    if (slack > maximum_clock_period_) {
-      num_unconstrained_hyperedges++;
-      hyperedge_slacks_[hyperedge_id] = 1.0;
-    } else {
-      if (guardband_flag_ == false) {
-        hyperedge_slacks_[hyperedge_id] = slack / maximum_clock_period_;
-      } else {
-        hyperedge_slacks_[hyperedge_id]
-            = slack / maximum_clock_period_ - extra_delay_;
-      }
-    }
-  }
-  logger_->report("[STATUS] Finish traversing timing graph");
-  if (num_unconstrained_hyperedges > 0) {
-    logger_->warn(PAR,
-                  137,
-                  "{} unconstrained hyperedges !",
-                  num_unconstrained_hyperedges);
-  }
-  logger_->warn(PAR,
-                138,
-                "Reset the slack of all unconstrained hyperedges to {} seconds",
-                maximum_clock_period_);
 }
 
 // Partition the hypergraph_ with the multilevel methodology
@@ -1944,6 +2603,8 @@ void TritonPart::MultiLevelPartition()
   logger_->info(PAR, 100, "num_coarsen_solutions : {}", num_coarsen_solutions_);
   logger_->info(
       PAR, 101, "num_vertices_threshold_ilp : {}", num_vertices_threshold_ilp_);
+  logger_->info(
+      PAR, 185, "num_vertices_threshold_lp : {}", num_vertices_threshold_lp_);
 
   // create the evaluator class
   auto tritonpart_evaluator
@@ -1995,7 +2656,7 @@ void TritonPart::MultiLevelPartition()
       num_parts_, seed_, tritonpart_evaluator, logger_);
 
   // create the refinement classes
-  // We have four types of refiner
+  // We have five types of refiner
   // (1) greedy refinement. try to one entire hyperedge each time
   auto greedy_refiner = std::make_shared<GreedyRefine>(num_parts_,
                                                        refiner_iters_,
@@ -2035,6 +2696,27 @@ void TritonPart::MultiLevelPartition()
                                                          tritonpart_evaluator,
                                                          logger_);
 
+  // (5) parallel label propagation (only for large hypergraphs,
+  // see num_vertices_threshold_lp_)
+  auto label_propagation_refiner
+      = std::make_shared<LabelPropagationRefine>(num_parts_,
+                                                 refiner_iters_,
+                                                 path_timing_factor_,
+                                                 path_snaking_factor_,
+                                                 max_moves_,
+                                                 tritonpart_evaluator,
+                                                 logger_);
+
+  // create the persistent worker pool shared by the multi-level partitioner
+  auto thread_pool = std::make_shared<ThreadPool>(num_threads_);
+  debugPrint(logger_,
+             PAR,
+             "multilevel_partitioning",
+             1,
+             "Number of threads : {}",
+             thread_pool->GetNumThreads());
+  tritonpart_evaluator->SetThreadPool(thread_pool);
+
   // create the multi-level class
   auto tritonpart_mlevel_partitioner
       = std::make_shared<MultilevelPartitioner>(num_parts_,
@@ -2042,6 +2724,7 @@ void TritonPart::MultiLevelPartition()
                                                 num_initial_solutions_,
                                                 num_best_initial_solutions_,
                                                 num_vertices_threshold_ilp_,
+                                                num_vertices_threshold_lp_,
                                                 max_num_vcycle_,
                                                 num_coarsen_solutions_,
                                                 seed_,
@@ -2051,8 +2734,11 @@ void TritonPart::MultiLevelPartition()
                                                 k_way_pm_refiner,
                                                 greedy_refiner,
                                                 ilp_refiner,
+                                                label_propagation_refiner,
                                                 tritonpart_evaluator,
+                                                thread_pool,
                                                 logger_);
+  tritonpart_mlevel_partitioner->SetPhaseTimer(phase_timer_);
 
   if (timing_aware_flag_ == true) {
     // Initialize the timing on original_hypergraph_
@@ -2092,10 +2778,16 @@ void TritonPart::MultiLevelPartition()
     }
   }
 
-  // Perform the last-minute refinement
+  // Perform the last-minute refinement (charged to the v-cycle phase)
   tritonpart_coarsener->SetThrCoarsenHyperedgeSizeSkip(global_net_threshold_);
+  auto vcycle_start = std::chrono::high_resolution_clock::now();
   tritonpart_mlevel_partitioner->VcycleRefinement(
       hypergraph_, upper_block_balance, lower_block_balance, solution_);
+  if (phase_timer_ != nullptr) {
+    const std::chrono::duration<double> vcycle_time
+        = std::chrono::high_resolution_clock::now() - vcycle_start;
+    phase_timer_->Add(PartitionPhase::VCYCLE, vcycle_time.count());
+  }
 
   // evaluate on the original hypergraph
   // tritonpart_evaluator->CutEvaluator(original_hypergraph_, solution_, true);
@@ -2214,6 +2906,8 @@ void TritonPart::Refine()
   logger_->report( "max_num_vcycle : {}", max_num_vcycle_);
   logger_->report( "num_coarsen_solutions : {}", num_coarsen_solutions_);
   logger_->report( "num_vertices_threshold_ilp : {}", num_vertices_threshold_ilp_);
+  logger_->report("num_vertices_threshold_lp : {}",
+                  num_vertices_threshold_lp_);
 
   // create the evaluator class
   auto tritonpart_evaluator
@@ -2249,7 +2943,19 @@ void TritonPart::Refine()
                                                          total_corking_passes_,
                                                          tritonpart_evaluator,
                                                          logger_);
-
+  // parallel label propagation (only for large hypergraphs,
+  // see num_vertices_threshold_lp_)
+  auto label_propagation_refiner
+      = std::make_shared<LabelPropagationRefine>(num_parts_,
+                                                 refiner_iters_,
+                                                 path_timing_factor_,
+                                                 path_snaking_factor_,
+                                                 max_moves_,
+                                                 tritonpart_evaluator,
+                                                 logger_);
+  auto thread_pool = std::make_shared<ThreadPool>(num_threads_);
+  k_way_fm_refiner->SetThreadPool(thread_pool);
+  label_propagation_refiner->SetThreadPool(thread_pool);
 
   if (timing_aware_flag_ == true) {
     // Initialize the timing on original_hypergraph_
@@ -2265,6 +2971,15 @@ void TritonPart::Refine()
                                                   true);
 
   // Perform the refinement
+  // The label propagation removes most of the easy moves in parallel,
+  // same as in MultilevelPartitioner::CallRefiner
+  if (num_vertices_threshold_lp_ > 0
+      && original_hypergraph_->GetNumVertices() >= num_vertices_threshold_lp_) {
+    label_propagation_refiner->Refine(original_hypergraph_,
+                                      upper_block_balance,
+                                      lower_block_balance,
+                                      solution_);
+  }
   k_way_fm_refiner->Refine(original_hypergraph_, upper_block_balance, lower_block_balance, solution_);
 
   // evaluate refined solution
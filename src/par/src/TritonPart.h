@@ -33,10 +33,13 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <queue>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -45,6 +48,7 @@
 #include "db_sta/dbReadVerilog.hh"
 #include "db_sta/dbSta.hh"
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 #include "sta/Bfs.hh"
 #include "sta/Graph.hh"
 #include "sta/Liberty.hh"
@@ -65,6 +69,114 @@ namespace par {
 // Type 2:  Take the input hypergraph as an argument in the same manner as
 //          hMetis.
 
+// The netlist changes (ECO) since the last design partitioning.
+// The removed objects no longer exist in OpenDB,
+// so they are identified by their vertex / hyperedge ids.
+struct NetlistEco
+{
+  std::set<odb::dbInst*> added_insts;
+  std::set<odb::dbInst*> resized_insts;  // the area has been changed
+  std::set<int> removed_vertices;
+  std::set<odb::dbNet*> added_nets;
+  std::set<odb::dbNet*> modified_nets;  // the connections have been changed
+  std::set<int> removed_hyperedges;
+
+  bool Empty() const;
+  void Clear();
+};
+
+// Record the netlist changes through the OpenDB callbacks,
+// e.g., buffering and resizing during timing repair.
+class NetlistEcoRecorder : public odb::dbBlockCallBackObj
+{
+ public:
+  const NetlistEco& GetEco() const { return eco_; }
+  void Clear() { eco_.Clear(); }
+
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
+  void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbNetCreate(odb::dbNet* net) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override;
+
+ private:
+  void ModifyNet(odb::dbNet* net);
+
+  NetlistEco eco_;
+};
+
+// The critical timing paths and net slacks extracted from OpenSTA for
+// design partitioning. Extracting and converting the top_n paths is the
+// most expensive part of reading a timing-aware netlist, so the result is
+// kept across triton_part_design calls. The netlist version is bumped by the
+// OpenDB callbacks on every netlist edit and instance move, and each time the
+// cache attaches to a block, so it also acts as a generation counter: a block
+// destroyed and re-created at the same address never matches an old key.
+// Changes of the constraints or the parasitics do not touch the netlist, so
+// the slack of every hyperedge is part of the key as well: the net slacks
+// are cheap to query once the timing is updated, and any timing change that
+// can alter the paths moves some of them.
+// The slacks are stored before the normalization by the clock period.
+class TimingPathCache : public odb::dbBlockCallBackObj
+{
+ public:
+  struct Key
+  {
+    int64_t netlist_version = -1;
+    int top_n = 0;
+    int num_vertices = 0;
+    int num_hyperedges = 0;
+    bool fence_flag = false;
+    Rect fence{0, 0, 0, 0};
+    std::vector<float> net_slacks;  // the slack of each hyperedge
+
+    bool operator==(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    std::vector<TimingPath> timing_paths;
+    float maximum_clock_period = 0.0;
+  };
+
+  // track the netlist changes of block
+  // (re-attach if the tracked block has been destroyed in the meantime)
+  void Track(odb::dbBlock* block);
+  int64_t GetNetlistVersion() const { return netlist_version_; }
+
+  // the cached entry extracted with the same key (nullptr if none)
+  const Entry* Find(const Key& key) const;
+  void Store(const Key& key, Entry entry);
+
+  void inDbInstCreate(odb::dbInst*) override { netlist_version_++; }
+  void inDbInstCreate(odb::dbInst*, odb::dbRegion*) override
+  {
+    netlist_version_++;
+  }
+  void inDbInstDestroy(odb::dbInst*) override { netlist_version_++; }
+  void inDbInstSwapMasterAfter(odb::dbInst*) override { netlist_version_++; }
+  void inDbPostMoveInst(odb::dbInst*) override { netlist_version_++; }
+  void inDbNetCreate(odb::dbNet*) override { netlist_version_++; }
+  void inDbNetDestroy(odb::dbNet*) override { netlist_version_++; }
+  void inDbITermPostConnect(odb::dbITerm*) override { netlist_version_++; }
+  void inDbITermPreDisconnect(odb::dbITerm*) override { netlist_version_++; }
+  void inDbBTermPostConnect(odb::dbBTerm*) override { netlist_version_++; }
+  void inDbBTermPreDisconnect(odb::dbBTerm*) override { netlist_version_++; }
+
+ private:
+  odb::dbBlock* block_ = nullptr;
+  int64_t netlist_version_ = 0;
+  Key key_;
+  Entry entry_;
+};
+
+class PhaseTimer;
+
 class TritonPart
 {
  public:
@@ -100,6 +212,18 @@ class TritonPart
                        const char* group_file_arg,
                        const char* solution_filename_arg);
 
+  // Incremental re-partitioning for small netlist ECOs.
+  // The hypergraph and solution_ of the previous PartitionDesign call are
+  // patched in place for the netlist changes, then only the vertices around
+  // the touched vertices are refined (greedy and k-way FM refinement).
+  // The critical timing paths are not extracted again.
+  void PartitionDesignEco(const NetlistEco& eco,
+                          const char* solution_filename_arg);
+
+  // Same as above, the netlist changes are recorded through the OpenDB
+  // callbacks since the previous PartitionDesign or PartitionDesignEco call.
+  void PartitionDesignEco(const char* solution_filename_arg);
+
   // Function to evaluate the hypergraph partitioning solution
   // This can be used to write the timing-weighted hypergraph
   // and evaluate the solution.
@@ -148,6 +272,21 @@ class TritonPart
                            const char* group_file,
                            const char* placement_file);
 
+  // Partition an in-memory hypergraph with the same multi-level flow as
+  // above, without the timing-driven parts and without writing the
+  // solution file.  The hypergraph is modified (see
+  // Coarsener::GroupVertices).  This is used by par_bench.
+  std::vector<int> PartitionHypergraph(HGraphPtr hypergraph,
+                                       unsigned int num_parts,
+                                       float balance_constraint,
+                                       unsigned int seed);
+
+  // Read a hypergraph in the hMETIS text format or in the binary format,
+  // with the same reader as PartitionHypergraph
+  HGraphPtr ReadHypergraphFile(const std::string& hypergraph_file,
+                               int vertex_dimension,
+                               int hyperedge_dimension);
+
 void RefineHypergraphPartition(unsigned int num_parts,
                            float balance_constraint,
                            std::vector<float> base_balance,
@@ -195,6 +334,13 @@ void RefineHypergraphPartition(unsigned int num_parts,
                        float extra_delay,
                        bool guardband_flag);
 
+  // The timing paths are reused from (and stored into) timing_path_cache
+  // if the netlist has not changed since they were extracted
+  void SetTimingPathCache(std::shared_ptr<TimingPathCache> timing_path_cache)
+  {
+    timing_path_cache_ = std::move(timing_path_cache);
+  }
+
   // The cost introduced by a cut hyperedge e is e_wt_factors
   // dot_product hyperedge_weights_[e]. This parameter is used by
   // coarsening and partitioning
@@ -251,8 +397,22 @@ void RefineHypergraphPartition(unsigned int num_parts,
       int max_num_vcycle,
       int num_coarsen_solutions,
       int num_vertices_threshold_ilp,
+      int num_vertices_threshold_lp,
       int global_net_threshold);
 
+  // The fine-tuning parameters above by name (the defaults if
+  // SetFineTuneParams has not been called)
+  std::map<std::string, double> GetFineTuneParams() const;
+
+  // Number of workers of the thread pool shared by the partitioners
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  // Record the runtime of each phase of the multi-level partitioner
+  void SetPhaseTimer(std::shared_ptr<PhaseTimer> phase_timer)
+  {
+    phase_timer_ = std::move(phase_timer);
+  }
+
  private:
   // Main partititon function
   void MultiLevelPartition();
@@ -260,7 +420,7 @@ void RefineHypergraphPartition(unsigned int num_parts,
   // refinement function
   void Refine();
 
-  // read and build hypergraph
+  // read and build hypergraph (hMETIS text format or binary format)
   void ReadHypergraph(const std::string& hypergraph,
                       const std::string& fixed_file,
                       const std::string& community_file,
@@ -273,6 +433,16 @@ void RefineHypergraphPartition(unsigned int num_parts,
                    const std::string& community_file,
                    const std::string& group_file);
   void BuildTimingPaths();  // Find all the critical timing paths
+  void ExtractTimingPaths();  // Query the top_n_ paths from OpenSTA
+
+  // the vertices connected by the net (the driver is the first one)
+  std::vector<int> GetNetVertices(odb::dbNet* net) const;
+  // the slack of the net normalized by the maximum clock period
+  float GetNetSlack(odb::dbNet* net, bool& unconstrained) const;
+  float NormalizeNetSlack(float slack, bool& unconstrained) const;
+
+  // write the solution_ of design partitioning to OpenDB and solution file
+  void WriteDesignSolution(const std::string& solution_file);
 
   // private member functions
   ord::dbNetwork* network_ = nullptr;
@@ -291,6 +461,9 @@ void RefineHypergraphPartition(unsigned int num_parts,
   // random seed
   int seed_ = 0;
 
+  int num_threads_ = 1;
+  std::shared_ptr<PhaseTimer> phase_timer_;
+
   // ---- support for partitioning design with placed information
   // ---- for example, pin-3D flow
   bool placement_flag_
@@ -422,6 +595,12 @@ void RefineHypergraphPartition(unsigned int num_parts,
   // num_vertices_threshold_ilp_, then we will NOT use ILP-based partitioning
   int num_vertices_threshold_ilp_ = 50;
 
+  // number of vertices used for label propagation refinement
+  // If the number of vertices of a hypergraph is not smaller than
+  // num_vertices_threshold_lp_, then we run parallel label propagation
+  // before FM refinement.  0 disables label propagation.
+  int num_vertices_threshold_lp_ = 0;
+
   // Hypergraph information
   // basic information
   std::vector<std::vector<int>> hyperedges_;
@@ -442,6 +621,13 @@ void RefineHypergraphPartition(unsigned int num_parts,
   // Final solution
   std::vector<int> solution_;  // store the part_id for each vertex
 
+  // ---- netlist ECO support (design partitioning)
+  std::vector<odb::dbNet*> hyperedge_nets_;  // the net of each hyperedge
+  NetlistEcoRecorder eco_recorder_;
+
+  // the timing paths extracted by the previous design partitioning
+  std::shared_ptr<TimingPathCache> timing_path_cache_ = nullptr;
+
   // logger
   utl::Logger* logger_ = nullptr;
 };
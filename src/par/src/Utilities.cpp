@@ -44,6 +44,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <charconv>
 #include <chrono>
 #include <climits>
 #include <cmath>
@@ -132,48 +133,137 @@ std::vector<std::string> SplitLine(const std::string& line)
   return items;
 }
 
-// Add right vector to left vector
-void Accumulate(std::vector<float>& a, const std::vector<float>& b)
+bool ReadWholeFile(const std::string& file_name, std::string& content)
+{
+  std::ifstream file_input(file_name, std::ios::binary);
+  if (!file_input.is_open()) {
+    return false;
+  }
+  file_input.seekg(0, std::ios::end);
+  content.resize(file_input.tellg());
+  file_input.seekg(0, std::ios::beg);
+  file_input.read(content.data(), content.size());
+  return true;
+}
+
+bool PopLine(std::string_view& text, std::string_view& line)
+{
+  if (text.empty()) {
+    return false;
+  }
+  const size_t pos = text.find('\n');
+  if (pos == std::string_view::npos) {
+    line = text;
+    text = std::string_view();
+  } else {
+    line = text.substr(0, pos);
+    text.remove_prefix(pos + 1);
+  }
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  return true;
+}
+
+namespace {
+
+bool IsNumberDelim(const char c)
+{
+  return c == ' ' || c == ',' || c == '\t' || c == '\r' || c == '\n';
+}
+
+template <typename T>
+size_t ParseNumbersImpl(std::string_view text,
+                        std::vector<T>& values,
+                        const int max_num_values)
+{
+  const char* const begin = text.data();
+  const char* const end = begin + text.size();
+  const char* ptr = begin;
+  for (int num_values = 0; num_values < max_num_values; num_values++) {
+    const char* token = ptr;
+    while (token != end && IsNumberDelim(*token)) {
+      token++;
+    }
+    if (token != end && *token == '+') {
+      token++;  // std::from_chars does not accept the leading '+'
+    }
+    T value;
+    const auto [next, error_code] = std::from_chars(token, end, value);
+    if (error_code != std::errc()) {
+      break;
+    }
+    values.push_back(value);
+    ptr = next;
+  }
+  return ptr - begin;
+}
+
+}  // namespace
+
+size_t ParseNumbers(std::string_view text,
+                    std::vector<int>& values,
+                    const int max_num_values)
+{
+  return ParseNumbersImpl(text, values, max_num_values);
+}
+
+size_t ParseNumbers(std::string_view text,
+                    std::vector<float>& values,
+                    const int max_num_values)
+{
+  return ParseNumbersImpl(text, values, max_num_values);
+}
+
+// a += b
+void Accumulate(Span<float> a, Span<const float> b)
 {
   assert(a.size() == b.size());
-  std::transform(a.begin(), a.end(), b.begin(), a.begin(), std::plus<float>());
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    a[i] += b[i];
+  }
 }
 
-// weighted sum
-std::vector<float> WeightedSum(const std::vector<float>& a,
-                               const float a_factor,
-                               const std::vector<float>& b,
-                               const float b_factor)
+// a -= b
+void Subtract(Span<float> a, Span<const float> b)
 {
   assert(a.size() == b.size());
-  std::vector<float> result;
-  result.reserve(a.size());
-  auto a_iter = a.begin();
-  auto b_iter = b.begin();
-  while (a_iter != a.end()) {
-    result.push_back(((*a_iter++) * a_factor + (*b_iter++) * b_factor)
-                     / (a_factor + b_factor));
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    a[i] -= b[i];
   }
-  return result;
 }
 
-// divide the vector
-std::vector<float> DivideFactor(const std::vector<float>& a, const float factor)
+// a *= factor
+void MultiplyFactor(Span<float> a, const float factor)
 {
-  std::vector<float> result = a;
-  for (auto& value : result) {
-    value /= factor;
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    a[i] *= factor;
   }
-  return result;
 }
 
-// multiply the vector
-std::vector<float> MultiplyFactor(const std::vector<float>& a,
-                                  const float factor)
+// result = a * a_factor + b * b_factor
+void WeightedSum(Span<const float> a,
+                 const float a_factor,
+                 Span<const float> b,
+                 const float b_factor,
+                 Span<float> result)
+{
+  assert(a.size() == b.size() && a.size() == result.size());
+  const size_t size = result.size();
+  for (size_t i = 0; i < size; i++) {
+    result[i] = a[i] * a_factor + b[i] * b_factor;
+  }
+}
+
+// divide the vector
+std::vector<float> DivideFactor(const std::vector<float>& a, const float factor)
 {
   std::vector<float> result = a;
   for (auto& value : result) {
-    value *= factor;
+    value /= factor;
   }
   return result;
 }
@@ -197,66 +287,57 @@ std::vector<float> DivideVectorElebyEle(const std::vector<float>& emb,
   return result;
 }
 
-// operation for two vectors +, -, *,  ==, <
-std::vector<float> operator+(const std::vector<float>& a,
-                             const std::vector<float>& b)
+// all(a + sign * b < c)
+bool ShiftedLess(Span<const float> a,
+                 Span<const float> b,
+                 const float sign,
+                 Span<const float> c)
 {
-  assert(a.size() == b.size());
-  std::vector<float> result;
-  result.reserve(a.size());
-  std::transform(a.begin(),
-                 a.end(),
-                 b.begin(),
-                 std::back_inserter(result),
-                 std::plus<float>());
-  return result;
-}
-
-std::vector<float> operator-(const std::vector<float>& a,
-                             const std::vector<float>& b)
-{
-  assert(a.size() == b.size());
-  std::vector<float> result;
-  result.reserve(a.size());
-  std::transform(a.begin(),
-                 a.end(),
-                 b.begin(),
-                 std::back_inserter(result),
-                 std::minus<float>());
-  return result;
+  assert(a.size() == b.size() && a.size() == c.size());
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    if (a[i] + sign * b[i] >= c[i]) {
+      return false;
+    }
+  }
+  return true;
 }
 
-std::vector<float> operator*(const std::vector<float>& a,
-                             const std::vector<float>& b)
+// lexicographical comparison between a + sign * b and c
+int ShiftedLexCompare(Span<const float> a,
+                      Span<const float> b,
+                      const float sign,
+                      Span<const float> c)
 {
   assert(a.size() == b.size());
-  std::vector<float> result;
-  result.reserve(a.size());
-  std::transform(a.begin(),
-                 a.end(),
-                 b.begin(),
-                 std::back_inserter(result),
-                 std::multiplies<float>());
-  return result;
+  const size_t size = std::min(a.size(), c.size());
+  for (size_t i = 0; i < size; i++) {
+    const float value = a[i] + sign * b[i];
+    if (value < c[i]) {
+      return -1;
+    }
+    if (c[i] < value) {
+      return 1;
+    }
+  }
+  if (a.size() == c.size()) {
+    return 0;
+  }
+  return a.size() < c.size() ? -1 : 1;
 }
 
-std::vector<float> operator*(const std::vector<float>& a, const float factor)
+// operation for two vectors <, <=, ==
+bool operator<(const std::vector<float>& a, const std::vector<float>& b)
 {
-  std::vector<float> result;
-  result.reserve(a.size());
-  for (auto value : a) {
-    result.push_back(value * factor);
-  }
-  return result;
+  return Span<const float>(a) < Span<const float>(b);
 }
 
-bool operator<(const std::vector<float>& a, const std::vector<float>& b)
+bool operator<(Span<const float> a, Span<const float> b)
 {
   assert(a.size() == b.size());
-  auto a_iter = a.begin();
-  auto b_iter = b.begin();
-  while (a_iter != a.end()) {
-    if ((*a_iter++) >= (*b_iter++)) {
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    if (a[i] >= b[i]) {
       return false;
     }
   }
@@ -282,34 +363,38 @@ bool operator<=(const Matrix<float>& a, const Matrix<float>& b)
 }
 
 // Basic functions for a vector
-std::vector<float> abs(const std::vector<float>& a)
+float norm2(Span<const float> a)
 {
-  std::vector<float> result;
-  result.reserve(a.size());
-  std::transform(a.begin(),
-                 a.end(),
-                 std::back_inserter(result),
-                 static_cast<float (*)(float)>(&std::abs));
-  return result;
+  float result{0};
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    result += a[i] * a[i];
+  }
+  return std::sqrt(result);
 }
 
-float norm2(const std::vector<float>& a)
+float norm2(Span<const float> a, Span<const float> factor)
 {
   float result{0};
-  result = std::inner_product(a.begin(), a.end(), a.begin(), result);
+  assert(a.size() <= factor.size());
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    result += a[i] * a[i] * std::abs(factor[i]);
+  }
   return std::sqrt(result);
 }
 
-float norm2(const std::vector<float>& a, const std::vector<float>& factor)
+// norm2(a - b, factor)
+float WeightedDistance(Span<const float> a,
+                       Span<const float> b,
+                       Span<const float> factor)
 {
   float result{0};
-  assert(a.size() <= factor.size());
-  auto a_iter = a.begin();
-  auto factor_iter = factor.begin();
-  while (a_iter != a.end()) {
-    result += (*a_iter) * (*a_iter) * std::abs(*factor_iter);
-    a_iter++;
-    factor_iter++;
+  assert(a.size() == b.size() && a.size() <= factor.size());
+  const size_t size = a.size();
+  for (size_t i = 0; i < size; i++) {
+    const float diff = a[i] - b[i];
+    result += diff * diff * std::abs(factor[i]);
   }
   return std::sqrt(result);
 }
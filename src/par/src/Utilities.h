@@ -36,8 +36,11 @@
 // This file includes the basic utility functions for operations
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <limits>
 #include <map>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #ifdef LOAD_CPLEX
@@ -52,6 +55,47 @@ namespace par {
 template <typename T>
 using Matrix = std::vector<std::vector<T>>;
 
+// Span is a non-owning view of a contiguous sequence of elements,
+// e.g., the weights of one vertex in the flat weight array of Hypergraph.
+// (std::span is only available from C++20)
+template <typename T>
+class Span
+{
+ public:
+  using value_type = std::remove_const_t<T>;
+
+  Span() = default;
+  Span(T* data, size_t size) : data_(data), size_(size) {}
+  Span(std::vector<value_type>& vec) : data_(vec.data()), size_(vec.size()) {}
+  // read-only views can also be built from const vectors and mutable views
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_const_v<U>>>
+  Span(const std::vector<value_type>& vec)
+      : data_(vec.data()), size_(vec.size())
+  {
+  }
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_const_v<U>>>
+  Span(const Span<value_type>& other)
+      : data_(other.data()), size_(other.size())
+  {
+  }
+
+  T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T* begin() const { return data_; }
+  T* end() const { return data_ + size_; }
+  T& operator[](size_t i) const { return data_[i]; }
+
+  // copy the elements into a new vector
+  std::vector<value_type> ToVector() const { return {begin(), end()}; }
+
+ private:
+  T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
 struct Rect
 {
   // all the values are in db unit
@@ -91,14 +135,47 @@ std::string GetVectorString(const std::vector<float>& vec);
 // Split a string based on deliminator : empty space and ","
 std::vector<std::string> SplitLine(const std::string& line);
 
-// Add right vector to left vector
-void Accumulate(std::vector<float>& a, const std::vector<float>& b);
-
-// weighted sum
-std::vector<float> WeightedSum(const std::vector<float>& a,
-                               float a_factor,
-                               const std::vector<float>& b,
-                               float b_factor);
+// Fast path for reading text files.
+// Read the whole file into content. Return false if the file can not be opened
+bool ReadWholeFile(const std::string& file_name, std::string& content);
+
+// Pop the first line from text (without the line break).
+// Return false if there is no line left.
+bool PopLine(std::string_view& text, std::string_view& line);
+
+// Parse the numbers in text with std::from_chars and append them to values.
+// The numbers are separated by empty space (including tabs) or ",".
+// Similar to std::istream, the parsing stops at the first invalid number
+// (or after max_num_values numbers). Return the position after the last
+// parsed number.
+size_t ParseNumbers(std::string_view text,
+                    std::vector<int>& values,
+                    int max_num_values = std::numeric_limits<int>::max());
+size_t ParseNumbers(std::string_view text,
+                    std::vector<float>& values,
+                    int max_num_values = std::numeric_limits<int>::max());
+
+// Allocation-free kernels on spans.
+// The hypergraph stores all the weights and attributes in flat arrays,
+// the kernels below work in place on the rows of these arrays (and on
+// std::vector, which converts to Span implicitly).  They are written
+// as plain indexed loops such that the compiler can vectorize them.
+
+// a += b
+void Accumulate(Span<float> a, Span<const float> b);
+
+// a -= b
+void Subtract(Span<float> a, Span<const float> b);
+
+// a *= factor
+void MultiplyFactor(Span<float> a, float factor);
+
+// result = a * a_factor + b * b_factor.  result can alias a or b.
+void WeightedSum(Span<const float> a,
+                 float a_factor,
+                 Span<const float> b,
+                 float b_factor,
+                 Span<float> result);
 
 // divide the vector
 std::vector<float> DivideFactor(const std::vector<float>& a, float factor);
@@ -107,33 +184,37 @@ std::vector<float> DivideFactor(const std::vector<float>& a, float factor);
 std::vector<float> DivideVectorElebyEle(const std::vector<float>& emb,
                                         const std::vector<float>& factor);
 
-// multiplty the vector
-std::vector<float> MultiplyFactor(const std::vector<float>& a, float factor);
-
-// operation for two vectors +, -, *,  ==, <
-std::vector<float> operator+(const std::vector<float>& a,
-                             const std::vector<float>& b);
-
-std::vector<float> operator*(const std::vector<float>& a, float factor);
-
-std::vector<float> operator-(const std::vector<float>& a,
-                             const std::vector<float>& b);
-
-std::vector<float> operator*(const std::vector<float>& a,
-                             const std::vector<float>& b);
-
+// Compare (a + sign * b) with c without materializing (a + sign * b).
+// ShiftedLess follows operator< below (all the elements are less),
+// ShiftedLexCompare follows the lexicographical comparison of std::vector
+// and returns -1, 0 or 1.
+bool ShiftedLess(Span<const float> a,
+                 Span<const float> b,
+                 float sign,
+                 Span<const float> c);
+
+int ShiftedLexCompare(Span<const float> a,
+                      Span<const float> b,
+                      float sign,
+                      Span<const float> c);
+
+// operation for two vectors <, <=, ==
 bool operator<(const std::vector<float>& a, const std::vector<float>& b);
+bool operator<(Span<const float> a, Span<const float> b);
 
 bool operator<=(const Matrix<float>& a, const Matrix<float>& b);
 
 bool operator==(const std::vector<float>& a, const std::vector<float>& b);
 
 // Basic functions for a vector
-std::vector<float> abs(const std::vector<float>& a);
+float norm2(Span<const float> a);
 
-float norm2(const std::vector<float>& a);
+float norm2(Span<const float> a, Span<const float> factor);
 
-float norm2(const std::vector<float>& a, const std::vector<float>& factor);
+// norm2(a - b, factor)
+float WeightedDistance(Span<const float> a,
+                       Span<const float> b,
+                       Span<const float> factor);
 
 // ILP-based Partitioning Instance
 // Call ILP Solver to partition the design
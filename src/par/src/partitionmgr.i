@@ -107,6 +107,7 @@ void triton_part_hypergraph(unsigned int num_parts,
                             int max_num_vcycle,
                             int num_coarsen_solutions,
                             int num_vertices_threshold_ilp,
+                            int num_vertices_threshold_lp,
                             int global_net_threshold)
 {
   getPartitionMgr()->tritonPartHypergraph(
@@ -148,6 +149,7 @@ void triton_part_hypergraph(unsigned int num_parts,
       max_num_vcycle,
       num_coarsen_solutions,
       num_vertices_threshold_ilp,
+      num_vertices_threshold_lp,
       global_net_threshold);
 }
 
@@ -190,6 +192,7 @@ void triton_part_refine(unsigned int num_parts,
                             int max_num_vcycle,
                             int num_coarsen_solutions,
                             int num_vertices_threshold_ilp,
+                            int num_vertices_threshold_lp,
                             int global_net_threshold)
 {
   getPartitionMgr()->tritonPartRefine(
@@ -232,6 +235,7 @@ void triton_part_refine(unsigned int num_parts,
       max_num_vcycle,
       num_coarsen_solutions,
       num_vertices_threshold_ilp,
+      num_vertices_threshold_lp,
       global_net_threshold);
 }
 
@@ -311,6 +315,7 @@ void triton_part_design(unsigned int num_parts_arg,
                         int max_num_vcycle,
                         int num_coarsen_solutions,
                         int num_vertices_threshold_ilp,
+                        int num_vertices_threshold_lp,
                         int global_net_threshold)
 {
   getPartitionMgr()->tritonPartDesign(
@@ -363,9 +368,15 @@ void triton_part_design(unsigned int num_parts_arg,
       max_num_vcycle,
       num_coarsen_solutions,
       num_vertices_threshold_ilp,
+      num_vertices_threshold_lp,
       global_net_threshold);
 }
 
+void triton_part_design_eco(const char* solution_filename_arg)
+{
+  getPartitionMgr()->tritonPartDesignEco(solution_filename_arg);
+}
+
 void evaluate_part_design_solution(unsigned int num_parts_arg,
                                    float balance_constraint_arg,
                                    const std::vector<float>& base_balance_arg,
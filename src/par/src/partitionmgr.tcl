@@ -70,6 +70,7 @@ sta::define_cmd_args "triton_part_hypergraph" {
   [-max_num_vcycle max_num_vcycle] \
   [-num_coarsen_solutions num_coarsen_solutions] \
   [-num_vertices_threshold_ilp num_vertices_threshold_ilp] \
+  [-num_vertices_threshold_lp num_vertices_threshold_lp] \
   [-global_net_threshold global_net_threshold] \
   }
 proc triton_part_hypergraph { args } {
@@ -107,6 +108,7 @@ proc triton_part_hypergraph { args } {
             -max_num_vcycle \
             -num_coarsen_solutions \
             -num_vertices_threshold_ilp \
+            -num_vertices_threshold_lp \
             -global_net_threshold } \
       flags {}
  
@@ -146,6 +148,7 @@ proc triton_part_hypergraph { args } {
   set max_num_vcycle 1
   set num_coarsen_solutions 3
   set num_vertices_threshold_ilp 50
+  set num_vertices_threshold_lp 0
   set global_net_threshold 1000
   
   if { [info exists keys(-num_parts)] } {
@@ -276,6 +279,10 @@ proc triton_part_hypergraph { args } {
     set num_vertices_threshold_ilp $keys(-num_vertices_threshold_ilp)
   }
 
+  if { [info exists keys(-num_vertices_threshold_lp)] } {
+    set num_vertices_threshold_lp $keys(-num_vertices_threshold_lp)
+  }
+
   if { [info exists keys(-global_net_threshold)] } {
     set global_net_threshold $keys(-global_net_threshold)
   }
@@ -313,6 +320,7 @@ proc triton_part_hypergraph { args } {
             $max_num_vcycle \
             $num_coarsen_solutions \
             $num_vertices_threshold_ilp \
+            $num_vertices_threshold_lp \
             $global_net_threshold
 }
 
@@ -353,6 +361,7 @@ proc triton_part_refine { args } {
             -max_num_vcycle \
             -num_coarsen_solutions \
             -num_vertices_threshold_ilp \
+            -num_vertices_threshold_lp \
             -global_net_threshold } \
       flags {}
  
@@ -396,6 +405,7 @@ proc triton_part_refine { args } {
   set max_num_vcycle 1
   set num_coarsen_solutions 3
   set num_vertices_threshold_ilp 50
+  set num_vertices_threshold_lp 0
   set global_net_threshold 1000
   
   if { [info exists keys(-num_parts)] } {
@@ -526,6 +536,10 @@ proc triton_part_refine { args } {
     set num_vertices_threshold_ilp $keys(-num_vertices_threshold_ilp)
   }
 
+  if { [info exists keys(-num_vertices_threshold_lp)] } {
+    set num_vertices_threshold_lp $keys(-num_vertices_threshold_lp)
+  }
+
   if { [info exists keys(-global_net_threshold)] } {
     set global_net_threshold $keys(-global_net_threshold)
   }
@@ -564,6 +578,7 @@ proc triton_part_refine { args } {
             $max_num_vcycle \
             $num_coarsen_solutions \
             $num_vertices_threshold_ilp \
+            $num_vertices_threshold_lp \
             $global_net_threshold
 }
 
@@ -717,6 +732,7 @@ sta::define_cmd_args "triton_part_design" { [-num_parts num_parts] \
                                             [-max_num_vcycle max_num_vcycle] \
                                             [-num_coarsen_solutions num_coarsen_solutions] \
                                             [-num_vertices_threshold_ilp num_vertices_threshold_ilp] \
+                                            [-num_vertices_threshold_lp num_vertices_threshold_lp] \
                                             [-global_net_threshold global_net_threshold] \
                                           }
 proc triton_part_design { args } {
@@ -764,6 +780,7 @@ proc triton_part_design { args } {
             -max_num_vcycle \
             -num_coarsen_solutions \
             -num_vertices_threshold_ilp \
+            -num_vertices_threshold_lp \
             -global_net_threshold } \
       flags {}
   set num_parts 2
@@ -809,6 +826,7 @@ proc triton_part_design { args } {
   set max_num_vcycle 1
   set num_coarsen_solutions 4
   set num_vertices_threshold_ilp 50
+  set num_vertices_threshold_lp 0
   set global_net_threshold 1000
   
   if { [info exists keys(-num_parts)] } {
@@ -975,6 +993,10 @@ proc triton_part_design { args } {
     set num_vertices_threshold_ilp $keys(-num_vertices_threshold_ilp)
   }
 
+  if { [info exists keys(-num_vertices_threshold_lp)] } {
+    set num_vertices_threshold_lp $keys(-num_vertices_threshold_lp)
+  }
+
   if { [info exists keys(-global_net_threshold)] } {
     set global_net_threshold $keys(-global_net_threshold)
   }
@@ -1023,9 +1045,22 @@ proc triton_part_design { args } {
             $max_num_vcycle \
             $num_coarsen_solutions \
             $num_vertices_threshold_ilp \
+            $num_vertices_threshold_lp \
             $global_net_threshold 
 }
 
+sta::define_cmd_args "triton_part_design_eco" { [-solution_file solution_file] }
+proc triton_part_design_eco { args } {
+  sta::parse_key_args "triton_part_design_eco" args \
+      keys {-solution_file} \
+      flags {}
+  set solution_file ""
+  if { [info exists keys(-solution_file)] } {
+    set solution_file $keys(-solution_file)
+  }
+  par::triton_part_design_eco $solution_file
+}
+
 
 sta::define_cmd_args "evaluate_part_design_solution" { 
   [-num_parts num_parts] \
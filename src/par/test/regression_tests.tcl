@@ -0,0 +1,3 @@
+record_pass_fail_tests {
+  triton_part_eco
+}
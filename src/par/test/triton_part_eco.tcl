@@ -0,0 +1,74 @@
+# triton_part_design_eco after a buffer insertion must assign the new
+# buffer and keep the rest of the partition
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_liberty Nangate45/Nangate45_typ.lib
+read_def ../../drt/test/gcd_nangate45_preroute.def
+
+set block [ord::get_db_block]
+
+proc partition_id { inst } {
+  set property [odb::dbIntProperty_find $inst "partition_id"]
+  if { $property == "NULL" } {
+    return -1
+  }
+  return [$property getValue]
+}
+
+triton_part_design -num_parts 2 -balance_constraint 5 -seed 0 \
+  -timing_aware_flag false \
+  -solution_file [make_result_file triton_part_eco.part]
+
+set before {}
+foreach inst [$block getInsts] {
+  set part [partition_id $inst]
+  if { $part != -1 } {
+    dict set before [$inst getName] $part
+  }
+}
+
+# buffer the _515_ A1 sink of net _084_
+set buffer [odb::dbInst_create $block [[ord::get_db] findMaster "BUF_X1"] \
+              "eco_buf"]
+$buffer setLocation 128820 100800
+$buffer setPlacementStatus PLACED
+set eco_net [odb::dbNet_create $block "eco_net"]
+[$buffer findITerm "A"] connect [$block findNet "_084_"]
+[$buffer findITerm "Z"] connect $eco_net
+set sink [[$block findInst "_515_"] findITerm "A1"]
+$sink disconnect
+$sink connect $eco_net
+
+triton_part_design_eco \
+  -solution_file [make_result_file triton_part_eco_after.part]
+
+if { [dict size $before] == 0 } {
+  puts "FAIL: No partitioned instances"
+  exit 1
+}
+set buffer_part [partition_id $buffer]
+if { $buffer_part != 0 && $buffer_part != 1 } {
+  puts "FAIL: eco_buf is in partition $buffer_part"
+  exit 1
+}
+set moved 0
+dict for {name part} $before {
+  set after [partition_id [$block findInst $name]]
+  if { $after != 0 && $after != 1 } {
+    puts "FAIL: $name is in partition $after after the ECO"
+    exit 1
+  }
+  if { $after != $part } {
+    incr moved
+  }
+}
+# only the neighborhood of the buffered net may move
+if { $moved * 10 > [dict size $before] } {
+  puts "FAIL: $moved of [dict size $before] instances moved by the ECO"
+  exit 1
+}
+
+puts "pass"
+exit 0
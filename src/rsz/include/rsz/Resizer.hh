@@ -325,6 +325,10 @@ public:
   // resizeSlackPreamble must be called before the first findResizeSlacks.
   void resizeSlackPreamble();
   void findResizeSlacks();
+  // findResizeSlacks after a full pass: only the moved nets and the nets
+  // changed by the previous pass get new parasitics.  repair_design still
+  // covers the whole design (see Resizer.cc).
+  void findResizeSlacksIncremental(const vector<dbNet*> &moved_nets);
   // Return nets with worst slack.
   NetSeq &resizeWorstSlackNets();
   // Return net slack, if any (indicated by the bool).
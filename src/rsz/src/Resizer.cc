@@ -35,6 +35,7 @@
 
 #include "rsz/Resizer.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <optional>
@@ -65,6 +66,7 @@
 #include "sta/TimingModel.hh"
 #include "sta/Units.hh"
 #include "utl/Logger.h"
+#include "utl/timer.h"
 
 // http://vlsicad.eecs.umich.edu/BK/Slots/cache/dropzone.tamu.edu/~zhuoli/GSRC/fast_buffer_insertion.html
 
@@ -1146,6 +1148,55 @@ Resizer::findResizeSlacks()
   findResizeSlacks1();
   journalRestore(resize_count_, inserted_buffer_count_, cloned_gate_count_);
 }
+
+// Only the parasitics of the moved nets are estimated again, and the
+// slack update is incremental in the STA as well because only the delays
+// of nets with new parasitics are invalidated.
+//
+// repair_design is still run on the whole design.  Every call starts from
+// the netlist restored by the previous journalRestore, so the buffers and
+// driver resizing of the nets that did not move are gone too.  Repairing
+// only the moved nets or their fanin/fanout cone would leave every other
+// long or overloaded net unrepaired, and the slacks of their paths would
+// be those of the unrepaired netlist instead of the ones findResizeSlacks
+// reports.  "set_debug_level RSZ resize_slacks 1" reports the time spent
+// in repair_design against the parasitics and slack update.
+void
+Resizer::findResizeSlacksIncremental(const vector<dbNet*> &moved_nets)
+{
+  if (parasitics_src_ != ParasiticsSrc::placement) {
+    findResizeSlacks();
+    return;
+  }
+  journalBegin();
+  utl::Timer parasitics_timer;
+  for (dbNet *db_net : moved_nets)
+    parasiticsInvalid(db_net);
+  // Also picks up the nets invalidated by the last journalRestore.
+  updateParasitics();
+  const double parasitics_time = parasitics_timer.elapsed();
+
+  utl::Timer repair_timer;
+  int repaired_net_count, slew_violations, cap_violations;
+  int fanout_violations, length_violations;
+  repair_design_->repairDesign(max_wire_length_, 0.0, 0.0, false,
+                               repaired_net_count, slew_violations, cap_violations,
+                               fanout_violations, length_violations);
+  const double repair_time = repair_timer.elapsed();
+
+  utl::Timer slack_timer;
+  findResizeSlacks1();
+  const double slack_time = slack_timer.elapsed();
+  journalRestore(resize_count_, inserted_buffer_count_, cloned_gate_count_);
+  debugPrint(logger_, RSZ, "resize_slacks", 1,
+             "{} moved nets: parasitics {:.3f}s, repair_design {:.3f}s "
+             "({} nets repaired), slacks {:.3f}s",
+             moved_nets.size(),
+             parasitics_time,
+             repair_time,
+             repaired_net_count,
+             slack_time);
+}
   
 void
 Resizer::findResizeSlacks1()
@@ -1153,7 +1204,7 @@ Resizer::findResizeSlacks1()
   // Use driver pin slacks rather than Sta::netSlack to save visiting
   // the net pins and min'ing the slack.
   net_slack_map_.clear();
-  NetSeq nets;
+  vector<pair<Slack, const Net*>> net_slacks;
   for (int i = level_drvr_vertices_.size() - 1; i >= 0; i--) {
     Vertex *drvr = level_drvr_vertices_[i];
     Pin *drvr_pin = drvr->pin();
@@ -1165,20 +1216,28 @@ Resizer::findResizeSlacks1()
         // Hands off special nets.
         && !db_network_->isSpecial(net)
         && !sta_->isClock(drvr_pin)) {
-      net_slack_map_[net] = sta_->vertexSlack(drvr, max_);
-      nets.emplace_back(net);
+      const Slack slack = sta_->vertexSlack(drvr, max_);
+      net_slack_map_[net] = slack;
+      net_slacks.emplace_back(slack, net);
     }
   }
 
   // Find the nets with the worst slack.
-
-  //  sort(nets.begin(), nets.end(). [&](const Net *net1,
-  sort(nets, [this](const Net *net1,
-                 const Net *net2)
-             { return resizeNetSlack(net1) < resizeNetSlack(net2); });
+  // Only they need to be sorted.
+  const size_t worst_count
+    = std::min(net_slacks.size(),
+               static_cast<size_t>(std::ceil(net_slacks.size()
+                                             * worst_slack_nets_percent_
+                                             / 100.0)));
+  std::partial_sort(net_slacks.begin(),
+                    net_slacks.begin() + worst_count,
+                    net_slacks.end(),
+                    [](const pair<Slack, const Net*> &slack1,
+                       const pair<Slack, const Net*> &slack2)
+                    { return slack1.first < slack2.first; });
   worst_slack_nets_.clear();
-  for (int i = 0; i < nets.size() * worst_slack_nets_percent_ / 100.0; i++)
-    worst_slack_nets_.emplace_back(nets[i]);
+  for (size_t i = 0; i < worst_count; i++)
+    worst_slack_nets_.emplace_back(net_slacks[i].second);
 }
 
 NetSeq &
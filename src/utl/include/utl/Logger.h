@@ -40,6 +40,7 @@
 #include <iomanip>
 #include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -263,6 +264,10 @@ class Logger
 
   void addSink(spdlog::sink_ptr sink);
   void removeSink(spdlog::sink_ptr sink);
+  // A logger with the debug levels and message counters of this one that
+  // only writes to sink. Tasks that run concurrently use it to buffer their
+  // messages, so they can be reported in a fixed order afterwards.
+  std::unique_ptr<Logger> cloneWithSink(spdlog::sink_ptr sink) const;
   void addMetricsSink(const char* metrics_filename);
   void removeMetricsSink(const char* metrics_filename);
 
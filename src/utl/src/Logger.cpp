@@ -147,6 +147,18 @@ void Logger::removeSink(spdlog::sink_ptr sink)
   }
 }
 
+std::unique_ptr<Logger> Logger::cloneWithSink(spdlog::sink_ptr sink) const
+{
+  auto logger = std::make_unique<Logger>();
+  logger->sinks_.clear();
+  logger->logger_->sinks().clear();
+  logger->addSink(sink);
+  logger->message_counters_ = message_counters_;
+  logger->debug_group_level_ = debug_group_level_;
+  logger->debug_on_ = debug_on_;
+  return logger;
+}
+
 void Logger::setMetricsStage(std::string_view format)
 {
   if (metrics_stages_.empty())